@@ -1,5 +1,6 @@
 #include <osc/osc_config.h>
 
+#include <OpenSimCreator/Platform/HeadlessCommands.h>
 #include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
 #include <OpenSimCreator/UI/MainUIScreen.h>
 #include <oscar/Platform/AppMetadata.h>
@@ -14,11 +15,19 @@ using namespace osc;
 
 namespace
 {
-    constexpr std::string_view c_Usage = "usage: osc [--help] [fd] MODEL.osim\n";
+    constexpr std::string_view c_Usage = R"(usage: osc [--help] [fd] MODEL.osim
+       osc COMMAND [ARGS...]
+)";
 
     constexpr std::string_view c_Help = R"(OPTIONS
     --help
         Show this help
+
+COMMANDS
+    Commands run headlessly (i.e. without creating a window or graphics context),
+    print a timing summary when they complete, and run multiple inputs concurrently
+    on N threads (default: the number of hardware threads).
+
 )";
 
     AppMetadata GetOpenSimCreatorAppMetadata()
@@ -37,6 +46,13 @@ namespace
 
 int main(int argc, char* argv[])
 {
+    const std::vector<std::string_view> args(argv + 1, argv + argc);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    // headless commands (e.g. `osc simulate MODEL.osim`) don't boot the UI
+    if (not args.empty() and IsHeadlessCommand(args.front())) {
+        return RunHeadlessCommand(args, std::cout, std::cerr);
+    }
+
     std::vector<std::string_view> unnamedArgs;
     for (int i = 1; i < argc; ++i)
     {
@@ -52,7 +68,8 @@ int main(int argc, char* argv[])
         }
         else if (arg == "--help")
         {
-            std::cout << c_Usage << '\n' << c_Help << '\n';
+            std::cout << c_Usage << '\n' << c_Help;
+            WriteHeadlessCommandsHelp(std::cout);
             return EXIT_SUCCESS;
         }
     }
@@ -0,0 +1,155 @@
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+
+#include <BenchOpenSimCreator/BenchOpenSimCreatorConfig.h>
+#include <benchmark/benchmark.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Graphics/AntiAliasingLevel.h>
+#include <oscar/Graphics/GraphicsBackendStats.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
+#include <oscar/Graphics/GraphicsContext.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Graphics/Scene/SceneRenderer.h>
+#include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/PolarPerspectiveCamera.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Platform/FilesystemResourceLoader.h>
+#include <oscar/Platform/ResourceLoader.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+// these benchmarks render models with a recording graphics backend, so that they measure the
+// CPU-side cost of the render path (culling, sorting, batching, etc.) and can run on machines
+// that don't have a GPU
+namespace
+{
+    // models of increasing size
+    constexpr auto c_model_paths = std::to_array({
+        "Arm26/arm26.osim",
+        "Tug_of_War/Tug_of_War.osim",
+        "RajagopalModel/Rajagopal2015.osim",
+    });
+    constexpr auto c_num_models = static_cast<int64_t>(c_model_paths.size());
+    constexpr Vec2 c_render_dimensions = {1920.0f, 1080.0f};
+
+    // holds everything that's needed to repeatedly render one model
+    struct RenderingFixture final {
+        explicit RenderingFixture(const std::filesystem::path& model_path) :
+            model{model_path}
+        {
+            GenerateModelDecorations(
+                cache,
+                model.getModel(),
+                model.getState(),
+                OpenSimDecorationOptions{},
+                1.0f,
+                [this](const OpenSim::Component&, SceneDecoration&& decoration)
+                {
+                    decorations.push_back(std::move(decoration));
+                }
+            );
+
+            std::optional<AABB> scene_bounds;
+            for (const SceneDecoration& decoration : decorations) {
+                scene_bounds = bounding_aabb_of(scene_bounds, worldspace_bounds_of(decoration));
+            }
+            PolarPerspectiveCamera camera;
+            if (scene_bounds) {
+                auto_focus(camera, *scene_bounds, c_render_dimensions.x/c_render_dimensions.y);
+            }
+            params = calc_standard_dark_scene_render_params(camera, AntiAliasingLevel{4}, c_render_dimensions);
+            params.cull_offscreen_decorations = true;  // as the model viewer does (see `CalcSceneRendererParams`)
+        }
+
+        // the context must outlive (and be initialized before) every other graphics object
+        GraphicsContext context{GraphicsBackendType::Recording};
+        SceneCache cache{make_resource_loader<FilesystemResourceLoader>(OSC_RESOURCES_DIR)};
+        BasicModelStatePair model;
+        std::vector<SceneDecoration> decorations;
+        SceneRendererParams params;
+        SceneRenderer renderer{cache};
+    };
+
+    std::filesystem::path GetModelPath(int64_t index)
+    {
+        [[maybe_unused]] static const bool s_opensim_initialized = []()
+        {
+            GloballyInitOpenSim();
+            GloballyAddDirectoryToOpenSimGeometrySearchPath(std::filesystem::path{OSC_RESOURCES_DIR} / "geometry");
+            return true;
+        }();
+        return std::filesystem::path{OSC_RESOURCES_DIR} / "models" / c_model_paths.at(static_cast<size_t>(index));
+    }
+
+    // reports the graphics backend's counters as per-frame averages
+    void SetBackendCounters(benchmark::State& state, const RenderingFixture& fixture)
+    {
+        const GraphicsBackendStats& stats = fixture.context.backend_stats();
+        const auto per_frame = [](size_t count)
+        {
+            return benchmark::Counter{static_cast<double>(count), benchmark::Counter::kAvgIterations};
+        };
+        state.counters["decorations"] = static_cast<double>(fixture.decorations.size());
+        state.counters["render_passes"] = per_frame(stats.num_render_passes);
+        state.counters["draw_calls"] = per_frame(stats.num_draw_calls);
+        state.counters["instances"] = per_frame(stats.num_instances_drawn);
+        state.counters["state_changes"] = per_frame(stats.num_state_changes);
+        state.counters["uniforms"] = per_frame(stats.num_uniforms_set);
+        state.counters["bytes_uploaded"] = per_frame(stats.num_bytes_uploaded);
+    }
+}
+
+// the CPU-side cost of rendering a model's (already-generated) decorations in one frame
+static void BM_RenderModelDecorations(benchmark::State& state)
+{
+    RenderingFixture fixture{GetModelPath(state.range(0))};
+    fixture.renderer.render(fixture.decorations, fixture.params);  // warm up (e.g. upload meshes)
+
+    fixture.context.reset_backend_stats();
+    for (auto _ : state) {
+        fixture.renderer.render(fixture.decorations, fixture.params);
+    }
+    SetBackendCounters(state, fixture);
+}
+BENCHMARK(BM_RenderModelDecorations)->DenseRange(0, c_num_models - 1)->Unit(benchmark::kMillisecond);
+
+// the CPU-side cost of generating, and then rendering, a model's decorations in one frame
+static void BM_GenerateAndRenderModelDecorations(benchmark::State& state)
+{
+    RenderingFixture fixture{GetModelPath(state.range(0))};
+    const OpenSimDecorationOptions options;
+    fixture.renderer.render(fixture.decorations, fixture.params);  // warm up (e.g. upload meshes)
+
+    fixture.context.reset_backend_stats();
+    for (auto _ : state) {
+        fixture.decorations.clear();
+        GenerateModelDecorations(
+            fixture.cache,
+            fixture.model.getModel(),
+            fixture.model.getState(),
+            options,
+            1.0f,
+            [&fixture](const OpenSim::Component&, SceneDecoration&& decoration)
+            {
+                fixture.decorations.push_back(std::move(decoration));
+            }
+        );
+        fixture.renderer.render(fixture.decorations, fixture.params);
+    }
+    SetBackendCounters(state, fixture);
+}
+BENCHMARK(BM_GenerateAndRenderModelDecorations)->DenseRange(0, c_num_models - 1)->Unit(benchmark::kMillisecond);
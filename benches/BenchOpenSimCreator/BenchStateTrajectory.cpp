@@ -0,0 +1,171 @@
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/StateTrajectory.h>
+
+#include <BenchOpenSimCreator/BenchOpenSimCreatorConfig.h>
+#include <benchmark/benchmark.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <Simbody.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+// replace the global `operator new`/`operator delete`, so that the benchmarks can measure how
+// many bytes are live on the heap
+//
+// care: on Windows, this only tracks allocations made by this executable (not its DLLs)
+namespace
+{
+    std::atomic<int64_t> g_live_heap_bytes{0};
+
+    // each allocation is prefixed with its size, so that `operator delete` can track it
+    constexpr size_t c_allocation_header_size = alignof(std::max_align_t);
+}
+
+void* operator new(size_t num_bytes)
+{
+    void* base = std::malloc(num_bytes + c_allocation_header_size);
+    if (not base) {
+        throw std::bad_alloc{};
+    }
+    *static_cast<size_t*>(base) = num_bytes;
+    g_live_heap_bytes += static_cast<int64_t>(num_bytes);
+    return static_cast<std::byte*>(base) + c_allocation_header_size;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (not ptr) {
+        return;
+    }
+    void* base = static_cast<std::byte*>(ptr) - c_allocation_header_size;
+    g_live_heap_bytes -= static_cast<int64_t>(*static_cast<size_t*>(base));
+    std::free(base);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+namespace
+{
+    // the number of reports that each benchmark stores (e.g. a 10 s simulation that's
+    // reported every 1 ms)
+    constexpr size_t c_num_reports = 10000;
+
+    // models of increasing size
+    constexpr auto c_model_paths = std::to_array({
+        "Arm26/arm26.osim",
+        "RajagopalModel/Rajagopal2015.osim",
+    });
+    constexpr auto c_num_models = static_cast<int64_t>(c_model_paths.size());
+    constexpr auto c_num_precisions = static_cast<int64_t>(num_options<StateTrajectoryPrecision>());
+
+    const BasicModelStatePair& GetModel(int64_t index)
+    {
+        static const auto s_models = []()
+        {
+            std::vector<BasicModelStatePair> rv;
+            for (const char* path : c_model_paths) {
+                rv.emplace_back(std::filesystem::path{OSC_RESOURCES_DIR} / "models" / path);
+            }
+            return rv;
+        }();
+        return s_models.at(static_cast<size_t>(index));
+    }
+
+    // returns an unrealized report, similar to what the simulator thread emits
+    SimulationReport MakeReport(const BasicModelStatePair& model, size_t i)
+    {
+        SimTK::State state = model.getState();
+        state.setTime(0.001 * static_cast<double>(i));
+        SimTK::Vector& y = state.updY();
+        for (int j = 0; j < y.size(); ++j) {
+            y[j] += 1e-6 * static_cast<double>(i);
+        }
+        state.invalidateAllCacheAtOrAbove(SimTK::Stage::Instance);
+        return SimulationReport{std::move(state)};
+    }
+
+    void SetMemoryCounters(benchmark::State& state, int64_t num_bytes, size_t num_continuous_state_variables)
+    {
+        state.counters["MiB"] = static_cast<double>(num_bytes) / (1024.0 * 1024.0);
+        state.counters["bytes_per_report"] = static_cast<double>(num_bytes) / static_cast<double>(c_num_reports);
+        state.counters["ny"] = static_cast<double>(num_continuous_state_variables);
+    }
+}
+
+// the original storage: a vector of reports, each containing a complete (realized) `SimTK::State`
+static void BM_StateStorageLegacyReportVector(benchmark::State& state)
+{
+    const BasicModelStatePair& model = GetModel(state.range(0));
+
+    int64_t num_bytes = 0;
+    for (auto _ : state) {
+        const int64_t before = g_live_heap_bytes.load();
+
+        std::vector<SimulationReport> reports;
+        for (size_t i = 0; i < c_num_reports; ++i) {
+            reports.push_back(MakeReport(model, i));
+            model.getModel().realizeReport(reports.back().updStateHACK());
+        }
+
+        num_bytes = g_live_heap_bytes.load() - before;
+        benchmark::DoNotOptimize(reports);
+    }
+    SetMemoryCounters(state, num_bytes, static_cast<size_t>(model.getState().getNY()));
+}
+BENCHMARK(BM_StateStorageLegacyReportVector)->DenseRange(0, c_num_models - 1)->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// a `StateTrajectory`, which only stores each report's continuous state variables
+static void BM_StateStorageStateTrajectory(benchmark::State& state)
+{
+    const BasicModelStatePair& model = GetModel(state.range(0));
+    const auto precision = from_index<StateTrajectoryPrecision>(static_cast<size_t>(state.range(1))).value();
+
+    int64_t num_bytes = 0;
+    for (auto _ : state) {
+        const int64_t before = g_live_heap_bytes.load();
+
+        StateTrajectory trajectory{precision};
+        for (size_t i = 0; i < c_num_reports; ++i) {
+            trajectory.push_back(MakeReport(model, i));
+        }
+
+        num_bytes = g_live_heap_bytes.load() - before;
+        benchmark::DoNotOptimize(trajectory);
+    }
+    SetMemoryCounters(state, num_bytes, static_cast<size_t>(model.getState().getNY()));
+}
+BENCHMARK(BM_StateStorageStateTrajectory)->ArgsProduct({
+    benchmark::CreateDenseRange(0, c_num_models - 1, 1),
+    benchmark::CreateDenseRange(0, c_num_precisions - 1, 1),
+})->Iterations(1)->Unit(benchmark::kMillisecond);
+
+// the cost of lazily rebuilding (and realizing) a report from a `StateTrajectory` (i.e. a cache miss)
+static void BM_StateTrajectoryRebuildReport(benchmark::State& state)
+{
+    const BasicModelStatePair& model = GetModel(state.range(0));
+
+    StateTrajectory trajectory{StateTrajectoryPrecision::Double, 0};  // (no caching: always rebuild)
+    for (size_t i = 0; i < 64; ++i) {
+        trajectory.push_back(MakeReport(model, i));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trajectory.getReport(i++ % trajectory.size(), model.getModel()));
+    }
+}
+BENCHMARK(BM_StateTrajectoryRebuildReport)->DenseRange(0, c_num_models - 1)->Unit(benchmark::kMicrosecond);
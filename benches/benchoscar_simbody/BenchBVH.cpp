@@ -0,0 +1,324 @@
+#include <benchoscar_simbody/benchoscar_simbody_config.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHBuildStrategy.h>
+#include <oscar/Maths/BVHCollision.h>
+#include <oscar/Maths/BVHNode.h>
+#include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/Triangle.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // meshes from `resources/geometry` that are benchmarked (large and/or long+thin)
+    constexpr auto c_benchmarked_meshes = std::to_array<std::string_view>({
+        "hat_ribs_scap.vtp",
+        "spine.vtp",
+        "fly_femur_mesh_scaled.stl",
+        "femur_r.vtp",
+        "skull.vtp",
+    });
+
+    struct BenchmarkedMesh final {
+        std::vector<Vec3> vertices;
+        std::vector<uint32_t> indices;
+        AABB bounds;
+    };
+
+    const BenchmarkedMesh& load_benchmarked_mesh(std::string_view filename)
+    {
+        static std::map<std::string_view, BenchmarkedMesh> s_cache;
+        if (const auto it = s_cache.find(filename); it != s_cache.end()) {
+            return it->second;
+        }
+
+        const Mesh mesh = LoadMeshViaSimTK(std::filesystem::path{OSC_RESOURCES_DIR} / "geometry" / filename);
+        const MeshIndicesView indices = mesh.indices();
+        return s_cache[filename] = BenchmarkedMesh{
+            .vertices = mesh.vertices(),
+            .indices = std::vector<uint32_t>(indices.begin(), indices.end()),
+            .bounds = mesh.bounds(),
+        };
+    }
+
+    // returns rays that start outside of `bounds` and point at random locations within it,
+    // which is roughly what hit-testing a mesh with a mouse does
+    std::vector<Line> generate_rays_into(const AABB& bounds, size_t n)
+    {
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        std::uniform_real_distribution<float> dist{0.0f, 1.0f};
+        const auto random_point_in = [&](const AABB& aabb)
+        {
+            return aabb.min + Vec3{dist(rng), dist(rng), dist(rng)}*dimensions_of(aabb);
+        };
+
+        const AABB origin_bounds{
+            .min = bounds.min - dimensions_of(bounds),
+            .max = bounds.max + dimensions_of(bounds),
+        };
+
+        std::vector<Line> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            const Vec3 origin = random_point_in(origin_bounds);
+            const Vec3 target = random_point_in(bounds);
+            rv.push_back(Line{.origin = origin, .direction = normalize(target - origin)});
+        }
+        return rv;
+    }
+
+    // a copy of the original (binary, recursive) `BVH` implementation, so that the
+    // wide/iterative implementation in `oscar` can be compared against it
+    namespace legacy
+    {
+        void build(std::vector<BVHNode>& nodes, std::vector<BVHPrim>& prims, ptrdiff_t begin, ptrdiff_t n)
+        {
+            if (n == 1) {
+                nodes.push_back(BVHNode::leaf(prims.at(begin).bounds(), begin));
+                return;
+            }
+
+            const AABB aabb = bounding_aabb_of(
+                std::span<const BVHPrim>{prims.begin() + begin, static_cast<size_t>(n)},
+                &BVHPrim::bounds
+            );
+            const auto longest_dim_index = max_element_index(dimensions_of(aabb));
+            const float midpoint_x2 = aabb.min[longest_dim_index] + aabb.max[longest_dim_index];
+            const auto it = std::partition(prims.begin() + begin, prims.begin() + begin + n, [&](const BVHPrim& p)
+            {
+                return p.bounds().min[longest_dim_index] + p.bounds().max[longest_dim_index] <= midpoint_x2;
+            });
+
+            ptrdiff_t midpoint = std::distance(prims.begin(), it);
+            if (midpoint == begin or midpoint == begin + n) {
+                midpoint = begin + n/2;
+            }
+
+            const ptrdiff_t internal_node_loc = std::ssize(nodes);
+            nodes.push_back(BVHNode::node(aabb, 0));
+            build(nodes, prims, begin, midpoint-begin);
+            nodes[internal_node_loc].set_num_lhs_nodes((std::ssize(nodes) - 1) - internal_node_loc);
+            build(nodes, prims, midpoint, (begin + n) - midpoint);
+        }
+
+        struct LegacyBVH final {
+            explicit LegacyBVH(const BenchmarkedMesh& mesh)
+            {
+                for (size_t i = 0; i+2 < mesh.indices.size(); i += 3) {
+                    const Triangle triangle{
+                        mesh.vertices[mesh.indices[i]],
+                        mesh.vertices[mesh.indices[i+1]],
+                        mesh.vertices[mesh.indices[i+2]],
+                    };
+                    if (not (triangle.p0 == triangle.p1 or triangle.p0 == triangle.p2 or triangle.p1 == triangle.p2)) {
+                        prims.emplace_back(static_cast<ptrdiff_t>(i), bounding_aabb_of(triangle));
+                    }
+                }
+                if (not prims.empty()) {
+                    build(nodes, prims, 0, std::ssize(prims));
+                }
+            }
+
+            std::vector<BVHNode> nodes;
+            std::vector<BVHPrim> prims;
+        };
+
+        std::optional<BVHCollision> closest_recursive(
+            const LegacyBVH& bvh,
+            const BenchmarkedMesh& mesh,
+            const Line& ray,
+            float& closest,
+            size_t node_index)
+        {
+            const BVHNode& node = bvh.nodes[node_index];
+            const std::optional<RayCollision> node_collision = find_collision(ray, node.bounds());
+            if (not node_collision or node_collision->distance > closest) {
+                return std::nullopt;
+            }
+
+            if (node.is_leaf()) {
+                const BVHPrim& prim = bvh.prims[node.first_prim_offset()];
+                const Triangle triangle{
+                    mesh.vertices[mesh.indices[prim.id()]],
+                    mesh.vertices[mesh.indices[prim.id()+1]],
+                    mesh.vertices[mesh.indices[prim.id()+2]],
+                };
+                const std::optional<RayCollision> collision = find_collision(ray, triangle);
+                if (collision and collision->distance < closest) {
+                    closest = collision->distance;
+                    return BVHCollision{collision->distance, collision->position, prim.id()};
+                }
+                return std::nullopt;
+            }
+
+            const auto lhs = closest_recursive(bvh, mesh, ray, closest, node_index+1);
+            const auto rhs = closest_recursive(bvh, mesh, ray, closest, node_index+node.num_lhs_nodes()+1);
+            return rhs ? rhs : lhs;
+        }
+
+        std::optional<BVHCollision> closest(const LegacyBVH& bvh, const BenchmarkedMesh& mesh, const Line& ray)
+        {
+            if (bvh.nodes.empty()) {
+                return std::nullopt;
+            }
+            float closest = std::numeric_limits<float>::max();
+            return closest_recursive(bvh, mesh, ray, closest, 0);
+        }
+    }
+
+    // returns the surface area heuristic (SAH) cost of `bvh`, assuming that traversing
+    // a node costs the same as intersecting a prim (lower is better)
+    double sah_cost_of(const BVH& bvh)
+    {
+        const std::optional<AABB> root_bounds = bvh.bounds();
+        if (not root_bounds) {
+            return 0.0;
+        }
+
+        const double root_area = surface_area_of(*root_bounds);
+        double rv = 0.0;
+        bvh.for_each_leaf_or_inner_node([root_area, &rv](const BVHNode& node)
+        {
+            rv += surface_area_of(node.bounds()) / root_area;
+        });
+        return rv;
+    }
+
+    // the strategies that are benchmarked (the benchmark's second argument)
+    constexpr auto c_benchmarked_strategies = std::to_array<BVHBuildStrategy>({
+        BVHBuildStrategy::Midpoint,
+        BVHBuildStrategy::BinnedSAH,
+    });
+
+    std::string_view to_string_view(BVHBuildStrategy strategy)
+    {
+        return strategy == BVHBuildStrategy::BinnedSAH ? "BinnedSAH" : "Midpoint";
+    }
+
+    void BM_BVHBuildFromIndexedTriangles(benchmark::State& state)
+    {
+        const std::string_view filename = c_benchmarked_meshes.at(static_cast<size_t>(state.range(0)));
+        const BVHBuildStrategy strategy = c_benchmarked_strategies.at(static_cast<size_t>(state.range(1)));
+        const BenchmarkedMesh& mesh = load_benchmarked_mesh(filename);
+
+        BVH bvh{strategy};
+        for (auto _ : state) {
+            bvh.build_from_indexed_triangles(mesh.vertices, mesh.indices);
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["triangles"] = static_cast<double>(mesh.indices.size()/3);
+        state.counters["sah_cost"] = sah_cost_of(bvh);
+        state.counters["max_depth"] = static_cast<double>(bvh.max_depth());
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mesh.indices.size()/3));
+        state.SetLabel(std::string{filename} + '/' + std::string{to_string_view(strategy)});
+    }
+
+    void BM_BVHClosestRayTriangleCollision(benchmark::State& state)
+    {
+        const std::string_view filename = c_benchmarked_meshes.at(static_cast<size_t>(state.range(0)));
+        const BVHBuildStrategy strategy = c_benchmarked_strategies.at(static_cast<size_t>(state.range(1)));
+        const BenchmarkedMesh& mesh = load_benchmarked_mesh(filename);
+        const std::vector<Line> rays = generate_rays_into(mesh.bounds, 1024);
+
+        BVH bvh{strategy};
+        bvh.build_from_indexed_triangles(mesh.vertices, mesh.indices);
+
+        // sanity check: should produce the same answer as the legacy implementation
+        //
+        // (the hit triangle's ID is only compared for identical trees, because equidistant
+        // hits are tie-broken on the tree's prim order)
+        const legacy::LegacyBVH legacy_bvh{mesh};
+        for (const Line& ray : rays) {
+            const auto expected = legacy::closest(legacy_bvh, mesh, ray);
+            const auto got = bvh.closest_ray_indexed_triangle_collision(mesh.vertices, mesh.indices, ray);
+            const bool same_id = strategy != BVHBuildStrategy::Midpoint or not expected or expected->id == got->id;
+            if (expected.has_value() != got.has_value() or (expected and (not same_id or expected->distance != got->distance))) {
+                state.SkipWithError("the BVH produced a different result from the legacy implementation");
+                return;
+            }
+        }
+
+        for (auto _ : state) {
+            for (const Line& ray : rays) {
+                benchmark::DoNotOptimize(bvh.closest_ray_indexed_triangle_collision(mesh.vertices, mesh.indices, ray));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size()));
+        state.SetLabel(std::string{filename} + '/' + std::string{to_string_view(strategy)});
+    }
+
+    void BM_LegacyBVHClosestRayTriangleCollision(benchmark::State& state)
+    {
+        const std::string_view filename = c_benchmarked_meshes.at(static_cast<size_t>(state.range(0)));
+        const BenchmarkedMesh& mesh = load_benchmarked_mesh(filename);
+        const std::vector<Line> rays = generate_rays_into(mesh.bounds, 1024);
+        const legacy::LegacyBVH legacy_bvh{mesh};
+
+        for (auto _ : state) {
+            for (const Line& ray : rays) {
+                benchmark::DoNotOptimize(legacy::closest(legacy_bvh, mesh, ray));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size()));
+        state.SetLabel(std::string{filename});
+    }
+
+    void BM_BVHForEachRayAABBCollision(benchmark::State& state)
+    {
+        const std::string_view filename = c_benchmarked_meshes.at(static_cast<size_t>(state.range(0)));
+        const BenchmarkedMesh& mesh = load_benchmarked_mesh(filename);
+        const std::vector<Line> rays = generate_rays_into(mesh.bounds, 1024);
+
+        BVH bvh;
+        bvh.build_from_indexed_triangles(mesh.vertices, mesh.indices);
+
+        for (auto _ : state) {
+            size_t num_collisions = 0;
+            for (const Line& ray : rays) {
+                bvh.for_each_ray_aabb_collision(ray, [&num_collisions](BVHCollision) { ++num_collisions; });
+            }
+            benchmark::DoNotOptimize(num_collisions);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size()));
+        state.SetLabel(std::string{filename});
+    }
+}
+
+BENCHMARK(BM_BVHBuildFromIndexedTriangles)->ArgsProduct({
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_meshes)-1, 1),
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_strategies)-1, 1),
+})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_BVHClosestRayTriangleCollision)->ArgsProduct({
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_meshes)-1, 1),
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_strategies)-1, 1),
+});
+BENCHMARK(BM_LegacyBVHClosestRayTriangleCollision)->DenseRange(0, std::ssize(c_benchmarked_meshes)-1);
+BENCHMARK(BM_BVHForEachRayAABBCollision)->DenseRange(0, std::ssize(c_benchmarked_meshes)-1);
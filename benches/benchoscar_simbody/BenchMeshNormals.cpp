@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // returns a (bumpy) grid mesh with `2 * (grid_size-1)^2` triangles, normals, and texture coordinates
+    Mesh generate_grid_mesh(size_t grid_size)
+    {
+        std::vector<Vec3> vertices;
+        std::vector<Vec2> tex_coords;
+        vertices.reserve(grid_size * grid_size);
+        tex_coords.reserve(grid_size * grid_size);
+        for (size_t row = 0; row < grid_size; ++row) {
+            for (size_t col = 0; col < grid_size; ++col) {
+                const auto x = static_cast<float>(col);
+                const auto z = static_cast<float>(row);
+                vertices.emplace_back(x, std::sin(0.1f*x) * std::cos(0.1f*z), z);
+                tex_coords.emplace_back(x / static_cast<float>(grid_size), z / static_cast<float>(grid_size));
+            }
+        }
+
+        std::vector<uint32_t> indices;
+        indices.reserve(6 * (grid_size-1) * (grid_size-1));
+        for (size_t row = 0; row < grid_size-1; ++row) {
+            for (size_t col = 0; col < grid_size-1; ++col) {
+                const auto i = static_cast<uint32_t>(row*grid_size + col);
+                const auto below = static_cast<uint32_t>(i + grid_size);
+                indices.insert(indices.end(), {i, below, i+1,  i+1, below, below+1});
+            }
+        }
+
+        Mesh rv;
+        rv.set_vertices(vertices);
+        rv.set_tex_coords(tex_coords);
+        rv.set_indices(indices);
+        rv.recalculate_normals();
+        return rv;
+    }
+
+    void set_counters(benchmark::State& state, const Mesh& mesh)
+    {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (mesh.num_indices()/3)));
+        state.SetLabel("triangles=" + std::to_string(mesh.num_indices()/3));
+    }
+
+    void BM_MeshRecalculateNormals(benchmark::State& state)
+    {
+        Mesh mesh = generate_grid_mesh(static_cast<size_t>(state.range(0)));
+        for ([[maybe_unused]] auto _ : state) {
+            mesh.recalculate_normals();
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, mesh);
+    }
+
+    void BM_MeshRecalculateTangents(benchmark::State& state)
+    {
+        Mesh mesh = generate_grid_mesh(static_cast<size_t>(state.range(0)));
+        for ([[maybe_unused]] auto _ : state) {
+            mesh.recalculate_tangents();
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, mesh);
+    }
+
+    // emulates (e.g.) a TPS-warping UI, where the same mesh is repeatedly warped and has its
+    // normals recalculated
+    void BM_MeshWarpAndRecalculateNormals(benchmark::State& state)
+    {
+        Mesh mesh = generate_grid_mesh(static_cast<size_t>(state.range(0)));
+        float offset = 0.0f;
+        for ([[maybe_unused]] auto _ : state) {
+            {
+                const MeshAttributeEdit<Vec3> vertices = mesh.edit_vertices();
+                for (Vec3& vertex : vertices) {
+                    vertex.y = std::sin(0.1f*vertex.x + offset) * std::cos(0.1f*vertex.z);
+                }
+            }
+            mesh.recalculate_normals();
+            benchmark::ClobberMemory();
+            offset += 0.01f;
+        }
+        set_counters(state, mesh);
+    }
+}
+
+// 708x708 grid ~= 1M triangles
+BENCHMARK(BM_MeshRecalculateNormals)->Arg(128)->Arg(708)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_MeshRecalculateTangents)->Arg(128)->Arg(708)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_MeshWarpAndRecalculateNormals)->Arg(128)->Arg(708)->Unit(benchmark::kMillisecond)->UseRealTime();
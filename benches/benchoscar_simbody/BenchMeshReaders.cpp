@@ -0,0 +1,86 @@
+#include <benchoscar_simbody/benchoscar_simbody_config.h>
+
+#include <benchmark/benchmark.h>
+#include <oscar/Formats/OBJ.h>
+#include <oscar/Formats/STL.h>
+#include <oscar/Formats/VTP.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+using namespace osc;
+
+namespace
+{
+    // mesh files from `resources/geometry` that are benchmarked (the largest of each format)
+    constexpr auto c_benchmarked_mesh_files = std::to_array<std::string_view>({
+        "hat_ribs_scap.vtp",
+        "spine.vtp",
+        "femur_r.vtp",
+        "fly_femur_mesh_scaled.stl",
+        "ellipsoid.stl",
+        "soccer_ball_seg_Holes.obj",
+        "goalie.obj",
+    });
+
+    std::filesystem::path benchmarked_mesh_file_path(const benchmark::State& state)
+    {
+        const std::string_view filename = c_benchmarked_mesh_files.at(static_cast<size_t>(state.range(0)));
+        return std::filesystem::path{OSC_RESOURCES_DIR} / "geometry" / filename;
+    }
+
+    Mesh read_with_native_reader(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (path.extension() == ".vtp") {
+            return read_as_vtp(in);
+        }
+        else if (path.extension() == ".stl") {
+            return read_as_stl(in);
+        }
+        else {
+            return read_as_obj(in);
+        }
+    }
+
+    void set_counters(benchmark::State& state, const std::filesystem::path& path, const Mesh& mesh)
+    {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+        state.counters["triangles"] = static_cast<double>(mesh.num_indices()/3);
+        state.SetLabel(path.filename().string());
+    }
+
+    void BM_NativeMeshReader(benchmark::State& state)
+    {
+        const std::filesystem::path path = benchmarked_mesh_file_path(state);
+
+        Mesh mesh;
+        for (auto _ : state) {
+            mesh = read_with_native_reader(path);
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, path, mesh);
+    }
+
+    void BM_SimTKMeshLoader(benchmark::State& state)
+    {
+        const std::filesystem::path path = benchmarked_mesh_file_path(state);
+
+        Mesh mesh;
+        for (auto _ : state) {
+            mesh = LoadMeshViaSimTK(path);
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, path, mesh);
+    }
+}
+
+BENCHMARK(BM_NativeMeshReader)->DenseRange(0, std::ssize(c_benchmarked_mesh_files)-1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_SimTKMeshLoader)->DenseRange(0, std::ssize(c_benchmarked_mesh_files)-1)->Unit(benchmark::kMillisecond)->UseRealTime();
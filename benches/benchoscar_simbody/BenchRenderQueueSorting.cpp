@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <oscar/Utils/RadixSort.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace osc;
+
+// these benchmarks don't require a GPU: they sort render-queue-like keys in the same way as
+// the graphics backend's render queue sort (bit-packed IDs + quantized depth), so that the
+// CPU cost of sorting can be measured on headless machines
+
+namespace
+{
+    struct SortItem final {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // returns keys that are distributed similarly to a typical model viewport: a few materials,
+    // many property blocks (per-decoration colors), many meshes, and some transparent objects
+    std::vector<SortItem> generate_render_queue_keys(size_t n)
+    {
+        std::mt19937_64 engine{};  // default-seeded, so that each run is the same
+        std::uniform_int_distribution<uint64_t> material_dist{0, 3};
+        std::uniform_int_distribution<uint64_t> property_block_dist{0, 255};
+        std::uniform_int_distribution<uint64_t> mesh_dist{0, 511};
+        std::uniform_real_distribution<float> distance2_dist{0.0f, 100.0f};
+        std::bernoulli_distribution transparent_dist{0.1};
+
+        std::vector<SortItem> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t key = 0;
+            if (transparent_dist(engine)) {
+                key = (uint64_t{1} << 63) | static_cast<uint64_t>(~std::bit_cast<uint32_t>(distance2_dist(engine)));
+            }
+            else {
+                key = (material_dist(engine) << 17) | (property_block_dist(engine) << 9) | mesh_dist(engine);
+            }
+            rv.push_back({key, static_cast<uint32_t>(i)});
+        }
+        return rv;
+    }
+
+    void BM_RadixSortRenderQueueKeys(benchmark::State& state)
+    {
+        const std::vector<SortItem> keys = generate_render_queue_keys(static_cast<size_t>(state.range(0)));
+        std::vector<SortItem> items;
+        std::vector<SortItem> scratch;
+        for ([[maybe_unused]] auto _ : state) {
+            items = keys;
+            radix_sort(items, [](const SortItem& item) { return item.key; }, scratch);
+            benchmark::DoNotOptimize(items.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+    }
+
+    void BM_StdStableSortRenderQueueKeys(benchmark::State& state)
+    {
+        const std::vector<SortItem> keys = generate_render_queue_keys(static_cast<size_t>(state.range(0)));
+        std::vector<SortItem> items;
+        for ([[maybe_unused]] auto _ : state) {
+            items = keys;
+            std::ranges::stable_sort(items, std::ranges::less{}, &SortItem::key);
+            benchmark::DoNotOptimize(items.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+    }
+}
+
+BENCHMARK(BM_RadixSortRenderQueueKeys)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK(BM_StdStableSortRenderQueueKeys)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <oscar/Utils/SpscQueue.h>
+#include <oscar/Utils/SynchronizedValue.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // stands in for a `SimulationReport` (a reference-counted, immutable, state)
+    using Report = std::shared_ptr<const std::vector<double>>;
+
+    // the number of reports that the producer sends in each iteration of a benchmark
+    constexpr size_t c_num_reports_per_iteration = 2000;
+
+    // the original implementation of the simulation report queue: a mutex-guarded vector
+    class LegacyLockedReportQueue final {
+    public:
+        void push(Report report)
+        {
+            reports_.lock()->push_back(std::move(report));
+        }
+
+        template<typename Consumer>
+        size_t pop_all(Consumer&& consumer)
+        {
+            auto guard = reports_.lock();
+            for (Report& report : *guard) {
+                consumer(std::move(report));
+            }
+            const size_t n = guard->size();
+            guard->clear();
+            return n;
+        }
+    private:
+        SynchronizedValue<std::vector<Report>> reports_;
+    };
+
+    // emulates a simulator thread that sends reports at `reports_per_second` (or as fast as
+    // possible, if it's zero) while the UI thread repeatedly polls for them (each accessor
+    // on `ForwardDynamicSimulation` polls the queue)
+    template<typename Queue>
+    void BM_SimulationReportQueue(benchmark::State& state)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto reports_per_second = static_cast<size_t>(state.range(0));
+        const Report report = std::make_shared<const std::vector<double>>(64, 1.0);
+
+        Clock::duration total_push_duration{};
+        Clock::duration max_push_duration{};
+        size_t num_polls = 0;
+
+        for (auto _ : state) {
+            Queue queue;
+            std::thread producer{[&]()
+            {
+                const Clock::time_point start = Clock::now();
+                for (size_t i = 0; i < c_num_reports_per_iteration; ++i) {
+                    if (reports_per_second > 0) {
+                        const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{static_cast<double>(i) / static_cast<double>(reports_per_second)});
+                        while (Clock::now() < deadline) {
+                            std::this_thread::yield();
+                        }
+                    }
+
+                    const Clock::time_point push_start = Clock::now();
+                    queue.push(report);
+                    const Clock::duration push_duration = Clock::now() - push_start;
+                    total_push_duration += push_duration;
+                    max_push_duration = std::max(max_push_duration, push_duration);
+                }
+            }};
+
+            size_t num_received = 0;
+            while (num_received < c_num_reports_per_iteration) {
+                num_received += queue.pop_all([](Report&& r) { benchmark::DoNotOptimize(r); });
+                ++num_polls;
+            }
+            producer.join();
+        }
+
+        const auto num_reports = static_cast<double>(state.iterations() * c_num_reports_per_iteration);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * c_num_reports_per_iteration));
+        state.counters["mean_push_ns"] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(total_push_duration).count()) / num_reports;
+        state.counters["max_push_us"] = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(max_push_duration).count());
+        state.counters["polls_per_report"] = static_cast<double>(num_polls) / num_reports;
+    }
+}
+
+BENCHMARK(BM_SimulationReportQueue<LegacyLockedReportQueue>)->Arg(0)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_SimulationReportQueue<SpscQueue<Report>>)->Arg(0)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
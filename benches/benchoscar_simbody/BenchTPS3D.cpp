@@ -0,0 +1,246 @@
+#include <benchmark/benchmark.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar_simbody/LandmarkPair3D.h>
+#include <oscar_simbody/TPS3D.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<Vec3> generate_random_points(std::default_random_engine& rng, size_t n)
+    {
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return rv;
+    }
+
+    // returns coefficients with random non-affine terms (evaluation doesn't care whether they're solved)
+    TPSCoefficients3D generate_random_coefficients(std::default_random_engine& rng, size_t num_terms)
+    {
+        TPSCoefficients3D rv;
+        const std::vector<Vec3> weights = generate_random_points(rng, num_terms);
+        const std::vector<Vec3> control_points = generate_random_points(rng, num_terms);
+        for (size_t i = 0; i < num_terms; ++i) {
+            rv.nonAffineTerms.emplace_back(weights[i], control_points[i]);
+        }
+        return rv;
+    }
+
+    // returns points that are scattered around the surface of a unit sphere (i.e. like a mesh's
+    // vertices, or the semilandmarks placed on it)
+    std::vector<Vec3> generate_random_points_on_sphere(std::default_random_engine& rng, size_t n)
+    {
+        std::normal_distribution<float> direction_dist{0.0f, 1.0f};
+        std::uniform_real_distribution<float> radius_dist{0.99f, 1.01f};
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.push_back(radius_dist(rng) * normalize(Vec3{direction_dist(rng), direction_dist(rng), direction_dist(rng)}));
+        }
+        return rv;
+    }
+
+    // returns coefficients that resemble a solution for `num_terms` semilandmarks on a unit
+    // sphere (weights are small and sum to zero)
+    TPSCoefficients3D generate_semilandmark_coefficients(std::default_random_engine& rng, size_t num_terms)
+    {
+        const std::vector<Vec3> control_points = generate_random_points_on_sphere(rng, num_terms);
+        std::vector<Vec3> weights = generate_random_points(rng, num_terms);
+        Vec3 mean_weight{};
+        for (Vec3& weight : weights) {
+            weight /= static_cast<float>(num_terms);
+            mean_weight += weight / static_cast<float>(num_terms);
+        }
+
+        TPSCoefficients3D rv;
+        for (size_t i = 0; i < num_terms; ++i) {
+            rv.nonAffineTerms.emplace_back(weights[i] - mean_weight, control_points[i]);
+        }
+        return rv;
+    }
+
+    std::vector<LandmarkPair3D> generate_random_landmarks(std::default_random_engine& rng, size_t n)
+    {
+        std::vector<LandmarkPair3D> rv;
+        rv.reserve(n);
+        for (const Vec3& source : generate_random_points(rng, n)) {
+            rv.push_back({source, 1.1f * source});
+        }
+        return rv;
+    }
+
+    // a copy of the original implementation of `ApplyThinPlateWarpToPointsInPlace`, so that
+    // `TPSEvaluator3D` can be compared against it
+    void legacy_apply_thin_plate_warp_to_points_in_place(const TPSCoefficients3D& coefs, std::span<Vec3> points, float blending_factor)
+    {
+        for_each_parallel_unsequenced(8192, points, [&coefs, blending_factor](Vec3& vert)
+        {
+            vert = lerp(vert, EvaluateTPSEquation(coefs, vert), blending_factor);
+        });
+    }
+
+    // the kernels that are benchmarked (the benchmark's third argument)
+    constexpr auto c_benchmarked_kernels = std::to_array<TPSEvaluatorKernel3D>({
+        TPSEvaluatorKernel3D::Scalar,
+        TPSEvaluatorKernel3D::AVX2,
+    });
+
+    // the maximum absolute errors that are benchmarked (the benchmark's third argument)
+    constexpr auto c_benchmarked_tolerances = std::to_array<float>({1e-3f, 1e-4f, 1e-5f});
+
+    void set_counters(benchmark::State& state, size_t num_terms, size_t num_points)
+    {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_points));
+        state.counters["term_evaluations/s"] = benchmark::Counter{
+            static_cast<double>(state.iterations() * num_points * num_terms),
+            benchmark::Counter::kIsRate,
+        };
+    }
+
+    // emulates dragging a landmark around when the coefficients are fully re-solved each time
+    void BM_CalcCoefficientsAfterMovingALandmark(benchmark::State& state)
+    {
+        const auto num_landmarks = static_cast<size_t>(state.range(0));
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        TPSCoefficientSolverInputs3D inputs{generate_random_landmarks(rng, num_landmarks)};
+        const std::vector<Vec3> drag_path = generate_random_points(rng, 64);
+
+        size_t i = 0;
+        for (auto _ : state) {
+            inputs.landmarks.front().source = drag_path[i++ % drag_path.size()];
+            benchmark::DoNotOptimize(CalcCoefficients(inputs));
+        }
+    }
+
+    // emulates dragging a landmark around when the coefficients are incrementally updated
+    void BM_TPSCoefficientSolver3DSetLandmark(benchmark::State& state)
+    {
+        const auto num_landmarks = static_cast<size_t>(state.range(0));
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{generate_random_landmarks(rng, num_landmarks)}};
+        const std::vector<Vec3> drag_path = generate_random_points(rng, 64);
+
+        size_t i = 0;
+        for (auto _ : state) {
+            const Vec3 source = drag_path[i++ % drag_path.size()];
+            solver.setLandmark(0, {source, 1.1f * source});
+            benchmark::DoNotOptimize(solver.getCoefficients());
+        }
+        state.counters["full_solves"] = static_cast<double>(solver.getNumFullSolves());
+    }
+
+    void BM_LegacyApplyThinPlateWarpToPointsInPlace(benchmark::State& state)
+    {
+        const auto num_terms = static_cast<size_t>(state.range(0));
+        const auto num_points = static_cast<size_t>(state.range(1));
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        const TPSCoefficients3D coefs = generate_random_coefficients(rng, num_terms);
+        const std::vector<Vec3> points = generate_random_points(rng, num_points);
+
+        std::vector<Vec3> warped;
+        for (auto _ : state) {
+            warped = points;
+            legacy_apply_thin_plate_warp_to_points_in_place(coefs, warped, 1.0f);
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, num_terms, num_points);
+    }
+
+    void BM_TPSEvaluator3DEvaluateInPlace(benchmark::State& state)
+    {
+        const auto num_terms = static_cast<size_t>(state.range(0));
+        const auto num_points = static_cast<size_t>(state.range(1));
+        const TPSEvaluatorKernel3D kernel = c_benchmarked_kernels.at(static_cast<size_t>(state.range(2)));
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        const TPSCoefficients3D coefs = generate_random_coefficients(rng, num_terms);
+        const std::vector<Vec3> points = generate_random_points(rng, num_points);
+
+        const TPSEvaluator3D evaluator{coefs, kernel};
+        if (evaluator.getKernel() != kernel) {
+            state.SkipWithError("the kernel isn't supported by this CPU");
+            return;
+        }
+
+        std::vector<Vec3> warped;
+        for (auto _ : state) {
+            warped = points;
+            evaluator.evaluateInPlace(warped, 1.0f);
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, num_terms, num_points);
+        state.SetLabel(kernel == TPSEvaluatorKernel3D::AVX2 ? "AVX2" : "Scalar");
+    }
+
+    // reports the approximation's actual maximum error, and its speedup, relative to `TPSEvaluator3D`
+    void BM_TPSApproximateEvaluator3DEvaluateInPlace(benchmark::State& state)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const auto num_terms = static_cast<size_t>(state.range(0));
+        const auto num_points = static_cast<size_t>(state.range(1));
+        const float max_absolute_error = c_benchmarked_tolerances.at(static_cast<size_t>(state.range(2)));
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        const TPSCoefficients3D coefs = generate_semilandmark_coefficients(rng, num_terms);
+        const std::vector<Vec3> points = generate_random_points_on_sphere(rng, num_points);
+
+        std::vector<Vec3> exact = points;
+        const Clock::time_point exact_start = Clock::now();
+        TPSEvaluator3D{coefs}.evaluateInPlace(exact, 1.0f);
+        const std::chrono::duration<double> exact_duration = Clock::now() - exact_start;
+
+        std::vector<Vec3> warped;
+        std::chrono::duration<double> approximate_duration{};
+        for (auto _ : state) {
+            warped = points;
+            const Clock::time_point start = Clock::now();
+            TPSApproximateEvaluator3D{coefs, max_absolute_error}.evaluateInPlace(warped, 1.0f);
+            approximate_duration += Clock::now() - start;
+            benchmark::ClobberMemory();
+        }
+        set_counters(state, num_terms, num_points);
+
+        double actual_max_absolute_error = 0.0;
+        double max_displacement = 0.0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            actual_max_absolute_error = max(actual_max_absolute_error, static_cast<double>(length(warped[i] - exact[i])));
+            max_displacement = max(max_displacement, static_cast<double>(length(exact[i] - points[i])));
+        }
+        state.counters["max_abs_error"] = actual_max_absolute_error;
+        state.counters["max_displacement"] = max_displacement;
+        state.counters["speedup"] = exact_duration.count() / (approximate_duration.count() / static_cast<double>(state.iterations()));
+        state.SetLabel("tolerance=" + std::to_string(max_absolute_error));
+    }
+}
+
+BENCHMARK(BM_LegacyApplyThinPlateWarpToPointsInPlace)->ArgsProduct({
+    {16, 128, 512},
+    {500000},
+})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_TPSEvaluator3DEvaluateInPlace)->ArgsProduct({
+    {16, 128, 512},
+    {500000},
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_kernels)-1, 1),
+})->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_CalcCoefficientsAfterMovingALandmark)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TPSCoefficientSolver3DSetLandmark)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TPSApproximateEvaluator3DEvaluateInPlace)->ArgsProduct({
+    {4096, 16384},
+    {100000},
+    benchmark::CreateDenseRange(0, std::ssize(c_benchmarked_tolerances)-1, 1),
+})->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -54,39 +54,27 @@ namespace osc
             }
         }
 
-        // returns `true` if cached inputs were updated; otherwise, returns the cached inputs
-        bool updateInputs(const TPSDocument& doc)
+        // returns `true` if cached coefficients were updated
+        bool updateCoefficients(const TPSDocument& doc)
         {
             TPSCoefficientSolverInputs3D newInputs
             {
                 GetLandmarkPairs(doc),
             };
 
-            if (newInputs != m_CachedInputs)
-            {
-                m_CachedInputs = std::move(newInputs);
-                return true;
-            }
-            else
-            {
-                return false;
-            }
-        }
-
-        // returns `true` if cached coefficients were updated
-        bool updateCoefficients(const TPSDocument& doc)
-        {
-            if (!updateInputs(doc))
+            if (newInputs == m_CoefficientSolver.getInputs())
             {
                 // cache: the inputs have not been updated, so the coefficients will not change
                 return false;
             }
 
-            TPSCoefficients3D newCoefficients = CalcCoefficients(m_CachedInputs);
+            // the solver incrementally updates the coefficients if only a few landmarks
+            // changed (e.g. because the user is dragging one)
+            m_CoefficientSolver.setInputs(newInputs);
 
-            if (newCoefficients != m_CachedCoefficients)
+            if (m_CoefficientSolver.getCoefficients() != m_CachedCoefficients)
             {
-                m_CachedCoefficients = std::move(newCoefficients);
+                m_CachedCoefficients = m_CoefficientSolver.getCoefficients();
                 return true;
             }
             else
@@ -95,7 +83,6 @@ namespace osc
             }
         }
 
-
         bool updateSourceNonParticipatingLandmarks(const TPSDocument& doc)
         {
             const auto& docLandmarks = doc.nonParticipatingLandmarks;
@@ -161,7 +148,7 @@ namespace osc
             }
         }
 
-        TPSCoefficientSolverInputs3D m_CachedInputs;
+        TPSCoefficientSolver3D m_CoefficientSolver;
         TPSCoefficients3D m_CachedCoefficients;
         Mesh m_CachedSourceMesh;
         float m_CachedBlendingFactor = 1.0f;
@@ -17,6 +17,25 @@ namespace osc
 
         float getFixupScaleFactor() const { return m_FixupScaleFactor; }
 
+        // returns `true` if both infos refer to the same model and scale factor (i.e. they may
+        // only differ in their state, selection, and/or hover)
+        bool hasSameModelAs(const ModelStatePairInfo& other) const
+        {
+            return
+                m_ModelVersion == other.m_ModelVersion &&
+                m_FixupScaleFactor == other.m_FixupScaleFactor;
+        }
+
+        // returns `true` if both infos refer to the same model, state, and scale factor (i.e.
+        // they may only differ in their selection and/or hover)
+        bool hasSameModelAndStateAs(const ModelStatePairInfo& other) const
+        {
+            return
+                m_ModelVersion == other.m_ModelVersion &&
+                m_StateVersion == other.m_StateVersion &&
+                m_FixupScaleFactor == other.m_FixupScaleFactor;
+        }
+
         friend bool operator==(const ModelStatePairInfo&, const ModelStatePairInfo&) = default;
 
     private:
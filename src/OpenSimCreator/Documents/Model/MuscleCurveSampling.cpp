@@ -0,0 +1,417 @@
+#include "MuscleCurveSampling.h"
+
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/ThreadPool.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a group of requested curves that share a coordinate, and can therefore be sampled
+    // from the same sweep over that coordinate
+    struct CurveGroup final {
+        OpenSim::ComponentPath coordinatePath;
+        std::vector<size_t> curveIndices;
+    };
+
+    std::vector<CurveGroup> GroupCurvesByCoordinate(std::span<const MuscleCurveRequest> requests)
+    {
+        std::vector<CurveGroup> rv;
+        for (size_t i = 0; i < requests.size(); ++i) {
+            const auto it = std::find_if(rv.begin(), rv.end(), [&](const CurveGroup& g)
+            {
+                return g.coordinatePath == requests[i].coordinatePath;
+            });
+            if (it != rv.end()) {
+                it->curveIndices.push_back(i);
+            }
+            else {
+                rv.push_back(CurveGroup{requests[i].coordinatePath, {i}});
+            }
+        }
+        return rv;
+    }
+
+    const OpenSim::Coordinate& FindCoordinateOrThrow(const OpenSim::Model& model, const OpenSim::ComponentPath& path)
+    {
+        const auto* coordinate = FindComponent<OpenSim::Coordinate>(model, path);
+        if (not coordinate) {
+            std::stringstream ss;
+            ss << path.toString() << ": cannot find a coordinate with this name";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        return *coordinate;
+    }
+
+    const OpenSim::Muscle& FindMuscleOrThrow(const OpenSim::Model& model, const OpenSim::ComponentPath& path)
+    {
+        const auto* muscle = FindComponent<OpenSim::Muscle>(model, path);
+        if (not muscle) {
+            std::stringstream ss;
+            ss << path.toString() << ": cannot find a muscle with this name";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        return *muscle;
+    }
+
+    // the range of coordinate values that a sweep samples
+    struct SweepRange final {
+        double firstXValue = 0.0;
+        double stepBetweenXValues = 0.0;
+        size_t numDataPoints = 0;
+    };
+
+    SweepRange CalcSweepRange(const OpenSim::Coordinate& coordinate, size_t numDataPoints)
+    {
+        const double firstXValue = coordinate.getRangeMin();
+        const double lastXValue = coordinate.getRangeMax();
+
+        if (firstXValue > lastXValue) {
+            // this invariant is necessary because downstream algorithms assume X increases over
+            // the datapoint collection (e.g. for optimized binary searches, lower_bound etc.)
+            std::stringstream ss;
+            ss << coordinate.getAbsolutePathString() << ": cannot plot a coordinate with reversed min/max";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+
+        const double step = (lastXValue - firstXValue) / static_cast<double>(std::max<size_t>(1, numDataPoints - 1));
+        return SweepRange{firstXValue, step, numDataPoints};
+    }
+
+    // a sweep over one coordinate, which samples every curve in a group
+    struct Sweep final {
+        const CurveGroup* group = nullptr;
+        SweepRange range;
+    };
+
+    // the components that a worker samples during one sweep, resolved in the worker's model
+    struct ResolvedSweep final {
+        const OpenSim::Coordinate* coordinate = nullptr;
+        std::vector<const OpenSim::Muscle*> muscles;  // one per curve in the group
+    };
+
+    // a worker's own copy of the model, which it reuses for each sweep that it samples
+    class SamplingWorker final {
+    public:
+        SamplingWorker(
+            const OpenSim::Model& sourceModel,
+            std::mutex& sourceModelMutex,
+            size_t numSweeps)
+        {
+            {
+                // copying from the (shared) source model is serialized, initializing the copy isn't
+                const std::lock_guard lock{sourceModelMutex};
+                m_Model = std::make_unique<OpenSim::Model>(sourceModel);
+            }
+            InitializeModel(*m_Model);
+            m_State = &InitializeState(*m_Model);
+            m_InitialState = *m_State;
+            m_ResolvedSweeps.resize(numSweeps);
+        }
+
+        // samples the `pointIndex`th point of the `sweepIndex`th sweep, returning one data point per curve
+        std::vector<Vec2> sample(
+            std::span<const MuscleCurveRequest> requests,
+            std::span<const Sweep> sweeps,
+            size_t sweepIndex,
+            size_t pointIndex)
+        {
+            const Sweep& sweep = sweeps[sweepIndex];
+            const ResolvedSweep& resolved = enterSweep(requests, sweep, sweepIndex);
+
+            // each point starts from the sweep's initial state, rather than from whichever point
+            // this worker previously sampled, so that (e.g. muscle equilibrium) results don't
+            // depend on how points were scheduled between workers
+            *m_State = m_SweepInitialState;
+
+            const double xVal = sweep.range.firstXValue + (static_cast<double>(pointIndex) * sweep.range.stepBetweenXValues);
+            resolved.coordinate->setValue(*m_State, xVal);
+            m_Model->equilibrateMuscles(*m_State);
+            m_Model->realizeReport(*m_State);
+
+            // every curve in the group shares the realized state
+            const float xDisplayVal = ConvertCoordValueToDisplayValue(*resolved.coordinate, xVal);
+            std::vector<Vec2> rv;
+            rv.reserve(resolved.muscles.size());
+            for (size_t i = 0; i < resolved.muscles.size(); ++i) {
+                const MuscleOutputGetter& output = requests[sweep.group->curveIndices[i]].output;
+                const auto yVal = static_cast<float>(output(*m_State, *resolved.muscles[i], *resolved.coordinate));
+                rv.emplace_back(xDisplayVal, yVal);
+            }
+            return rv;
+        }
+
+    private:
+        const ResolvedSweep& enterSweep(
+            std::span<const MuscleCurveRequest> requests,
+            const Sweep& sweep,
+            size_t sweepIndex)
+        {
+            std::optional<ResolvedSweep>& resolved = m_ResolvedSweeps[sweepIndex];
+            if (not resolved) {
+                resolved.emplace();
+                resolved->coordinate = &FindCoordinateOrThrow(*m_Model, sweep.group->coordinatePath);
+                resolved->muscles.reserve(sweep.group->curveIndices.size());
+                for (const size_t curveIndex : sweep.group->curveIndices) {
+                    resolved->muscles.push_back(&FindMuscleOrThrow(*m_Model, requests[curveIndex].musclePath));
+                }
+            }
+
+            if (m_CurrentSweep != sweepIndex) {
+                // each sweep starts from the model's initial state, so that the other coordinates
+                // aren't left wherever a previous sweep left them
+                m_SweepInitialState = m_InitialState;
+
+                // this fixes an unusual bug (#352), where the underlying assembly solver in the
+                // model ends up retaining invalid values across a coordinate (un)lock, which makes
+                // it sets coordinate values from X (what we want) to 0 after model assembly
+                //
+                // see #352 for a lengthier explanation
+                resolved->coordinate->setLocked(m_SweepInitialState, false);
+                m_Model->updateAssemblyConditions(m_SweepInitialState);
+
+                m_CurrentSweep = sweepIndex;
+            }
+            return *resolved;
+        }
+
+        std::unique_ptr<OpenSim::Model> m_Model;
+        SimTK::State* m_State = nullptr;
+        SimTK::State m_InitialState;
+        SimTK::State m_SweepInitialState;
+        std::vector<std::optional<ResolvedSweep>> m_ResolvedSweeps;
+        std::optional<size_t> m_CurrentSweep;
+    };
+
+    // reorders data points that are sampled out-of-order by the workers, so that they're
+    // emitted to the consumer (serially) in increasing-X order as soon as each prefix of
+    // a sweep is complete
+    class InOrderEmitter final {
+    public:
+        InOrderEmitter(
+            std::span<const Sweep> sweeps,
+            const MuscleCurveDataPointConsumer& consumer) :
+
+            m_Sweeps{sweeps},
+            m_Pending(sweeps.size()),
+            m_NextPointIndices(sweeps.size(), 0),
+            m_Consumer{&consumer}
+        {
+            for (size_t i = 0; i < sweeps.size(); ++i) {
+                m_Pending[i].resize(sweeps[i].range.numDataPoints);
+            }
+        }
+
+        void submit(size_t sweepIndex, size_t pointIndex, std::vector<Vec2> dataPoints)
+        {
+            const std::lock_guard lock{m_Mutex};
+
+            auto& pending = m_Pending[sweepIndex];
+            size_t& nextPointIndex = m_NextPointIndices[sweepIndex];
+
+            pending[pointIndex] = std::move(dataPoints);
+            while (nextPointIndex < pending.size() and pending[nextPointIndex]) {
+                const std::vector<Vec2>& next = *pending[nextPointIndex];
+                for (size_t i = 0; i < next.size(); ++i) {
+                    (*m_Consumer)(m_Sweeps[sweepIndex].group->curveIndices[i], next[i]);
+                }
+                pending[nextPointIndex].reset();
+                ++nextPointIndex;
+            }
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::span<const Sweep> m_Sweeps;
+        std::vector<std::vector<std::optional<std::vector<Vec2>>>> m_Pending;
+        std::vector<size_t> m_NextPointIndices;
+        const MuscleCurveDataPointConsumer* m_Consumer;
+    };
+
+    // state that's shared between all workers
+    struct SharedSamplingState final {
+        std::mutex sourceModelMutex;
+        std::atomic<size_t> nextWorkItem = 0;
+        std::atomic<bool> failed = false;
+        std::mutex exceptionMutex;
+        std::exception_ptr firstException;
+    };
+
+    void SamplingWorkerMainUnguarded(
+        const OpenSim::Model& sourceModel,
+        std::span<const MuscleCurveRequest> requests,
+        std::span<const Sweep> sweeps,
+        size_t numDataPoints,
+        InOrderEmitter& emitter,
+        SharedSamplingState& shared,
+        const cpp20::stop_token& stopToken)
+    {
+        const auto shouldStop = [&]() { return stopToken.stop_requested() or shared.failed.load(); };
+
+        // the worker's model is only copied once it has claimed a work item, so that workers
+        // that start after all items have been claimed don't needlessly copy the model
+        std::optional<SamplingWorker> worker;
+
+        // work items (sweep-major) are claimed in increasing order, so that all workers advance
+        // through a sweep together and the emitter can stream a growing prefix of it, while
+        // workers that finish a sweep early move straight on to the next one
+        const size_t numWorkItems = sweeps.size() * numDataPoints;
+        for (size_t item = shared.nextWorkItem++; item < numWorkItems; item = shared.nextWorkItem++) {
+            if (shouldStop()) {
+                return;
+            }
+
+            if (not worker) {
+                worker.emplace(sourceModel, shared.sourceModelMutex, sweeps.size());
+            }
+
+            const size_t sweepIndex = item / numDataPoints;
+            const size_t pointIndex = item % numDataPoints;
+            std::vector<Vec2> dataPoints = worker->sample(requests, sweeps, sweepIndex, pointIndex);
+
+            if (shouldStop()) {
+                return;
+            }
+
+            emitter.submit(sweepIndex, pointIndex, std::move(dataPoints));
+        }
+    }
+
+    void SamplingWorkerMain(
+        const OpenSim::Model& sourceModel,
+        std::span<const MuscleCurveRequest> requests,
+        std::span<const Sweep> sweeps,
+        size_t numDataPoints,
+        InOrderEmitter& emitter,
+        SharedSamplingState& shared,
+        const cpp20::stop_token& stopToken)
+    {
+        try {
+            SamplingWorkerMainUnguarded(sourceModel, requests, sweeps, numDataPoints, emitter, shared, stopToken);
+        }
+        catch (...) {
+            const std::lock_guard lock{shared.exceptionMutex};
+            if (not shared.firstException) {
+                shared.firstException = std::current_exception();
+            }
+            shared.failed = true;
+        }
+    }
+}
+
+double osc::GetMomentArm(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate& c)
+{
+    return muscle.getGeometryPath().computeMomentArm(st, c);
+}
+
+double osc::GetFiberLength(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate&)
+{
+    return muscle.getFiberLength(st);
+}
+
+double osc::GetTendonLength(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate&)
+{
+    return muscle.getTendonLength(st);
+}
+
+bool osc::SampleMuscleCurves(
+    const OpenSim::Model& model,
+    std::span<const MuscleCurveRequest> requests,
+    const MuscleCurveSamplingParams& params,
+    const MuscleCurveDataPointConsumer& consumer,
+    const cpp20::stop_token& stopToken)
+{
+    OSC_PERF("SampleMuscleCurves");
+
+    if (params.numDataPoints <= 0 or requests.empty()) {
+        return true;
+    }
+
+    // validate the requests against the source model up-front, so that workers aren't
+    // spun up (and models aren't copied) for invalid requests
+    const std::vector<CurveGroup> groups = GroupCurvesByCoordinate(requests);
+    std::vector<Sweep> sweeps;
+    sweeps.reserve(groups.size());
+    for (const CurveGroup& group : groups) {
+        for (const size_t curveIndex : group.curveIndices) {
+            FindMuscleOrThrow(model, requests[curveIndex].musclePath);
+        }
+        const OpenSim::Coordinate& coordinate = FindCoordinateOrThrow(model, group.coordinatePath);
+        sweeps.push_back(Sweep{&group, CalcSweepRange(coordinate, params.numDataPoints)});
+    }
+
+    InOrderEmitter emitter{sweeps, consumer};
+    SharedSamplingState shared;
+
+    // each worker can run for a long time (e.g. seconds, for a large model), so the workers
+    // run on the calling thread plus threads that are owned by this call, rather than on the
+    // global thread pool, which is for short tasks
+    const size_t numWorkers = std::clamp<size_t>(params.numThreads, 1, sweeps.size() * params.numDataPoints);
+    const auto runWorker = [&]()
+    {
+        SamplingWorkerMain(model, requests, sweeps, params.numDataPoints, emitter, shared, stopToken);
+    };
+    if (numWorkers > 1) {
+        ThreadPool pool{numWorkers - 1};
+        std::vector<std::future<void>> helpers;
+        helpers.reserve(numWorkers - 1);
+        for (size_t i = 1; i < numWorkers; ++i) {
+            helpers.push_back(pool.submit(runWorker));
+        }
+        runWorker();
+        for (std::future<void>& helper : helpers) {
+            helper.get();
+        }
+    }
+    else {
+        runWorker();
+    }
+
+    if (shared.firstException) {
+        std::rethrow_exception(shared.firstException);
+    }
+    return not stopToken.stop_requested();
+}
+
+std::vector<std::vector<Vec2>> osc::SampleMuscleCurves(
+    const OpenSim::Model& model,
+    std::span<const MuscleCurveRequest> requests,
+    const MuscleCurveSamplingParams& params)
+{
+    std::vector<std::vector<Vec2>> rv(requests.size());
+    for (auto& curve : rv) {
+        curve.reserve(params.numDataPoints);
+    }
+
+    const cpp20::stop_source neverStopped;
+    SampleMuscleCurves(model, requests, params, [&rv](size_t curveIndex, Vec2 dataPoint)
+    {
+        rv[curveIndex].push_back(dataPoint);
+    }, neverStopped.get_token());
+
+    return rv;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <OpenSim/Common/ComponentPath.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace OpenSim { class Coordinate; }
+namespace OpenSim { class Model; }
+namespace OpenSim { class Muscle; }
+namespace SimTK { class State; }
+
+namespace osc
+{
+    // a function that extracts a value (e.g. moment arm) from a muscle in a realized state
+    using MuscleOutputGetter = std::function<double(const SimTK::State&, const OpenSim::Muscle&, const OpenSim::Coordinate&)>;
+
+    // returns the muscle's moment arm about the coordinate
+    double GetMomentArm(const SimTK::State&, const OpenSim::Muscle&, const OpenSim::Coordinate&);
+
+    // returns the length of the muscle's fiber
+    double GetFiberLength(const SimTK::State&, const OpenSim::Muscle&, const OpenSim::Coordinate&);
+
+    // returns the length of the muscle's tendon
+    double GetTendonLength(const SimTK::State&, const OpenSim::Muscle&, const OpenSim::Coordinate&);
+
+    // a request to sample one muscle curve: the value of `output` for the muscle at `musclePath`
+    // as the coordinate at `coordinatePath` is swept from its minimum to its maximum range
+    struct MuscleCurveRequest final {
+        OpenSim::ComponentPath coordinatePath;
+        OpenSim::ComponentPath musclePath;
+        MuscleOutputGetter output;
+    };
+
+    // parameters that affect how muscle curves are sampled
+    struct MuscleCurveSamplingParams final {
+
+        // the number of evenly-spaced coordinate values that each curve is sampled at
+        size_t numDataPoints = 180;
+
+        // the maximum number of workers that a single sweep over a coordinate is split across
+        //
+        // each worker runs on its own thread (one of which is the calling thread, none of which
+        // are in the global thread pool) and samples on its own copy of the model and state, so
+        // it's only worth using many workers when `numDataPoints` is large relative to the
+        // model's size
+        size_t numThreads = 1;
+    };
+
+    // a function that receives a data point (`x`: the coordinate's value in display units,
+    // `y`: the output's value) of the `curveIndex`th requested curve
+    //
+    // data points are emitted serially (never concurrently) and in increasing-X order per curve
+    using MuscleCurveDataPointConsumer = std::function<void(size_t curveIndex, Vec2 dataPoint)>;
+
+    // samples each of the requested muscle curves from the given model and streams each
+    // sampled data point into the consumer
+    //
+    // requests that share a coordinate are sampled in a single sweep over that coordinate, so
+    // that each swept state is equilibrated and realized once, rather than once per curve.
+    // Each sweep is split across `params.numThreads` workers, which each sample on their own
+    // copy of the model. Each data point is sampled from the sweep's initial state, so the
+    // sampled curves don't depend on how many workers are used.
+    //
+    // returns `false` if sampling was cancelled via the stop token (in which case, each curve
+    // may have only received a prefix of its data points), or throws if a request refers to
+    // a missing component, or a coordinate has a reversed range
+    bool SampleMuscleCurves(
+        const OpenSim::Model&,
+        std::span<const MuscleCurveRequest>,
+        const MuscleCurveSamplingParams&,
+        const MuscleCurveDataPointConsumer&,
+        const cpp20::stop_token&
+    );
+
+    // returns the sampled data points of each of the requested muscle curves
+    std::vector<std::vector<Vec2>> SampleMuscleCurves(
+        const OpenSim::Model&,
+        std::span<const MuscleCurveRequest>,
+        const MuscleCurveSamplingParams& = {}
+    );
+}
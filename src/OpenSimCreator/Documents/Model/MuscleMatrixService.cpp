@@ -0,0 +1,462 @@
+#include "MuscleMatrixService.h"
+
+#include <OpenSimCreator/Documents/Model/IModelStatePair.h>
+#include <OpenSimCreator/Documents/Model/MuscleCurveSampling.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Formats/CSV.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+#include <oscar/Shims/Cpp20/thread.h>
+#include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/ObjectRepresentation.h>
+#include <oscar/Utils/UID.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr auto c_QuantityLabels = std::to_array<CStringView>({
+        "moment_arm",
+        "fiber_length",
+        "tendon_length",
+    });
+    static_assert(c_QuantityLabels.size() == num_options<MuscleMatrixQuantity>());
+
+    MuscleOutputGetter GetOutputGetter(MuscleMatrixQuantity quantity)
+    {
+        switch (quantity) {
+        case MuscleMatrixQuantity::FiberLength:  return GetFiberLength;
+        case MuscleMatrixQuantity::TendonLength: return GetTendonLength;
+        case MuscleMatrixQuantity::MomentArm:
+        default:                                 return GetMomentArm;
+        }
+    }
+
+    // binary format
+    constexpr std::array<char, 8> c_BinaryMagic = {'O', 'S', 'C', 'M', 'M', 'A', 'T', '\0'};
+    constexpr uint32_t c_BinaryVersion = 1;
+
+    struct BinaryHeader final {
+        std::array<char, 8> magic = c_BinaryMagic;
+        uint32_t version = c_BinaryVersion;
+        uint32_t quantity = 0;
+        uint64_t numMuscles = 0;
+        uint64_t numCoordinates = 0;
+        uint64_t numDataPoints = 0;
+    };
+
+    template<typename T>
+    void ReadBytesOrThrow(std::istream& in, T* data, size_t n)
+    {
+        in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n * sizeof(T)));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (not in) {
+            throw std::runtime_error{"error reading a muscle matrix: unexpected end of input"};
+        }
+    }
+
+    void WriteString(std::ostream& out, const std::string& s)
+    {
+        const auto size = static_cast<uint64_t>(s.size());
+        const auto bytes = view_object_representation<char>(size);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+
+    std::string ReadString(std::istream& in)
+    {
+        uint64_t size = 0;
+        ReadBytesOrThrow(in, &size, 1);
+        if (size > 4096) {
+            throw std::runtime_error{"error reading a muscle matrix: a component path is unreasonably long"};
+        }
+        std::string rv(static_cast<size_t>(size), '\0');
+        ReadBytesOrThrow(in, rv.data(), rv.size());
+        return rv;
+    }
+
+    template<typename T>
+    void WriteValues(std::ostream& out, const std::vector<T>& values)
+    {
+        const auto bytes = view_object_representations<char>(values);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    std::string ToString(float v)
+    {
+        std::stringstream ss;
+        ss.precision(std::numeric_limits<float>::max_digits10);
+        ss << v;
+        return std::move(ss).str();
+    }
+}
+
+CStringView osc::GetLabel(MuscleMatrixQuantity quantity)
+{
+    return c_QuantityLabels.at(to_index(quantity));
+}
+
+void osc::WriteMuscleMatrixAsCSV(std::ostream& out, const MuscleMatrix& matrix)
+{
+    const std::array<std::string, 4> header = {"muscle", "coordinate", "coordinate_value", std::string{GetLabel(matrix.quantity)}};
+    write_csv_row(out, header);
+
+    std::array<std::string, 4> row;
+    for (size_t muscle = 0; muscle < matrix.musclePaths.size(); ++muscle) {
+        row[0] = matrix.musclePaths[muscle];
+        for (size_t coordinate = 0; coordinate < matrix.coordinatePaths.size(); ++coordinate) {
+            row[1] = matrix.coordinatePaths[coordinate];
+            for (size_t sample = 0; sample < matrix.numDataPoints; ++sample) {
+                row[2] = ToString(matrix.coordinateValues.at(coordinate * matrix.numDataPoints + sample));
+                row[3] = ToString(matrix.at(muscle, coordinate, sample));
+                write_csv_row(out, row);
+            }
+        }
+    }
+}
+
+void osc::WriteMuscleMatrixAsBinary(std::ostream& out, const MuscleMatrix& matrix)
+{
+    const BinaryHeader header{
+        .quantity = static_cast<uint32_t>(to_index(matrix.quantity)),
+        .numMuscles = matrix.musclePaths.size(),
+        .numCoordinates = matrix.coordinatePaths.size(),
+        .numDataPoints = matrix.numDataPoints,
+    };
+    const auto headerBytes = view_object_representation<char>(header);
+    out.write(headerBytes.data(), static_cast<std::streamsize>(headerBytes.size()));
+
+    for (const std::string& path : matrix.musclePaths) {
+        WriteString(out, path);
+    }
+    for (const std::string& path : matrix.coordinatePaths) {
+        WriteString(out, path);
+    }
+    WriteValues(out, matrix.coordinateValues);
+    WriteValues(out, matrix.values);
+}
+
+MuscleMatrix osc::ReadMuscleMatrixBinary(std::istream& in)
+{
+    BinaryHeader header;
+    ReadBytesOrThrow(in, &header, 1);
+    if (header.magic != c_BinaryMagic) {
+        throw std::runtime_error{"error reading a muscle matrix: the input is not a muscle matrix"};
+    }
+    if (header.version != c_BinaryVersion) {
+        std::stringstream ss;
+        ss << "error reading a muscle matrix: unsupported version (" << header.version << ')';
+        throw std::runtime_error{std::move(ss).str()};
+    }
+    if (header.quantity >= num_options<MuscleMatrixQuantity>()) {
+        throw std::runtime_error{"error reading a muscle matrix: unknown quantity"};
+    }
+
+    // guard against allocating huge buffers for corrupt (or malicious) inputs
+    constexpr uint64_t c_MaxDimension = 1<<16;
+    constexpr uint64_t c_MaxNumValues = 1<<28;
+    if (header.numMuscles > c_MaxDimension or
+        header.numCoordinates > c_MaxDimension or
+        header.numDataPoints > c_MaxDimension or
+        header.numMuscles * header.numCoordinates * header.numDataPoints > c_MaxNumValues) {
+        throw std::runtime_error{"error reading a muscle matrix: the matrix's dimensions are unreasonably large"};
+    }
+
+    MuscleMatrix rv;
+    rv.quantity = static_cast<MuscleMatrixQuantity>(header.quantity);
+    rv.numDataPoints = static_cast<size_t>(header.numDataPoints);
+    for (uint64_t i = 0; i < header.numMuscles; ++i) {
+        rv.musclePaths.push_back(ReadString(in));
+    }
+    for (uint64_t i = 0; i < header.numCoordinates; ++i) {
+        rv.coordinatePaths.push_back(ReadString(in));
+    }
+    rv.coordinateValues.resize(rv.coordinatePaths.size() * rv.numDataPoints);
+    ReadBytesOrThrow(in, rv.coordinateValues.data(), rv.coordinateValues.size());
+    rv.values.resize(rv.musclePaths.size() * rv.coordinatePaths.size() * rv.numDataPoints);
+    ReadBytesOrThrow(in, rv.values.data(), rv.values.size());
+    return rv;
+}
+
+class osc::MuscleMatrixTask::Impl final {
+public:
+    Impl(const IModelStatePair& msp, const MuscleMatrixParams& params) :
+        m_Params{params},
+        m_Model{std::make_unique<OpenSim::Model>(msp.getModel())},
+        m_WorkerThread{[this](const cpp20::stop_token& stopToken) { run(stopToken); }}
+    {}
+
+    const MuscleMatrixParams& getParams() const
+    {
+        return m_Params;
+    }
+
+    MuscleMatrixTaskStatus getStatus() const
+    {
+        const std::lock_guard lock{m_Mutex};
+        return m_Status;
+    }
+
+    float getProgress() const
+    {
+        const size_t total = m_NumElementsTotal.load();
+        if (total == 0) {
+            return getStatus() == MuscleMatrixTaskStatus::Finished ? 1.0f : 0.0f;
+        }
+        return static_cast<float>(m_NumElementsComputed.load()) / static_cast<float>(total);
+    }
+
+    std::optional<std::string> getErrorMessage() const
+    {
+        const std::lock_guard lock{m_Mutex};
+        return m_ErrorMessage;
+    }
+
+    std::shared_ptr<const MuscleMatrix> getResult() const
+    {
+        const std::lock_guard lock{m_Mutex};
+        return m_Result;
+    }
+
+    void wait()
+    {
+        std::unique_lock lock{m_Mutex};
+        m_StatusChanged.wait(lock, [this]() { return m_Status != MuscleMatrixTaskStatus::Running; });
+    }
+
+    void requestCancellation()
+    {
+        m_WorkerThread.request_stop();
+    }
+
+private:
+    // top-level "main" function that the worker thread executes
+    //
+    // catches exceptions and propagates them to the task
+    void run(const cpp20::stop_token& stopToken)
+    {
+        try {
+            const MuscleMatrixTaskStatus status = runUnguarded(stopToken);
+            setStatus(status);
+        }
+        catch (const std::exception& ex) {
+            log_error("MuscleMatrixTask: exception thrown while computing a muscle matrix: %s", ex.what());
+            {
+                const std::lock_guard lock{m_Mutex};
+                m_ErrorMessage = ex.what();
+            }
+            setStatus(MuscleMatrixTaskStatus::Error);
+        }
+    }
+
+    MuscleMatrixTaskStatus runUnguarded(const cpp20::stop_token& stopToken)
+    {
+        InitializeModel(*m_Model);
+        InitializeState(*m_Model);
+
+        auto matrix = std::make_shared<MuscleMatrix>();
+        matrix->quantity = m_Params.quantity;
+        matrix->numDataPoints = m_Params.numDataPoints;
+        for (const OpenSim::Coordinate& coordinate : m_Model->getComponentList<OpenSim::Coordinate>()) {
+            // coordinates with reversed ranges can't be swept
+            if (coordinate.getRangeMin() <= coordinate.getRangeMax()) {
+                matrix->coordinatePaths.push_back(coordinate.getAbsolutePathString());
+            }
+        }
+        for (const OpenSim::Muscle& muscle : m_Model->getComponentList<OpenSim::Muscle>()) {
+            matrix->musclePaths.push_back(muscle.getAbsolutePathString());
+        }
+
+        // one curve per (muscle, coordinate) pair, laid out in the same order as `MuscleMatrix::values`
+        const MuscleOutputGetter getter = GetOutputGetter(m_Params.quantity);
+        std::vector<MuscleCurveRequest> requests;
+        requests.reserve(matrix->musclePaths.size() * matrix->coordinatePaths.size());
+        for (const std::string& musclePath : matrix->musclePaths) {
+            for (const std::string& coordinatePath : matrix->coordinatePaths) {
+                requests.push_back(MuscleCurveRequest{
+                    .coordinatePath = OpenSim::ComponentPath{coordinatePath},
+                    .musclePath = OpenSim::ComponentPath{musclePath},
+                    .output = getter,
+                });
+            }
+        }
+
+        const size_t numCoordinates = matrix->coordinatePaths.size();
+        const size_t numDataPoints = matrix->numDataPoints;
+        matrix->coordinateValues.resize(numCoordinates * numDataPoints);
+        matrix->values.resize(requests.size() * numDataPoints);
+        m_NumElementsTotal = matrix->values.size();
+
+        // data points are emitted serially and in increasing-X order per curve, so the
+        // number of points received so far is the index of the next point
+        std::vector<size_t> numReceived(requests.size(), 0);
+        const bool finished = SampleMuscleCurves(
+            *m_Model,
+            requests,
+            {.numDataPoints = numDataPoints, .numThreads = m_Params.numThreads},
+            [&](size_t curveIndex, Vec2 dataPoint)
+            {
+                const size_t sampleIndex = numReceived[curveIndex]++;
+                matrix->values[curveIndex * numDataPoints + sampleIndex] = dataPoint.y;
+                matrix->coordinateValues[(curveIndex % numCoordinates) * numDataPoints + sampleIndex] = dataPoint.x;
+                ++m_NumElementsComputed;
+            },
+            stopToken
+        );
+
+        if (not finished) {
+            return MuscleMatrixTaskStatus::Cancelled;
+        }
+
+        const std::lock_guard lock{m_Mutex};
+        m_Result = std::move(matrix);
+        return MuscleMatrixTaskStatus::Finished;
+    }
+
+    void setStatus(MuscleMatrixTaskStatus status)
+    {
+        {
+            const std::lock_guard lock{m_Mutex};
+            m_Status = status;
+        }
+        m_StatusChanged.notify_all();
+    }
+
+    MuscleMatrixParams m_Params;
+    std::unique_ptr<OpenSim::Model> m_Model;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_StatusChanged;
+    MuscleMatrixTaskStatus m_Status = MuscleMatrixTaskStatus::Running;
+    std::optional<std::string> m_ErrorMessage;
+    std::shared_ptr<const MuscleMatrix> m_Result;
+    std::atomic<size_t> m_NumElementsComputed = 0;
+    std::atomic<size_t> m_NumElementsTotal = 0;
+
+    // must be the last member, so that it's started after (and joined before) everything
+    // else is initialized (destroyed)
+    cpp20::jthread m_WorkerThread;
+};
+
+osc::MuscleMatrixTask::MuscleMatrixTask(const IModelStatePair& msp, const MuscleMatrixParams& params) :
+    m_Impl{std::make_unique<Impl>(msp, params)}
+{}
+osc::MuscleMatrixTask::~MuscleMatrixTask() noexcept = default;
+
+const MuscleMatrixParams& osc::MuscleMatrixTask::getParams() const
+{
+    return m_Impl->getParams();
+}
+
+MuscleMatrixTaskStatus osc::MuscleMatrixTask::getStatus() const
+{
+    return m_Impl->getStatus();
+}
+
+float osc::MuscleMatrixTask::getProgress() const
+{
+    return m_Impl->getProgress();
+}
+
+std::optional<std::string> osc::MuscleMatrixTask::getErrorMessage() const
+{
+    return m_Impl->getErrorMessage();
+}
+
+std::shared_ptr<const MuscleMatrix> osc::MuscleMatrixTask::getResult() const
+{
+    return m_Impl->getResult();
+}
+
+void osc::MuscleMatrixTask::wait()
+{
+    m_Impl->wait();
+}
+
+void osc::MuscleMatrixTask::requestCancellation()
+{
+    m_Impl->requestCancellation();
+}
+
+class osc::MuscleMatrixService::Impl final {
+public:
+    std::shared_ptr<MuscleMatrixTask> request(const IModelStatePair& msp, const MuscleMatrixParams& params)
+    {
+        const std::lock_guard lock{m_Mutex};
+
+        const UID modelVersion = msp.getModelVersion();
+        const auto it = std::find_if(m_Entries.begin(), m_Entries.end(), [&](const Entry& e)
+        {
+            return e.modelVersion == modelVersion and e.task->getParams() == params;
+        });
+
+        if (it != m_Entries.end()) {
+            const MuscleMatrixTaskStatus status = it->task->getStatus();
+            if (status != MuscleMatrixTaskStatus::Cancelled and status != MuscleMatrixTaskStatus::Error) {
+                // cache hit (finished or in-flight): mark it as the most-recently-requested entry
+                std::rotate(it, std::next(it), m_Entries.end());
+                return m_Entries.back().task;
+            }
+            m_Entries.erase(it);  // failed: recompute it
+        }
+
+        // evict (and cancel) the least-recently-requested entry, so that a task that nothing
+        // is interested in anymore doesn't keep the machine's cores busy
+        if (m_Entries.size() >= c_MaxEntries) {
+            m_Entries.front().task->requestCancellation();
+            m_Entries.erase(m_Entries.begin());
+        }
+
+        auto task = std::make_shared<MuscleMatrixTask>(msp, params);
+        m_Entries.push_back(Entry{modelVersion, task});
+        return task;
+    }
+
+private:
+    static constexpr size_t c_MaxEntries = 8;
+
+    struct Entry final {
+        UID modelVersion;
+        std::shared_ptr<MuscleMatrixTask> task;
+    };
+
+    std::mutex m_Mutex;
+    std::vector<Entry> m_Entries;  // least-recently-requested first
+};
+
+osc::MuscleMatrixService::MuscleMatrixService() :
+    m_Impl{std::make_unique<Impl>()}
+{}
+osc::MuscleMatrixService::MuscleMatrixService(MuscleMatrixService&&) noexcept = default;
+osc::MuscleMatrixService& osc::MuscleMatrixService::operator=(MuscleMatrixService&&) noexcept = default;
+osc::MuscleMatrixService::~MuscleMatrixService() noexcept = default;
+
+std::shared_ptr<MuscleMatrixTask> osc::MuscleMatrixService::request(const IModelStatePair& msp, const MuscleMatrixParams& params)
+{
+    return m_Impl->request(msp, params);
+}
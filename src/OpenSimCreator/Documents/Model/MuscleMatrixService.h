@@ -0,0 +1,152 @@
+#pragma once
+
+#include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/ThreadPool.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace osc { class IModelStatePair; }
+
+namespace osc
+{
+    // a muscle quantity that can be tabulated in a `MuscleMatrix`
+    enum class MuscleMatrixQuantity {
+        MomentArm = 0,
+        FiberLength,
+        TendonLength,
+        NUM_OPTIONS,
+    };
+
+    // returns a human-readable label for the quantity (e.g. "moment_arm")
+    CStringView GetLabel(MuscleMatrixQuantity);
+
+    // parameters that affect how a `MuscleMatrix` is computed
+    struct MuscleMatrixParams final {
+
+        friend bool operator==(const MuscleMatrixParams&, const MuscleMatrixParams&) = default;
+
+        MuscleMatrixQuantity quantity = MuscleMatrixQuantity::MomentArm;
+
+        // the number of evenly-spaced values that each coordinate is sampled at over its range
+        size_t numDataPoints = 32;
+
+        // the number of threads that the computation is split across (these are owned by the
+        // task, rather than taken from the global thread pool)
+        size_t numThreads = ThreadPool::default_num_threads();
+    };
+
+    // a (muscle x coordinate x sample) tensor of a muscle quantity, where each element is
+    // the value of the quantity for a muscle when a coordinate is set to one of its sampled
+    // values (all other coordinates are left at their default values)
+    struct MuscleMatrix final {
+
+        // returns the value of the quantity for the given muscle when the given coordinate is
+        // set to its `sampleIndex`th sampled value
+        float at(size_t muscleIndex, size_t coordinateIndex, size_t sampleIndex) const
+        {
+            return values.at((muscleIndex * coordinatePaths.size() + coordinateIndex) * numDataPoints + sampleIndex);
+        }
+
+        MuscleMatrixQuantity quantity = MuscleMatrixQuantity::MomentArm;
+        size_t numDataPoints = 0;
+        std::vector<std::string> musclePaths;
+        std::vector<std::string> coordinatePaths;
+
+        // [coordinate][sample]: the sampled coordinate values, in the coordinate's display units
+        std::vector<float> coordinateValues;
+
+        // [muscle][coordinate][sample]
+        std::vector<float> values;
+    };
+
+    // writes the matrix as a "long" CSV file, with one row per element
+    // (`muscle,coordinate,coordinate_value,QUANTITY`)
+    void WriteMuscleMatrixAsCSV(std::ostream&, const MuscleMatrix&);
+
+    // writes the matrix in a compact binary format that `ReadMuscleMatrixBinary` can read
+    //
+    // the format is a fixed header (magic, version, quantity, dimensions) followed by
+    // length-prefixed path strings, then the coordinate values and matrix values as
+    // contiguous native-endian 32-bit floats
+    void WriteMuscleMatrixAsBinary(std::ostream&, const MuscleMatrix&);
+
+    // reads a matrix that was written by `WriteMuscleMatrixAsBinary`, or throws on error
+    MuscleMatrix ReadMuscleMatrixBinary(std::istream&);
+
+    // the status of a `MuscleMatrixTask`
+    enum class MuscleMatrixTaskStatus {
+        Running,
+        Cancelled,
+        Finished,
+        Error,
+    };
+
+    // a handle to a `MuscleMatrix` that is being computed on a background thread
+    //
+    // the computation is split across `MuscleMatrixParams::numThreads` threads. It's cancelled
+    // when the task is destroyed, or when `requestCancellation` is called. Note: tasks that are
+    // returned by a `MuscleMatrixService` are also owned by the service's cache, so they
+    // aren't destroyed when the caller's handle is dropped (see `MuscleMatrixService`)
+    class MuscleMatrixTask final {
+    public:
+        MuscleMatrixTask(const IModelStatePair&, const MuscleMatrixParams&);
+        MuscleMatrixTask(const MuscleMatrixTask&) = delete;
+        MuscleMatrixTask(MuscleMatrixTask&&) noexcept = delete;
+        MuscleMatrixTask& operator=(const MuscleMatrixTask&) = delete;
+        MuscleMatrixTask& operator=(MuscleMatrixTask&&) noexcept = delete;
+        ~MuscleMatrixTask() noexcept;
+
+        const MuscleMatrixParams& getParams() const;
+        MuscleMatrixTaskStatus getStatus() const;
+
+        // returns the fraction (0.0 to 1.0) of the matrix's elements that have been computed
+        float getProgress() const;
+
+        std::optional<std::string> getErrorMessage() const;
+
+        // returns the computed matrix, or `nullptr` if the task hasn't (successfully) finished
+        std::shared_ptr<const MuscleMatrix> getResult() const;
+
+        // blocks the calling thread until the task is no longer running
+        void wait();
+
+        void requestCancellation();
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+
+    // a background service that computes `MuscleMatrix`es for models, caching each one
+    // against the version of the model that it was computed from
+    //
+    // the cache holds a handle to each of the most-recently-requested tasks (finished, or
+    // still running), so that dropping the caller's handle doesn't cancel (or discard) it.
+    // Tasks that are evicted from the cache are cancelled, even if the caller still holds
+    // a handle to them.
+    class MuscleMatrixService final {
+    public:
+        MuscleMatrixService();
+        MuscleMatrixService(const MuscleMatrixService&) = delete;
+        MuscleMatrixService(MuscleMatrixService&&) noexcept;
+        MuscleMatrixService& operator=(const MuscleMatrixService&) = delete;
+        MuscleMatrixService& operator=(MuscleMatrixService&&) noexcept;
+        ~MuscleMatrixService() noexcept;
+
+        // returns a task that computes the matrix for the given model
+        //
+        // if a task with the same parameters was already requested for the same version of the
+        // model (and it hasn't failed or been cancelled), then that task is returned, rather than
+        // recomputing the matrix
+        std::shared_ptr<MuscleMatrixTask> request(const IModelStatePair&, const MuscleMatrixParams& = {});
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> m_Impl;
+    };
+}
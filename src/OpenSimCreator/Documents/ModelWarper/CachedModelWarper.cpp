@@ -12,6 +12,7 @@
 #include <oscar/Formats/OBJ.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/Perf.h>
 #include <oscar_simbody/SimTKConverters.h>
 
 #include <filesystem>
@@ -100,6 +101,8 @@ public:
 
     std::shared_ptr<const IModelStatePair> createWarpedModel(const WarpableModel& document)
     {
+        OSC_PERF("CachedModelWarper/createWarpedModel");
+
         // copy the model into an editable "warped" version
         OpenSim::Model warpedModel{document.model()};
         InitializeModel(warpedModel);
@@ -0,0 +1,414 @@
+#include "BatchSimulation.h"
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Formats/CSV.h>
+#include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/ThreadPool.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a set of per-worker double-ended queues of point indices
+    //
+    // each worker pops points from the front of its own queue and, once it runs out, steals
+    // points from the back of the other workers' queues. This keeps each worker working on a
+    // contiguous (and, in a typical sweep, similar) block of points while still balancing the
+    // load when some points take much longer to simulate than others.
+    class WorkStealingQueues final {
+    public:
+        WorkStealingQueues(size_t numWorkers, size_t numPoints)
+        {
+            OSC_ASSERT(numWorkers > 0);
+
+            m_Queues.reserve(numWorkers);
+            for (size_t worker = 0; worker < numWorkers; ++worker) {
+                m_Queues.push_back(std::make_unique<Queue>());
+            }
+
+            // initially, partition the points into contiguous blocks
+            for (size_t point = 0; point < numPoints; ++point) {
+                m_Queues[(point * numWorkers) / numPoints]->items.push_back(point);
+            }
+        }
+
+        std::optional<size_t> pop(size_t worker)
+        {
+            if (auto own = popFront(*m_Queues[worker])) {
+                return own;
+            }
+            for (size_t offset = 1; offset < m_Queues.size(); ++offset) {
+                if (auto stolen = popBack(*m_Queues[(worker + offset) % m_Queues.size()])) {
+                    return stolen;
+                }
+            }
+            return std::nullopt;
+        }
+
+    private:
+        struct Queue final {
+            std::mutex mutex;
+            std::deque<size_t> items;
+        };
+
+        static std::optional<size_t> popFront(Queue& q)
+        {
+            const std::lock_guard lock{q.mutex};
+            if (q.items.empty()) {
+                return std::nullopt;
+            }
+            const size_t rv = q.items.front();
+            q.items.pop_front();
+            return rv;
+        }
+
+        static std::optional<size_t> popBack(Queue& q)
+        {
+            const std::lock_guard lock{q.mutex};
+            if (q.items.empty()) {
+                return std::nullopt;
+            }
+            const size_t rv = q.items.back();
+            q.items.pop_back();
+            return rv;
+        }
+
+        std::vector<std::unique_ptr<Queue>> m_Queues;
+    };
+
+    void ThrowIfAnyCoordinateIsMissing(const OpenSim::Model& model, std::span<const BatchSimulationPoint> points)
+    {
+        const auto& coordinates = model.getCoordinateSet();
+        for (size_t i = 0; i < points.size(); ++i) {
+            for (const auto& [name, value] : points[i].initialCoordinateValues) {
+                if (not coordinates.contains(name)) {
+                    std::stringstream ss;
+                    ss << "batch simulation point " << i << ": cannot find a coordinate called '" << name << "' in the model";
+                    throw std::runtime_error{std::move(ss).str()};
+                }
+            }
+        }
+    }
+
+    std::ofstream OpenOutputFile(const std::filesystem::path& path)
+    {
+        std::ofstream rv{path};
+        if (not rv) {
+            std::stringstream ss;
+            ss << path.string() << ": cannot open for writing";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        rv.precision(std::numeric_limits<double>::max_digits10);
+        return rv;
+    }
+
+    std::filesystem::path GetPointOutputPath(const std::filesystem::path& outputDirectory, size_t pointIndex)
+    {
+        return outputDirectory / ("point_" + std::to_string(pointIndex) + ".csv");
+    }
+
+    // streams each report of a simulation to a CSV file (one row per report)
+    class ReportCSVWriter final {
+    public:
+        ReportCSVWriter(const OpenSim::Model& model, const std::filesystem::path& path) :
+            m_Model{&model},
+            m_Output{OpenOutputFile(path)}
+        {
+            const OpenSim::Array<std::string> names = model.getStateVariableNames();
+            std::vector<std::string> header;
+            header.reserve(static_cast<size_t>(names.size()) + 1);
+            header.emplace_back("time");
+            for (int i = 0; i < names.size(); ++i) {
+                header.push_back(names[i]);
+            }
+            write_csv_row(m_Output, header);
+        }
+
+        void write(const SimulationReport& report)
+        {
+            const SimTK::Vector values = m_Model->getStateVariableValues(report.getState());
+            m_Output << report.getState().getTime();
+            for (int i = 0; i < values.size(); ++i) {
+                m_Output << ',' << values[i];
+            }
+            m_Output << '\n';
+        }
+
+    private:
+        const OpenSim::Model* m_Model;
+        std::ofstream m_Output;
+    };
+
+    // the state that's shared between all workers in the batch
+    struct SharedBatchState final {
+        SharedBatchState(
+            std::span<const BatchSimulationPoint> points_,
+            const BatchSimulationParams& params_,
+            size_t numWorkers_,
+            const std::function<void(const BatchSimulationPointResult&)>& onPointCompleted_) :
+
+            points{points_},
+            params{params_},
+            queues{numWorkers_, points_.size()},
+            onPointCompleted{onPointCompleted_}
+        {
+            if (params.outputDirectory) {
+                summaryOutput = OpenOutputFile(*params.outputDirectory / "summary.csv");
+                write_csv_row(*summaryOutput, {{"point", "status", "num_reports", "simulated_time", "wall_time"}});
+            }
+        }
+
+        void onCompleted(const BatchSimulationPointResult& result)
+        {
+            const std::lock_guard lock{mutex};
+
+            ++summary.numPoints;
+            if (result.status == SimulationStatus::Completed) {
+                ++summary.numCompleted;
+            }
+            else {
+                ++summary.numFailed;
+            }
+            summary.simulatedTime += result.simulatedTime;
+
+            if (summaryOutput) {
+                *summaryOutput << result.pointIndex << ','
+                               << GetAllSimulationStatusStrings()[static_cast<size_t>(result.status)] << ','
+                               << result.numReports << ','
+                               << result.simulatedTime.count() << ','
+                               << result.wallTime.count() << '\n';
+            }
+
+            if (onPointCompleted) {
+                onPointCompleted(result);
+            }
+        }
+
+        std::span<const BatchSimulationPoint> points;
+        const BatchSimulationParams& params;
+        WorkStealingQueues queues;
+        const std::function<void(const BatchSimulationPointResult&)>& onPointCompleted;
+
+        std::mutex mutex;
+        BatchSimulationSummary summary;
+        std::optional<std::ofstream> summaryOutput;
+        std::exception_ptr firstException;
+
+        // set when any worker fails, so that the other workers stop between points
+        std::atomic<bool> stopRequested = false;
+    };
+
+    BatchSimulationPointResult RunPoint(
+        const BasicModelStatePair& workerModel,
+        const BatchSimulationPoint& point,
+        size_t pointIndex,
+        const BatchSimulationParams& params)
+    {
+        const OpenSim::Model& model = workerModel.getModel();
+
+        // apply the point's initial coordinate values to a copy of the (immutable) worker's state
+        SimTK::State initialState = workerModel.getState();
+        for (const auto& [name, value] : point.initialCoordinateValues) {
+            model.getCoordinateSet().get(name).setValue(initialState, value, false);
+        }
+
+        std::optional<ReportCSVWriter> writer;
+        if (params.outputDirectory) {
+            writer.emplace(model, GetPointOutputPath(*params.outputDirectory, pointIndex));
+        }
+
+        BatchSimulationPointResult rv;
+        rv.pointIndex = pointIndex;
+
+        const auto tStart = std::chrono::high_resolution_clock::now();
+        std::optional<SimulationClock::time_point> tLatest;
+        rv.status = RunForwardDynamicSimulation(model, initialState, point.params, [&](const SimulationReport& report)
+        {
+            if (writer) {
+                writer->write(report);
+            }
+            tLatest = report.getTime();
+            ++rv.numReports;
+        });
+        rv.wallTime = std::chrono::high_resolution_clock::now() - tStart;
+        if (tLatest) {
+            rv.simulatedTime = *tLatest - (SimulationClock::start() + SimulationClock::duration{initialState.getTime()});
+        }
+        return rv;
+    }
+
+    void WorkerMain(size_t worker, const BasicModelStatePair& workerModel, SharedBatchState& shared)
+    {
+        while (not shared.stopRequested.load(std::memory_order_relaxed)) {
+            const auto pointIndex = shared.queues.pop(worker);
+            if (not pointIndex) {
+                return;  // no points left
+            }
+
+            try {
+                shared.onCompleted(RunPoint(workerModel, shared.points[*pointIndex], *pointIndex, shared.params));
+            }
+            catch (...) {
+                // unexpected (e.g. I/O) failures are re-thrown on the calling thread, so that
+                // the caller doesn't have to deal with partially-written output
+                const std::lock_guard lock{shared.mutex};
+                if (not shared.firstException) {
+                    shared.firstException = std::current_exception();
+                }
+                shared.stopRequested = true;
+                return;
+            }
+        }
+    }
+
+    double ParseDouble(std::string_view columnName, const std::string& value, size_t row)
+    {
+        std::istringstream ss{value};
+        double rv = 0.0;
+        if (not (ss >> rv) or not (ss >> std::ws).eof()) {
+            std::stringstream msg;
+            msg << "row " << row << ": cannot parse '" << value << "' (in column '" << columnName << "') as a number";
+            throw std::runtime_error{std::move(msg).str()};
+        }
+        return rv;
+    }
+}
+
+BatchSimulationSummary osc::RunBatchSimulation(
+    const BasicModelStatePair& modelState,
+    std::span<const BatchSimulationPoint> points,
+    const BatchSimulationParams& params,
+    const std::function<void(const BatchSimulationPointResult&)>& onPointCompleted)
+{
+    ThrowIfAnyCoordinateIsMissing(modelState.getModel(), points);
+
+    if (params.outputDirectory) {
+        std::filesystem::create_directories(*params.outputDirectory);
+    }
+
+    const size_t numWorkers = std::clamp<size_t>(params.numThreads, 1, std::max<size_t>(points.size(), 1));
+
+    // copy the model once per worker up-front, on this thread, so that each worker exclusively
+    // (and immutably) uses its own copy for all of the points that it runs
+    std::vector<BasicModelStatePair> workerModels;
+    workerModels.reserve(numWorkers);
+    for (size_t worker = 0; worker < numWorkers; ++worker) {
+        workerModels.push_back(modelState);
+    }
+
+    SharedBatchState shared{points, params, numWorkers, onPointCompleted};
+
+    // each worker runs many (potentially long) simulations, so the workers are ran on a pool
+    // that's owned by the batch, with one thread per worker, rather than on the global thread
+    // pool (which is for short tasks). This means that each worker's model copy is in use for
+    // the whole batch, and that `numThreads` bounds the number of concurrent simulations
+    const auto tStart = std::chrono::high_resolution_clock::now();
+    {
+        ThreadPool pool{numWorkers};
+        std::vector<std::future<void>> workers;
+        workers.reserve(numWorkers);
+        for (size_t worker = 0; worker < numWorkers; ++worker) {
+            workers.push_back(pool.submit([worker, &workerModels, &shared]()
+            {
+                WorkerMain(worker, workerModels[worker], shared);
+            }));
+        }
+        for (std::future<void>& worker : workers) {
+            worker.get();
+        }
+    }
+
+    if (shared.firstException) {
+        std::rethrow_exception(shared.firstException);
+    }
+
+    BatchSimulationSummary rv = shared.summary;
+    rv.wallTime = std::chrono::high_resolution_clock::now() - tStart;
+    return rv;
+}
+
+std::vector<BatchSimulationPoint> osc::ReadBatchSimulationPointsCSV(
+    std::istream& in,
+    const ForwardDynamicSimulatorParams& defaults)
+{
+    const std::optional<std::vector<std::string>> header = read_csv_row(in);
+    if (not header or header->empty()) {
+        throw std::runtime_error{"cannot read the header row of the batch simulation points"};
+    }
+
+    std::vector<BatchSimulationPoint> rv;
+    size_t row = 1;
+    for (std::vector<std::string> values; read_csv_row_into_vector(in, values);) {
+        ++row;
+
+        if (values.size() == 1 and values.front().empty()) {
+            continue;  // skip blank lines
+        }
+        if (values.size() != header->size()) {
+            std::stringstream ss;
+            ss << "row " << row << ": has " << values.size() << " columns, but the header has " << header->size() << " columns";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+
+        BatchSimulationPoint& point = rv.emplace_back(BatchSimulationPoint{.params = defaults});
+        for (size_t column = 0; column < header->size(); ++column) {
+            const std::string& name = (*header)[column];
+            const double value = ParseDouble(name, values[column], row);
+
+            if (name == "final_time") {
+                point.params.finalTime = SimulationClock::start() + SimulationClock::duration{value};
+            }
+            else if (name == "reporting_interval") {
+                point.params.reportingInterval = SimulationClock::duration{value};
+            }
+            else if (name == "integrator_step_limit") {
+                point.params.integratorStepLimit = static_cast<int>(value);
+            }
+            else if (name == "integrator_minimum_step_size") {
+                point.params.integratorMinimumStepSize = SimulationClock::duration{value};
+            }
+            else if (name == "integrator_maximum_step_size") {
+                point.params.integratorMaximumStepSize = SimulationClock::duration{value};
+            }
+            else if (name == "integrator_accuracy") {
+                point.params.integratorAccuracy = value;
+            }
+            else {
+                point.initialCoordinateValues.emplace_back(name, value);
+            }
+        }
+    }
+    return rv;
+}
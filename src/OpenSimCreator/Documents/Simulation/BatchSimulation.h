@@ -0,0 +1,102 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osc { class BasicModelStatePair; }
+
+namespace osc
+{
+    // one point in a batch (e.g. a parameter sweep) of forward-dynamic simulations
+    struct BatchSimulationPoint final {
+
+        // the parameters that the point's simulation should be ran with
+        ForwardDynamicSimulatorParams params;
+
+        // (coordinate name, value) pairs that are applied to the model's initial state before
+        // the point's simulation starts
+        //
+        // values are in the coordinate's internal units (e.g. radians for rotational coordinates)
+        std::vector<std::pair<std::string, double>> initialCoordinateValues;
+    };
+
+    // parameters that affect how a batch of simulations is ran
+    struct BatchSimulationParams final {
+
+        // the number of workers that the batch is split between (each worker holds its own copy of the model)
+        //
+        // each worker runs on its own thread, so this is also the maximum number of concurrent simulations
+        size_t numThreads = 1;
+
+        // if provided, each point's reports are streamed to `outputDirectory/point_N.csv` (one row per
+        // report) while the simulation runs and a `summary.csv` (one row per point) is written as points
+        // complete
+        std::optional<std::filesystem::path> outputDirectory;
+    };
+
+    // the result of running one point in a batch of simulations
+    struct BatchSimulationPointResult final {
+        size_t pointIndex = 0;
+        SimulationStatus status = SimulationStatus::Error;
+        size_t numReports = 0;
+        SimulationClock::duration simulatedTime{0.0};
+        std::chrono::duration<double> wallTime{0.0};
+    };
+
+    // a summary of running a batch of simulations
+    struct BatchSimulationSummary final {
+
+        // returns the aggregate throughput of the batch, in simulated seconds per wall-clock second
+        double getThroughput() const
+        {
+            return wallTime.count() > 0.0 ? simulatedTime.count() / wallTime.count() : 0.0;
+        }
+
+        size_t numPoints = 0;
+        size_t numCompleted = 0;
+        size_t numFailed = 0;
+        SimulationClock::duration simulatedTime{0.0};
+        std::chrono::duration<double> wallTime{0.0};
+    };
+
+    // synchronously runs a forward-dynamic simulation for each point in `points` on a thread pool that's
+    // owned by the batch (i.e. not the global thread pool) and returns a summary of the batch
+    //
+    // - each worker holds one copy of the model, which it uses (immutably) for all of the points that it runs
+    // - the points are initially partitioned between the workers, and idle workers steal points from busy ones
+    // - `onPointCompleted` is called from the worker threads, but never concurrently
+    // - if a worker throws (e.g. because `onPointCompleted` throws), the other workers stop after their
+    //   current point and the first exception is rethrown to the caller
+    // - throws if a point references a coordinate that doesn't exist in the model, or if an output file
+    //   cannot be created
+    BatchSimulationSummary RunBatchSimulation(
+        const BasicModelStatePair&,
+        std::span<const BatchSimulationPoint>,
+        const BatchSimulationParams&,
+        const std::function<void(const BatchSimulationPointResult&)>& onPointCompleted = {}
+    );
+
+    // returns points read from a CSV "sweep" file, where the first row is a header and each other row is a point
+    //
+    // header columns that match a `ForwardDynamicSimulatorParams` field (`final_time`, `reporting_interval`,
+    // `integrator_step_limit`, `integrator_minimum_step_size`, `integrator_maximum_step_size`, or
+    // `integrator_accuracy`) set that field on each point; all other columns are treated as coordinate names
+    // that should be set on each point's initial state. Fields that aren't in the header are copied from
+    // `defaults`. Throws if the file is malformed.
+    std::vector<BatchSimulationPoint> ReadBatchSimulationPointsCSV(
+        std::istream&,
+        const ForwardDynamicSimulatorParams& defaults = {}
+    );
+}
@@ -7,10 +7,12 @@
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <OpenSimCreator/Documents/Simulation/StateTrajectory.h>
 #include <OpenSimCreator/Utils/ParamBlock.h>
 
 #include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/SpscQueue.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
 
@@ -20,6 +22,7 @@
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -30,16 +33,18 @@ using namespace osc;
 // helpers
 namespace
 {
-    // creates a simulator that's hooked up to the reports vector
+    // creates a simulator that's hooked up to the (lock-free) report queue
+    //
+    // the simulator's thread is the queue's only producer (the previous simulator, if any, must
+    // be stopped before a new one is made)
     ForwardDynamicSimulator MakeSimulation(
         BasicModelStatePair p,
         const ForwardDynamicSimulatorParams& params,
-        SynchronizedValue<std::vector<SimulationReport>>& reportQueue)
+        SpscQueue<SimulationReport>& reportQueue)
     {
-        auto callback = [&](SimulationReport r)
+        auto callback = [&reportQueue](SimulationReport r)
         {
-            auto reportsGuard = reportQueue.lock();
-            reportsGuard->push_back(std::move(r));
+            reportQueue.push(std::move(r));
         };
         return ForwardDynamicSimulator{std::move(p), params, std::move(callback)};
     }
@@ -81,19 +86,33 @@ public:
     ptrdiff_t getNumReports() const
     {
         popReportsHACK();
-        return m_Reports.size();
+        return m_Trajectory.size();
     }
 
     SimulationReport getSimulationReport(ptrdiff_t reportIndex) const
     {
         popReportsHACK();
-        return m_Reports.at(reportIndex);
+        return m_Trajectory.getReport(static_cast<size_t>(reportIndex), m_ModelState.lock()->getModel());
     }
 
     std::vector<SimulationReport> getAllSimulationReports() const
     {
         popReportsHACK();
-        return m_Reports;
+
+        // care: this rebuilds every report in the trajectory
+        const auto modelLock = m_ModelState.lock();
+        std::vector<SimulationReport> rv;
+        rv.reserve(m_Trajectory.size());
+        for (size_t i = 0; i < m_Trajectory.size(); ++i) {
+            rv.push_back(m_Trajectory.getReport(i, modelLock->getModel()));
+        }
+        return rv;
+    }
+
+    SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const
+    {
+        popReportsHACK();
+        return m_Trajectory.getTime(static_cast<size_t>(reportIndex));
     }
 
     SimulationStatus getStatus() const
@@ -110,8 +129,8 @@ public:
     {
         popReportsHACK();
 
-        if (not m_Reports.empty()) {
-            return SimulationClock::start() + SimulationClock::duration{m_Reports.back().getState().getTime()};
+        if (not m_Trajectory.empty()) {
+            return m_Trajectory.getTime(m_Trajectory.size() - 1);
         }
         else {
             return getStartTime();
@@ -151,14 +170,13 @@ public:
         }
 
         // if necessary, truncate any dangling reports
-        if (new_end_time < old_end_time and not m_Reports.empty()) {
-
-            const auto reportBeforeOrEqualToNewEndTime = [new_end_time](const SimulationReport& r)
-            {
-                return r.getTime() <= new_end_time;
-            };
-            const auto it = find_if(m_Reports.rbegin(), m_Reports.rend(), reportBeforeOrEqualToNewEndTime);
-            m_Reports.erase(it.base(), m_Reports.end());
+        if (new_end_time < old_end_time and not m_Trajectory.empty()) {
+
+            size_t newSize = m_Trajectory.size();
+            while (newSize > 0 and m_Trajectory.getTime(newSize - 1) > new_end_time) {
+                --newSize;
+            }
+            m_Trajectory.truncate(newSize);
         }
 
         // update the simulation parameters to reflect the new end-time
@@ -169,16 +187,19 @@ public:
 
         // edge-case: if the latest available report has an end-time equal to `t`, then
         // our work is complete
-        if (not m_Reports.empty() and m_Reports.back().getTime() == new_end_time) {
+        if (not m_Trajectory.empty() and m_Trajectory.getTime(m_Trajectory.size() - 1) == new_end_time) {
             return;
         }
 
         // otherwise, create a new simulator with the new parameters
         {
             const auto guard = m_ModelState.lock();
-            const SimTK::State& latestState = m_Reports.empty() ?
-                guard->getState() :
-                m_Reports.back().getState();
+            const std::optional<SimulationReport> latestReport = m_Trajectory.empty() ?
+                std::nullopt :
+                std::optional{m_Trajectory.getReport(m_Trajectory.size() - 1, guard->getModel())};
+            const SimTK::State& latestState = latestReport ?
+                latestReport->getState() :
+                guard->getState();
 
             m_Simulation = MakeSimulation(
                 BasicModelStatePair{guard->getModel(), latestState},
@@ -222,49 +243,34 @@ private:
     // the reason this insane hack is necessary is because the background thread
     // requires access to the UI thread's copy of the model in order to perform
     // the realization step
+    //
+    // (the trajectory lazily realizes reports against the UI thread's model when
+    // they're requested, rather than when they're popped)
     void popReportsHACK() const
     {
-        auto& reports = const_cast<std::vector<SimulationReport>&>(m_Reports);
+        auto& trajectory = const_cast<StateTrajectory&>(m_Trajectory);
 
         // handle double-reporting (e.g. due to `requestNewEndTime`) by checking
         // the time of each incoming reports against the latest already collected
         std::optional<SimulationClock::time_point> latestReportTime;
-        if (not reports.empty()) {
-            latestReportTime = reports.back().getTime();
+        if (not trajectory.empty()) {
+            latestReportTime = trajectory.getTime(trajectory.size() - 1);
         }
 
-        const size_t nReportsBefore = reports.size();
-        size_t nAdded = 0;
-
-        // pop them onto the local reports queue
+        // pop them onto the trajectory (this doesn't lock, so it never contends with
+        // the simulator thread, which is usually the case when there's nothing to pop)
+        m_ReportQueue.pop_all([&trajectory, &latestReportTime](SimulationReport&& report)
         {
-            auto guard = const_cast<SynchronizedValue<std::vector<SimulationReport>>&>(m_ReportQueue).lock();
-            reports.reserve(reports.size() + guard->size());
-            for (SimulationReport& report : *guard) {
-                if (report.getTime() == latestReportTime) {
-                    continue;  // filter out duplicate reports (e.g. due to `requestNewEndTime`)
-                }
-
-                reports.push_back(std::move(report));
-                ++nAdded;
+            if (report.getTime() == latestReportTime) {
+                return;  // filter out duplicate reports (e.g. due to `requestNewEndTime`)
             }
-            guard->clear();
-        }
-
-        if (nAdded <= 0) {
-            return;
-        }
-
-        // ensure all reports are realized on the UI model
-        auto modelLock = m_ModelState.lock();
-        for (auto it = reports.begin() + nReportsBefore; it != reports.end(); ++it) {
-            modelLock->getModel().realizeReport(it->updStateHACK());
-        }
+            trajectory.push_back(report);
+        });
     }
 
     SynchronizedValue<BasicModelStatePair> m_ModelState;
-    SynchronizedValue<std::vector<SimulationReport>> m_ReportQueue;
-    std::vector<SimulationReport> m_Reports;
+    mutable SpscQueue<SimulationReport> m_ReportQueue;  // (the UI thread is the only consumer)
+    StateTrajectory m_Trajectory;  // (only stores the continuous state variables of each report)
     ForwardDynamicSimulator m_Simulation;
     ForwardDynamicSimulatorParams m_Params;
     ParamBlock m_ParamsAsParamBlock;
@@ -304,6 +310,11 @@ std::vector<SimulationReport> osc::ForwardDynamicSimulation::implGetAllSimulatio
     return m_Impl->getAllSimulationReports();
 }
 
+SimulationClock::time_point osc::ForwardDynamicSimulation::implGetSimulationReportTime(ptrdiff_t reportIndex) const
+{
+    return m_Impl->getSimulationReportTime(reportIndex);
+}
+
 SimulationStatus osc::ForwardDynamicSimulation::implGetStatus() const
 {
     return m_Impl->getStatus();
@@ -39,6 +39,7 @@ namespace osc
         ptrdiff_t implGetNumReports() const final;
         SimulationReport implGetSimulationReport(ptrdiff_t) const final;
         std::vector<SimulationReport> implGetAllSimulationReports() const final;
+        SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t) const final;
 
         SimulationStatus implGetStatus() const final;
         SimulationClocks implGetClocks() const final;
@@ -17,6 +17,7 @@
 #include <oscar/Shims/Cpp20/stop_token.h>
 #include <oscar/Shims/Cpp20/thread.h>
 #include <oscar/Utils/HashHelpers.h>
+#include <oscar/Utils/Perf.h>
 #include <oscar/Utils/UID.h>
 #include <simmath/Integrator.h>
 #include <simmath/TimeStepper.h>
@@ -194,19 +195,20 @@ namespace
         return s_Outputs;
     }
 
-    std::unique_ptr<SimTK::Integrator> CreateInitializedIntegrator(const SimulatorThreadInput& input)
+    std::unique_ptr<SimTK::Integrator> CreateInitializedIntegrator(
+        const SimTK::MultibodySystem& system,
+        const SimTK::State& initialState,
+        const ForwardDynamicSimulatorParams& params)
     {
-        const ForwardDynamicSimulatorParams& params = input.getParams();
-
         // create + init an integrator
-        auto integ = params.integratorMethodUsed.instantiate(input.getMultiBodySystem());
+        auto integ = params.integratorMethodUsed.instantiate(system);
         integ->setInternalStepLimit(params.integratorStepLimit);
         integ->setMinimumStepSize(params.integratorMinimumStepSize.count());
         integ->setMaximumStepSize(params.integratorMaximumStepSize.count());
         integ->setAccuracy(params.integratorAccuracy);
         integ->setFinalTime(params.finalTime.time_since_epoch().count());
         integ->setReturnEveryInternalStep(true);  // so that cancellations/interrupts work
-        integ->initialize(input.getState());
+        integ->initialize(initialState);
         return integ;
     }
 
@@ -260,19 +262,20 @@ namespace
 
     // this is the main function that the simulator thread works through (unguarded against exceptions)
     SimulationStatus FdSimulationMainUnguarded(
-        cpp20::stop_token stopToken,
-        SimulatorThreadInput& input,
+        const cpp20::stop_token& stopToken,
+        const SimTK::MultibodySystem& system,
+        const SimTK::State& initialState,
+        const ForwardDynamicSimulatorParams& params,
+        const std::function<void(SimulationReport)>& emitReport,
         SharedState& shared)
     {
         const std::chrono::high_resolution_clock::time_point tSimStart = std::chrono::high_resolution_clock::now();
 
-        const ForwardDynamicSimulatorParams& params = input.getParams();
-
         // create + init an integrator
-        std::unique_ptr<SimTK::Integrator> integ = CreateInitializedIntegrator(input);
+        std::unique_ptr<SimTK::Integrator> integ = CreateInitializedIntegrator(system, initialState, params);
 
         // create + init a timestepper for the integrator
-        SimTK::TimeStepper ts{input.getMultiBodySystem(), *integ};
+        SimTK::TimeStepper ts{system, *integ};
         ts.initialize(integ->getState());
         ts.setReportAllSignificantStates(true);  // so that cancellations/interrupts work
 
@@ -282,7 +285,7 @@ namespace
         // immediately report t = start
         {
             std::chrono::duration<float> wallDur = std::chrono::high_resolution_clock::now() - tSimStart;
-            input.emitReport(CreateSimulationReport(wallDur, {}, input.getMultiBodySystem(), *integ));
+            emitReport(CreateSimulationReport(wallDur, {}, system, *integ));
         }
 
         // integrate (t0..tfinal]
@@ -318,7 +321,7 @@ namespace
                 // report the step and continue
                 std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
                 std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
+                emitReport(CreateSimulationReport(wallDur, stepDur, system, *integ));
                 tLastReport = GetSimulationTime(*integ);
                 ++step;
                 continue;
@@ -333,7 +336,7 @@ namespace
                 {
                     std::chrono::duration<float> wallDur = tStepEnd - tSimStart;
                     std::chrono::duration<float> stepDur = tStepEnd - tStepStart;
-                    input.emitReport(CreateSimulationReport(wallDur, stepDur, input.getMultiBodySystem(), *integ));
+                    emitReport(CreateSimulationReport(wallDur, stepDur, system, *integ));
                     tLastReport = t;
                 }
                 break;
@@ -347,19 +350,20 @@ namespace
         return SimulationStatus::Completed;
     }
 
-    // MAIN function for the simulator thread
-    //
     // guarded against exceptions (which are handled as simulation failures)
-    int FdSimulationMain(
-        cpp20::stop_token stopToken,
-        std::unique_ptr<SimulatorThreadInput> input,
-        std::shared_ptr<SharedState> shared)  // NOLINT(performance-unnecessary-value-param)
+    SimulationStatus FdSimulationMainGuarded(
+        const cpp20::stop_token& stopToken,
+        const SimTK::MultibodySystem& system,
+        const SimTK::State& initialState,
+        const ForwardDynamicSimulatorParams& params,
+        const std::function<void(SimulationReport)>& emitReport,
+        SharedState& shared)
     {
         SimulationStatus status = SimulationStatus::Error;
 
         try
         {
-            status = FdSimulationMainUnguarded(std::move(stopToken), *input, *shared);
+            status = FdSimulationMainUnguarded(stopToken, system, initialState, params, emitReport, shared);
         }
         catch (const OpenSim::Exception& ex)
         {
@@ -374,8 +378,25 @@ namespace
             log_error("an exception with unknown type occurred when running a simulation (no error message available)");
         }
 
-        shared->setStatus(status);
+        shared.setStatus(status);
 
+        return status;
+    }
+
+    // MAIN function for the simulator thread
+    int FdSimulationMain(
+        cpp20::stop_token stopToken,
+        std::unique_ptr<SimulatorThreadInput> input,
+        std::shared_ptr<SharedState> shared)  // NOLINT(performance-unnecessary-value-param)
+    {
+        FdSimulationMainGuarded(
+            stopToken,
+            input->getMultiBodySystem(),
+            input->getState(),
+            input->getParams(),
+            [&input](SimulationReport report) { input->emitReport(std::move(report)); },
+            *shared
+        );
         return 0;
     }
 }
@@ -448,6 +469,28 @@ OutputExtractor osc::GetFdSimulatorOutputExtractor(int idx)
     return GetSimulatorOutputExtractors().at(static_cast<size_t>(idx));
 }
 
+SimulationStatus osc::RunForwardDynamicSimulation(
+    const OpenSim::Model& model,
+    const SimTK::State& initialState,
+    const ForwardDynamicSimulatorParams& params,
+    const std::function<void(SimulationReport)>& onReport)
+{
+    const cpp20::stop_source neverStopped;
+    return RunForwardDynamicSimulation(model, initialState, params, onReport, neverStopped.get_token());
+}
+
+SimulationStatus osc::RunForwardDynamicSimulation(
+    const OpenSim::Model& model,
+    const SimTK::State& initialState,
+    const ForwardDynamicSimulatorParams& params,
+    const std::function<void(SimulationReport)>& onReport,
+    const cpp20::stop_token& stopToken)
+{
+    OSC_PERF("RunForwardDynamicSimulation");
+    SharedState shared;
+    return FdSimulationMainGuarded(stopToken, model.getMultibodySystem(), initialState, params, onReport, shared);
+}
+
 osc::ForwardDynamicSimulator::ForwardDynamicSimulator(
     BasicModelStatePair msp,
     const ForwardDynamicSimulatorParams& params,
@@ -4,11 +4,15 @@
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 
+#include <oscar/Shims/Cpp20/stop_token.h>
+
 #include <functional>
 #include <memory>
 
+namespace OpenSim { class Model; }
 namespace osc { struct ForwardDynamicSimulatorParams; }
 namespace osc { class SimulationReport; }
+namespace SimTK { class State; }
 
 namespace osc
 {
@@ -17,6 +21,28 @@ namespace osc
     int GetNumFdSimulatorOutputExtractors();
     OutputExtractor GetFdSimulatorOutputExtractor(int);
 
+    // synchronously runs a forward-dynamic simulation of `model`, starting from `initialState`, on
+    // the calling thread and returns how the simulation ended
+    //
+    // - `onReport` is called (on the calling thread) with each report that the simulation emits
+    // - the model is not modified, so (e.g.) one model can be used to run many simulations
+    // - exceptions thrown by the simulation are logged and returned as `SimulationStatus::Error`
+    SimulationStatus RunForwardDynamicSimulation(
+        const OpenSim::Model&,
+        const SimTK::State& initialState,
+        const ForwardDynamicSimulatorParams&,
+        const std::function<void(SimulationReport)>& onReport
+    );
+
+    // as above, but returns `SimulationStatus::Cancelled` as soon as a stop is requested via `stopToken`
+    SimulationStatus RunForwardDynamicSimulation(
+        const OpenSim::Model&,
+        const SimTK::State& initialState,
+        const ForwardDynamicSimulatorParams&,
+        const std::function<void(SimulationReport)>& onReport,
+        const cpp20::stop_token& stopToken
+    );
+
     // a forward-dynamic simulation that immediately starts running on a background thread
     class ForwardDynamicSimulator final {
     public:
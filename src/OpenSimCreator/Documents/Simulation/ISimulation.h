@@ -57,11 +57,19 @@ namespace osc
             return implGetSimulationReport(reportIndex);
         }
 
+        // care: this can be expensive (e.g. a forward-dynamic simulation rebuilds every report), so
+        // per-frame code should prefer `getNumReports` + `getSimulationReport`, or an `OutputValueCache`
         std::vector<SimulationReport> getAllSimulationReports() const
         {
             return implGetAllSimulationReports();
         }
 
+        // returns the time of the given report (can be cheaper than `getSimulationReport(reportIndex).getTime()`)
+        SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const
+        {
+            return implGetSimulationReportTime(reportIndex);
+        }
+
         SimulationStatus getStatus() const
         {
             return implGetStatus();
@@ -134,6 +142,10 @@ namespace osc
         virtual ptrdiff_t implGetNumReports() const = 0;
         virtual SimulationReport implGetSimulationReport(ptrdiff_t) const = 0;
         virtual std::vector<SimulationReport> implGetAllSimulationReports() const = 0;
+        virtual SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t reportIndex) const
+        {
+            return implGetSimulationReport(reportIndex).getTime();
+        }
 
         virtual SimulationStatus implGetStatus() const = 0;
         virtual SimulationClocks implGetClocks() const = 0;
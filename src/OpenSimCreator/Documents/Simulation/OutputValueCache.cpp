@@ -0,0 +1,174 @@
+#include "OutputValueCache.h"
+
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractorDataType.h>
+#include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/Assertions.h>
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // returns `true` if `column` no longer reflects a prefix of `simulation`'s reports
+    //
+    // (e.g. because the reports were truncated by changing the simulation's end time)
+    template<typename TColumn>
+    bool IsStale(const TColumn& column, const ISimulation& simulation, size_t numReports)
+    {
+        if (column.values.empty()) {
+            return false;
+        }
+        if (column.values.size() > numReports) {
+            return true;
+        }
+        const auto lastCachedIndex = static_cast<ptrdiff_t>(column.values.size() - 1);
+        return simulation.getSimulationReportTime(lastCachedIndex) != column.latestReportTime;
+    }
+
+    // appends any reports in `simulation` that haven't yet been extracted into `column`
+    template<typename TColumn, typename FetchFunction, typename ExtractFunction>
+    void UpdateColumn(
+        TColumn& column,
+        const ISimulation& simulation,
+        FetchFunction&& fetch,
+        ExtractFunction&& extract)
+    {
+        const size_t numReports = simulation.getNumReports();
+
+        if (IsStale(column, simulation, numReports)) {
+            column.values.clear();
+            column.latestReportTime.reset();
+        }
+
+        if (column.values.size() >= numReports) {
+            return;  // already up to date
+        }
+
+        const std::span<const SimulationReport> newReports = fetch(column.values.size(), numReports);
+
+        column.values.reserve(numReports);
+        {
+            const auto model = simulation.getModel();
+            extract(*model, newReports, column.values);
+        }
+        column.latestReportTime = newReports.back().getTime();
+    }
+}
+
+std::span<const float> osc::OutputValueCache::getValuesFloat(
+    const ISimulation& simulation,
+    const OutputExtractor& output)
+{
+    OSC_ASSERT(output.getOutputType() == OutputExtractorDataType::Float);
+
+    auto& column = m_FloatColumns[output];
+    const auto fetch = [this, &simulation](size_t firstReportIndex, size_t numReports)
+    {
+        return fetchReports(simulation, firstReportIndex, numReports);
+    };
+    UpdateColumn(column, simulation, fetch, [&output](const OpenSim::Component& root, std::span<const SimulationReport> reports, std::vector<float>& out)
+    {
+        output.getValuesFloat(root, reports, [&out](float v) { out.push_back(v); });
+    });
+    trimFetchedReports();
+    return column.values;
+}
+
+std::span<const Vec2> osc::OutputValueCache::getValuesVec2(
+    const ISimulation& simulation,
+    const OutputExtractor& output)
+{
+    OSC_ASSERT(output.getOutputType() == OutputExtractorDataType::Vec2);
+
+    auto& column = m_Vec2Columns[output];
+    const auto fetch = [this, &simulation](size_t firstReportIndex, size_t numReports)
+    {
+        return fetchReports(simulation, firstReportIndex, numReports);
+    };
+    UpdateColumn(column, simulation, fetch, [&output](const OpenSim::Component& root, std::span<const SimulationReport> reports, std::vector<Vec2>& out)
+    {
+        output.getValuesVec2(root, reports, [&out](Vec2 v) { out.push_back(v); });
+    });
+    trimFetchedReports();
+    return column.values;
+}
+
+void osc::OutputValueCache::clear()
+{
+    m_FloatColumns.clear();
+    m_Vec2Columns.clear();
+    m_ReportCursor = {};
+}
+
+std::span<const SimulationReport> osc::OutputValueCache::fetchReports(
+    const ISimulation& simulation,
+    size_t firstReportIndex,
+    size_t numReports)
+{
+    ReportCursor& cursor = m_ReportCursor;
+
+    // discard the cursor if it's for a different simulation, or if the simulation's
+    // reports have changed since they were fetched (e.g. because they were truncated)
+    if (not cursor.reports.empty()) {
+        const size_t cursorEnd = cursor.firstReportIndex + cursor.reports.size();
+        const bool isStale =
+            cursor.simulation != &simulation or
+            cursorEnd > numReports or
+            simulation.getSimulationReportTime(static_cast<ptrdiff_t>(cursorEnd - 1)) != cursor.reports.back().getTime();
+        if (isStale) {
+            cursor.reports.clear();
+        }
+    }
+    if (cursor.reports.empty()) {
+        cursor.simulation = &simulation;
+        cursor.firstReportIndex = firstReportIndex;
+    }
+
+    // fetch any reports that are missing from the start or the end of the cursor
+    if (firstReportIndex < cursor.firstReportIndex) {
+        std::vector<SimulationReport> earlierReports;
+        earlierReports.reserve(cursor.firstReportIndex - firstReportIndex);
+        for (size_t i = firstReportIndex; i < cursor.firstReportIndex; ++i) {
+            earlierReports.push_back(simulation.getSimulationReport(static_cast<ptrdiff_t>(i)));
+        }
+        cursor.reports.insert(cursor.reports.begin(), earlierReports.begin(), earlierReports.end());
+        cursor.firstReportIndex = firstReportIndex;
+    }
+    for (size_t i = cursor.firstReportIndex + cursor.reports.size(); i < numReports; ++i) {
+        cursor.reports.push_back(simulation.getSimulationReport(static_cast<ptrdiff_t>(i)));
+    }
+
+    return std::span<const SimulationReport>{cursor.reports}.subspan(
+        firstReportIndex - cursor.firstReportIndex,
+        numReports - firstReportIndex
+    );
+}
+
+void osc::OutputValueCache::trimFetchedReports()
+{
+    size_t numExtractedByAllColumns = std::numeric_limits<size_t>::max();
+    for (const auto& [output, column] : m_FloatColumns) {
+        numExtractedByAllColumns = min(numExtractedByAllColumns, column.values.size());
+    }
+    for (const auto& [output, column] : m_Vec2Columns) {
+        numExtractedByAllColumns = min(numExtractedByAllColumns, column.values.size());
+    }
+
+    ReportCursor& cursor = m_ReportCursor;
+    if (numExtractedByAllColumns <= cursor.firstReportIndex) {
+        return;
+    }
+    const size_t numToDrop = min(numExtractedByAllColumns - cursor.firstReportIndex, cursor.reports.size());
+    cursor.reports.erase(cursor.reports.begin(), cursor.reports.begin() + static_cast<ptrdiff_t>(numToDrop));
+    cursor.firstReportIndex += numToDrop;
+}
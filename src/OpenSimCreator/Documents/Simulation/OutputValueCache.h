@@ -0,0 +1,75 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <oscar/Maths/Vec2.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace osc { class ISimulation; }
+
+namespace osc
+{
+    // a columnar cache of output values for a single simulation
+    //
+    // each (float or `Vec2`) `OutputExtractor` that's requested from the cache gets its own
+    // column, which contains one value per simulation report. Columns are incrementally
+    // appended to as new reports arrive in the simulation, so that (e.g.) plotting an output
+    // doesn't require re-extracting the entire history of the simulation each frame.
+    //
+    // if the simulation's reports are truncated (e.g. because its end time was changed),
+    // the affected columns are re-extracted from scratch
+    //
+    // all columns share one cursor of fetched reports, so that each report is only fetched
+    // from the simulation once, rather than once per column, because fetching a report can
+    // be expensive (e.g. `ForwardDynamicSimulation` rebuilds and realizes them on demand)
+    class OutputValueCache final {
+    public:
+        // returns one value per report in `simulation` for the given (float) output
+        //
+        // the returned span is invalidated by the next non-const call to the cache
+        std::span<const float> getValuesFloat(const ISimulation&, const OutputExtractor&);
+
+        // returns one value per report in `simulation` for the given (Vec2) output
+        //
+        // the returned span is invalidated by the next non-const call to the cache
+        std::span<const Vec2> getValuesVec2(const ISimulation&, const OutputExtractor&);
+
+        // returns the number of columns currently held by the cache
+        size_t getNumColumns() const { return m_FloatColumns.size() + m_Vec2Columns.size(); }
+
+        // removes all columns from the cache
+        void clear();
+    private:
+        template<typename T>
+        struct Column final {
+            std::vector<T> values;
+            std::optional<SimulationClock::time_point> latestReportTime;
+        };
+
+        // a contiguous range of reports that were fetched from a simulation, but haven't
+        // yet been extracted into every column
+        struct ReportCursor final {
+            const ISimulation* simulation = nullptr;
+            size_t firstReportIndex = 0;
+            std::vector<SimulationReport> reports;
+        };
+
+        // returns reports [`firstReportIndex`, `numReports`) of `simulation`, fetching any
+        // that aren't already in the cursor
+        std::span<const SimulationReport> fetchReports(const ISimulation&, size_t firstReportIndex, size_t numReports);
+
+        // drops reports from the cursor that have been extracted into every column
+        void trimFetchedReports();
+
+        std::unordered_map<OutputExtractor, Column<float>> m_FloatColumns;
+        std::unordered_map<OutputExtractor, Column<Vec2>> m_Vec2Columns;
+        ReportCursor m_ReportCursor;
+    };
+}
@@ -37,6 +37,7 @@ namespace osc
         size_t getNumReports() const { return m_Simulation->getNumReports(); }
         SimulationReport getSimulationReport(ptrdiff_t reportIndex) const { return m_Simulation->getSimulationReport(std::move(reportIndex)); }
         std::vector<SimulationReport> getAllSimulationReports() const { return m_Simulation->getAllSimulationReports(); }
+        SimulationClock::time_point getSimulationReportTime(ptrdiff_t reportIndex) const { return m_Simulation->getSimulationReportTime(reportIndex); }
 
         SimulationStatus getStatus() const { return m_Simulation->getStatus(); }
         SimulationClock::time_point getCurTime() { return m_Simulation->getCurTime(); }
@@ -49,6 +49,11 @@ public:
         return lookup_or_nullopt(m_AuxiliaryValues, id);
     }
 
+    const std::unordered_map<UID, float>& getAuxiliaryValues() const
+    {
+        return m_AuxiliaryValues;
+    }
+
 private:
     SimTK::State m_State;
     std::unordered_map<UID, float> m_AuxiliaryValues;
@@ -89,3 +94,8 @@ std::optional<float> osc::SimulationReport::getAuxiliaryValue(UID id) const
 {
     return m_Impl->getAuxiliaryValue(id);
 }
+
+const std::unordered_map<UID, float>& osc::SimulationReport::getAuxiliaryValues() const
+{
+    return m_Impl->getAuxiliaryValues();
+}
@@ -28,6 +28,7 @@ namespace osc
         const SimTK::State& getState() const;
         SimTK::State& updStateHACK();  // necessary because of a bug in OpenSim PathWrap
         std::optional<float> getAuxiliaryValue(UID) const;
+        const std::unordered_map<UID, float>& getAuxiliaryValues() const;
 
         friend bool operator==(const SimulationReport&, const SimulationReport&) = default;
     private:
@@ -0,0 +1,206 @@
+#include "StateTrajectory.h"
+
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/UID.h>
+#include <SimTKcommon.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr float c_MissingAuxiliaryValue = std::numeric_limits<float>::quiet_NaN();
+
+    void ThrowIfOutOfBounds(size_t i, size_t size)
+    {
+        if (i >= size) {
+            std::stringstream ss;
+            ss << "StateTrajectory: report index (" << i << ") is out of bounds (size = " << size << ')';
+            throw std::out_of_range{std::move(ss).str()};
+        }
+    }
+}
+
+osc::StateTrajectory::StateTrajectory(
+    StateTrajectoryPrecision precision,
+    size_t maxCachedReports) :
+
+    m_Precision{precision},
+    m_MaxCachedReports{maxCachedReports}
+{}
+osc::StateTrajectory::StateTrajectory(StateTrajectory&&) noexcept = default;
+osc::StateTrajectory& osc::StateTrajectory::operator=(StateTrajectory&&) noexcept = default;
+osc::StateTrajectory::~StateTrajectory() noexcept = default;
+
+void osc::StateTrajectory::push_back(const SimulationReport& report)
+{
+    const SimTK::State& state = report.getState();
+
+    // the first report's state is used as a template for all rebuilt states
+    if (not m_TemplateState) {
+        m_TemplateState = std::make_unique<SimTK::State>(state);
+        m_NumStateVariables = static_cast<size_t>(state.getNY());
+    }
+    else if (static_cast<size_t>(state.getNY()) != m_NumStateVariables) {
+        std::stringstream ss;
+        ss << "StateTrajectory: cannot add a state with " << state.getNY() << " continuous state variables to a trajectory of states that have " << m_NumStateVariables << " continuous state variables";
+        throw std::runtime_error{std::move(ss).str()};
+    }
+
+    m_Times.push_back(state.getTime());
+
+    // record the continuous state variables (Q, U, Z)
+    const SimTK::Vector& y = state.getY();
+    if (m_Precision == StateTrajectoryPrecision::Float) {
+        m_FloatStateVariables.reserve(m_FloatStateVariables.size() + m_NumStateVariables);
+        for (int i = 0; i < y.size(); ++i) {
+            m_FloatStateVariables.push_back(static_cast<float>(y[i]));
+        }
+    }
+    else {
+        m_DoubleStateVariables.reserve(m_DoubleStateVariables.size() + m_NumStateVariables);
+        for (int i = 0; i < y.size(); ++i) {
+            m_DoubleStateVariables.push_back(y[i]);
+        }
+    }
+
+    // record the auxiliary values into their columns
+    const std::unordered_map<UID, float>& auxiliaryValues = report.getAuxiliaryValues();
+    size_t numRecorded = 0;
+    for (size_t column = 0; column < m_AuxiliaryValueIDs.size(); ++column) {
+        if (const auto v = lookup_or_nullopt(auxiliaryValues, m_AuxiliaryValueIDs[column])) {
+            m_AuxiliaryValueColumns[column].push_back(*v);
+            ++numRecorded;
+        }
+        else {
+            m_AuxiliaryValueColumns[column].push_back(c_MissingAuxiliaryValue);
+        }
+    }
+
+    // add new columns for any auxiliary values that haven't been seen before (backfilled with "missing")
+    if (numRecorded < auxiliaryValues.size()) {
+        for (const auto& [id, value] : auxiliaryValues) {
+            if (std::ranges::find(m_AuxiliaryValueIDs, id) == m_AuxiliaryValueIDs.end()) {
+                m_AuxiliaryValueIDs.push_back(id);
+                auto& column = m_AuxiliaryValueColumns.emplace_back(m_Times.size() - 1, c_MissingAuxiliaryValue);
+                column.push_back(value);
+            }
+        }
+    }
+}
+
+void osc::StateTrajectory::truncate(size_t newSize)
+{
+    if (newSize >= size()) {
+        return;  // nothing to truncate
+    }
+
+    m_Times.resize(newSize);
+    if (m_Precision == StateTrajectoryPrecision::Float) {
+        m_FloatStateVariables.resize(newSize * m_NumStateVariables);
+    }
+    else {
+        m_DoubleStateVariables.resize(newSize * m_NumStateVariables);
+    }
+    for (auto& column : m_AuxiliaryValueColumns) {
+        column.resize(newSize);
+    }
+
+    std::erase_if(m_CachedReports, [newSize](const auto& p) { return p.first >= newSize; });
+
+    // if the trajectory is now empty, the next report becomes the new template
+    if (newSize == 0) {
+        m_TemplateState.reset();
+        m_NumStateVariables = 0;
+        m_AuxiliaryValueIDs.clear();
+        m_AuxiliaryValueColumns.clear();
+    }
+}
+
+SimulationClock::time_point osc::StateTrajectory::getTime(size_t i) const
+{
+    ThrowIfOutOfBounds(i, size());
+    return SimulationClock::start() + SimulationClock::duration{m_Times[i]};
+}
+
+std::optional<float> osc::StateTrajectory::getAuxiliaryValue(size_t i, UID id) const
+{
+    ThrowIfOutOfBounds(i, size());
+
+    const auto it = std::ranges::find(m_AuxiliaryValueIDs, id);
+    if (it == m_AuxiliaryValueIDs.end()) {
+        return std::nullopt;
+    }
+    const float v = m_AuxiliaryValueColumns[std::distance(m_AuxiliaryValueIDs.begin(), it)][i];
+    return std::isnan(v) ? std::nullopt : std::optional<float>{v};
+}
+
+SimulationReport osc::StateTrajectory::getReport(size_t i, const OpenSim::Model& model) const
+{
+    ThrowIfOutOfBounds(i, size());
+
+    // if it's cached, move it to the front of the cache and return it
+    const auto it = std::ranges::find(m_CachedReports, i, [](const auto& p) { return p.first; });
+    if (it != m_CachedReports.end()) {
+        std::rotate(m_CachedReports.begin(), it, it + 1);
+        return m_CachedReports.front().second;
+    }
+
+    // else: rebuild it and put it at the front of the cache (evicting the least-recently used report)
+    SimulationReport report = buildReport(i, model);
+    if (m_MaxCachedReports > 0) {
+        if (m_CachedReports.size() >= m_MaxCachedReports) {
+            m_CachedReports.pop_back();
+        }
+        m_CachedReports.emplace(m_CachedReports.begin(), i, report);
+    }
+    return report;
+}
+
+SimulationReport osc::StateTrajectory::buildReport(size_t i, const OpenSim::Model& model) const
+{
+    SimTK::State state = *m_TemplateState;
+    state.setTime(m_Times[i]);
+
+    SimTK::Vector& y = state.updY();
+    const size_t offset = i * m_NumStateVariables;
+    if (m_Precision == StateTrajectoryPrecision::Float) {
+        for (size_t j = 0; j < m_NumStateVariables; ++j) {
+            y[static_cast<int>(j)] = static_cast<double>(m_FloatStateVariables[offset + j]);
+        }
+    }
+    else {
+        for (size_t j = 0; j < m_NumStateVariables; ++j) {
+            y[static_cast<int>(j)] = m_DoubleStateVariables[offset + j];
+        }
+    }
+
+    std::unordered_map<UID, float> auxiliaryValues;
+    auxiliaryValues.reserve(m_AuxiliaryValueIDs.size());
+    for (size_t column = 0; column < m_AuxiliaryValueIDs.size(); ++column) {
+        const float v = m_AuxiliaryValueColumns[column][i];
+        if (not std::isnan(v)) {
+            auxiliaryValues.emplace(m_AuxiliaryValueIDs[column], v);
+        }
+    }
+
+    model.realizeReport(state);
+
+    return SimulationReport{std::move(state), std::move(auxiliaryValues)};
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace OpenSim { class Model; }
+namespace SimTK { class State; }
+
+namespace osc
+{
+    // the precision that a `StateTrajectory` stores each state variable with
+    enum class StateTrajectoryPrecision {
+        Double,  // lossless
+        Float,   // halves the memory usage, but quantizes each state variable to a `float`
+        NUM_OPTIONS,
+    };
+
+    // a compact, append-only, sequence of `SimulationReport`s
+    //
+    // rather than storing a complete `SimTK::State` per report, a trajectory only stores
+    // each report's time, continuous state variables (i.e. Q, U, and Z) and auxiliary values
+    // in contiguous arrays. A complete (realized) `SimulationReport` is lazily rebuilt from
+    // these arrays when it's requested via `getReport`, and the most-recently requested reports
+    // are kept in a small LRU cache.
+    //
+    // note: only continuous state variables are recorded. All other parts of a rebuilt state
+    //       (e.g. discrete variables) are copied from the first report that was added to the
+    //       trajectory.
+    class StateTrajectory final {
+    public:
+        explicit StateTrajectory(
+            StateTrajectoryPrecision = StateTrajectoryPrecision::Double,
+            size_t maxCachedReports = 8
+        );
+        StateTrajectory(const StateTrajectory&) = delete;
+        StateTrajectory(StateTrajectory&&) noexcept;
+        StateTrajectory& operator=(const StateTrajectory&) = delete;
+        StateTrajectory& operator=(StateTrajectory&&) noexcept;
+        ~StateTrajectory() noexcept;
+
+        size_t size() const { return m_Times.size(); }
+        bool empty() const { return m_Times.empty(); }
+        StateTrajectoryPrecision getPrecision() const { return m_Precision; }
+
+        // appends the report's time, continuous state variables, and auxiliary values to the trajectory
+        //
+        // throws if the report's state has a different number of continuous state variables from
+        // the other reports in the trajectory
+        void push_back(const SimulationReport&);
+
+        // removes all reports at, or after, `newSize` from the trajectory
+        void truncate(size_t newSize);
+
+        // removes all reports from the trajectory
+        void clear() { truncate(0); }
+
+        // returns the time of the `i`th report in the trajectory (throws if out-of-bounds)
+        SimulationClock::time_point getTime(size_t i) const;
+
+        // returns an auxiliary value of the `i`th report in the trajectory (throws if out-of-bounds)
+        std::optional<float> getAuxiliaryValue(size_t i, UID) const;
+
+        // returns the `i`th report in the trajectory, realized to `SimTK::Stage::Report` against
+        // the given model (throws if out-of-bounds)
+        //
+        // the model must be the model that the reports were produced by (or a copy of it)
+        SimulationReport getReport(size_t i, const OpenSim::Model&) const;
+
+    private:
+        SimulationReport buildReport(size_t i, const OpenSim::Model&) const;
+
+        StateTrajectoryPrecision m_Precision;
+        size_t m_MaxCachedReports;
+
+        // the first report's state, which is used as a template for rebuilt states
+        std::unique_ptr<SimTK::State> m_TemplateState;
+        size_t m_NumStateVariables = 0;
+
+        // one element per report
+        std::vector<double> m_Times;
+
+        // `m_NumStateVariables` elements per report (only one of these is used, based on `m_Precision`)
+        std::vector<double> m_DoubleStateVariables;
+        std::vector<float> m_FloatStateVariables;
+
+        // one column (one element per report) per auxiliary value, with NaNs for missing values
+        std::vector<UID> m_AuxiliaryValueIDs;
+        std::vector<std::vector<float>> m_AuxiliaryValueColumns;
+
+        // most-recently requested reports, most-recent first
+        mutable std::vector<std::pair<size_t, SimulationReport>> m_CachedReports;
+    };
+}
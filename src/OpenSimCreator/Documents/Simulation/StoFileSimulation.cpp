@@ -16,6 +16,7 @@
 #include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
 #include <OpenSim/Simulation/SimbodyEngine/SimbodyEngine.h>
 #include <oscar/Platform/Log.h>
+#include <oscar/Utils/Perf.h>
 #include <oscar/Utils/ScopeGuard.h>
 
 #include <algorithm>
@@ -55,6 +56,8 @@ namespace
         OpenSim::Model& model,
         const std::filesystem::path& stoFilePath)
     {
+        OSC_PERF("StoFileSimulation/ExtractReports");
+
         // load+condition the underlying `OpenSim::Storage`
         const auto storage = LoadStorage(model, stoFilePath, StorageLoadingParameters{
             .resampleToFrequency = 1.0/100.0,  // resample the state trajectory at 100FPS (#708)
@@ -2,27 +2,39 @@
 
 #include <OpenSimCreator/Documents/Model/IModelStatePair.h>
 #include <OpenSimCreator/Documents/Model/ModelStatePairInfo.h>
+#include <OpenSimCreator/Graphics/ComponentSceneDecorationFlagsTagger.h>
 #include <OpenSimCreator/Graphics/ModelRendererParams.h>
+#include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
 #include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
 #include <OpenSimCreator/Graphics/OverlayDecorationGenerator.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <OpenSim/Simulation/Model/Frame.h>
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationFlags.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Scene/SceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
 #include <oscar/Maths/AABB.h>
 #include <oscar/Maths/BVH.h>
 #include <oscar/Maths/PolarPerspectiveCamera.h>
+#include <oscar/Maths/QuaternionFunctions.h>
+#include <oscar/Maths/Transform.h>
+#include <oscar/Maths/TransformFunctions.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar_simbody/SimTKConverters.h>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <span>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,6 +42,26 @@ using namespace osc;
 
 namespace
 {
+    // a contiguous range of decorations in the drawlist that are associated with one component
+    struct ComponentDecorationRange final {
+        const OpenSim::Component* component = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // retained information about a (non-overlay) decoration in the drawlist
+    struct RetainedDecoration final {
+
+        // index of the component (in `m_Components`) that generated the decoration
+        size_t componentIndex = 0;
+
+        // the component that the decoration is associated with (e.g. for tagging)
+        const OpenSim::Component* linkedComponent = nullptr;
+
+        // the decoration's transform relative to its generating component's rigid frame (if any)
+        Transform frameLocalTransform;
+    };
+
     // cache for decorations generated from a model+state+params
     class CachedDecorationState final {
     public:
@@ -45,43 +77,36 @@ namespace
             OSC_PERF("CachedModelRenderer/generateDecorationsCached");
 
             const ModelStatePairInfo info{modelState};
-            if (info != m_PrevModelStateInfo ||
+            if (!info.hasSameModelAs(m_PrevModelStateInfo) ||
                 params.decorationOptions != m_PrevDecorationOptions ||
                 params.overlayOptions != m_PrevOverlayOptions)
             {
-                m_Drawlist.clear();
-                m_BVH.clear();
-
-                // regenerate
-                const auto onComponentDecoration = [this](const OpenSim::Component&, SceneDecoration&& dec)
-                {
-                    m_Drawlist.push_back(std::move(dec));
-                };
-                GenerateDecorations(
-                    *m_MeshCache,
-                    modelState,
-                    params.decorationOptions,
-                    onComponentDecoration
-                );
-                update_scene_bvh(m_Drawlist, m_BVH);
-
-                const auto onOverlayDecoration = [this](SceneDecoration&& dec)
-                {
-                    m_Drawlist.push_back(std::move(dec));
-                };
-                GenerateOverlayDecorations(
-                    *m_MeshCache,
-                    params.overlayOptions,
-                    m_BVH,
-                    modelState.getFixupScaleFactor(),
-                    onOverlayDecoration
-                );
-
+                regenerate(modelState, params);
                 m_PrevModelStateInfo = info;
                 m_PrevDecorationOptions = params.decorationOptions;
                 m_PrevOverlayOptions = params.overlayOptions;
                 return true;   // updated
             }
+            else if (!info.hasSameModelAndStateAs(m_PrevModelStateInfo))
+            {
+                // only the state (e.g. coordinate values while scrubbing a simulation) changed,
+                // so only move the decorations that are rigidly attached to frames and regenerate
+                // the rest
+                updateState(modelState, params);
+                if (modelState.getSelected() != m_PrevSelected || modelState.getHovered() != m_PrevHovered) {
+                    retag(modelState);
+                }
+                m_PrevModelStateInfo = info;
+                return true;   // updated
+            }
+            else if (info != m_PrevModelStateInfo)
+            {
+                // only the selection and/or hover changed, so the geometry (and BVH) are
+                // still valid: only re-tag the affected decorations
+                retag(modelState);
+                m_PrevModelStateInfo = info;
+                return true;   // updated
+            }
             else
             {
                 return false;  // already up to date
@@ -98,12 +123,252 @@ namespace
         }
 
     private:
+        void regenerate(
+            const IModelStatePair& modelState,
+            const ModelRendererParams& params)
+        {
+            m_Drawlist.clear();
+            m_BVH.clear();
+            m_Components.clear();
+            m_RigidFrames.clear();
+            m_DynamicComponentIndices.clear();
+            m_RetainedDecorations.clear();
+
+            // classify each component by whether its decorations can be moved, rather than
+            // regenerated, when only the state changes
+            for (const OpenSim::Component& component : modelState.getModel().getComponentList()) {
+                const OpenSim::Frame* rigidFrame = FindRigidDecorationFrame(component);
+                if (!rigidFrame) {
+                    m_DynamicComponentIndices.push_back(m_Components.size());
+                }
+                m_Components.push_back(&component);
+                m_RigidFrames.push_back(rigidFrame);
+            }
+
+            // regenerate, while keeping track of which component generated which decorations
+            const auto onComponentDecoration = [this](size_t componentIndex, const OpenSim::Component& component, SceneDecoration&& dec)
+            {
+                m_RetainedDecorations.push_back({componentIndex, &component, Transform{}});
+                m_Drawlist.push_back(std::move(dec));
+            };
+            GenerateDecorationsForComponents(
+                *m_MeshCache,
+                modelState,
+                m_Components,
+                params.decorationOptions,
+                onComponentDecoration
+            );
+
+            // store each rigidly-attached decoration's transform relative to its frame
+            const SimTK::State& state = modelState.getState();
+            std::optional<size_t> prevComponentIndex;
+            Transform frameInGround;
+            for (size_t i = 0; i < m_RetainedDecorations.size(); ++i) {
+                RetainedDecoration& retained = m_RetainedDecorations[i];
+                const OpenSim::Frame* frame = m_RigidFrames[retained.componentIndex];
+                if (!frame) {
+                    continue;
+                }
+                if (retained.componentIndex != prevComponentIndex) {
+                    frameInGround = to<Transform>(frame->getTransformInGround(state));
+                    prevComponentIndex = retained.componentIndex;
+                }
+                const Transform& decorationInGround = m_Drawlist[i].transform;
+                retained.frameLocalTransform = {
+                    .scale = decorationInGround.scale,
+                    .rotation = conjugate(frameInGround.rotation) * decorationInGround.rotation,
+                    .position = inverse_transform_point(frameInGround, decorationInGround.position),
+                };
+            }
+
+            rebuildComponentRanges();
+            update_scene_bvh(m_Drawlist, m_BVH);
+            appendOverlayDecorations(modelState, params);
+
+            m_PrevSelected = modelState.getSelected();
+            m_PrevHovered = modelState.getHovered();
+        }
+
+        // updates the (non-overlay) decorations for a new state of the same model, by moving
+        // the decorations that are rigidly attached to a frame and regenerating the others
+        void updateState(
+            const IModelStatePair& modelState,
+            const ModelRendererParams& params)
+        {
+            OSC_PERF("CachedModelRenderer/updateDecorationsForNewState");
+
+            // regenerate the decorations of components that aren't rigidly attached to a frame
+            std::vector<const OpenSim::Component*> dynamicComponents;
+            dynamicComponents.reserve(m_DynamicComponentIndices.size());
+            for (const size_t componentIndex : m_DynamicComponentIndices) {
+                dynamicComponents.push_back(m_Components[componentIndex]);
+            }
+
+            std::vector<SceneDecoration> dynamicDecorations;
+            std::vector<RetainedDecoration> dynamicRetainedDecorations;
+            const auto onDynamicDecoration = [this, &dynamicDecorations, &dynamicRetainedDecorations](size_t dynamicIndex, const OpenSim::Component& component, SceneDecoration&& dec)
+            {
+                dynamicRetainedDecorations.push_back({m_DynamicComponentIndices[dynamicIndex], &component, Transform{}});
+                dynamicDecorations.push_back(std::move(dec));
+            };
+            GenerateDecorationsForComponents(
+                *m_MeshCache,
+                modelState,
+                dynamicComponents,
+                params.decorationOptions,
+                onDynamicDecoration
+            );
+
+            // merge the moved rigid decorations with the regenerated ones, in component order, so
+            // that the drawlist has the same order as a full regeneration
+            const SimTK::State& state = modelState.getState();
+            std::vector<SceneDecoration> drawlist;
+            std::vector<RetainedDecoration> retainedDecorations;
+            drawlist.reserve(m_RetainedDecorations.size() + dynamicDecorations.size());
+            retainedDecorations.reserve(drawlist.capacity());
+
+            size_t nextDynamic = 0;
+            const auto emitDynamicDecorationsBefore = [&](size_t componentIndex)
+            {
+                for (; nextDynamic < dynamicDecorations.size() && dynamicRetainedDecorations[nextDynamic].componentIndex < componentIndex; ++nextDynamic) {
+                    drawlist.push_back(std::move(dynamicDecorations[nextDynamic]));
+                    retainedDecorations.push_back(dynamicRetainedDecorations[nextDynamic]);
+                }
+            };
+
+            std::optional<size_t> prevComponentIndex;
+            Transform frameInGround;
+            for (size_t i = 0; i < m_RetainedDecorations.size(); ++i) {
+                const RetainedDecoration& retained = m_RetainedDecorations[i];
+                const OpenSim::Frame* frame = m_RigidFrames[retained.componentIndex];
+                if (!frame) {
+                    continue;  // it was regenerated
+                }
+                emitDynamicDecorationsBefore(retained.componentIndex);
+
+                if (retained.componentIndex != prevComponentIndex) {
+                    frameInGround = to<Transform>(frame->getTransformInGround(state));
+                    prevComponentIndex = retained.componentIndex;
+                }
+                SceneDecoration& decoration = drawlist.emplace_back(std::move(m_Drawlist[i]));
+                decoration.transform = {
+                    .scale = retained.frameLocalTransform.scale,
+                    .rotation = frameInGround.rotation * retained.frameLocalTransform.rotation,
+                    .position = frameInGround * retained.frameLocalTransform.position,
+                };
+                retainedDecorations.push_back(retained);
+            }
+            emitDynamicDecorationsBefore(m_Components.size());
+
+            m_Drawlist = std::move(drawlist);
+            m_RetainedDecorations = std::move(retainedDecorations);
+
+            rebuildComponentRanges();
+            refit_scene_bvh(m_Drawlist, m_BVH);
+            appendOverlayDecorations(modelState, params);
+        }
+
+        // (re)computes the ranges of consecutive decorations that are associated with the same
+        // component from the retained decorations
+        void rebuildComponentRanges()
+        {
+            m_ComponentRanges.clear();
+            m_RangesAffectedByComponent.clear();
+            for (size_t i = 0; i < m_RetainedDecorations.size(); ++i) {
+                const OpenSim::Component* component = m_RetainedDecorations[i].linkedComponent;
+                if (m_ComponentRanges.empty() || m_ComponentRanges.back().component != component) {
+                    m_ComponentRanges.push_back({component, i, i});
+                }
+                ++m_ComponentRanges.back().end;
+            }
+        }
+
+        // appends the overlay decorations (which may depend on the BVH) to the drawlist
+        void appendOverlayDecorations(
+            const IModelStatePair& modelState,
+            const ModelRendererParams& params)
+        {
+            const auto onOverlayDecoration = [this](SceneDecoration&& dec)
+            {
+                m_Drawlist.push_back(std::move(dec));
+            };
+            GenerateOverlayDecorations(
+                *m_MeshCache,
+                params.overlayOptions,
+                m_BVH,
+                modelState.getFixupScaleFactor(),
+                onOverlayDecoration
+            );
+        }
+
+        // updates the rim highlight flags of the decorations that are affected by the
+        // previous and current selection/hover (i.e. the decorations that are owned by
+        // those components, or their descendants)
+        void retag(const IModelStatePair& modelState)
+        {
+            OSC_PERF("CachedModelRenderer/retagDecorations");
+
+            if (m_RangesAffectedByComponent.empty()) {
+                // lazily index (component --> ranges) so that full regenerations, which happen
+                // more often than hover/selection changes during (e.g.) scrubbing, don't pay for it
+                for (size_t i = 0; i < m_ComponentRanges.size(); ++i) {
+                    for (const OpenSim::Component* c = m_ComponentRanges[i].component; c; c = GetOwner(*c)) {
+                        m_RangesAffectedByComponent[c].push_back(i);
+                    }
+                }
+            }
+
+            const ComponentSceneDecorationFlagsTagger tagger{modelState.getSelected(), modelState.getHovered()};
+            const auto affectedComponents = std::to_array({
+                m_PrevSelected,
+                m_PrevHovered,
+                modelState.getSelected(),
+                modelState.getHovered(),
+            });
+            for (const OpenSim::Component* affected : affectedComponents) {
+                if (!affected) {
+                    continue;
+                }
+                const auto it = m_RangesAffectedByComponent.find(affected);
+                if (it == m_RangesAffectedByComponent.end()) {
+                    continue;
+                }
+                for (const size_t rangeIndex : it->second) {
+                    const ComponentDecorationRange& range = m_ComponentRanges[rangeIndex];
+                    const SceneDecorationFlags flags = tagger.computeFlags(*range.component);
+                    for (size_t i = range.begin; i < range.end; ++i) {
+                        SceneDecoration& decoration = m_Drawlist[i];
+                        decoration.flags = decoration.flags.without(SceneDecorationFlag::AllRimHighlightGroups) | flags;
+                    }
+                }
+            }
+
+            m_PrevSelected = modelState.getSelected();
+            m_PrevHovered = modelState.getHovered();
+        }
+
         std::shared_ptr<SceneCache> m_MeshCache;
         ModelStatePairInfo m_PrevModelStateInfo;
         OpenSimDecorationOptions m_PrevDecorationOptions;
         OverlayDecorationOptions m_PrevOverlayOptions;
         std::vector<SceneDecoration> m_Drawlist;
         BVH m_BVH;
+
+        // used to move or regenerate decorations when only the state changes
+        //
+        // the component pointers (here, and below) are only valid while the model's version is
+        // unchanged, which is guaranteed, because changing the model's version triggers a full
+        // regeneration
+        std::vector<const OpenSim::Component*> m_Components;
+        std::vector<const OpenSim::Frame*> m_RigidFrames;  // per-component, `nullptr` if not rigid
+        std::vector<size_t> m_DynamicComponentIndices;
+        std::vector<RetainedDecoration> m_RetainedDecorations;  // per-decoration, excluding overlays
+
+        // used to re-tag decorations when only the selection and/or hover changes
+        std::vector<ComponentDecorationRange> m_ComponentRanges;
+        std::unordered_map<const OpenSim::Component*, std::vector<size_t>> m_RangesAffectedByComponent;
+        const OpenSim::Component* m_PrevSelected = nullptr;
+        const OpenSim::Component* m_PrevHovered = nullptr;
     };
 }
 
@@ -146,7 +411,7 @@ public:
             rendererParameters != m_PrevRendererParams)
         {
             OSC_PERF("CachedModelRenderer/on_draw/render");
-            m_Renderer.render(m_DecorationCache.getDrawlist(), rendererParameters);
+            m_Renderer.render(m_DecorationCache.getDrawlist(), rendererParameters, m_DecorationCache.getBVH());
             m_PrevRendererParams = rendererParameters;
         }
 
@@ -16,8 +16,10 @@ namespace osc
         );
 
         void operator()(const OpenSim::Component&, SceneDecoration&);
-    private:
+
+        // returns the selection-related flags (i.e. rim highlights) of the component's decorations
         SceneDecorationFlags computeFlags(const OpenSim::Component&) const;
+    private:
 
         const OpenSim::Component* m_Selected;
         const OpenSim::Component* m_Hovered;
@@ -13,6 +13,7 @@
 #include <OpenSim/Simulation/Model/GeometryPath.h>
 #include <OpenSim/Simulation/Model/HuntCrossleyForce.h>
 #include <OpenSim/Simulation/Model/Ligament.h>
+#include <OpenSim/Simulation/Model/Marker.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Muscle.h>
 #include <OpenSim/Simulation/Model/PathSpring.h>
@@ -22,6 +23,7 @@
 #include <OpenSim/Simulation/Model/Station.h>
 #include <OpenSim/Simulation/SimbodyEngine/Body.h>
 #include <OpenSim/Simulation/SimbodyEngine/ScapulothoracicJoint.h>
+#include <OpenSim/Simulation/Wrap/WrapObject.h>
 #include <oscar/Graphics/Color.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
@@ -46,10 +48,12 @@
 #include <cmath>
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -1173,50 +1177,9 @@ namespace
             rs.consume(hcf, std::move(d));
         });
     }
-}
 
-void osc::GenerateModelDecorations(
-    SceneCache& meshCache,
-    const OpenSim::Model& model,
-    const SimTK::State& state,
-    const OpenSimDecorationOptions& opts,
-    float fixupScaleFactor,
-    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out)
-{
-    GenerateSubcomponentDecorations(
-        meshCache,
-        model,
-        state,
-        model,  // i.e. the subcomponent is the root
-        opts,
-        fixupScaleFactor,
-        out,
-        false
-    );
-}
-
-void osc::GenerateSubcomponentDecorations(
-    SceneCache& meshCache,
-    const OpenSim::Model& model,
-    const SimTK::State& state,
-    const OpenSim::Component& subcomponent,
-    const OpenSimDecorationOptions& opts,
-    float fixupScaleFactor,
-    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out,
-    bool inclusiveOfProvidedSubcomponent)
-{
-    OSC_PERF("OpenSimRenderer/GenerateModelDecorations");
-
-    RendererState rendererState{
-        meshCache,
-        model,
-        state,
-        opts,
-        fixupScaleFactor,
-        out,
-    };
-
-    const auto emitDecorationsForComponent = [&](const OpenSim::Component& c)
+    // emits the decorations of one component
+    void GenerateComponentDecorations(RendererState& rendererState, const OpenSim::Component& c)
     {
         // handle OSC-specific decoration specializations, or fallback to generic
         // component decoration handling
@@ -1240,7 +1203,7 @@ void osc::GenerateSubcomponentDecorations(
         else if (const auto* const fg = dynamic_cast<const OpenSim::FrameGeometry*>(&c)) {
             HandleFrameGeometry(rendererState, *fg);
         }
-        else if (const auto* const p2p = dynamic_cast<const OpenSim::PointToPointSpring*>(&c); p2p and opts.getShouldShowPointToPointSprings()) {
+        else if (const auto* const p2p = dynamic_cast<const OpenSim::PointToPointSpring*>(&c); p2p and rendererState.getOptions().getShouldShowPointToPointSprings()) {
             GenerateBodySpatialVectorArrowDecorationsForForcesThatOnlyHaveComputeForceMethod(rendererState, *p2p);
             HandlePointToPointSpring(rendererState, *p2p);
         }
@@ -1248,7 +1211,7 @@ void osc::GenerateSubcomponentDecorations(
             // CARE: it's a typeid comparison because OpenSim::Marker inherits from OpenSim::Station
             HandleStation(rendererState, dynamic_cast<const OpenSim::Station&>(c));
         }
-        else if (const auto* const sj = dynamic_cast<const OpenSim::ScapulothoracicJoint*>(&c); sj && opts.getShouldShowScapulo()) {
+        else if (const auto* const sj = dynamic_cast<const OpenSim::ScapulothoracicJoint*>(&c); sj && rendererState.getOptions().getShouldShowScapulo()) {
             HandleScapulothoracicJoint(rendererState, *sj);
         }
         else if (const auto* const hcf = dynamic_cast<const OpenSim::HuntCrossleyForce*>(&c)) {
@@ -1273,13 +1236,112 @@ void osc::GenerateSubcomponentDecorations(
         else {
             rendererState.emitGenericDecorations(c, c);
         }
+    }
+}
+
+void osc::GenerateModelDecorations(
+    SceneCache& meshCache,
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    const OpenSimDecorationOptions& opts,
+    float fixupScaleFactor,
+    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out)
+{
+    GenerateSubcomponentDecorations(
+        meshCache,
+        model,
+        state,
+        model,  // i.e. the subcomponent is the root
+        opts,
+        fixupScaleFactor,
+        out,
+        false
+    );
+}
+
+void osc::GenerateDecorationsForComponents(
+    SceneCache& meshCache,
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    std::span<const OpenSim::Component* const> components,
+    const OpenSimDecorationOptions& opts,
+    float fixupScaleFactor,
+    const std::function<void(size_t, const OpenSim::Component&, SceneDecoration&&)>& out)
+{
+    size_t componentIndex = 0;
+    const std::function<void(const OpenSim::Component&, SceneDecoration&&)> consumer = [&componentIndex, &out](const OpenSim::Component& c, SceneDecoration&& dec)
+    {
+        out(componentIndex, c, std::move(dec));
+    };
+
+    RendererState rendererState{
+        meshCache,
+        model,
+        state,
+        opts,
+        fixupScaleFactor,
+        consumer,
+    };
+    for (; componentIndex < components.size(); ++componentIndex) {
+        GenerateComponentDecorations(rendererState, *components[componentIndex]);
+    }
+}
+
+const OpenSim::Frame* osc::FindRigidDecorationFrame(const OpenSim::Component& c)
+{
+    // CARE: this must be kept in sync with the dispatch in `GenerateComponentDecorations`
+    if (not ShouldShowInUI(c)) {
+        return nullptr;  // it doesn't generate any decorations
+    }
+    else if (dynamic_cast<const ICustomDecorationGenerator*>(&c)) {
+        return nullptr;  // it could generate anything
+    }
+    else if (dynamic_cast<const OpenSim::GeometryPath*>(&c)) {
+        return nullptr;  // paths wrap over, and between, multiple frames
+    }
+    else if (const auto* const geom = dynamic_cast<const OpenSim::Geometry*>(&c)) {
+        return &geom->getFrame();  // includes `OpenSim::FrameGeometry`
+    }
+    else if (typeid(c) == typeid(OpenSim::Station) || typeid(c) == typeid(OpenSim::Marker)) {
+        return &dynamic_cast<const OpenSim::Station&>(c).getParentFrame();
+    }
+    else if (const auto* const frame = dynamic_cast<const OpenSim::Frame*>(&c)) {
+        return frame;  // includes `OpenSim::Body` (and its center of mass)
+    }
+    else if (const auto* const wrapObject = dynamic_cast<const OpenSim::WrapObject*>(&c)) {
+        return &wrapObject->getFrame();
+    }
+    else {
+        return nullptr;  // e.g. forces, joints, and other (potentially, state-dependent) components
+    }
+}
+
+void osc::GenerateSubcomponentDecorations(
+    SceneCache& meshCache,
+    const OpenSim::Model& model,
+    const SimTK::State& state,
+    const OpenSim::Component& subcomponent,
+    const OpenSimDecorationOptions& opts,
+    float fixupScaleFactor,
+    const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out,
+    bool inclusiveOfProvidedSubcomponent)
+{
+    OSC_PERF("OpenSimRenderer/GenerateModelDecorations");
+
+    RendererState rendererState{
+        meshCache,
+        model,
+        state,
+        opts,
+        fixupScaleFactor,
+        out,
     };
 
     if (inclusiveOfProvidedSubcomponent) {
-        emitDecorationsForComponent(subcomponent);
+        GenerateComponentDecorations(rendererState, subcomponent);
     }
     for (const OpenSim::Component& c : subcomponent.getComponentList()) {
-        emitDecorationsForComponent(c);
+        GenerateComponentDecorations(rendererState, c);
     }
 }
 
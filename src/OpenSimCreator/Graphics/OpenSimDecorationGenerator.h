@@ -2,9 +2,12 @@
 
 #include <oscar/Graphics/Mesh.h>
 
+#include <cstddef>
 #include <functional>
+#include <span>
 
 namespace OpenSim { class Component; }
+namespace OpenSim { class Frame; }
 namespace OpenSim { class Mesh; }
 namespace OpenSim { class Model; }
 namespace OpenSim { class ModelDisplayHints; }
@@ -27,6 +30,31 @@ namespace osc
         const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out
     );
 
+    // generates 3D decorations for each of the given components (excluding their subcomponents)
+    // and passes each of them, tagged with the index of the component (in `components`) that
+    // generated it and its associated component, to the output consumer in the same order that
+    // `GenerateModelDecorations` would emit them
+    //
+    // note: the associated component isn't always the generating one (e.g. frame geometry is
+    //       associated with the frame that owns it)
+    void GenerateDecorationsForComponents(
+        SceneCache&,
+        const OpenSim::Model&,
+        const SimTK::State&,
+        std::span<const OpenSim::Component* const> components,
+        const OpenSimDecorationOptions&,
+        float fixupScaleFactor,
+        const std::function<void(size_t, const OpenSim::Component&, SceneDecoration&&)>& out
+    );
+
+    // returns the frame that all of the decorations generated for `component` (excluding its
+    // subcomponents) are rigidly attached to, or `nullptr` if they might move relative to every
+    // frame when the state changes (e.g. muscles, forces, joints)
+    //
+    // i.e. if the model and decoration options don't change, a non-`nullptr` frame's transform
+    // in ground is enough to recompute the decorations' transforms for a new state
+    const OpenSim::Frame* FindRigidDecorationFrame(const OpenSim::Component&);
+
     // generates 3D decorations only for `subcomponent` within the given {model, state} pair
     // and passes each of them, tagged with their associated (potentially, sub-subcomponent)
     // component to the output consumer
@@ -5,8 +5,12 @@
 #include <OpenSimCreator/Graphics/ComponentSceneDecorationFlagsTagger.h>
 #include <OpenSimCreator/Graphics/ModelRendererParams.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationGenerator.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/Model.h>
 #include <oscar/Graphics/AntiAliasingLevel.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Maths/Line.h>
@@ -14,8 +18,12 @@
 #include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
 
+#include <algorithm>
+#include <filesystem>
 #include <optional>
+#include <span>
 #include <vector>
 
 using namespace osc;
@@ -44,6 +52,14 @@ SceneRendererParams osc::CalcSceneRendererParams(
     rv.light_color = renderParams.lightColor;
     rv.background_color = renderParams.backgroundColor;
     rv.floor_location = renderParams.floorLocation;
+
+    // models can contain thousands of decorations (e.g. muscle path segments, markers), many
+    // of which are off-screen when zoomed into part of the model, and model viewers provide a
+    // scene BVH, so off-screen culling is worthwhile here
+    //
+    // (small feature culling is left disabled, because it can drop thin muscle lines and small
+    // markers, which users care about)
+    rv.cull_offscreen_decorations = true;
     return rv;
 }
 
@@ -73,6 +89,52 @@ void osc::GenerateDecorations(
     );
 }
 
+void osc::GenerateDecorationsForComponents(
+    SceneCache& meshCache,
+    const IModelStatePair& msp,
+    std::span<const OpenSim::Component* const> components,
+    const OpenSimDecorationOptions& options,
+    const std::function<void(size_t, const OpenSim::Component&, SceneDecoration&&)>& out)
+{
+    ComponentAbsPathDecorationTagger pathTagger{};
+    ComponentSceneDecorationFlagsTagger flagsTagger{msp.getSelected(), msp.getHovered()};
+
+    auto callback = [pathTagger, flagsTagger, &out](size_t componentIndex, const OpenSim::Component& component, SceneDecoration&& decoration) mutable
+    {
+        pathTagger(component, decoration);
+        flagsTagger(component, decoration);
+        out(componentIndex, component, std::move(decoration));
+    };
+
+    GenerateDecorationsForComponents(
+        meshCache,
+        msp.getModel(),
+        msp.getState(),
+        components,
+        options,
+        msp.getFixupScaleFactor(),
+        callback
+    );
+}
+
+void osc::PreloadMeshFiles(SceneCache& cache, const OpenSim::Model& model)
+{
+    OSC_PERF("PreloadMeshFiles");
+
+    // the paths must match what the model emits in its `SimTK::DecorativeMeshFile`s, so
+    // that the decoration generator's `SceneCache` lookups hit the preloaded meshes
+    std::vector<std::filesystem::path> meshFiles;
+    for (const OpenSim::Mesh& mesh : model.getComponentList<OpenSim::Mesh>()) {
+        if (auto path = FindGeometryFilePath(model, mesh)) {
+            meshFiles.push_back(std::move(*path));
+        }
+    }
+    std::sort(meshFiles.begin(), meshFiles.end());
+    meshFiles.erase(std::unique(meshFiles.begin(), meshFiles.end()), meshFiles.end());
+
+    cache.preload_mesh_files(meshFiles, LoadMesh);
+}
+
 std::optional<SceneCollision> osc::GetClosestCollision(
     const BVH& sceneBVH,
     SceneCache& sceneCache,
@@ -90,32 +152,13 @@ std::optional<SceneCollision> osc::GetClosestCollision(
         dimensions_of(viewportScreenRect)
     );
 
-    // find all collisions along the camera ray
-    const std::vector<SceneCollision> collisions = get_all_ray_collisions_with_scene(
+    // find the closest collision along the camera ray with a decoration that hasn't been
+    // filtered out (i.e. it has an ID)
+    return get_closest_ray_collision_with_scene(
         sceneBVH,
         sceneCache,
         taggedDrawlist,
-        worldspaceCameraRay
+        worldspaceCameraRay,
+        [](const SceneDecoration& decoration) { return not decoration.id.empty(); }
     );
-
-    // filter through the collisions list
-    const SceneCollision* closestCollision = nullptr;
-    for (const SceneCollision& c : collisions)
-    {
-        if (closestCollision && c.distance_from_ray_origin > closestCollision->distance_from_ray_origin)
-        {
-            continue;  // it's further away than the current closest collision
-        }
-
-        const SceneDecoration& decoration = taggedDrawlist[c.decoration_index];
-
-        if (decoration.id.empty())
-        {
-            continue;  // filtered out by external filter
-        }
-
-        closestCollision = &c;
-    }
-
-    return closestCollision ? *closestCollision : std::optional<SceneCollision>{};
 }
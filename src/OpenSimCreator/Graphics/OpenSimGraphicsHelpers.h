@@ -6,11 +6,13 @@
 #include <oscar/Maths/Rect.h>
 #include <oscar/Maths/Vec2.h>
 
+#include <cstddef>
 #include <functional>
 #include <optional>
 #include <span>
 
 namespace OpenSim { class Component; }
+namespace OpenSim { class Model; }
 namespace osc { class BVH; }
 namespace osc { class IModelStatePair; }
 namespace osc { class OpenSimDecorationOptions; }
@@ -35,6 +37,23 @@ namespace osc
         const std::function<void(const OpenSim::Component&, SceneDecoration&&)>& out
     );
 
+    // as above, but only generates the decorations of the given components (excluding their
+    // subcomponents), and also passes the index of the generating component to the output
+    void GenerateDecorationsForComponents(
+        SceneCache&,
+        const IModelStatePair&,
+        std::span<const OpenSim::Component* const>,
+        const OpenSimDecorationOptions&,
+        const std::function<void(size_t, const OpenSim::Component&, SceneDecoration&&)>& out
+    );
+
+    // finds all mesh files that are referenced by the model and concurrently loads them
+    // into the `SceneCache`, so that generating the model's decorations doesn't have to
+    // (serially) load each of them on first use
+    //
+    // blocks until all of the mesh files are loaded
+    void PreloadMeshFiles(SceneCache&, const OpenSim::Model&);
+
     std::optional<SceneCollision> GetClosestCollision(
         const BVH& sceneBVH,
         SceneCache&,
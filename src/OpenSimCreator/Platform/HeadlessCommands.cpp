@@ -0,0 +1,711 @@
+#include "HeadlessCommands.h"
+
+#include <OpenSimCreator/Documents/Landmarks/Landmark.h>
+#include <OpenSimCreator/Documents/Landmarks/LandmarkHelpers.h>
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Model/Environment.h>
+#include <OpenSimCreator/Documents/Model/MuscleMatrixService.h>
+#include <OpenSimCreator/Documents/ModelWarper/CachedModelWarper.h>
+#include <OpenSimCreator/Documents/ModelWarper/ValidationCheckState.h>
+#include <OpenSimCreator/Documents/ModelWarper/WarpableModel.h>
+#include <OpenSimCreator/Documents/Simulation/BatchSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationHelpers.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <OpenSimCreator/Documents/Simulation/StoFileSimulation.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Formats/OBJ.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Utils/EnumHelpers.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/PerfMeasurement.h>
+#include <oscar/Utils/ThreadPool.h>
+#include <oscar_simbody/LandmarkPair3D.h>
+#include <oscar_simbody/SimTKMeshLoader.h>
+#include <oscar_simbody/TPS3D.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // command-line arguments that have been parsed into positional arguments and `--option value` pairs
+    class ParsedArguments final {
+    public:
+        ParsedArguments(
+            std::span<const std::string_view> args,
+            std::span<const std::string_view> allowedOptions)
+        {
+            for (size_t i = 0; i < args.size(); ++i) {
+                if (not args[i].starts_with("--")) {
+                    m_Positional.push_back(args[i]);
+                    continue;
+                }
+                if (std::ranges::find(allowedOptions, args[i]) == allowedOptions.end()) {
+                    std::stringstream ss;
+                    ss << "unknown option: " << args[i];
+                    throw std::runtime_error{std::move(ss).str()};
+                }
+                if (i+1 >= args.size()) {
+                    std::stringstream ss;
+                    ss << args[i] << ": missing value";
+                    throw std::runtime_error{std::move(ss).str()};
+                }
+                m_Options.emplace_back(args[i], args[i+1]);
+                ++i;
+            }
+        }
+
+        std::span<const std::string_view> positional() const { return m_Positional; }
+
+        std::optional<std::string_view> find(std::string_view option) const
+        {
+            // (the last occurrence wins, like most command-line tools)
+            const auto it = std::ranges::find(m_Options.rbegin(), m_Options.rend(), option, [](const auto& p) { return p.first; });
+            return it != m_Options.rend() ? std::optional{it->second} : std::nullopt;
+        }
+
+        std::optional<double> findDouble(std::string_view option) const
+        {
+            const auto value = find(option);
+            if (not value) {
+                return std::nullopt;
+            }
+            std::istringstream ss{std::string{*value}};
+            double rv = 0.0;
+            if (not (ss >> rv) or not (ss >> std::ws).eof()) {
+                std::stringstream msg;
+                msg << option << ": cannot parse '" << *value << "' as a number";
+                throw std::runtime_error{std::move(msg).str()};
+            }
+            return rv;
+        }
+
+        std::optional<size_t> findPositiveInteger(std::string_view option) const
+        {
+            const auto value = findDouble(option);
+            if (not value) {
+                return std::nullopt;
+            }
+            if (*value < 1.0 or *value != static_cast<double>(static_cast<size_t>(*value))) {
+                std::stringstream msg;
+                msg << option << ": must be a positive integer";
+                throw std::runtime_error{std::move(msg).str()};
+            }
+            return static_cast<size_t>(*value);
+        }
+
+        size_t getNumThreads() const
+        {
+            return findPositiveInteger("--threads").value_or(ThreadPool::default_num_threads());
+        }
+
+        std::optional<std::filesystem::path> getOutputDirectory() const
+        {
+            if (const auto dir = find("--output")) {
+                return std::filesystem::path{*dir};
+            }
+            return std::nullopt;
+        }
+
+    private:
+        std::vector<std::string_view> m_Positional;
+        std::vector<std::pair<std::string_view, std::string_view>> m_Options;
+    };
+
+    // thread-safe wrapper around a command's output streams
+    class CommandOutput final {
+    public:
+        CommandOutput(std::ostream& out, std::ostream& err) :
+            m_Out{&out},
+            m_Err{&err}
+        {}
+
+        template<typename... Args>
+        void println(Args&&... args)
+        {
+            const std::lock_guard lock{m_Mutex};
+            ((*m_Out) << ... << std::forward<Args>(args)) << '\n';
+        }
+
+        template<typename... Args>
+        void printlnError(Args&&... args)
+        {
+            const std::lock_guard lock{m_Mutex};
+            ((*m_Err) << ... << std::forward<Args>(args)) << '\n';
+        }
+
+    private:
+        std::mutex m_Mutex;
+        std::ostream* m_Out;
+        std::ostream* m_Err;
+    };
+
+    // calls `f(i)` for each input in `inputs` on up to `numThreads` threads and returns the number
+    // of inputs that failed (i.e. that `f` threw an exception for, which is written to the output)
+    //
+    // `f` may be called concurrently, so commands hold a (per-command) mutex while `f` runs the
+    // steps that aren't thread-safe: loading models, or the files that they refer to (e.g. `.sto`
+    // files, or a model's meshes), via OpenSim, and copying a model that's shared between inputs.
+    // Everything else (e.g. initializing or simulating a model that only `f` has access to, or
+    // warping a standalone mesh) runs concurrently.
+    template<std::invocable<size_t> F>
+    size_t ForEachInput(
+        size_t numThreads,
+        std::span<const std::string_view> inputs,
+        CommandOutput& output,
+        const F& f)
+    {
+        std::atomic<size_t> numFailed = 0;
+        const auto runInput = [&](size_t i)
+        {
+            try {
+                f(i);
+            }
+            catch (const std::exception& ex) {
+                output.printlnError(inputs[i], ": error: ", ex.what());
+                ++numFailed;
+            }
+        };
+
+        if (numThreads <= 1 or inputs.size() <= 1) {
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                runInput(i);
+            }
+        }
+        else {
+            // run at most `numThreads` lanes concurrently, where each lane claims the next
+            // unprocessed input until there are none left (so that slow inputs don't hold
+            // up a lane's other inputs)
+            //
+            // the lanes run for the whole command, so they're ran on a pool that's owned by
+            // this call, rather than on the global thread pool, which is left free for the
+            // short tasks that an input's processing may spawn (e.g. parallel mesh warping)
+            std::atomic<size_t> nextInput = 0;
+            const size_t numLanes = std::min(numThreads, inputs.size());
+            ThreadPool pool{numLanes};
+            std::vector<std::future<void>> lanes;
+            lanes.reserve(numLanes);
+            for (size_t lane = 0; lane < numLanes; ++lane) {
+                lanes.push_back(pool.submit([&nextInput, &inputs, &runInput]()
+                {
+                    for (size_t i = nextInput++; i < inputs.size(); i = nextInput++) {
+                        runInput(i);
+                    }
+                }));
+            }
+            for (std::future<void>& lane : lanes) {
+                lane.get();
+            }
+        }
+        return numFailed;
+    }
+
+    std::filesystem::path GetOutputPath(
+        const std::optional<std::filesystem::path>& outputDirectory,
+        const std::filesystem::path& inputPath,
+        std::string_view suffix)
+    {
+        const std::filesystem::path directory = outputDirectory ? *outputDirectory : inputPath.parent_path();
+        if (not directory.empty()) {
+            std::filesystem::create_directories(directory);
+        }
+        return directory / (inputPath.stem().string() + std::string{suffix});
+    }
+
+    std::ofstream OpenOutputFile(const std::filesystem::path& path, std::ios::openmode mode = {})
+    {
+        std::ofstream rv{path, mode | std::ios::trunc};
+        if (not rv) {
+            std::stringstream ss;
+            ss << path.string() << ": cannot open for writing";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        return rv;
+    }
+
+    std::ifstream OpenInputFile(const std::filesystem::path& path)
+    {
+        std::ifstream rv{path};
+        if (not rv) {
+            std::stringstream ss;
+            ss << path.string() << ": cannot open for reading";
+            throw std::runtime_error{std::move(ss).str()};
+        }
+        return rv;
+    }
+
+    void PrintThroughput(CommandOutput& output, SimulationClock::duration simulatedTime, std::chrono::duration<double> wallTime)
+    {
+        const double throughput = wallTime.count() > 0.0 ? simulatedTime.count() / wallTime.count() : 0.0;
+        output.println("simulated time: ", simulatedTime.count(), " s");
+        output.println("throughput: ", throughput, " sim-seconds per wall-second");
+    }
+
+    // `osc simulate`
+    int RunSimulate(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().empty()) {
+            throw std::runtime_error{"no models provided"};
+        }
+
+        ForwardDynamicSimulatorParams params;
+        if (const auto finalTime = args.findDouble("--final-time")) {
+            params.finalTime = SimulationClock::start() + SimulationClock::duration{*finalTime};
+        }
+        const auto outputDirectory = args.getOutputDirectory();
+
+        std::mutex mutex;
+        SimulationClock::duration totalSimulatedTime{0.0};
+        std::mutex modelLoadingMutex;
+
+        const auto tStart = std::chrono::high_resolution_clock::now();
+        const size_t numFailed = ForEachInput(args.getNumThreads(), args.positional(), output, [&](size_t i)
+        {
+            const std::filesystem::path modelPath{args.positional()[i]};
+
+            // models are loaded one-at-a-time (see `ForEachInput`), and then each simulation
+            // runs on its own copy of its model
+            std::optional<BasicModelStatePair> model;
+            {
+                const std::lock_guard lock{modelLoadingMutex};
+                model.emplace(modelPath);
+            }
+
+            BatchSimulationParams batchParams;
+            if (outputDirectory) {
+                batchParams.outputDirectory = *outputDirectory / modelPath.stem();
+            }
+            const auto points = std::to_array({BatchSimulationPoint{.params = params}});
+            const BatchSimulationSummary summary = RunBatchSimulation(*model, points, batchParams);
+            if (summary.numFailed > 0) {
+                throw std::runtime_error{"the simulation failed (see log for details)"};
+            }
+
+            output.println(modelPath.string(), ": simulated ", summary.simulatedTime.count(), " s in ", summary.wallTime.count(), " s");
+            const std::lock_guard lock{mutex};
+            totalSimulatedTime += summary.simulatedTime;
+        });
+        PrintThroughput(output, totalSimulatedTime, std::chrono::high_resolution_clock::now() - tStart);
+
+        return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // `osc batch-fd`
+    int RunBatchFd(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().size() != 2) {
+            throw std::runtime_error{"expected exactly two arguments: MODEL.osim SWEEP.csv"};
+        }
+
+        BatchSimulationParams params;
+        params.numThreads = args.getNumThreads();
+        params.outputDirectory = args.getOutputDirectory();
+
+        const BasicModelStatePair model{std::filesystem::path{args.positional()[0]}};
+        std::ifstream sweepFile = OpenInputFile(std::filesystem::path{args.positional()[1]});
+        const std::vector<BatchSimulationPoint> points = ReadBatchSimulationPointsCSV(sweepFile);
+
+        output.println("running ", points.size(), " simulations on ", params.numThreads, " threads");
+        const BatchSimulationSummary summary = RunBatchSimulation(model, points, params, [&output, &points](const BatchSimulationPointResult& result)
+        {
+            output.println(
+                "point ", result.pointIndex, '/', points.size(), ": ",
+                GetAllSimulationStatusStrings()[static_cast<size_t>(result.status)], " (",
+                result.simulatedTime.count(), " sim-seconds in ", result.wallTime.count(), " wall-seconds)"
+            );
+        });
+
+        output.println("completed: ", summary.numCompleted, '/', summary.numPoints);
+        output.println("failed: ", summary.numFailed);
+        PrintThroughput(output, summary.simulatedTime, summary.wallTime);
+
+        return summary.numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // `osc warp-model`
+    int RunWarpModel(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().empty()) {
+            throw std::runtime_error{"no models provided"};
+        }
+        const auto outputDirectory = args.getOutputDirectory();
+        std::mutex modelLoadingMutex;
+
+        const size_t numFailed = ForEachInput(args.getNumThreads(), args.positional(), output, [&](size_t i)
+        {
+            const std::filesystem::path modelPath{args.positional()[i]};
+
+            // models (and their warp configurations) are loaded, and warped, one-at-a-time (see
+            // `ForEachInput`), because warping loads each of the model's meshes via OpenSim and
+            // writes the warped meshes to disk (which may be shared between models), so only
+            // writing the warped model runs concurrently
+            std::shared_ptr<const IModelStatePair> warped;
+            {
+                const std::lock_guard lock{modelLoadingMutex};
+
+                mow::WarpableModel document{modelPath};
+                document.setShouldWriteWarpedMeshesToDisk(true);
+                if (document.state() == mow::ValidationCheckState::Error) {
+                    throw std::runtime_error{"the model cannot be warped: it has validation errors (open it in the model warper UI for details)"};
+                }
+
+                mow::CachedModelWarper warper;
+                warped = warper.warp(document);
+            }
+            if (not warped) {
+                throw std::runtime_error{"the model could not be warped (see log for details)"};
+            }
+
+            const std::filesystem::path outputPath = GetOutputPath(outputDirectory, modelPath, "_warped.osim");
+            warped->getModel().print(outputPath.string());
+            output.println(modelPath.string(), ": wrote ", outputPath.string());
+        });
+
+        return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::vector<lm::Landmark> ReadLandmarks(const std::filesystem::path& path)
+    {
+        std::ifstream in = OpenInputFile(path);
+        std::vector<lm::Landmark> rv;
+        lm::ReadLandmarksFromCSV(in, [&rv](lm::Landmark&& landmark) { rv.push_back(std::move(landmark)); });
+        return rv;
+    }
+
+    // pairs landmarks with the same name (unnamed landmarks are paired in the order that they appear)
+    std::vector<LandmarkPair3D> PairLandmarks(std::span<const lm::Landmark> sources, std::vector<lm::Landmark> destinations)
+    {
+        std::vector<LandmarkPair3D> rv;
+        rv.reserve(sources.size());
+        for (const lm::Landmark& source : sources) {
+            const auto it = std::ranges::find(destinations, source.maybeName, &lm::Landmark::maybeName);
+            if (it != destinations.end()) {
+                rv.push_back({source.position, it->position});
+                destinations.erase(it);
+            }
+        }
+        return rv;
+    }
+
+    // `osc warp-mesh`
+    int RunWarpMesh(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().size() < 3) {
+            throw std::runtime_error{"expected at least three arguments: SOURCE_LANDMARKS.csv DESTINATION_LANDMARKS.csv MESH..."};
+        }
+        const auto blendingFactor = static_cast<float>(args.findDouble("--blending-factor").value_or(1.0));
+        const auto maxApproximationError = static_cast<float>(args.findDouble("--approximation-error").value_or(0.0));
+        const auto outputDirectory = args.getOutputDirectory();
+
+        const std::vector<lm::Landmark> sources = ReadLandmarks(std::filesystem::path{args.positional()[0]});
+        const std::vector<LandmarkPair3D> pairs = PairLandmarks(sources, ReadLandmarks(std::filesystem::path{args.positional()[1]}));
+        output.println("paired ", pairs.size(), " landmarks");
+        const TPSCoefficients3D coefficients = CalcCoefficients(TPSCoefficientSolverInputs3D{pairs});
+
+        const auto meshPaths = args.positional().subspan(2);
+        const size_t numFailed = ForEachInput(args.getNumThreads(), meshPaths, output, [&](size_t i)
+        {
+            const std::filesystem::path meshPath{meshPaths[i]};
+
+            Mesh warped = ApplyThinPlateWarpToMeshVertices(coefficients, LoadMesh(meshPath), blendingFactor, maxApproximationError);
+            warped.recalculate_normals();
+
+            const std::filesystem::path outputPath = GetOutputPath(outputDirectory, meshPath, "_warped.obj");
+            std::ofstream out = OpenOutputFile(outputPath);
+            write_as_obj(out, warped, ObjMetadata{"osc warp-mesh"});
+            output.println(meshPath.string(), ": wrote ", outputPath.string());
+        });
+
+        return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // `osc load-sto`
+    int RunLoadSto(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().size() < 2) {
+            throw std::runtime_error{"expected at least two arguments: MODEL.osim STO..."};
+        }
+        const auto outputDirectory = args.getOutputDirectory();
+
+        const BasicModelStatePair model{std::filesystem::path{args.positional()[0]}};
+        std::mutex modelMutex;
+
+        const auto stoPaths = args.positional().subspan(1);
+        const size_t numFailed = ForEachInput(args.getNumThreads(), stoPaths, output, [&](size_t i)
+        {
+            const std::filesystem::path stoPath{stoPaths[i]};
+
+            // each `.sto` file is loaded against its own copy of the (shared) model. Copying the
+            // model and loading the file happen one-at-a-time (see `ForEachInput`)
+            std::unique_ptr<OpenSim::Model> modelCopy;
+            {
+                const std::lock_guard lock{modelMutex};
+                modelCopy = std::make_unique<OpenSim::Model>(model.getModel());
+            }
+            InitializeModel(*modelCopy);
+            InitializeState(*modelCopy);
+
+            std::optional<StoFileSimulation> simulation;
+            {
+                const std::lock_guard lock{modelMutex};
+                simulation.emplace(std::move(modelCopy), stoPath, 1.0f, std::make_shared<Environment>());
+            }
+            output.println(stoPath.string(), ": loaded ", simulation->getNumReports(), " states");
+
+            if (outputDirectory) {
+                const std::filesystem::path outputPath = GetOutputPath(outputDirectory, stoPath, ".csv");
+                std::ofstream out = OpenOutputFile(outputPath);
+                const std::vector<SimulationReport> reports = simulation->getAllSimulationReports();
+                WriteOutputsAsCSV(*simulation->getModel(), simulation->getOutputExtractors(), reports, out);
+                output.println(stoPath.string(), ": wrote ", outputPath.string());
+            }
+        });
+
+        return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    MuscleMatrixQuantity ParseMuscleMatrixQuantity(std::string_view label)
+    {
+        for (const MuscleMatrixQuantity quantity : make_option_iterable<MuscleMatrixQuantity>()) {
+            if (std::string_view{GetLabel(quantity)} == label) {
+                return quantity;
+            }
+        }
+        std::stringstream ss;
+        ss << "--quantity: unknown quantity '" << label << "' (expected moment_arm, fiber_length, or tendon_length)";
+        throw std::runtime_error{std::move(ss).str()};
+    }
+
+    // `osc muscle-matrix`
+    int RunMuscleMatrix(const ParsedArguments& args, CommandOutput& output)
+    {
+        if (args.positional().empty()) {
+            throw std::runtime_error{"no models provided"};
+        }
+
+        MuscleMatrixParams params;
+        if (const auto quantity = args.find("--quantity")) {
+            params.quantity = ParseMuscleMatrixQuantity(*quantity);
+        }
+        params.numDataPoints = args.findPositiveInteger("--data-points").value_or(params.numDataPoints);
+        params.numThreads = args.getNumThreads();
+        const std::string_view format = args.find("--format").value_or("csv");
+        if (format != "csv" and format != "binary") {
+            throw std::runtime_error{"--format: must be csv or binary"};
+        }
+        const auto outputDirectory = args.getOutputDirectory();
+        const std::string suffix = "_" + std::string{GetLabel(params.quantity)} + (format == "csv" ? ".csv" : ".bin");
+
+        // each matrix is already split across `--threads` threads (owned by its task), so the
+        // models are processed one-at-a-time
+        MuscleMatrixService service;
+        const size_t numFailed = ForEachInput(1, args.positional(), output, [&](size_t i)
+        {
+            const std::filesystem::path modelPath{args.positional()[i]};
+            const BasicModelStatePair model{modelPath};
+
+            const std::shared_ptr<MuscleMatrixTask> task = service.request(model, params);
+            task->wait();
+            const std::shared_ptr<const MuscleMatrix> matrix = task->getResult();
+            if (not matrix) {
+                throw std::runtime_error{task->getErrorMessage().value_or("the muscle matrix could not be computed (see log for details)")};
+            }
+
+            const std::filesystem::path outputPath = GetOutputPath(outputDirectory, modelPath, suffix);
+            if (format == "csv") {
+                std::ofstream out = OpenOutputFile(outputPath);
+                WriteMuscleMatrixAsCSV(out, *matrix);
+            }
+            else {
+                std::ofstream out = OpenOutputFile(outputPath, std::ios::binary);
+                WriteMuscleMatrixAsBinary(out, *matrix);
+            }
+            output.println(
+                modelPath.string(), ": wrote a ", matrix->musclePaths.size(), " muscle x ",
+                matrix->coordinatePaths.size(), " coordinate matrix to ", outputPath.string()
+            );
+        });
+
+        return numFailed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    struct HeadlessCommand final {
+        std::string_view name;
+        std::string_view synopsis;
+        std::string_view description;
+        std::span<const std::string_view> options;
+        int(*run)(const ParsedArguments&, CommandOutput&);
+    };
+
+    constexpr auto c_SimulateOptions = std::to_array<std::string_view>({"--final-time", "--threads", "--output"});
+    constexpr auto c_BatchFdOptions = std::to_array<std::string_view>({"--threads", "--output"});
+    constexpr auto c_WarpModelOptions = std::to_array<std::string_view>({"--threads", "--output"});
+    constexpr auto c_WarpMeshOptions = std::to_array<std::string_view>({"--blending-factor", "--approximation-error", "--threads", "--output"});
+    constexpr auto c_LoadStoOptions = std::to_array<std::string_view>({"--threads", "--output"});
+    constexpr auto c_MuscleMatrixOptions = std::to_array<std::string_view>({"--quantity", "--data-points", "--format", "--threads", "--output"});
+
+    constexpr auto c_HeadlessCommands = std::to_array<HeadlessCommand>({
+        {
+            "simulate",
+            "simulate [--final-time T] [--threads N] [--output DIR] MODEL.osim...",
+            "Runs a forward-dynamic simulation of each model (concurrently, on N threads) and prints the\n"
+            "aggregate throughput. If --output is provided, each model's states are streamed to\n"
+            "DIR/MODEL/point_0.csv.",
+            c_SimulateOptions,
+            RunSimulate,
+        },
+        {
+            "batch-fd",
+            "batch-fd [--threads N] [--output DIR] MODEL.osim SWEEP.csv",
+            "Runs one forward-dynamic simulation of the model per row of SWEEP.csv and prints the\n"
+            "aggregate throughput. SWEEP.csv's header may contain final_time, reporting_interval,\n"
+            "integrator_step_limit, integrator_minimum_step_size, integrator_maximum_step_size, and\n"
+            "integrator_accuracy columns; all other columns are coordinate names that are set on each\n"
+            "simulation's initial state. If --output is provided, each simulation's states are streamed\n"
+            "to DIR/point_N.csv.",
+            c_BatchFdOptions,
+            RunBatchFd,
+        },
+        {
+            "warp-model",
+            "warp-model [--threads N] [--output DIR] MODEL.osim...",
+            "Warps each model with its model warper configuration (i.e. the landmark files next to the\n"
+            "model's meshes) and writes the warped model to DIR/MODEL_warped.osim (default: next to the\n"
+            "model). Warped meshes are written to the model's warped meshes directory.",
+            c_WarpModelOptions,
+            RunWarpModel,
+        },
+        {
+            "warp-mesh",
+            "warp-mesh [--blending-factor F] [--approximation-error E] [--threads N] [--output DIR] SOURCE_LANDMARKS.csv DESTINATION_LANDMARKS.csv MESH...",
+            "Computes a thin-plate spline (TPS) warp from the landmark pairs (paired by name) and\n"
+            "applies it to each mesh, writing the result to DIR/MESH_warped.obj (default: next to the\n"
+            "mesh).",
+            c_WarpMeshOptions,
+            RunWarpMesh,
+        },
+        {
+            "load-sto",
+            "load-sto [--threads N] [--output DIR] MODEL.osim STO...",
+            "Loads each .sto file as a simulation of the model. If --output is provided, the\n"
+            "simulation's outputs are written to DIR/STO.csv.",
+            c_LoadStoOptions,
+            RunLoadSto,
+        },
+        {
+            "muscle-matrix",
+            "muscle-matrix [--quantity Q] [--data-points M] [--format csv|binary] [--threads N] [--output DIR] MODEL.osim...",
+            "Computes each model's muscle matrix, which is the value of Q (moment_arm (default),\n"
+            "fiber_length, or tendon_length) for every muscle as every coordinate is swept over M\n"
+            "(default: 32) values in its range. Each matrix is computed on N threads and written to\n"
+            "DIR/MODEL_Q.csv, or DIR/MODEL_Q.bin for the binary format (default: next to the model).",
+            c_MuscleMatrixOptions,
+            RunMuscleMatrix,
+        },
+    });
+
+    const HeadlessCommand* FindHeadlessCommand(std::string_view name)
+    {
+        const auto it = std::ranges::find(c_HeadlessCommands, name, &HeadlessCommand::name);
+        return it != c_HeadlessCommands.end() ? &(*it) : nullptr;
+    }
+
+    void WritePerfSummary(std::ostream& out, std::chrono::duration<double> wallTime)
+    {
+        std::vector<PerfMeasurement> measurements = get_all_perf_measurements();
+        std::erase_if(measurements, [](const PerfMeasurement& m) { return m.call_count() == 0; });
+        std::ranges::sort(measurements, std::greater{}, [](const PerfMeasurement& m) { return m.total_duration(); });
+
+        using Millis = std::chrono::duration<double, std::milli>;
+        out << "\ntiming summary (" << wallTime.count() << " s wall time):\n";
+        if (measurements.empty()) {
+            out << "    (no OSC_PERF measurements were recorded)\n";
+        }
+        for (const PerfMeasurement& m : measurements) {
+            out << "    " << m.label() << ": "
+                << m.call_count() << " calls, "
+                << std::chrono::duration_cast<Millis>(m.total_duration()).count() << " ms total, "
+                << std::chrono::duration_cast<Millis>(m.average_duration()).count() << " ms mean\n";
+        }
+    }
+}
+
+bool osc::IsHeadlessCommand(std::string_view name)
+{
+    return FindHeadlessCommand(name) != nullptr;
+}
+
+int osc::RunHeadlessCommand(
+    std::span<const std::string_view> args,
+    std::ostream& out,
+    std::ostream& err)
+{
+    if (args.empty()) {
+        err << "osc: no headless command provided\n";
+        return EXIT_FAILURE;
+    }
+    const HeadlessCommand* command = FindHeadlessCommand(args.front());
+    if (not command) {
+        err << "osc: " << args.front() << ": unknown headless command\n";
+        return EXIT_FAILURE;
+    }
+
+    CommandOutput output{out, err};
+    try {
+        const ParsedArguments parsed{args.subspan(1), command->options};
+
+        GloballyInitOpenSim();
+        clear_all_perf_measurements();
+
+        const auto tStart = std::chrono::high_resolution_clock::now();
+        const int rv = command->run(parsed, output);
+        WritePerfSummary(out, std::chrono::high_resolution_clock::now() - tStart);
+        return rv;
+    }
+    catch (const std::exception& ex) {
+        err << "osc " << command->name << ": error: " << ex.what() << '\n'
+            << "usage: osc " << command->synopsis << '\n';
+        return EXIT_FAILURE;
+    }
+}
+
+void osc::WriteHeadlessCommandsHelp(std::ostream& out)
+{
+    for (const HeadlessCommand& command : c_HeadlessCommands) {
+        out << "    " << command.synopsis << '\n';
+        std::istringstream description{std::string{command.description}};
+        for (std::string line; std::getline(description, line);) {
+            out << "        " << line << '\n';
+        }
+        out << '\n';
+    }
+}
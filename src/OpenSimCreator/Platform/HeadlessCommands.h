@@ -0,0 +1,29 @@
+#pragma once
+
+#include <iosfwd>
+#include <span>
+#include <string_view>
+
+namespace osc
+{
+    // headless commands are subcommands of the `osc` executable (e.g. `osc simulate MODEL.osim`) that
+    // run one of OpenSim Creator's pipelines (e.g. forward-dynamic simulation, model warping) without
+    // creating a window or graphics context, so that they can be ran on (e.g.) compute nodes
+
+    // returns `true` if `name` is the name of a headless command
+    bool IsHeadlessCommand(std::string_view name);
+
+    // runs the headless command named by the first element of `args` with the remaining elements
+    // as its arguments, and returns the process exit code (e.g. `EXIT_SUCCESS`)
+    //
+    // progress, results, and a timing summary (from `OSC_PERF` measurements) are written to `out`,
+    // whereas errors are written to `err`
+    int RunHeadlessCommand(
+        std::span<const std::string_view> args,
+        std::ostream& out,
+        std::ostream& err
+    );
+
+    // writes a human-readable description of each headless command to the output stream
+    void WriteHeadlessCommandsHelp(std::ostream&);
+}
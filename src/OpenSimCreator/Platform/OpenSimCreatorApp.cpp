@@ -16,6 +16,8 @@
 #include <OpenSim/Simulation/Model/ModelVisualizer.h>
 #include <OpenSim/Tools/RegisterTypes_osimTools.h>
 #include <OpenSimThirdPartyPlugins/RegisterTypes_osimPlugin.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Platform/App.h>
 #include <oscar/Platform/AppMetadata.h>
 #include <oscar/Platform/AppSettings.h>
@@ -215,6 +217,17 @@ namespace
         RegisterOscarSimbodyTabs(registry);
     }
 
+    // if enabled in the application's settings, makes the global `SceneCache` use an
+    // on-disk cache of decoded mesh files, which makes subsequent model loads faster
+    void InitializeMeshDiskCacheIfEnabled(App& app)
+    {
+        if (auto v = app.get_config().find_value("experimental_feature_flags/mesh_disk_cache"); v and *v) {
+            const std::filesystem::path cache_dir = app.user_data_directory() / "cache" / "meshes";
+            log_info("enabling on-disk mesh cache: %s", cache_dir.string().c_str());
+            App::singleton<SceneCache>(App::resource_loader())->set_mesh_disk_cache(std::make_shared<MeshDiskCache>(cache_dir));
+        }
+    }
+
     void InitializeOpenSimCreatorSpecificSettingDefaults(AppSettings& settings)
     {
         for (const auto& [setting_id, default_state] : c_default_panel_states) {
@@ -251,6 +264,7 @@ osc::OpenSimCreatorApp::OpenSimCreatorApp(const AppMetadata& metadata) :
     GloballyAddDirectoryToOpenSimGeometrySearchPath(resource_filepath("geometry"));
     InitializeTabRegistry(*singleton<TabRegistry>());
     InitializeOpenSimCreatorSpecificSettingDefaults(upd_settings());
+    InitializeMeshDiskCacheIfEnabled(*this);
     g_opensimcreator_app_global = this;
 }
 
@@ -1,10 +1,12 @@
 #include "LoadingTab.h"
 
 #include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <OpenSimCreator/Graphics/OpenSimGraphicsHelpers.h>
 #include <OpenSimCreator/Platform/RecentFiles.h>
 #include <OpenSimCreator/UI/ModelEditor/ModelEditorTab.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 
+#include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Rect.h>
 #include <oscar/Maths/Vec2.h>
@@ -30,7 +32,13 @@ namespace
 {
     std::unique_ptr<UndoableModelStatePair> LoadOsimIntoUndoableModel(const std::filesystem::path& p)
     {
-        return std::make_unique<UndoableModelStatePair>(p);
+        auto rv = std::make_unique<UndoableModelStatePair>(p);
+
+        // load the model's meshes concurrently while still on the loading thread, so that
+        // the model editor doesn't have to load them one-by-one when it first renders
+        PreloadMeshFiles(*App::singleton<SceneCache>(App::resource_loader()), rv->getModel());
+
+        return rv;
     }
 }
 
@@ -27,6 +27,7 @@
 #include <oscar/Graphics/Scene/SceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
 #include <oscar/Maths/Angle.h>
+#include <oscar/Maths/BVH.h>
 #include <oscar/Maths/CollisionTests.h>
 #include <oscar/Maths/Line.h>
 #include <oscar/Maths/MathHelpers.h>
@@ -605,12 +606,12 @@ namespace osc::mi
                     continue;
                 }
 
-                const std::optional<RayCollision> rc = get_closest_worldspace_ray_triangle_collision(
-                    drawable.mesh,
-                    cache->get_bvh(drawable.mesh),
-                    drawable.transform,
-                    ray
-                );
+                // if the mesh's BVH is still being built in the background, fall back
+                // to hit-testing its bounds, rather than blocking the UI
+                const BVH* bvh = cache->try_get_bvh(drawable.mesh);
+                const std::optional<RayCollision> rc = bvh ?
+                    get_closest_worldspace_ray_triangle_collision(drawable.mesh, *bvh, drawable.transform, ray) :
+                    find_collision(ray, calcBounds(drawable));
 
                 if (rc && rc->distance < closestDist)
                 {
@@ -1,6 +1,7 @@
 #include "ModelMusclePlotPanel.h"
 
 #include <OpenSimCreator/Documents/Model/ModelStateCommit.h>
+#include <OpenSimCreator/Documents/Model/MuscleCurveSampling.h>
 #include <OpenSimCreator/Documents/Model/UndoableModelActions.h>
 #include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
 #include <OpenSimCreator/Platform/OSCColors.h>
@@ -33,12 +34,14 @@
 #include <oscar/Utils/StringHelpers.h>
 #include <oscar/Utils/SynchronizedValue.h>
 #include <oscar/Utils/SynchronizedValueGuard.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <compare>
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <memory>
@@ -110,21 +113,6 @@ namespace
         double(*m_Getter)(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate& c);
     };
 
-    double GetMomentArm(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate& c)
-    {
-        return muscle.getGeometryPath().computeMomentArm(st, c);
-    }
-
-    double GetFiberLength(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate&)
-    {
-        return muscle.getFiberLength(st);
-    }
-
-    double GetTendonLength(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate&)
-    {
-        return muscle.getTendonLength(st);
-    }
-
     double GetPennationAngle(const SimTK::State& st, const OpenSim::Muscle& muscle, const OpenSim::Coordinate&)
     {
         return Degreesd{Radiansd{muscle.getPennationAngle(st)}}.count();
@@ -347,14 +335,6 @@ namespace
         return c.getRangeMax();
     }
 
-    double GetStepBetweenXValues(const PlotParameters& p, const OpenSim::Coordinate& c)
-    {
-        double start = GetFirstXValue(p, c);
-        double end = GetLastXValue(p, c);
-
-        return (end - start) / max(1, p.getNumRequestedDataPoints() - 1);
-    }
-
     using PlotDataPoint = Vec2;
 
     // virtual interface to a thing that can receive datapoints from a plotter
@@ -433,7 +413,6 @@ namespace
     // this is the function that actually does the "work" of computing plot points
     PlottingTaskStatus ComputePlotPointsUnguarded(const cpp20::stop_token& stopToken, PlottingTaskInputs& inputs)
     {
-        PlottingTaskThreadsafeSharedData& shared = *inputs.shared;
         const PlotParameters& params = inputs.plotParameters;
         PlotDataPointConsumer& callback = *inputs.dataPointConsumer;
 
@@ -442,107 +421,33 @@ namespace
             return PlottingTaskStatus::Finished;
         }
 
-        // create a local copy of the model
-        std::unique_ptr<OpenSim::Model> model = std::make_unique<OpenSim::Model>(*params.getCommit().getModel());
-
-        if (stopToken.stop_requested())
-        {
-            return PlottingTaskStatus::Cancelled;
-        }
-
-        // init the model + state
-
-        InitializeModel(*model);
-
-        if (stopToken.stop_requested())
-        {
-            return PlottingTaskStatus::Cancelled;
-        }
-
-        SimTK::State& state = InitializeState(*model);
+        // take a local copy of the model, so that the commit isn't locked while sampling
+        const auto model = std::make_unique<OpenSim::Model>(*params.getCommit().getModel());
 
         if (stopToken.stop_requested())
         {
             return PlottingTaskStatus::Cancelled;
         }
 
-        const auto* maybeMuscle = FindComponent<OpenSim::Muscle>(*model, params.getMusclePath());
-        if (!maybeMuscle)
-        {
-            shared.setErrorMessage(params.getMusclePath().toString() + ": cannot find a muscle with this name");
-            return PlottingTaskStatus::Error;
-        }
-        const OpenSim::Muscle& muscle = *maybeMuscle;
-
-        const OpenSim::Coordinate* maybeCoord = FindComponentMut<OpenSim::Coordinate>(*model, params.getCoordinatePath());
-        if (!maybeCoord)
-        {
-            shared.setErrorMessage(params.getCoordinatePath().toString() + ": cannot find a coordinate with this name");
-            return PlottingTaskStatus::Error;
-        }
-        const OpenSim::Coordinate& coord = *maybeCoord;
-
-        const int numDataPoints = params.getNumRequestedDataPoints();
-        const double firstXValue = GetFirstXValue(params, coord);
-        const double lastXValue = GetLastXValue(params, coord);
-        const double stepBetweenXValues = GetStepBetweenXValues(params, coord);
-
-        if (firstXValue > lastXValue)
-        {
-            // this invariant is necessary because other algorithms assume X increases over
-            // the datapoint collection (e.g. for optimized binary searches, lower_bound etc.)
-
-            shared.setErrorMessage(params.getCoordinatePath().toString() + ": cannot plot a coordinate with reversed min/max");
-            return PlottingTaskStatus::Error;
-        }
-
-        // this fixes an unusual bug (#352), where the underlying assembly solver in the
-        // model ends up retaining invalid values across a coordinate (un)lock, which makes
-        // it sets coordinate values from X (what we want) to 0 after model assembly
-        //
-        // I don't exactly know *why* it's doing it - it looks like OpenSim holds a solver
-        // internally that, itself, retains invalid coordinate values or something
-        //
-        // see #352 for a lengthier explanation
-        coord.setLocked(state, false);
-        model->updateAssemblyConditions(state);
-
-        if (stopToken.stop_requested())
-        {
-            return PlottingTaskStatus::Cancelled;
-        }
-
-        for (int i = 0; i < numDataPoints; ++i)
-        {
-            if (stopToken.stop_requested())
-            {
-                return PlottingTaskStatus::Cancelled;
-            }
-
-            double xVal = firstXValue + (i * stepBetweenXValues);
-            coord.setValue(state, xVal);
-
-            model->equilibrateMuscles(state);
-
-            if (stopToken.stop_requested())
-            {
-                return PlottingTaskStatus::Cancelled;
-            }
-
-            model->realizeReport(state);
-
-            if (stopToken.stop_requested())
-            {
-                return PlottingTaskStatus::Cancelled;
-            }
-
-            const float xDisplayVal = ConvertCoordValueToDisplayValue(coord, xVal);
-            const auto yVal = static_cast<float>(params.getPlottedOutput()(state, muscle, coord));
-
-            callback(PlotDataPoint{xDisplayVal, yVal});
-        }
+        const MuscleCurveRequest request{
+            .coordinatePath = params.getCoordinatePath(),
+            .musclePath = params.getMusclePath(),
+            .output = params.getPlottedOutput(),
+        };
+        const MuscleCurveSamplingParams samplingParams{
+            .numDataPoints = static_cast<size_t>(params.getNumRequestedDataPoints()),
+            // the sampler owns its threads, so leave a core for the UI thread
+            .numThreads = std::max<size_t>(ThreadPool::default_num_threads() - 1, 1),
+        };
+        const bool finished = SampleMuscleCurves(
+            *model,
+            {&request, 1},
+            samplingParams,
+            [&callback](size_t, PlotDataPoint p) { callback(p); },
+            stopToken
+        );
 
-        return PlottingTaskStatus::Finished;
+        return finished ? PlottingTaskStatus::Finished : PlottingTaskStatus::Cancelled;
     }
 
     // top-level "main" function that the Plotting task worker thread executes
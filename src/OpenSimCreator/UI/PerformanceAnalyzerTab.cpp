@@ -6,6 +6,7 @@
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulator.h>
 #include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
 #include <OpenSimCreator/Documents/Simulation/IntegratorMethod.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
 #include <OpenSimCreator/UI/Shared/ParamBlockEditorPopup.h>
 #include <OpenSimCreator/Utils/ParamBlock.h>
@@ -20,6 +21,7 @@
 #include <oscar/Utils/Algorithms.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <filesystem>
 #include <optional>
 #include <ostream>
@@ -92,14 +94,17 @@ public:
             ui::table_headers_row();
 
             for (const ForwardDynamicSimulation& sim : m_Sims) {
-                auto reports = sim.getAllSimulationReports();
-                if (reports.empty()) {
+                // only the latest report is needed (fetching every report would rebuild
+                // the whole trajectory each frame)
+                const size_t numReports = sim.getNumReports();
+                if (numReports == 0) {
                     continue;
                 }
+                const SimulationReport latestReport = sim.getSimulationReport(static_cast<ptrdiff_t>(numReports - 1));
 
                 IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
-                float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-                float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
+                float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), latestReport);
+                float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), latestReport);
 
                 ui::table_next_row();
                 int column = 0;
@@ -149,14 +154,15 @@ private:
         fout << "Integrator,Wall Time (sec),NumStepsTaken\n";
 
         for (const ForwardDynamicSimulation& sim : m_Sims) {
-            auto reports = sim.getAllSimulationReports();
-            if (reports.empty()) {
+            const size_t numReports = sim.getNumReports();
+            if (numReports == 0) {
                 continue;
             }
+            const SimulationReport latestReport = sim.getSimulationReport(static_cast<ptrdiff_t>(numReports - 1));
 
             IntegratorMethod m = std::get<IntegratorMethod>(sim.getParams().findValue("Integrator Method").value());
-            float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), reports.back());
-            float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), reports.back());
+            float t = m_WalltimeExtractor.getValueFloat(*sim.getModel(), latestReport);
+            float steps = m_StepsTakenExtractor.getValueFloat(*sim.getModel(), latestReport);
 
             fout << m.label() << ',' << t << ',' << steps << '\n';
         }
@@ -13,6 +13,7 @@
 #include <vector>
 
 namespace osc { class OutputExtractor; }
+namespace osc { class OutputValueCache; }
 namespace osc { class SimulationModelStatePair; }
 namespace osc { class ISimulation; }
 
@@ -61,6 +62,9 @@ namespace osc
 
         SimulationModelStatePair* tryGetCurrentSimulationState() { return implTryGetCurrentSimulationState(); }
 
+        // returns a cache of (already-extracted) output values for the simulation
+        OutputValueCache& updOutputValueCache() { return implUpdOutputValueCache(); }
+
     private:
         virtual const ISimulation& implGetSimulation() const = 0;
         virtual ISimulation& implUpdSimulation() = 0;
@@ -78,5 +82,6 @@ namespace osc
         virtual std::optional<SimulationReport> implTrySelectReportBasedOnScrubbing() = 0;
 
         virtual SimulationModelStatePair* implTryGetCurrentSimulationState() = 0;
+        virtual OutputValueCache& implUpdOutputValueCache() = 0;
     };
 }
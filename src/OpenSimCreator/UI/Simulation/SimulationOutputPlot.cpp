@@ -7,6 +7,7 @@
 #include <OpenSimCreator/Documents/OutputExtractors/IOutputExtractor.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/OutputValueCache.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
 #include <OpenSimCreator/Platform/OSCColors.h>
@@ -209,12 +210,11 @@ private:
             return;
         }
 
-        // collect output data from the `OutputExtractor`
-        std::vector<float> buf;
+        // collect output data from the (incrementally-updated) cache
+        std::span<const float> buf;
         {
             OSC_PERF("collect output data");
-            const std::vector<SimulationReport> reports = sim.getAllSimulationReports();
-            buf = m_OutputExtractor.slurpValuesFloat(*sim.getModel(), reports);
+            buf = m_API->updOutputValueCache().getValuesFloat(sim, m_OutputExtractor);
         }
 
         // setup drawing area for drawing
@@ -257,8 +257,8 @@ private:
 
         // figure out mapping between screen space and plot space
 
-        SimulationClock::time_point simStartTime = sim.getSimulationReport(0).getTime();
-        SimulationClock::time_point simEndTime = sim.getSimulationReport(nReports-1).getTime();
+        SimulationClock::time_point simStartTime = sim.getSimulationReportTime(0);
+        SimulationClock::time_point simEndTime = sim.getSimulationReportTime(nReports-1);
         SimulationClock::duration simTimeStep = (simEndTime-simStartTime)/nReports;
         SimulationClock::time_point simScrubTime = m_API->getSimulationScrubTime();
 
@@ -332,12 +332,11 @@ private:
             return;
         }
 
-        // collect output data from the `OutputExtractor`
-        std::vector<Vec2> buf;
+        // collect output data from the (incrementally-updated) cache
+        std::span<const Vec2> buf;
         {
             OSC_PERF("collect output data");
-            std::vector<SimulationReport> reports = sim.getAllSimulationReports();
-            buf = m_OutputExtractor.slurpValuesVec2(*sim.getModel(), reports);
+            buf = m_API->updOutputValueCache().getValuesVec2(sim, m_OutputExtractor);
         }
 
         // setup drawing area for drawing
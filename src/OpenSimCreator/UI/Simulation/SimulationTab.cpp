@@ -3,6 +3,7 @@
 #include <OpenSimCreator/Documents/OutputExtractors/ComponentOutputExtractor.h>
 #include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
 #include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/OutputValueCache.h>
 #include <OpenSimCreator/Documents/Simulation/Simulation.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
 #include <OpenSimCreator/Documents/Simulation/SimulationModelStatePair.h>
@@ -295,8 +296,7 @@ private:
         ptrdiff_t zeroethReportIndex = static_cast<ptrdiff_t>(numSimulationReports) - 1;
         for (ptrdiff_t i = 0; i < numSimulationReports; ++i)
         {
-            SimulationReport r = m_Simulation->getSimulationReport(i);
-            if (r.getTime() >= t)
+            if (m_Simulation->getSimulationReportTime(i) >= t)
             {
                 zeroethReportIndex = i;
                 break;
@@ -377,8 +377,8 @@ private:
 
             const SimulationClock::duration simDur = m_PlaybackSpeed * SimulationClock::duration{wallDur};
             const SimulationClock::time_point simNow = m_PlaybackStartSimtime + simDur;
-            const SimulationClock::time_point simEarliest = m_Simulation->getSimulationReport(0).getTime();
-            const SimulationClock::time_point simLatest = m_Simulation->getSimulationReport(nReports - 1).getTime();
+            const SimulationClock::time_point simEarliest = m_Simulation->getSimulationReportTime(0);
+            const SimulationClock::time_point simLatest = m_Simulation->getSimulationReportTime(nReports - 1);
 
             if (simNow < simEarliest) {
                 return simEarliest;
@@ -424,6 +424,11 @@ private:
         return m_ShownModelState.get();
     }
 
+    OutputValueCache& implUpdOutputValueCache() final
+    {
+        return m_OutputValueCache;
+    }
+
     void drawContent()
     {
         m_Toolbar.onDraw();
@@ -463,6 +468,9 @@ private:
     // if possible (i.e. there's a simulation report available), will be set each frame
     std::shared_ptr<SimulationModelStatePair> m_ShownModelState = std::make_shared<SimulationModelStatePair>();
 
+    // incrementally-updated output values of the simulation (e.g. for plotting)
+    OutputValueCache m_OutputValueCache;
+
     // scrubbing state
     SimulationUIPlaybackState m_PlaybackState = SimulationUIPlaybackState::Playing;
     SimulationUILoopingState m_LoopingState = SimulationUILoopingState::PlayOnce;
@@ -795,7 +795,7 @@ std::string osc::RecommendedDocumentName(const OpenSim::Model& model)
     }
 }
 
-std::optional<std::filesystem::path> osc::FindGeometryFileAbsPath(
+std::optional<std::filesystem::path> osc::FindGeometryFilePath(
     const OpenSim::Model& model,
     const OpenSim::Mesh& mesh)
 {
@@ -817,7 +817,17 @@ std::optional<std::filesystem::path> osc::FindGeometryFileAbsPath(
         return std::nullopt;
     }
 
-    return std::optional<std::filesystem::path>{std::filesystem::weakly_canonical({attempts.back()})};
+    return std::optional<std::filesystem::path>{attempts.back()};
+}
+
+std::optional<std::filesystem::path> osc::FindGeometryFileAbsPath(
+    const OpenSim::Model& model,
+    const OpenSim::Mesh& mesh)
+{
+    if (auto path = FindGeometryFilePath(model, mesh)) {
+        return std::filesystem::weakly_canonical(*path);
+    }
+    return std::nullopt;
 }
 
 std::string osc::GetMeshFileName(const OpenSim::Mesh& mesh)
@@ -570,6 +570,15 @@ namespace osc
     // returns the recommended name of the provided model file, e.g. for suggesting a name for users
     std::string RecommendedDocumentName(const OpenSim::Model&);
 
+    // returns the path that OpenSim resolves the given mesh component's `mesh_file` to, if found
+    // (otherwise, std::nullopt)
+    //
+    // this is the (non-canonicalized) path that OpenSim emits in the mesh's `SimTK::DecorativeMeshFile`
+    std::optional<std::filesystem::path> FindGeometryFilePath(
+        const OpenSim::Model&,
+        const OpenSim::Mesh&
+    );
+
     // returns the absolute path to the given mesh component, if found (otherwise, std::nullptr)
     std::optional<std::filesystem::path> FindGeometryFileAbsPath(
         const OpenSim::Model&,
@@ -7,3 +7,4 @@
 #include <oscar/Formats/OBJ.h>
 #include <oscar/Formats/STL.h>
 #include <oscar/Formats/SVG.h>
+#include <oscar/Formats/VTP.h>
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/TriangleFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/ThreadPool.h>
+
+#include <ankerl/unordered_dense.h>
+
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+#include <charconv>
+#include <clocale>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// internal helpers that are shared between the mesh file readers (OBJ, STL, VTP)
+namespace osc::detail
+{
+    // inputs smaller than this are parsed on the calling thread
+    inline constexpr size_t c_min_bytes_per_parallel_parse_chunk = static_cast<size_t>(1) << 20;
+
+    // returns the remaining content of `in` as a string, read in fixed-size chunks
+    inline std::string slurp_in_chunks(std::istream& in)
+    {
+        constexpr size_t c_chunk_size = static_cast<size_t>(1) << 20;
+
+        std::string rv;
+        while (in) {
+            const size_t offset = rv.size();
+            rv.resize(offset + c_chunk_size);
+            in.read(rv.data() + offset, static_cast<std::streamsize>(c_chunk_size));
+            rv.resize(offset + static_cast<size_t>(in.gcount()));
+        }
+        if (in.bad()) {
+            throw std::runtime_error{"an I/O error occurred while reading a mesh file"};
+        }
+        return rv;
+    }
+
+    constexpr bool is_whitespace(char c)
+    {
+        return c == ' ' or c == '\t' or c == '\n' or c == '\r' or c == '\v' or c == '\f';
+    }
+
+    // returns a pointer to the first non-whitespace character in [first, last)
+    constexpr const char* skip_whitespace(const char* first, const char* last)
+    {
+        while (first != last and is_whitespace(*first)) {
+            ++first;
+        }
+        return first;
+    }
+
+    // parses a (C-locale) floating point number from the start of [first, last), returning a
+    // pointer to one past the last parsed character, or `first` if nothing could be parsed
+    //
+    // requires that the number is followed by a non-numeric character (e.g. whitespace, a
+    // `'\0'`) before the end of the underlying buffer, because some standard libraries (e.g.
+    // MacOS, Ubuntu20) don't implement `std::from_chars` for floats, so `std::strtof` is used
+    // as a fallback
+    inline const char* parse_float(const char* first, const char* last, float& out)
+    {
+        if (first != last and *first == '+') {
+            ++first;  // `std::from_chars` doesn't accept a leading '+', but mesh files can contain them
+        }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        const auto [ptr, ec] = std::from_chars(first, last, out);
+        return ec == std::errc{} ? ptr : first;
+#else
+        // `std::strtof` uses the global locale (e.g. ',' decimal separators), so use the
+        // C-locale variant, which is nonstandard but available on all supported platforms
+        char* end = nullptr;
+#if defined(_WIN32)
+        static const _locale_t s_c_locale = _create_locale(LC_NUMERIC, "C");
+        out = _strtof_l(first, &end, s_c_locale);
+#else
+        static const locale_t s_c_locale = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+        out = strtof_l(first, &end, s_c_locale);
+#endif
+        return end <= last ? end : first;
+#endif
+    }
+
+    // parses an integer from the start of [first, last), returning a pointer to one past the
+    // last parsed character, or `first` if nothing could be parsed
+    template<std::integral T>
+    const char* parse_integer(const char* first, const char* last, T& out)
+    {
+        if (first != last and *first == '+') {
+            ++first;
+        }
+        const auto [ptr, ec] = std::from_chars(first, last, out);
+        return ec == std::errc{} ? ptr : first;
+    }
+
+    // splits `text` into roughly equally-sized chunks that each end just after a delimiter
+    // character (or the end of `text`), calls `f` with each chunk (in parallel, if `text` is
+    // large), and returns `f`'s results in chunk order
+    template<std::predicate<char> IsDelimiter, std::invocable<std::string_view> F>
+    std::vector<std::invoke_result_t<F, std::string_view>> transform_chunks_parallel(
+        std::string_view text,
+        IsDelimiter is_delimiter,
+        F f)
+    {
+        using Result = std::invoke_result_t<F, std::string_view>;
+
+        ThreadPool& pool = ThreadPool::global();
+        const size_t chunk_size = max(c_min_bytes_per_parallel_parse_chunk, text.size()/pool.num_threads() + 1);
+
+        std::vector<std::string_view> chunks;
+        while (not text.empty()) {
+            size_t end = min(chunk_size, text.size());
+            while (end < text.size() and not is_delimiter(text[end-1])) {
+                ++end;
+            }
+            chunks.push_back(text.substr(0, end));
+            text.remove_prefix(end);
+        }
+
+        std::vector<Result> rv;
+        rv.reserve(chunks.size());
+        if (chunks.size() <= 1) {
+            for (std::string_view chunk : chunks) {
+                rv.push_back(f(chunk));
+            }
+            return rv;
+        }
+
+        std::vector<std::optional<Result>> results(chunks.size());
+        for_each_chunk_parallel(pool, 1, chunks.size(), [&chunks, &results, &f](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i) {
+                results[i].emplace(f(chunks[i]));
+            }
+        });
+        for (std::optional<Result>& result : results) {
+            rv.push_back(std::move(result).value());
+        }
+        return rv;
+    }
+
+    // parses all whitespace-separated numbers in `text`, throwing if any can't be parsed
+    template<typename T>
+    requires std::same_as<T, float> or std::integral<T>
+    std::vector<T> parse_whitespace_separated_numbers(std::string_view text)
+    {
+        const auto parse_chunk = [](std::string_view chunk)
+        {
+            std::vector<T> rv;
+            rv.reserve(chunk.size()/4);  // guess
+            const char* it = chunk.data();
+            const char* const last = chunk.data() + chunk.size();
+            while ((it = skip_whitespace(it, last)) != last) {
+                T value{};
+                const char* const next = [&]()
+                {
+                    if constexpr (std::same_as<T, float>) { return parse_float(it, last, value); }
+                    else { return parse_integer(it, last, value); }
+                }();
+                if (next == it) {
+                    throw std::runtime_error{"could not parse a number in a mesh file"};
+                }
+                rv.push_back(value);
+                it = next;
+            }
+            return rv;
+        };
+
+        std::vector<T> rv;
+        for (const std::vector<T>& chunk_values : transform_chunks_parallel(text, is_whitespace, parse_chunk)) {
+            rv.insert(rv.end(), chunk_values.begin(), chunk_values.end());
+        }
+        return rv;
+    }
+
+    // accumulates indexed triangles, triangulating polygonal faces in the same way as
+    // `osc::ToOscMesh` does
+    class TriangulatedMeshBuilder final {
+    public:
+        explicit TriangulatedMeshBuilder(std::vector<Vec3> vertices) :
+            vertices_{std::move(vertices)}
+        {}
+
+        // returns the number of vertices in the mesh (this can change as polygons are added)
+        size_t num_vertices() const { return vertices_.size(); }
+
+        // adds `face` to the mesh, emitting triangles for it
+        //
+        // - points/lines are ignored
+        // - quads are split into two triangles
+        // - polygons are triangulated around an additional centroid vertex
+        // - triangles that are out-of-bounds or degenerate are skipped
+        void push_face(std::span<const uint32_t> face)
+        {
+            if (face.size() < 3) {
+                return;  // point/line (ignore)
+            }
+            else if (face.size() == 3) {
+                push_triangle(face[0], face[1], face[2]);
+            }
+            else if (face.size() == 4) {
+                push_triangle(face[0], face[1], face[2]);
+                push_triangle(face[0], face[2], face[3]);
+            }
+            else {
+                Vec3 centroid{};
+                for (uint32_t index : face) {
+                    if (index >= vertices_.size()) {
+                        return;  // index out-of-bounds
+                    }
+                    centroid += vertices_[index];
+                }
+                centroid /= static_cast<float>(face.size());
+
+                const auto centroid_index = static_cast<uint32_t>(vertices_.size());
+                vertices_.push_back(centroid);
+                for (size_t i = 0; i < face.size(); ++i) {
+                    push_triangle(centroid_index, face[i], face[(i+1) % face.size()]);
+                }
+            }
+        }
+
+        const std::vector<Vec3>& vertices() const { return vertices_; }
+        const std::vector<uint32_t>& indices() const { return indices_; }
+
+    private:
+        void push_triangle(uint32_t a, uint32_t b, uint32_t c)
+        {
+            if (a >= vertices_.size() or b >= vertices_.size() or c >= vertices_.size()) {
+                return;  // index out-of-bounds
+            }
+            if (not can_form_triangle(vertices_[a], vertices_[b], vertices_[c])) {
+                return;  // vertex data doesn't form a triangle (NaNs, degenerate locations)
+            }
+            indices_.insert(indices_.end(), {a, b, c});
+        }
+
+        std::vector<Vec3> vertices_;
+        std::vector<uint32_t> indices_;
+    };
+
+    // returns a `Mesh` that contains the builder's vertices and indices, plus normals
+    inline Mesh to_mesh_with_normals(const TriangulatedMeshBuilder& builder)
+    {
+        Mesh rv;
+        rv.set_vertices(builder.vertices());
+        rv.set_indices(builder.indices());
+        rv.recalculate_normals();
+        return rv;
+    }
+
+    // returns a `TriangulatedMeshBuilder` that contains each triangle in `triangle_soup` (a
+    // sequence of vertex triplets), where bitwise-equal vertices are merged
+    inline TriangulatedMeshBuilder build_mesh_from_triangle_soup(std::span<const Vec3> triangle_soup)
+    {
+        std::vector<Vec3> vertices;
+        std::vector<uint32_t> indices;
+        indices.reserve(triangle_soup.size());
+
+        ankerl::unordered_dense::map<Vec3, uint32_t> vertex_to_index;
+        vertex_to_index.reserve(triangle_soup.size()/2);  // guess
+        for (const Vec3& vertex : triangle_soup) {
+            const auto [it, inserted] = vertex_to_index.try_emplace(vertex, static_cast<uint32_t>(vertices.size()));
+            if (inserted) {
+                vertices.push_back(vertex);
+            }
+            indices.push_back(it->second);
+        }
+
+        TriangulatedMeshBuilder rv{std::move(vertices)};
+        for (size_t i = 0; i+2 < indices.size(); i += 3) {
+            rv.push_face({indices.data() + i, 3});
+        }
+        return rv;
+    }
+}
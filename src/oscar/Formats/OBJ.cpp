@@ -1,19 +1,146 @@
 #include "OBJ.h"
 
+#include <oscar/Formats/Detail/MeshParsingHelpers.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Platform/os.h>
 #include <oscar/Strings.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iomanip>
+#include <istream>
+#include <limits>
 #include <ostream>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <vector>
 
 using namespace osc;
 
 namespace
 {
+    // a face index that was read from an OBJ file
+    struct ObjFaceIndex final {
+        int64_t value = 0;         // zero-based
+        bool is_relative = false;  // `true` if `value` is relative to the start of the chunk it was read from
+    };
+
+    // the vertices and faces that were read from a (line-aligned) chunk of an OBJ file
+    struct ObjChunk final {
+        std::vector<Vec3> vertices;
+        std::vector<ObjFaceIndex> face_indices;
+        std::vector<uint32_t> face_sizes;
+    };
+
+    void parse_obj_vertex_line(const char* it, const char* last, ObjChunk& chunk)
+    {
+        Vec3 vertex;
+        for (size_t i = 0; i < 3; ++i) {
+            it = detail::skip_whitespace(it, last);
+            const char* const next = detail::parse_float(it, last, vertex[i]);
+            if (next == it) {
+                throw std::runtime_error{"could not parse a vertex in an OBJ file"};
+            }
+            it = next;
+        }
+        chunk.vertices.push_back(vertex);
+    }
+
+    void parse_obj_face_line(const char* it, const char* last, ObjChunk& chunk)
+    {
+        uint32_t num_indices = 0;
+        while ((it = detail::skip_whitespace(it, last)) != last) {
+            int64_t index = 0;
+            const char* const next = detail::parse_integer(it, last, index);
+            if (next == it) {
+                throw std::runtime_error{"could not parse a face index in an OBJ file"};
+            }
+
+            // OBJ indices are one-based, or (if negative) relative to the most recently read vertex
+            if (index > 0) {
+                chunk.face_indices.push_back({.value = index - 1, .is_relative = false});
+            }
+            else if (index < 0) {
+                chunk.face_indices.push_back({.value = static_cast<int64_t>(chunk.vertices.size()) + index, .is_relative = true});
+            }
+            else {
+                chunk.face_indices.push_back({.value = -1, .is_relative = false});  // invalid (skipped later)
+            }
+            ++num_indices;
+
+            // skip the (unused) texture coordinate and normal indices (e.g. `/2/3`)
+            it = std::find_if(next, last, detail::is_whitespace);
+        }
+        chunk.face_sizes.push_back(num_indices);
+    }
+
+    ObjChunk parse_obj_chunk(std::string_view text)
+    {
+        ObjChunk rv;
+        const char* it = text.data();
+        const char* const last = text.data() + text.size();
+        while (it != last) {
+            const char* const line_end = std::find(it, last, '\n');
+            const char* const line_begin = detail::skip_whitespace(it, line_end);
+
+            if (line_end - line_begin >= 2 and detail::is_whitespace(line_begin[1])) {
+                if (line_begin[0] == 'v') {
+                    parse_obj_vertex_line(line_begin + 2, line_end, rv);
+                }
+                else if (line_begin[0] == 'f') {
+                    parse_obj_face_line(line_begin + 2, line_end, rv);
+                }
+            }
+            // else: ignore it (comment, normal, texture coordinate, group, material, etc.)
+
+            it = line_end == last ? last : line_end + 1;
+        }
+        return rv;
+    }
+
+    Mesh parse_obj(std::string_view text)
+    {
+        const std::vector<ObjChunk> chunks = detail::transform_chunks_parallel(
+            text,
+            [](char c) { return c == '\n'; },
+            parse_obj_chunk
+        );
+
+        // concatenate the vertices, so that faces can index into any of them
+        std::vector<Vec3> vertices;
+        std::vector<int64_t> chunk_vertex_offsets;
+        chunk_vertex_offsets.reserve(chunks.size());
+        for (const ObjChunk& chunk : chunks) {
+            chunk_vertex_offsets.push_back(static_cast<int64_t>(vertices.size()));
+            vertices.insert(vertices.end(), chunk.vertices.begin(), chunk.vertices.end());
+        }
+        const auto num_vertices = static_cast<int64_t>(vertices.size());
+
+        detail::TriangulatedMeshBuilder builder{std::move(vertices)};
+        std::vector<uint32_t> face;
+        for (size_t chunk_index = 0; chunk_index < chunks.size(); ++chunk_index) {
+            const ObjChunk& chunk = chunks[chunk_index];
+            auto face_index_it = chunk.face_indices.begin();
+            for (uint32_t face_size : chunk.face_sizes) {
+                face.clear();
+                for (uint32_t i = 0; i < face_size; ++i, ++face_index_it) {
+                    int64_t index = face_index_it->value;
+                    if (face_index_it->is_relative) {
+                        index += chunk_vertex_offsets[chunk_index];
+                    }
+                    // out-of-bounds indices are mapped to a value that the builder skips
+                    face.push_back(0 <= index and index < num_vertices ? static_cast<uint32_t>(index) : std::numeric_limits<uint32_t>::max());
+                }
+                builder.push_face(face);
+            }
+        }
+        return detail::to_mesh_with_normals(builder);
+    }
+
     void write_header(std::ostream& out, const ObjMetadata& metadata)
     {
         out << "# " << metadata.authoring_tool << '\n';
@@ -27,7 +154,7 @@ namespace
 
     void write_vertices(std::ostream& out, const Mesh& mesh)
     {
-        for (const Vec3& vertex : mesh.vertices()) {
+        for (const Vec3& vertex : mesh.vertices_view()) {
             out << "v ";
             write_vec3(out, vertex);
             out << '\n';
@@ -36,9 +163,9 @@ namespace
 
     void write_normals(std::ostream& out, const Mesh& mesh)
     {
-        for (const Vec3& vertex : mesh.normals()) {
+        for (const Vec3& normal : mesh.normals_view()) {
             out << "vn ";
-            write_vec3(out, vertex);
+            write_vec3(out, normal);
             out << '\n';
         }
     }
@@ -81,6 +208,12 @@ osc::ObjMetadata::ObjMetadata(std::string_view authoring_tool_) :
     creation_time{system_calendar_time()}
 {}
 
+Mesh osc::read_as_obj(std::istream& in)
+{
+    const std::string content = detail::slurp_in_chunks(in);
+    return parse_obj(content);
+}
+
 void osc::write_as_obj(
     std::ostream& out,
     const Mesh& mesh,
@@ -27,6 +27,15 @@ namespace osc
         std::tm creation_time;
     };
 
+    // returns a `Mesh` that contains the (triangulated) faces of the OBJ data in the stream
+    //
+    // only vertex positions (`v`) and faces (`f`) are read: normals are recalculated and
+    // all other data (texture coordinates, materials, groups, etc.) are ignored. Large
+    // inputs are parsed in parallel.
+    //
+    // throws if the stream contains unparseable vertex/face data
+    Mesh read_as_obj(std::istream&);
+
     void write_as_obj(
         std::ostream&,
         const Mesh&,
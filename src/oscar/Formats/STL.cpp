@@ -1,6 +1,9 @@
 #include "STL.h"
 
+#include <oscar/Formats/Detail/MeshParsingHelpers.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
+#include <oscar/Graphics/MeshIndicesView.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Triangle.h>
 #include <oscar/Maths/TriangleFunctions.h>
@@ -14,19 +17,114 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iomanip>
+#include <istream>
 #include <ostream>
 #include <limits>
 #include <span>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 using namespace osc;
 
 namespace
 {
+    constexpr size_t c_num_bytes_in_stl_header = 80;
+    constexpr size_t c_num_bytes_per_binary_stl_triangle = 50;  // normal + 3 vertices + attribute count
+
+    uint32_t read_u32_little_endian(const char* p)
+    {
+        uint32_t rv = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            rv |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (8*i);
+        }
+        return rv;
+    }
+
+    // returns `true` if `content` has the exact size that a binary STL file with the
+    // triangle count in its header would have
+    //
+    // this is used in preference to checking for a leading "solid", because some
+    // exporters write "solid" into the header of binary STL files
+    bool is_binary_stl(std::string_view content)
+    {
+        if (content.size() < c_num_bytes_in_stl_header + sizeof(uint32_t)) {
+            return false;
+        }
+        const uint64_t num_triangles = read_u32_little_endian(content.data() + c_num_bytes_in_stl_header);
+        return content.size() == c_num_bytes_in_stl_header + sizeof(uint32_t) + num_triangles*c_num_bytes_per_binary_stl_triangle;
+    }
+
+    bool is_ascii_stl(std::string_view content)
+    {
+        const char* const first = detail::skip_whitespace(content.data(), content.data() + content.size());
+        return std::string_view{first, content.data() + content.size()}.starts_with("solid");
+    }
+
+    std::vector<Vec3> parse_binary_stl_triangle_soup(std::string_view content)
+    {
+        static_assert(std::numeric_limits<float>::is_iec559, "STL files use IEE754 floats");
+
+        const size_t num_triangles = read_u32_little_endian(content.data() + c_num_bytes_in_stl_header);
+
+        std::vector<Vec3> rv(3*num_triangles);
+        const char* triangle_data = content.data() + c_num_bytes_in_stl_header + sizeof(uint32_t);
+        for (size_t i = 0; i < num_triangles; ++i, triangle_data += c_num_bytes_per_binary_stl_triangle) {
+            // skip the normal, read the 3 vertices (the attribute count is ignored)
+            std::memcpy(&rv[3*i], triangle_data + sizeof(Vec3), 3*sizeof(Vec3));
+        }
+        return rv;
+    }
+
+    // returns the `vertex x y z` points in a (line-aligned) chunk of an ASCII STL file
+    std::vector<Vec3> parse_ascii_stl_chunk(std::string_view text)
+    {
+        constexpr std::string_view c_vertex_keyword = "vertex";
+
+        std::vector<Vec3> rv;
+        const char* it = text.data();
+        const char* const last = text.data() + text.size();
+        while (it != last) {
+            const char* const line_end = std::find(it, last, '\n');
+            const char* line_it = detail::skip_whitespace(it, line_end);
+
+            if (std::string_view{line_it, line_end}.starts_with(c_vertex_keyword)) {
+                line_it += c_vertex_keyword.size();
+                Vec3 vertex;
+                for (size_t i = 0; i < 3; ++i) {
+                    line_it = detail::skip_whitespace(line_it, line_end);
+                    const char* const next = detail::parse_float(line_it, line_end, vertex[i]);
+                    if (next == line_it) {
+                        throw std::runtime_error{"could not parse a vertex in an ASCII STL file"};
+                    }
+                    line_it = next;
+                }
+                rv.push_back(vertex);
+            }
+            // else: ignore it (`solid`, `facet normal`, `outer loop`, `endloop`, etc.)
+
+            it = line_end == last ? last : line_end + 1;
+        }
+        return rv;
+    }
+
+    std::vector<Vec3> parse_ascii_stl_triangle_soup(std::string_view content)
+    {
+        std::vector<Vec3> rv;
+        for (const std::vector<Vec3>& chunk_vertices : detail::transform_chunks_parallel(content, [](char c) { return c == '\n'; }, parse_ascii_stl_chunk)) {
+            rv.insert(rv.end(), chunk_vertices.begin(), chunk_vertices.end());
+        }
+        if (rv.size() % 3 != 0) {
+            throw std::runtime_error{"an ASCII STL file contains an incomplete triangle"};
+        }
+        return rv;
+    }
+
     std::string calc_header_text(const StlMetadata& metadata)
     {
         std::stringstream ss;
@@ -36,7 +134,6 @@ namespace
 
     void write_header(std::ostream& out, const StlMetadata& metadata)
     {
-        constexpr size_t c_num_bytes_in_stl_header = 80;
         constexpr size_t c_max_chars_in_stl_header = c_num_bytes_in_stl_header - 1;  // nul-terminator
 
         const std::string header_content = calc_header_text(metadata);
@@ -96,7 +193,12 @@ namespace
 
     void write_triangles(std::ostream& out, const Mesh& mesh)
     {
-        mesh.for_each_indexed_triangle([&out](Triangle t) { write_triangle(out, t); });
+        // read the vertices in-place, rather than decoding each one via `for_each_indexed_triangle`
+        const MeshAttributeView<Vec3> vertices = mesh.vertices_view();
+        const MeshIndicesView indices = mesh.indices();
+        for (size_t i = 0; i+2 < indices.size(); i += 3) {
+            write_triangle(out, Triangle{vertices[indices[i]], vertices[indices[i+1]], vertices[indices[i+2]]});
+        }
     }
 }
 
@@ -111,6 +213,24 @@ osc::StlMetadata::StlMetadata(
     creation_time{system_calendar_time()}
 {}
 
+Mesh osc::read_as_stl(std::istream& in)
+{
+    const std::string content = detail::slurp_in_chunks(in);
+
+    std::vector<Vec3> triangle_soup;
+    if (is_binary_stl(content)) {
+        triangle_soup = parse_binary_stl_triangle_soup(content);
+    }
+    else if (is_ascii_stl(content)) {
+        triangle_soup = parse_ascii_stl_triangle_soup(content);
+    }
+    else {
+        throw std::runtime_error{"the provided data is neither a binary STL file nor an ASCII STL file"};
+    }
+
+    return detail::to_mesh_with_normals(detail::build_mesh_from_triangle_soup(triangle_soup));
+}
+
 void osc::write_as_stl(
     std::ostream& output,
     const Mesh& mesh,
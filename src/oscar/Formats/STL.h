@@ -21,6 +21,15 @@ namespace osc
         std::tm creation_time;
     };
 
+    // returns a `Mesh` that contains the triangles of the (ASCII or binary) STL data in the
+    // stream
+    //
+    // bitwise-equal vertices are merged and normals are recalculated from the triangles (the
+    // STL file's facet normals are ignored). Large ASCII inputs are parsed in parallel.
+    //
+    // throws if the stream doesn't contain valid STL data
+    Mesh read_as_stl(std::istream&);
+
     void write_as_stl(
         std::ostream&,
         const Mesh&,
@@ -0,0 +1,204 @@
+#include "VTP.h"
+
+#include <oscar/Formats/Detail/MeshParsingHelpers.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // an XML element that was found by (very) minimally scanning the XML text
+    struct XMLElement final {
+        std::string_view attributes;  // e.g. `type="Float32" format="ascii"`
+        std::string_view content;     // e.g. `0.5 0.1 0.0 ...`
+        std::string_view remainder;   // the text after the element
+    };
+
+    // returns the first element called `name` in `xml`, or `std::nullopt` if there isn't one
+    //
+    // this isn't a general-purpose XML parser (e.g. it doesn't handle comments, CDATA, or
+    // nested elements with the same name), but it's sufficient for the regular structure
+    // of the VTP files that VTK (and, therefore, OpenSim tooling) writes
+    std::optional<XMLElement> find_element(std::string_view xml, std::string_view name)
+    {
+        for (size_t pos = xml.find('<'); pos != std::string_view::npos; pos = xml.find('<', pos+1)) {
+            const std::string_view tag = xml.substr(pos+1);
+            if (not tag.starts_with(name) or tag.size() <= name.size()) {
+                continue;
+            }
+            if (const char c = tag[name.size()]; not (detail::is_whitespace(c) or c == '>' or c == '/')) {
+                continue;  // e.g. `<PointData` when searching for `<Points`
+            }
+
+            const size_t start_tag_end = tag.find('>');
+            if (start_tag_end == std::string_view::npos) {
+                throw std::runtime_error{"unterminated XML tag in a VTP file"};
+            }
+
+            if (tag[start_tag_end-1] == '/') {
+                // self-closing (`<Name ... />`)
+                return XMLElement{
+                    .attributes = tag.substr(name.size(), start_tag_end - 1 - name.size()),
+                    .content = {},
+                    .remainder = tag.substr(start_tag_end + 1),
+                };
+            }
+
+            const std::string end_tag = std::string{"</"} + std::string{name};
+            const size_t end_tag_start = tag.find(end_tag, start_tag_end);
+            if (end_tag_start == std::string_view::npos) {
+                throw std::runtime_error{"unterminated XML element in a VTP file"};
+            }
+            return XMLElement{
+                .attributes = tag.substr(name.size(), start_tag_end - name.size()),
+                .content = tag.substr(start_tag_end + 1, end_tag_start - (start_tag_end + 1)),
+                .remainder = tag.substr(end_tag_start + end_tag.size()),
+            };
+        }
+        return std::nullopt;
+    }
+
+    // returns the value of the attribute called `name` in `attributes`, or `std::nullopt`
+    std::optional<std::string_view> find_attribute(std::string_view attributes, std::string_view name)
+    {
+        for (size_t pos = attributes.find(name); pos != std::string_view::npos; pos = attributes.find(name, pos+1)) {
+            if (pos > 0 and not detail::is_whitespace(attributes[pos-1])) {
+                continue;  // e.g. `RangeMin` when searching for `Min`
+            }
+            const std::string_view rest = attributes.substr(pos + name.size());
+            if (not rest.starts_with("=\"")) {
+                continue;
+            }
+            const size_t value_end = rest.find('"', 2);
+            if (value_end == std::string_view::npos) {
+                throw std::runtime_error{"unterminated XML attribute in a VTP file"};
+            }
+            return rest.substr(2, value_end - 2);
+        }
+        return std::nullopt;
+    }
+
+    // returns the content of a `DataArray`, throwing if it isn't in a supported format
+    std::string_view ascii_content_of(const XMLElement& data_array)
+    {
+        if (find_attribute(data_array.attributes, "format") != "ascii") {
+            throw std::runtime_error{"unsupported VTP DataArray format: only format=\"ascii\" is supported"};
+        }
+        return data_array.content;
+    }
+
+    // returns the `DataArray` in `xml` that has the given `Name` attribute, or `std::nullopt`
+    std::optional<XMLElement> find_named_data_array(std::string_view xml, std::string_view name)
+    {
+        while (auto data_array = find_element(xml, "DataArray")) {
+            if (find_attribute(data_array->attributes, "Name") == name) {
+                return data_array;
+            }
+            xml = data_array->remainder;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Vec3> parse_points(const XMLElement& points)
+    {
+        const std::optional<XMLElement> data_array = find_element(points.content, "DataArray");
+        if (not data_array) {
+            throw std::runtime_error{"a VTP Points element does not contain a DataArray"};
+        }
+        if (find_attribute(data_array->attributes, "NumberOfComponents") != "3") {
+            throw std::runtime_error{"a VTP Points DataArray does not have three components"};
+        }
+
+        const std::vector<float> values = detail::parse_whitespace_separated_numbers<float>(ascii_content_of(*data_array));
+        if (values.size() % 3 != 0) {
+            throw std::runtime_error{"a VTP Points DataArray contains an incomplete point"};
+        }
+
+        std::vector<Vec3> rv;
+        rv.reserve(values.size()/3);
+        for (size_t i = 0; i < values.size(); i += 3) {
+            rv.emplace_back(values[i], values[i+1], values[i+2]);
+        }
+        return rv;
+    }
+
+    // pushes the polygons in `polys` into `builder`, with indices offset by `first_vertex`
+    void push_polys(const XMLElement& polys, uint32_t first_vertex, detail::TriangulatedMeshBuilder& builder)
+    {
+        const std::optional<XMLElement> connectivity_array = find_named_data_array(polys.content, "connectivity");
+        const std::optional<XMLElement> offsets_array = find_named_data_array(polys.content, "offsets");
+        if (not connectivity_array or not offsets_array) {
+            throw std::runtime_error{"a VTP Polys element does not contain a connectivity and offsets DataArray"};
+        }
+
+        const auto connectivity = detail::parse_whitespace_separated_numbers<int64_t>(ascii_content_of(*connectivity_array));
+        const auto offsets = detail::parse_whitespace_separated_numbers<int64_t>(ascii_content_of(*offsets_array));
+
+        std::vector<uint32_t> face;
+        int64_t begin = 0;
+        for (const int64_t end : offsets) {
+            if (begin < 0 or end < begin or static_cast<size_t>(end) > connectivity.size()) {
+                throw std::runtime_error{"a VTP Polys offsets DataArray contains out-of-bounds offsets"};
+            }
+
+            face.clear();
+            for (int64_t i = begin; i < end; ++i) {
+                const int64_t index = connectivity[static_cast<size_t>(i)];
+                // out-of-bounds indices are mapped to a value that the builder skips
+                face.push_back(0 <= index and index < std::numeric_limits<uint32_t>::max() - first_vertex ?
+                    first_vertex + static_cast<uint32_t>(index) :
+                    std::numeric_limits<uint32_t>::max());
+            }
+            builder.push_face(face);
+            begin = end;
+        }
+    }
+
+    Mesh parse_vtp(std::string_view text)
+    {
+        const std::optional<XMLElement> polydata = find_element(text, "PolyData");
+        if (not polydata) {
+            throw std::runtime_error{"the provided data does not contain a VTP PolyData element"};
+        }
+
+        // first, collect the points of all pieces, so that the builder knows where each
+        // piece's vertices start
+        std::vector<Vec3> vertices;
+        std::vector<std::pair<uint32_t, XMLElement>> piece_polys;
+        std::string_view pieces = polydata->content;
+        while (auto piece = find_element(pieces, "Piece")) {
+            const auto first_vertex = static_cast<uint32_t>(vertices.size());
+            if (auto points = find_element(piece->content, "Points")) {
+                const std::vector<Vec3> piece_vertices = parse_points(*points);
+                vertices.insert(vertices.end(), piece_vertices.begin(), piece_vertices.end());
+            }
+            if (auto polys = find_element(piece->content, "Polys")) {
+                piece_polys.emplace_back(first_vertex, *polys);
+            }
+            pieces = piece->remainder;
+        }
+
+        detail::TriangulatedMeshBuilder builder{std::move(vertices)};
+        for (const auto& [first_vertex, polys] : piece_polys) {
+            push_polys(polys, first_vertex, builder);
+        }
+        return detail::to_mesh_with_normals(builder);
+    }
+}
+
+Mesh osc::read_as_vtp(std::istream& in)
+{
+    const std::string content = detail::slurp_in_chunks(in);
+    return parse_vtp(content);
+}
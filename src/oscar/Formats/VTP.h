@@ -0,0 +1,19 @@
+#pragma once
+
+#include <iosfwd>
+
+namespace osc { class Mesh; }
+
+namespace osc
+{
+    // returns a `Mesh` that contains the (triangulated) polygons of the VTK PolyData
+    // (`.vtp`) data in the stream
+    //
+    // only the points and polygons (`Polys`) of each `Piece` are read: normals are
+    // recalculated and all other data (vertices, lines, strips, point/cell data) are
+    // ignored. Only uncompressed `format="ascii"` data arrays are supported. Large
+    // data arrays are parsed in parallel.
+    //
+    // throws if the stream doesn't contain supported VTP data
+    Mesh read_as_vtp(std::istream&);
+}
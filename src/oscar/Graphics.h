@@ -23,15 +23,19 @@
 #include <oscar/Graphics/DestinationBlendingFactor.h>
 #include <oscar/Graphics/Geometries.h>
 #include <oscar/Graphics/Graphics.h>
+#include <oscar/Graphics/GraphicsBackendStats.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
 #include <oscar/Graphics/GraphicsContext.h>
 #include <oscar/Graphics/Material.h>
 #include <oscar/Graphics/Materials.h>
 #include <oscar/Graphics/MaterialPropertyBlock.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshFunctions.h>
 #include <oscar/Graphics/MeshIndicesView.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/MeshUpdateFlags.h>
+#include <oscar/Graphics/MeshVertexAdjacency.h>
 #include <oscar/Graphics/RenderBufferLoadAction.h>
 #include <oscar/Graphics/RenderBufferStoreAction.h>
 #include <oscar/Graphics/RenderTarget.h>
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace osc
+{
+    // counts of the GPU commands that a `GraphicsContext`'s backend issued (or, for a
+    // `GraphicsBackendType::Recording` backend, would've issued)
+    struct GraphicsBackendStats final {
+
+        friend bool operator==(const GraphicsBackendStats&, const GraphicsBackendStats&) = default;
+
+        // number of `Camera` render passes (e.g. `Camera::render_to`)
+        size_t num_render_passes = 0;
+
+        // number of (instanced) draw calls
+        size_t num_draw_calls = 0;
+
+        // number of mesh instances drawn by the draw calls
+        size_t num_instances_drawn = 0;
+
+        // number of pipeline state changes (shader program, blending, depth testing, culling, etc.)
+        size_t num_state_changes = 0;
+
+        // number of shader uniforms assigned (including samplers)
+        size_t num_uniforms_set = 0;
+
+        // number of textures bound to texture slots
+        size_t num_texture_binds = 0;
+
+        // number of bytes of mesh and instance data uploaded to the GPU
+        size_t num_bytes_uploaded = 0;
+    };
+}
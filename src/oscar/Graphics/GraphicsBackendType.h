@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+namespace osc
+{
+    // the backend that a `GraphicsContext` uses to execute GPU commands
+    enum class GraphicsBackendType : uint8_t {
+
+        // issues the commands to the OpenGL context of an application window
+        OpenGL,
+
+        // doesn't issue the commands: only records statistics about them (see `GraphicsBackendStats`)
+        //
+        // handy for benchmarking/testing the CPU-side of rendering (render queue sorting,
+        // instance data packing, uniform binding, etc.) on machines that don't have a GPU
+        Recording,
+
+        NUM_OPTIONS,
+    };
+}
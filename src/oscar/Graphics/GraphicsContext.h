@@ -2,6 +2,8 @@
 
 #include <oscar/Graphics/AntiAliasingLevel.h>
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/GraphicsBackendStats.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
 #include <oscar/Graphics/Texture2D.h>
 
 #include <future>
@@ -16,13 +18,26 @@ namespace osc
     // should be initialized exactly once by the application
     class GraphicsContext final {
     public:
+        // constructs a context that uses an OpenGL backend for the given window
         explicit GraphicsContext(SDL_Window&);
+
+        // constructs a context that uses a window-less backend (throws if `backend_type` requires
+        // a window, i.e. is `GraphicsBackendType::OpenGL`)
+        explicit GraphicsContext(GraphicsBackendType backend_type);
+
         GraphicsContext(const GraphicsContext&) = delete;
         GraphicsContext(GraphicsContext&&) noexcept = delete;
         GraphicsContext& operator=(const GraphicsContext&) = delete;
         GraphicsContext& operator=(GraphicsContext&&) noexcept = delete;
         ~GraphicsContext() noexcept;
 
+        GraphicsBackendType backend_type() const;
+
+        // returns counts of the GPU commands that were issued (or recorded) since the
+        // context was constructed, or since the last call to `reset_backend_stats`
+        const GraphicsBackendStats& backend_stats() const;
+        void reset_backend_stats();
+
         AntiAliasingLevel max_antialiasing_level() const;
 
         bool is_vsync_enabled() const;
@@ -24,11 +24,15 @@
 #include <oscar/Graphics/Detail/VertexAttributeList.h>
 #include <oscar/Graphics/Geometries/PlaneGeometry.h>
 #include <oscar/Graphics/Graphics.h>
+#include <oscar/Graphics/GraphicsBackendStats.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
 #include <oscar/Graphics/GraphicsContext.h>
 #include <oscar/Graphics/Material.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshFunctions.h>
 #include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/MeshVertexAdjacency.h>
 #include <oscar/Graphics/OpenGL/CPUDataTypeOpenGLTraits.h>
 #include <oscar/Graphics/OpenGL/CPUImageFormatOpenGLTraits.h>
 #include <oscar/Graphics/OpenGL/DepthStencilRenderBufferFormatOpenGLHelpers.h>
@@ -81,8 +85,13 @@
 #include <oscar/Utils/DefaultConstructOnCopy.h>
 #include <oscar/Utils/EnumHelpers.h>
 #include <oscar/Utils/ObjectRepresentation.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/HashHelpers.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/RadixSort.h>
 #include <oscar/Utils/StdVariantHelpers.h>
+#include <oscar/Utils/StringHelpers.h>
+#include <oscar/Utils/ThreadPool.h>
 #include <oscar/Utils/TransparentStringHasher.h>
 #include <oscar/Utils/UID.h>
 
@@ -91,12 +100,18 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <exception>
 #include <functional>
+#include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <ranges>
 #include <regex>
 #include <span>
@@ -104,6 +119,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -115,6 +131,22 @@ using namespace osc::literals;
 using namespace osc;
 namespace rgs = std::ranges;
 
+// graphics backend state
+namespace
+{
+    // these are globals because there can only be one `GraphicsContext` and because they're
+    // used by resource implementations (e.g. `Shader::Impl`) that are constructed while the
+    // context itself is being constructed
+    GraphicsBackendType g_graphics_backend_type = GraphicsBackendType::OpenGL;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+    GraphicsBackendStats g_graphics_backend_stats;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    // returns `true` if GPU commands should only be recorded in `g_graphics_backend_stats`, rather than issued
+    bool is_recording_graphics_backend()
+    {
+        return g_graphics_backend_type == GraphicsBackendType::Recording;
+    }
+}
+
 // shader source
 namespace
 {
@@ -451,6 +483,25 @@ namespace
         SharedDepthStencilRenderBuffer
     >;
 
+    // returns a hash of the value that's consistent with `operator==`
+    //
+    // values that can't be hashed by value (e.g. textures) only contribute their type
+    size_t hash_material_value(const MaterialValue& material_val)
+    {
+        return std::visit([&material_val]<typename T>(const T& value) -> size_t
+        {
+            if constexpr (Hashable<T>) {
+                return hash_of(material_val.index(), value);
+            }
+            else if constexpr (std::ranges::range<T>) {
+                return hash_combine(hash_range(value), material_val.index());
+            }
+            else {
+                return hash_of(material_val.index());
+            }
+        }, material_val);
+    }
+
     ShaderPropertyType get_shader_type(const MaterialValue& material_val)
     {
         static_assert(std::variant_size_v<MaterialValue> == 18);
@@ -707,25 +758,6 @@ namespace
         return ro.world_centroid;
     }
 
-    // function object that returns true if the first argument is farther from the second
-    //
-    // (handy for depth sorting)
-    class RenderObjectIsFartherFrom final {
-    public:
-        explicit RenderObjectIsFartherFrom(const Vec3& pos) : pos_{pos} {}
-
-        bool operator()(const RenderObject& a, const RenderObject& b) const
-        {
-            const Vec3 centroid_a = worldspace_centroid(a);
-            const Vec3 centroid_b = worldspace_centroid(b);
-            const Vec3 pos_to_a = centroid_a - pos_;
-            const Vec3 pos_to_b = centroid_b - pos_;
-            return length2(pos_to_a) > length2(pos_to_b);
-        }
-    private:
-        Vec3 pos_;
-    };
-
     class RenderObjectHasMaterial final {
     public:
         explicit RenderObjectHasMaterial(const Material* material) :
@@ -787,73 +819,172 @@ namespace
         MaybeIndex maybe_submesh_index_;
     };
 
+    // assigns dense IDs (0, 1, 2, ...), in order of first appearance, to equal values
+    //
+    // the values aren't copied, so they must outlive the interner
+    template<typename T, typename Hash = std::hash<T>>
+    class Interner final {
+    public:
+        uint32_t id_of(const T& value)
+        {
+            // fast-path: consecutive render objects often have equal values
+            if (previous_value_ and *previous_value_ == value) {
+                return previous_id_;
+            }
+            const auto [it, inserted] = ids_.try_emplace(&value, static_cast<uint32_t>(ids_.size()));
+            previous_value_ = &value;
+            previous_id_ = it->second;
+            return previous_id_;
+        }
+
+        // returns the number of bits required to store any ID that was returned by the interner
+        uint64_t num_id_bits() const
+        {
+            return ids_.empty() ? 0 : static_cast<uint64_t>(std::bit_width(ids_.size() - 1));
+        }
+
+    private:
+        struct DereferencingHasher final {
+            size_t operator()(const T* value) const { return Hash{}(*value); }
+        };
+        struct DereferencingEqualTo final {
+            bool operator()(const T* lhs, const T* rhs) const { return *lhs == *rhs; }
+        };
+
+        ankerl::unordered_dense::map<const T*, uint32_t, DereferencingHasher, DereferencingEqualTo> ids_;
+        const T* previous_value_ = nullptr;
+        uint32_t previous_id_ = 0;
+    };
+
+    struct MaybeIndexHasher final {
+        size_t operator()(MaybeIndex maybe_index) const
+        {
+            return maybe_index ? std::hash<size_t>{}(*maybe_index) : 0;
+        }
+    };
+
+    // a render object's position in the render queue, and its (precomputed) sort key
+    struct RenderQueueSortItem final {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    // returns a key that sorts transparent objects after opaque ones, back-to-front
+    //
+    // the (non-negative) squared distance is quantized to its IEEE754 bit pattern, which
+    // sorts in the same order as the floating-point value, and inverted so that farther
+    // objects are sorted first
+    uint64_t transparent_sort_key(const RenderObject& ro, const Vec3& camera_pos)
+    {
+        const float distance2 = length2(worldspace_centroid(ro) - camera_pos);
+        return (uint64_t{1} << 63) | static_cast<uint64_t>(~std::bit_cast<uint32_t>(distance2));
+    }
+
     // sort a sequence of `RenderObject`s for optimal drawing
+    //
+    // the queue is sorted into `[opaque_objs | transparent_objs]`, where `opaque_objs` are
+    // batched by `Material`, `MaterialPropertyBlock`, `Mesh`, and sub-mesh index (in that
+    // order of priority) and `transparent_objs` are sorted back-to-front. This is done by
+    // interning each of those into dense IDs, which are bit-packed into a 64-bit key per
+    // object that's then radix-sorted, so that batching doesn't require repeatedly comparing
+    // (potentially, deep) `MaterialPropertyBlock`s etc.
     std::vector<RenderObject>::iterator sort_render_queue(
         std::vector<RenderObject>::iterator queue_begin,
         std::vector<RenderObject>::iterator queue_end,
         Vec3 camera_pos)
     {
-        // partition the render queue into `[opaque_objs | transparent_objs]`
-        const auto opaque_objs_end = std::partition(queue_begin, queue_end, is_opaque);
-
-        // optimize the `opaque_objs` partition (it can be reordered safely)
-        //
-        // first, batch `opaque_objs` into `RenderObject`s that have the same `Material`
-        auto material_batch_start = queue_begin;
-        while (material_batch_start != opaque_objs_end) {
-
-            const auto material_batch_end = std::partition(
-                material_batch_start,
-                opaque_objs_end,
-                RenderObjectHasMaterial{&material_batch_start->material}
-            );
-
-            // second, batch `RenderObject`s with the same `Material` into sub-batches
-            // with the same `MaterialPropertyBlock`
-            auto props_batch_start = material_batch_start;
-            while (props_batch_start != material_batch_end) {
-
-                const auto props_batch_end = std::partition(
-                    props_batch_start,
-                    material_batch_end,
-                    RenderObjectHasMaterialPropertyBlock{props_batch_start->property_block}
-                );
-
-                // third, batch `RenderObject`s with the same `Material` and `MaterialPropertyBlock`s
-                // into sub-batches with the same `Mesh`
-                auto mesh_batch_start = props_batch_start;
-                while (mesh_batch_start != props_batch_end) {
-
-                    const auto mesh_batch_end = std::partition(
-                        mesh_batch_start,
-                        props_batch_end,
-                        RenderObjectHasMesh{&mesh_batch_start->mesh}
-                    );
+        const std::span<RenderObject> queue{queue_begin, queue_end};
+        if (queue.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error{"too many render objects were queued for one render pass"};
+        }
 
-                    // fourth, batch `RenderObject`s with the same `Material`, `MaterialPropertyBlock`,
-                    // and `Mesh` into sub-batches with the same sub-mesh index
-                    auto submesh_batch_start = mesh_batch_start;
-                    while (submesh_batch_start != mesh_batch_end) {
+        // intern the opaque objects' batching fields
+        struct BatchIDs final {
+            uint32_t material = 0;
+            uint32_t property_block = 0;
+            uint32_t mesh = 0;
+            uint32_t submesh = 0;
+        };
+        std::vector<BatchIDs> batch_ids(queue.size());
+        Interner<Material> materials;
+        Interner<MaterialPropertyBlock> property_blocks;
+        Interner<Mesh> meshes;
+        Interner<MaybeIndex, MaybeIndexHasher> submeshes;
+        size_t num_opaque_objs = 0;
+        for (size_t i = 0; i < queue.size(); ++i) {
+            const RenderObject& ro = queue[i];
+            if (is_opaque(ro)) {
+                batch_ids[i] = {
+                    .material = materials.id_of(ro.material),
+                    .property_block = property_blocks.id_of(ro.property_block),
+                    .mesh = meshes.id_of(ro.mesh),
+                    .submesh = submeshes.id_of(ro.maybe_submesh_index),
+                };
+                ++num_opaque_objs;
+            }
+        }
 
-                        const auto submesh_batch_end = std::partition(
-                            submesh_batch_start,
-                            mesh_batch_end,
-                            RenderObjectHasSubMeshIndex{submesh_batch_start->maybe_submesh_index}
-                        );
+        // radix-sort the objects by their keys
+        //
+        // the top bit of the key is reserved for transparency, so if the IDs don't fit in the
+        // remaining 63 bits, the objects are sorted by each ID from least-to-most significant
+        // instead (this works because the sort is stable)
+        std::vector<RenderQueueSortItem> items;
+        items.reserve(queue.size());
+        for (size_t i = 0; i < queue.size(); ++i) {
+            items.push_back({.key = 0, .index = static_cast<uint32_t>(i)});
+        }
+        std::vector<RenderQueueSortItem> scratch;
+        const auto sort_items_by = [&queue, &items, &scratch](const auto& calc_key)
+        {
+            for (RenderQueueSortItem& item : items) {
+                item.key = calc_key(queue[item.index], item.index);
+            }
+            radix_sort(items, [](const RenderQueueSortItem& item) { return item.key; }, scratch);
+        };
 
-                        submesh_batch_start = submesh_batch_end;
-                    }
-                    mesh_batch_start = mesh_batch_end;
+        const uint64_t submesh_bits = submeshes.num_id_bits();
+        const uint64_t mesh_bits = meshes.num_id_bits();
+        const uint64_t property_block_bits = property_blocks.num_id_bits();
+        const uint64_t material_bits = materials.num_id_bits();
+        if (material_bits + property_block_bits + mesh_bits + submesh_bits <= 63) {
+            sort_items_by([&](const RenderObject& ro, uint32_t index)
+            {
+                if (not is_opaque(ro)) {
+                    return transparent_sort_key(ro, camera_pos);
                 }
-                props_batch_start = props_batch_end;
-            }
-            material_batch_start = material_batch_end;
+                const BatchIDs& ids = batch_ids[index];
+                uint64_t key = ids.material;
+                key = (key << property_block_bits) | ids.property_block;
+                key = (key << mesh_bits) | ids.mesh;
+                key = (key << submesh_bits) | ids.submesh;
+                return key;
+            });
+        }
+        else {
+            sort_items_by([&](const RenderObject&, uint32_t index)
+            {
+                return (static_cast<uint64_t>(batch_ids[index].mesh) << 32) | batch_ids[index].submesh;
+            });
+            sort_items_by([&](const RenderObject&, uint32_t index)
+            {
+                return static_cast<uint64_t>(batch_ids[index].property_block);
+            });
+            sort_items_by([&](const RenderObject& ro, uint32_t index)
+            {
+                return is_opaque(ro) ? static_cast<uint64_t>(batch_ids[index].material) : transparent_sort_key(ro, camera_pos);
+            });
         }
 
-        // sort the transparent partition by distance from camera (back-to-front)
-        std::sort(opaque_objs_end, queue_end, RenderObjectIsFartherFrom{camera_pos});
+        // apply the sorted order to the queue
+        std::vector<RenderObject> sorted;
+        sorted.reserve(queue.size());
+        for (const RenderQueueSortItem& item : items) {
+            sorted.push_back(std::move(queue[item.index]));
+        }
+        rgs::move(sorted, queue_begin);
 
-        return opaque_objs_end;
+        return queue_begin + static_cast<ptrdiff_t>(num_opaque_objs);
     }
 
     // top-level state for a single call to `render`
@@ -909,14 +1040,14 @@ namespace
 
     struct InstancingState final {
         InstancingState(
-            gl::ArrayBuffer<float, GL_STREAM_DRAW>& buf_,
+            gl::ArrayBuffer<float, GL_STREAM_DRAW>* buf_,
             size_t stride_) :
 
             buffer{buf_},
             stride{stride_}
         {}
 
-        gl::ArrayBuffer<float, GL_STREAM_DRAW>& buffer;
+        gl::ArrayBuffer<float, GL_STREAM_DRAW>* buffer;  // `nullptr` if the backend is recording
         size_t stride = 0;
         size_t base_offset = 0;
     };
@@ -2792,27 +2923,209 @@ namespace
         }
 #endif
     }
+
+    // returns the `ShaderPropertyType` of a GLSL type name (e.g. "vec3")
+    ShaderPropertyType glsl_type_name_to_osc_shader_type(std::string_view glsl_type_name)
+    {
+        static_assert(num_options<ShaderPropertyType>() == 11);
+
+        if (glsl_type_name == "float")       { return ShaderPropertyType::Float; }
+        if (glsl_type_name == "vec2")        { return ShaderPropertyType::Vec2; }
+        if (glsl_type_name == "vec3")        { return ShaderPropertyType::Vec3; }
+        if (glsl_type_name == "vec4")        { return ShaderPropertyType::Vec4; }
+        if (glsl_type_name == "mat3")        { return ShaderPropertyType::Mat3; }
+        if (glsl_type_name == "mat4")        { return ShaderPropertyType::Mat4; }
+        if (glsl_type_name == "int")         { return ShaderPropertyType::Int; }
+        if (glsl_type_name == "bool")        { return ShaderPropertyType::Bool; }
+        if (glsl_type_name == "sampler2D")   { return ShaderPropertyType::Sampler2D; }
+        if (glsl_type_name == "samplerCube") { return ShaderPropertyType::SamplerCube; }
+        return ShaderPropertyType::Unknown;
+    }
+
+    // a global (e.g. `uniform`) declaration that was parsed from GLSL source code
+    struct GLSLDeclaration final {
+        std::string name;
+        ShaderPropertyType shader_type = ShaderPropertyType::Unknown;
+        int32_t size = 1;
+        std::optional<int32_t> maybe_layout_location;
+    };
+
+    std::vector<std::string_view> split_on_whitespace(std::string_view sv)
+    {
+        std::vector<std::string_view> rv;
+        size_t pos = 0;
+        while (pos < sv.size()) {
+            const size_t begin = sv.find_first_not_of(" \t\r\n", pos);
+            if (begin == std::string_view::npos) {
+                break;
+            }
+            const size_t end = min(sv.find_first_of(" \t\r\n", begin), sv.size());
+            rv.push_back(sv.substr(begin, end - begin));
+            pos = end;
+        }
+        return rv;
+    }
+
+    // tries to parse one global GLSL statement (e.g. `layout (location = 0) in vec3 aPos`) as
+    // a declaration that has the given storage qualifier (e.g. `in`)
+    void try_parse_glsl_declaration(
+        std::string_view statement,
+        std::string_view storage_qualifier,
+        std::vector<GLSLDeclaration>& out)
+    {
+        statement = strip_whitespace(statement);
+
+        // parse (and strip) the `layout` qualifier
+        std::optional<int32_t> maybe_layout_location;
+        if (statement.starts_with("layout")) {
+            const size_t open = statement.find('(');
+            const size_t close = statement.find(')');
+            if (open == std::string_view::npos or close == std::string_view::npos or close < open) {
+                return;
+            }
+            const std::string_view qualifiers = statement.substr(open + 1, close - open - 1);
+            if (const size_t location = qualifiers.find("location"); location != std::string_view::npos) {
+                if (const size_t equals = qualifiers.find('=', location); equals != std::string_view::npos) {
+                    const std::string_view value = strip_whitespace(qualifiers.substr(equals + 1));
+                    int32_t v = 0;
+                    if (std::from_chars(value.data(), value.data() + value.size(), v).ec == std::errc{}) {
+                        maybe_layout_location = v;
+                    }
+                }
+            }
+            statement = statement.substr(close + 1);
+        }
+
+        // ignore initializers (e.g. `uniform float uShininess = 8`)
+        statement = statement.substr(0, statement.find('='));
+
+        if (contains(statement, '(')) {
+            return;  // it's a function prototype
+        }
+
+        // parse the array size (e.g. `uniform vec3 uLightDirs[3]`)
+        int32_t size = 1;
+        std::string declaration{statement};
+        if (const size_t open = declaration.find('['); open != std::string::npos) {
+            const size_t close = declaration.find(']', open);
+            if (close == std::string::npos) {
+                return;
+            }
+            const std::string_view value = strip_whitespace(std::string_view{declaration}.substr(open + 1, close - open - 1));
+            if (std::from_chars(value.data(), value.data() + value.size(), size).ec != std::errc{}) {
+                size = 1;  // e.g. it's sized by a preprocessor definition
+            }
+            declaration.erase(open, close - open + 1);
+        }
+
+        // parse `[qualifiers...] storage_qualifier [precision] type name`
+        const std::vector<std::string_view> tokens = split_on_whitespace(declaration);
+        const auto qualifier_it = rgs::find(tokens, storage_qualifier);
+        if (qualifier_it == tokens.end() or std::distance(qualifier_it, tokens.end()) < 3) {
+            return;
+        }
+        const std::string_view type_name = *(tokens.end() - 2);
+        const std::string_view name = tokens.back();
+        if (not is_valid_identifier(name)) {
+            return;
+        }
+
+        out.push_back(GLSLDeclaration{
+            .name = std::string{name},
+            .shader_type = glsl_type_name_to_osc_shader_type(type_name),
+            .size = size,
+            .maybe_layout_location = maybe_layout_location,
+        });
+    }
+
+    // returns the global declarations in the GLSL source code `src` that have the given
+    // storage qualifier (e.g. `uniform`)
+    //
+    // used by the recording backend, which has no OpenGL driver to introspect a compiled
+    // program with. Unlike the driver, it doesn't remove declarations that the program
+    // doesn't use
+    std::vector<GLSLDeclaration> parse_glsl_declarations(
+        std::string_view src,
+        std::string_view storage_qualifier)
+    {
+        std::vector<GLSLDeclaration> rv;
+        std::string statement;
+        size_t brace_depth = 0;
+        bool at_line_start = true;
+
+        for (size_t i = 0; i < src.size(); ++i) {
+            const char c = src[i];
+
+            if (src.substr(i).starts_with("//") or (at_line_start and c == '#')) {
+                // skip line comment (or preprocessor directive)
+                i = min(src.find('\n', i), src.size()) - 1;
+                continue;
+            }
+            if (src.substr(i).starts_with("/*")) {
+                // skip block comment
+                const size_t end = src.find("*/", i + 2);
+                i = end == std::string_view::npos ? src.size() : end + 1;
+                continue;
+            }
+
+            if (c == '\n') {
+                at_line_start = true;
+            }
+            else if (c != ' ' and c != '\t' and c != '\r') {
+                at_line_start = false;
+            }
+
+            if (c == '{') {
+                if (brace_depth++ == 0) {
+                    statement.clear();  // e.g. a function body, or an interface block
+                }
+            }
+            else if (c == '}') {
+                if (brace_depth > 0 and --brace_depth == 0) {
+                    statement.clear();
+                }
+            }
+            else if (brace_depth == 0) {
+                if (c == ';') {
+                    try_parse_glsl_declaration(statement, storage_qualifier, rv);
+                    statement.clear();
+                }
+                else {
+                    statement += c;
+                }
+            }
+        }
+        return rv;
+    }
 }
 
 class osc::Shader::Impl final {
 public:
     Impl(
         CStringView vertex_shader_src,
-        CStringView fragment_shader_src) :
-
-        program_{compile_program_with_shimming(vertex_shader_src, fragment_shader_src)}
+        CStringView fragment_shader_src)
     {
-        parse_uniforms_and_attributes_from_program();
+        if (is_recording_graphics_backend()) {
+            parse_uniforms_and_attributes_from_source(vertex_shader_src, {vertex_shader_src, fragment_shader_src});
+        }
+        else {
+            maybe_program_ = compile_program_with_shimming(vertex_shader_src, fragment_shader_src);
+            parse_uniforms_and_attributes_from_program();
+        }
     }
 
     Impl(
         CStringView vertex_shader_src,
         CStringView geometry_shader_src,
-        CStringView fragment_shader_src) :
-
-        program_{compile_program_with_shimming(vertex_shader_src, fragment_shader_src, geometry_shader_src)}
+        CStringView fragment_shader_src)
     {
-        parse_uniforms_and_attributes_from_program();
+        if (is_recording_graphics_backend()) {
+            parse_uniforms_and_attributes_from_source(vertex_shader_src, {vertex_shader_src, geometry_shader_src, fragment_shader_src});
+        }
+        else {
+            maybe_program_ = compile_program_with_shimming(vertex_shader_src, fragment_shader_src, geometry_shader_src);
+            parse_uniforms_and_attributes_from_program();
+        }
     }
 
     size_t num_properties() const
@@ -2848,7 +3161,8 @@ public:
 
     const gl::Program& program() const
     {
-        return program_;
+        OSC_ASSERT(maybe_program_ && "a shader compiled by a recording backend has no OpenGL program");
+        return *maybe_program_;
     }
 
     const FastStringHashtable<ShaderElement>& uniforms() const
@@ -2866,11 +3180,13 @@ private:
     {
         constexpr GLsizei c_shader_max_name_length = 128;
 
+        const gl::Program& program = *maybe_program_;
+
         GLint num_attrs = 0;
-        glGetProgramiv(program_.get(), GL_ACTIVE_ATTRIBUTES, &num_attrs);
+        glGetProgramiv(program.get(), GL_ACTIVE_ATTRIBUTES, &num_attrs);
 
         GLint num_uniforms = 0;
-        glGetProgramiv(program_.get(), GL_ACTIVE_UNIFORMS, &num_uniforms);
+        glGetProgramiv(program.get(), GL_ACTIVE_UNIFORMS, &num_uniforms);
 
         attributes_.reserve(num_attrs);
         for (GLint attr_idx = 0; attr_idx < num_attrs; attr_idx++) {
@@ -2880,7 +3196,7 @@ private:
             std::array<GLchar, c_shader_max_name_length> name{};  // variable name in GLSL
             GLsizei length = 0;                                   // name length
             glGetActiveAttrib(
-                program_.get() ,
+                program.get(),
                 static_cast<GLuint>(attr_idx),
                 static_cast<GLsizei>(name.size()),
                 &length,
@@ -2892,7 +3208,7 @@ private:
             static_assert(sizeof(GLint) <= sizeof(int32_t));
             attributes_.try_emplace<std::string>(
                 normalize_shader_element_name(name.data()),
-                static_cast<int32_t>(glGetAttribLocation(program_.get(), name.data())),
+                static_cast<int32_t>(glGetAttribLocation(program.get(), name.data())),
                 opengl_shader_type_to_osc_shader_type(type),
                 static_cast<int32_t>(size)
             );
@@ -2905,7 +3221,7 @@ private:
             std::array<GLchar, c_shader_max_name_length> name{};  // variable name in GLSL
             GLsizei length = 0;                                   // name length
             glGetActiveUniform(
-                program_.get(),
+                program.get(),
                 static_cast<GLuint>(uniform_idx),
                 static_cast<GLsizei>(name.size()),
                 &length,
@@ -2917,12 +3233,54 @@ private:
             static_assert(sizeof(GLint) <= sizeof(int32_t));
             uniforms_.try_emplace<std::string>(
                 normalize_shader_element_name(name.data()),
-                static_cast<int32_t>(glGetUniformLocation(program_.get(), name.data())),
+                static_cast<int32_t>(glGetUniformLocation(program.get(), name.data())),
                 opengl_shader_type_to_osc_shader_type(type),
                 static_cast<int32_t>(size)
             );
         }
 
+        cache_automatic_shader_elements();
+    }
+
+    // used by the recording backend: parses the uniforms of all shader stages and the attributes
+    // (inputs) of the vertex shader from their source code, rather than from a compiled program
+    void parse_uniforms_and_attributes_from_source(
+        CStringView vertex_shader_src,
+        std::initializer_list<CStringView> all_shader_srcs)
+    {
+        int32_t next_attribute_location = 0;
+        for (auto& declaration : parse_glsl_declarations(vertex_shader_src, "in")) {
+            const int32_t location = declaration.maybe_layout_location.value_or(next_attribute_location);
+            next_attribute_location = location + 1;
+            attributes_.try_emplace<std::string>(
+                std::move(declaration.name),
+                location,
+                declaration.shader_type,
+                declaration.size
+            );
+        }
+
+        // uniforms that are declared by multiple stages share one location
+        int32_t next_uniform_location = 0;
+        for (const CStringView shader_src : all_shader_srcs) {
+            for (auto& declaration : parse_glsl_declarations(shader_src, "uniform")) {
+                const bool inserted = uniforms_.try_emplace<std::string>(
+                    std::move(declaration.name),
+                    next_uniform_location,
+                    declaration.shader_type,
+                    declaration.size
+                ).second;
+                if (inserted) {
+                    next_uniform_location += declaration.size;
+                }
+            }
+        }
+
+        cache_automatic_shader_elements();
+    }
+
+    void cache_automatic_shader_elements()
+    {
         // cache commonly-used "automatic" shader elements
         //
         // it's a perf optimization: the renderer uses this to skip lookups
@@ -2938,7 +3296,7 @@ private:
     friend class GraphicsBackend;
 
     UID id_;
-    gl::Program program_;
+    std::optional<gl::Program> maybe_program_;  // `std::nullopt` if the backend is recording
     FastStringHashtable<ShaderElement> uniforms_;
     FastStringHashtable<ShaderElement> attributes_;
     std::optional<ShaderElement> maybe_model_mat_uniform_;
@@ -3220,6 +3578,16 @@ public:
         return values_.empty();
     }
 
+    size_t hash() const
+    {
+        // summed, because the hashtable's iteration order can differ between equal blocks
+        size_t rv = 0;
+        for (const auto& [property_name, value] : values_) {
+            rv += hash_of(property_name, hash_material_value(value));
+        }
+        return rv;
+    }
+
     template<typename T, std::convertible_to<std::string_view> StringLike>
     std::optional<T> get(StringLike&& property_name) const
     {
@@ -3749,6 +4117,11 @@ std::ostream& osc::operator<<(std::ostream& o, const MaterialPropertyBlock&)
     return o << "MaterialPropertyBlock()";
 }
 
+size_t std::hash<osc::MaterialPropertyBlock>::operator()(const osc::MaterialPropertyBlock& block) const
+{
+    return block.impl_->hash();
+}
+
 // define an `Unorm8` to `Snorm8` `Converter`, so that vertex buffers
 // support this (re)encoding pathway
 template<>
@@ -4363,6 +4736,40 @@ namespace
             return std::vector<T>(range.begin(), range.end());
         }
 
+        // returns a view of the attribute that points into the buffer, or holds a decoded
+        // copy of it if it isn't stored in `T`'s format
+        template<MeshAttributeViewable T>
+        MeshAttributeView<T> view(VertexAttribute attribute) const
+        {
+            const auto layout = vertex_format_.attribute_layout(attribute);
+            if (not layout) {
+                return {};
+            }
+            if (layout->format() != float_vertex_attribute_format_of<T>()) {
+                return MeshAttributeView<T>{read<T>(attribute)};
+            }
+            return {data_.data() + layout->offset(), stride(), num_vertices()};
+        }
+
+        // returns a pointer to the first element of the attribute (or `nullptr` if the buffer
+        // has no such attribute), reencoding the buffer first if the attribute isn't stored
+        // in `T`'s format, so that it can be edited in-place as a `T`
+        template<MeshAttributeViewable T>
+        std::byte* prepare_for_in_place_editing(VertexAttribute attribute)
+        {
+            auto layout = vertex_format_.attribute_layout(attribute);
+            if (not layout) {
+                return nullptr;
+            }
+            if (layout->format() != float_vertex_attribute_format_of<T>()) {
+                VertexFormat new_format{vertex_format_};
+                new_format.insert({attribute, float_vertex_attribute_format_of<T>()});
+                set_format(new_format);
+                layout = vertex_format_.attribute_layout(attribute);
+            }
+            return data_.data() + layout->offset();
+        }
+
         template<UserFacingVertexData T>
         void write(VertexAttribute attribute, std::span<const T> values)
         {
@@ -4532,6 +4939,28 @@ public:
         version_->reset();
     }
 
+    template<MeshAttributeViewable T>
+    MeshAttributeView<T> attribute_view(VertexAttribute attribute) const
+    {
+        return vertex_buffer_.view<T>(attribute);
+    }
+
+    template<MeshAttributeViewable T>
+    MeshAttributeEdit<T> edit_attribute(Mesh& owner, VertexAttribute attribute)
+    {
+        std::byte* data = vertex_buffer_.prepare_for_in_place_editing<T>(attribute);
+        const size_t num_elements = data ? vertex_buffer_.num_vertices() : 0;
+        return MeshAttributeEdit<T>{owner, attribute, data, vertex_buffer_.stride(), num_elements};
+    }
+
+    void on_attribute_edited(VertexAttribute attribute)
+    {
+        if (attribute == VertexAttribute::Position) {
+            range_check_indices_and_recalculate_bounds();
+        }
+        version_->reset();
+    }
+
     bool has_normals() const
     {
         return vertex_buffer_.has_attribute(VertexAttribute::Normal);
@@ -4704,6 +5133,7 @@ public:
         indices_are_32bit_ = false;
         num_indices_ = 0;
         indices_data_.clear();
+        vertex_adjacency_.reset();
         aabb_ = {};
         submesh_descriptors_.clear();
     }
@@ -4769,51 +5199,69 @@ public:
         // ensure the vertex buffer has a normal attribute
         vertex_buffer_.emplace_attribute_descriptor({VertexAttribute::Normal, VertexAttributeFormat::Float32x3});
 
-        // calculate normals from triangle faces:
+        // calculate normals from triangle faces, in two (parallelized) passes:
         //
-        // - keep a count of the number of times a normal has been assigned
-        // - compute the normal from the triangle
-        // - if counts[i] == 0 assign it (we can't assume the buffer is zeroed - could be reused)
-        // - else, add (accumulate)
-        // - ++counts[i]
-        // - at the end, if counts[i] > 1, then renormalize that normal (it contains a sum)
-
-        const auto mesh_indices = indices();
-        const auto positions = vertex_buffer_.iter<Vec3>(VertexAttribute::Position);
+        // - compute the normal of each triangle (NaN, if it's degenerate)
+        // - for each vertex, sum the valid normals of the triangles that reference it, and
+        //   renormalize the sum if more than one normal contributed to it (vertices that
+        //   aren't referenced by any valid triangle are left as-is)
+        //
+        // the second pass sums each vertex's normals in the same (ascending) order that a
+        // serial pass over the triangles would, so the result is deterministic, and each
+        // vertex's normal is only written by one thread
+        const MeshVertexAdjacency& adjacency = vertex_adjacency();
+        const auto positions = vertex_buffer_.view<Vec3>(VertexAttribute::Position);
         auto normals = vertex_buffer_.iter<Vec3>(VertexAttribute::Normal);
-        std::vector<uint16_t> counts(normals.size());
-
-        for (size_t i = 0, len = 3*(mesh_indices.size()/3); i < len; i+=3) {
-            // get triangle indices
-            const Vec3uz idxs = {mesh_indices[i], mesh_indices[i+1], mesh_indices[i+2]};
+        ThreadPool& pool = ThreadPool::global();
 
-            // get triangle
-            const Triangle triangle = {positions[idxs[0]], positions[idxs[1]], positions[idxs[2]]};
+        const MeshIndicesView mesh_indices = indices();
+        const size_t num_triangles = mesh_indices.size()/3;
+        std::vector<Vec3> triangle_normals(num_triangles);
+        const auto calc_triangle_normals = [&]<typename Index>(std::span<const Index> typed_indices)
+        {
+            for_each_chunk_parallel(pool, 2048, num_triangles, [&](size_t first_triangle, size_t last_triangle)
+            {
+                for (size_t triangle = first_triangle; triangle < last_triangle; ++triangle) {
+                    const size_t i = 3*triangle;
+
+                    // can use unchecked access here: `mesh_indices` are range-checked on writing
+                    triangle_normals[triangle] = triangle_normal(Triangle{
+                        positions[typed_indices[i]],
+                        positions[typed_indices[i+1]],
+                        positions[typed_indices[i+2]],
+                    }).unwrap();
+                }
+            });
+        };
+        if (mesh_indices.is_uint32()) {
+            calc_triangle_normals(mesh_indices.to_uint32_span());
+        }
+        else {
+            calc_triangle_normals(mesh_indices.to_uint16_span());
+        }
 
-            // calculate + validate triangle normal
-            const auto normal = triangle_normal(triangle).unwrap();
-            if (any_of(isnan(normal))) {
-                continue;  // probably co-located, or invalid: don't accumulate it
-            }
+        for_each_chunk_parallel(pool, 4096, adjacency.num_vertices(), [&](size_t first_vertex, size_t last_vertex)
+        {
+            for (size_t vertex = first_vertex; vertex < last_vertex; ++vertex) {
+                Vec3 sum{};
+                size_t count = 0;
+                for (const uint32_t corner : adjacency.corners_of(vertex)) {
+                    const Vec3& normal = triangle_normals[corner/3];
+                    if (any_of(isnan(normal))) {
+                        continue;  // probably co-located, or invalid: don't accumulate it
+                    }
+                    sum = count == 0 ? normal : sum + normal;
+                    ++count;
+                }
 
-            // accumulate
-            for (auto idx : idxs) {
-                if (counts[idx] == 0) {
-                    normals[idx] = normal;
+                if (count == 1) {
+                    normals[static_cast<ptrdiff_t>(vertex)] = sum;
                 }
-                else {
-                    normals[idx] += normal;
+                else if (count > 1) {
+                    normals[static_cast<ptrdiff_t>(vertex)] = normalize(sum);
                 }
-                ++counts[idx];
             }
-        }
-
-        // renormalize shared normals
-        for (size_t i = 0; i < counts.size(); ++i) {
-            if (counts[i] > 1) {
-                normals[i] = normalize(Vec3{normals[i]});
-            }
-        }
+        });
     }
 
     void recalculate_tangents()
@@ -4840,16 +5288,13 @@ public:
 
         // calculate tangents
 
-        const auto vbverts = vertex_buffer_.iter<Vec3>(VertexAttribute::Position);
-        const auto vbnormals = vertex_buffer_.iter<Vec3>(VertexAttribute::Normal);
-        const auto vbtexcoords = vertex_buffer_.iter<Vec2>(VertexAttribute::TexCoord0);
-
         const auto tangents = calc_tangent_vectors(
             MeshTopology::Triangles,
-            std::vector<Vec3>(vbverts.begin(), vbverts.end()),
-            std::vector<Vec3>(vbnormals.begin(), vbnormals.end()),
-            std::vector<Vec2>(vbtexcoords.begin(), vbtexcoords.end()),
-            indices()
+            vertex_buffer_.view<Vec3>(VertexAttribute::Position),
+            vertex_buffer_.view<Vec3>(VertexAttribute::Normal),
+            vertex_buffer_.view<Vec2>(VertexAttribute::TexCoord0),
+            indices(),
+            vertex_adjacency()
         );
 
         vertex_buffer_.write<Vec4>(VertexAttribute::Tangent, tangents);
@@ -4865,6 +5310,15 @@ public:
         return (*maybe_gpu_data_)->vao;
     }
 
+    // equivalent to `upd_vertex_array`, but only records the upload (used by the recording backend)
+    void record_vertex_array_upload()
+    {
+        if (*maybe_recorded_data_version_ != *version_) {
+            g_graphics_backend_stats.num_bytes_uploaded += num_gpu_bytes();
+            *maybe_recorded_data_version_ = *version_;
+        }
+    }
+
     void drawInstanced(
         size_t n,
         MaybeIndex maybe_submesh_index)
@@ -4908,6 +5362,7 @@ private:
 
     void set_indices(std::span<const uint16_t> indices, MeshUpdateFlags flags)
     {
+        vertex_adjacency_.reset();
         indices_are_32bit_ = false;
         num_indices_ = indices.size();
 
@@ -4925,6 +5380,7 @@ private:
 
     void set_indices(std::span<const uint32_t> indices, MeshUpdateFlags flags)
     {
+        vertex_adjacency_.reset();
         if (indices.empty()) {
             indices_are_32bit_ = false;
             num_indices_ = 0;
@@ -4947,6 +5403,22 @@ private:
         version_->reset();
     }
 
+    // returns the mapping from each vertex to the indices that reference it
+    //
+    // the mapping only depends on the mesh's indices, so it's cached (and shared between
+    // copies of the mesh), which means that (e.g.) repeatedly warping a mesh's vertices and
+    // recalculating its normals only builds the mapping once
+    const MeshVertexAdjacency& vertex_adjacency()
+    {
+        if (not vertex_adjacency_ or
+            vertex_adjacency_->num_vertices() != vertex_buffer_.num_vertices() or
+            vertex_adjacency_->num_indices() != num_indices_) {
+
+            vertex_adjacency_ = std::make_shared<const MeshVertexAdjacency>(indices(), vertex_buffer_.num_vertices());
+        }
+        return *vertex_adjacency_;
+    }
+
     void range_check_indices_and_recalculate_bounds(
         MeshUpdateFlags flags = MeshUpdateFlag::Default)
     {
@@ -5047,8 +5519,16 @@ private:
         glEnableVertexAttribArray(shader_location_of(layout.attribute()));
     }
 
+    // returns the number of bytes of vertex and index data that are uploaded to the GPU
+    size_t num_gpu_bytes() const
+    {
+        return vertex_buffer_.bytes().size() + num_indices_ * (indices_are_32bit_ ? sizeof(uint32_t) : sizeof(uint16_t));
+    }
+
     void upload_to_gpu()
     {
+        g_graphics_backend_stats.num_bytes_uploaded += num_gpu_bytes();
+
         // allocate GPU-side buffers (or re-use the last ones)
         if (not *maybe_gpu_data_) {
             *maybe_gpu_data_ = MeshOpenGLData{};
@@ -5094,12 +5574,14 @@ private:
     bool indices_are_32bit_ = false;
     size_t num_indices_ = 0;
     std::vector<PackedIndex> indices_data_;
+    std::shared_ptr<const MeshVertexAdjacency> vertex_adjacency_;  // lazily computed from the indices
 
     AABB aabb_ = {};
 
     std::vector<SubMeshDescriptor> submesh_descriptors_;
 
     DefaultConstructOnCopy<std::optional<MeshOpenGLData>> maybe_gpu_data_;
+    DefaultConstructOnCopy<std::optional<UID>> maybe_recorded_data_version_;
 };
 
 std::ostream& osc::operator<<(std::ostream& o, MeshTopology topology)
@@ -5111,6 +5593,11 @@ osc::Mesh::Mesh() :
     impl_{make_cow<Impl>()}
 {}
 
+void osc::detail::on_mesh_attribute_edited(Mesh& mesh, VertexAttribute attribute)
+{
+    mesh.impl_.upd()->on_attribute_edited(attribute);
+}
+
 MeshTopology osc::Mesh::topology() const
 {
     return impl_->topology();
@@ -5156,6 +5643,16 @@ void osc::Mesh::transform_vertices(const Mat4& mat4)
     impl_.upd()->transform_vertices(mat4);
 }
 
+MeshAttributeView<Vec3> osc::Mesh::vertices_view() const
+{
+    return impl_->attribute_view<Vec3>(VertexAttribute::Position);
+}
+
+MeshAttributeEdit<Vec3> osc::Mesh::edit_vertices()
+{
+    return impl_.upd()->edit_attribute<Vec3>(*this, VertexAttribute::Position);
+}
+
 bool osc::Mesh::has_normals() const
 {
     return impl_->has_normals();
@@ -5176,6 +5673,16 @@ void osc::Mesh::transform_normals(const std::function<Vec3(Vec3)>& transformer)
     impl_.upd()->transform_normals(transformer);
 }
 
+MeshAttributeView<Vec3> osc::Mesh::normals_view() const
+{
+    return impl_->attribute_view<Vec3>(VertexAttribute::Normal);
+}
+
+MeshAttributeEdit<Vec3> osc::Mesh::edit_normals()
+{
+    return impl_.upd()->edit_attribute<Vec3>(*this, VertexAttribute::Normal);
+}
+
 bool osc::Mesh::has_tex_coords() const
 {
     return impl_->has_tex_coords();
@@ -5196,6 +5703,11 @@ void osc::Mesh::transform_tex_coords(const std::function<Vec2(Vec2)>& transforme
     impl_.upd()->transform_tex_coords(transformer);
 }
 
+MeshAttributeView<Vec2> osc::Mesh::tex_coords_view() const
+{
+    return impl_->attribute_view<Vec2>(VertexAttribute::TexCoord0);
+}
+
 std::vector<Color> osc::Mesh::colors() const
 {
     return impl_->colors();
@@ -6090,11 +6602,31 @@ severity = %s
 class osc::GraphicsContext::Impl final {
 public:
     explicit Impl(SDL_Window& window) :
-        opengl_context_{create_opengl_context(window)}
+        maybe_opengl_context_{create_opengl_context(window)},
+        max_aa_level_{get_opengl_max_aa_level(*maybe_opengl_context_)},
+        vsync_enabled_{SDL_GL_GetSwapInterval() != 0},
+        maybe_instance_gpu_buffer_{std::in_place}
     {
         quad_material_.set_depth_tested(false);  // it's for fullscreen rendering
     }
 
+    // constructs a recording backend, which has no OpenGL context
+    Impl() :
+        max_aa_level_{AntiAliasingLevel{64}}
+    {
+        quad_material_.set_depth_tested(false);  // it's for fullscreen rendering
+    }
+
+    const GraphicsBackendStats& backend_stats() const
+    {
+        return g_graphics_backend_stats;
+    }
+
+    void reset_backend_stats()
+    {
+        g_graphics_backend_stats = {};
+    }
+
     AntiAliasingLevel max_antialiasing_level() const
     {
         return max_aa_level_;
@@ -6107,6 +6639,10 @@ public:
 
     void set_vsync_enabled(bool v)
     {
+        if (not maybe_opengl_context_) {
+            return;  // recording backend: there's no swap chain
+        }
+
         if (v) {
             // try to enable vsync
 
@@ -6135,6 +6671,10 @@ public:
 
     void set_debug_mode(bool v)
     {
+        if (not maybe_opengl_context_) {
+            return;  // recording backend: there are no OpenGL debug messages
+        }
+
         if (v) {
             // enable debug mode
 
@@ -6163,6 +6703,10 @@ public:
     {
         // clear color is in sRGB, but the framebuffer is sRGB-corrected (GL_FRAMEBUFFER_SRGB)
         // and assumes that the given colors are in linear space
+        if (not maybe_opengl_context_) {
+            return;  // recording backend: there's no window framebuffer
+        }
+
         const Color linear_color = to_linear_colorspace(color);
 
         gl::bind_framebuffer(GL_DRAW_FRAMEBUFFER, gl::window_framebuffer);
@@ -6177,6 +6721,15 @@ public:
 
     void swap_buffers(SDL_Window& window)
     {
+        if (not maybe_opengl_context_) {
+            // recording backend: there's no window framebuffer to take a screenshot of
+            for (auto& request : screenshot_request_queue_) {
+                request.set_exception(std::make_exception_ptr(std::runtime_error{"cannot take a screenshot with a recording graphics backend"}));
+            }
+            screenshot_request_queue_.clear();
+            return;
+        }
+
         // ensure window FBO is bound (see: SDL_GL_SwapWindow's note about MacOS requiring 0 is bound)
         gl::bind_framebuffer(GL_FRAMEBUFFER, gl::window_framebuffer);
 
@@ -6214,22 +6767,22 @@ public:
 
     std::string backend_vendor_string() const
     {
-        return std::string{opengl_get_cstringview(GL_VENDOR)};
+        return maybe_opengl_context_ ? std::string{opengl_get_cstringview(GL_VENDOR)} : std::string{"oscar"};
     }
 
     std::string backend_renderer_string() const
     {
-        return std::string{opengl_get_cstringview(GL_RENDERER)};
+        return maybe_opengl_context_ ? std::string{opengl_get_cstringview(GL_RENDERER)} : std::string{"recording"};
     }
 
     std::string backend_version_string() const
     {
-        return std::string{opengl_get_cstringview(GL_VERSION)};
+        return maybe_opengl_context_ ? std::string{opengl_get_cstringview(GL_VERSION)} : std::string{"N/A"};
     }
 
     std::string backend_shading_language_version_string() const
     {
-        return std::string{opengl_get_cstringview(GL_SHADING_LANGUAGE_VERSION)};
+        return maybe_opengl_context_ ? std::string{opengl_get_cstringview(GL_SHADING_LANGUAGE_VERSION)} : std::string{"N/A"};
     }
 
     const Material& getQuadMaterial() const
@@ -6249,18 +6802,18 @@ public:
 
     gl::ArrayBuffer<float, GL_STREAM_DRAW>& updInstanceGPUBuffer()
     {
-        return instance_gpu_buffer_;
+        return *maybe_instance_gpu_buffer_;
     }
 
 private:
 
-    // active OpenGL context for the application
-    sdl::GLContext opengl_context_;
+    // active OpenGL context for the application (`std::nullopt` if the backend is recording)
+    std::optional<sdl::GLContext> maybe_opengl_context_;
 
     // maximum number of antiAliasingLevel supported by this hardware's OpenGL MSXAA API
-    AntiAliasingLevel max_aa_level_ = get_opengl_max_aa_level(opengl_context_);
+    AntiAliasingLevel max_aa_level_;
 
-    bool vsync_enabled_ = SDL_GL_GetSwapInterval() != 0;
+    bool vsync_enabled_ = false;
 
     // true if OpenGL's debug mode is enabled
     bool debug_mode_enabled_ = false;
@@ -6279,7 +6832,7 @@ private:
 
     // storage for instance data
     std::vector<float> instance_cpu_buffer_;
-    gl::ArrayBuffer<float, GL_STREAM_DRAW> instance_gpu_buffer_;
+    std::optional<gl::ArrayBuffer<float, GL_STREAM_DRAW>> maybe_instance_gpu_buffer_;
 };
 
 static std::unique_ptr<osc::GraphicsContext::Impl> g_graphics_context_impl = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -6290,12 +6843,50 @@ osc::GraphicsContext::GraphicsContext(SDL_Window& window)
         throw std::runtime_error{"a graphics context has already been initialized: you cannot initialize a second"};
     }
 
+    g_graphics_backend_type = GraphicsBackendType::OpenGL;
+    g_graphics_backend_stats = {};
     g_graphics_context_impl = std::make_unique<GraphicsContext::Impl>(window);
 }
 
+osc::GraphicsContext::GraphicsContext(GraphicsBackendType backend_type)
+{
+    if (g_graphics_context_impl) {
+        throw std::runtime_error{"a graphics context has already been initialized: you cannot initialize a second"};
+    }
+    if (backend_type != GraphicsBackendType::Recording) {
+        throw std::invalid_argument{"the given graphics backend requires a window"};
+    }
+
+    g_graphics_backend_type = backend_type;
+    g_graphics_backend_stats = {};
+    try {
+        g_graphics_context_impl = std::make_unique<GraphicsContext::Impl>();
+    }
+    catch (...) {
+        g_graphics_backend_type = GraphicsBackendType::OpenGL;
+        throw;
+    }
+}
+
 osc::GraphicsContext::~GraphicsContext() noexcept
 {
     g_graphics_context_impl.reset();
+    g_graphics_backend_type = GraphicsBackendType::OpenGL;
+}
+
+GraphicsBackendType osc::GraphicsContext::backend_type() const
+{
+    return g_graphics_backend_type;
+}
+
+const GraphicsBackendStats& osc::GraphicsContext::backend_stats() const
+{
+    return g_graphics_context_impl->backend_stats();
+}
+
+void osc::GraphicsContext::reset_backend_stats()
+{
+    g_graphics_context_impl->reset_backend_stats();
 }
 
 AntiAliasingLevel osc::GraphicsContext::max_antialiasing_level() const
@@ -6452,7 +7043,7 @@ void osc::GraphicsBackend::bind_to_instanced_attributes(
     const Shader::Impl& shader_impl,
     InstancingState& instancing_state)
 {
-    gl::bind_buffer(instancing_state.buffer);
+    gl::bind_buffer(*instancing_state.buffer);
 
     size_t byte_offset = 0;
     if (shader_impl.maybe_instanced_model_mat_attr_) {
@@ -6565,8 +7156,14 @@ std::optional<InstancingState> osc::GraphicsBackend::upload_instance_data(
         }
         OSC_ASSERT_ALWAYS(sizeof(float)*float_offset == render_queue.size() * byte_stride);
 
-        auto& vbo = maybeInstancingState.emplace(g_graphics_context_impl->updInstanceGPUBuffer(), byte_stride).buffer;
-        vbo.assign(std::span<const float>{buf.data(), float_offset});
+        g_graphics_backend_stats.num_bytes_uploaded += sizeof(float)*float_offset;
+        if (is_recording_graphics_backend()) {
+            maybeInstancingState.emplace(nullptr, byte_stride);
+        }
+        else {
+            auto* vbo = maybeInstancingState.emplace(&g_graphics_context_impl->updInstanceGPUBuffer(), byte_stride).buffer;
+            vbo->assign(std::span<const float>{buf.data(), float_offset});
+        }
     }
     return maybeInstancingState;
 }
@@ -6582,6 +7179,24 @@ void osc::GraphicsBackend::try_bind_material_value_to_shader_element(
 
     static_assert(std::variant_size_v<MaterialValue> == 18);
 
+    const bool is_texture = std::holds_alternative<Texture2D>(material_value) or
+        std::holds_alternative<RenderTexture>(material_value) or
+        std::holds_alternative<SharedColorRenderBuffer>(material_value) or
+        std::holds_alternative<SharedDepthStencilRenderBuffer>(material_value) or
+        std::holds_alternative<Cubemap>(material_value);
+
+    ++g_graphics_backend_stats.num_uniforms_set;
+    if (is_texture) {
+        ++g_graphics_backend_stats.num_texture_binds;
+    }
+
+    if (is_recording_graphics_backend()) {
+        if (is_texture) {
+            ++texture_slot;
+        }
+        return;
+    }
+
     switch (material_value.index()) {
     case variant_index<MaterialValue, Color>():
     {
@@ -6876,8 +7491,15 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
     auto& mesh_impl = const_cast<Mesh::Impl&>(*batch.front().mesh.impl_);
     const Shader::Impl& shader_impl = *batch.front().material.impl_->shader_.impl_;
     const MaybeIndex maybe_submesh_index = batch.front().maybe_submesh_index;
+    const bool recording = is_recording_graphics_backend();
 
-    gl::bind_vertex_array(mesh_impl.upd_vertex_array());
+    if (recording) {
+        mesh_impl.record_vertex_array_upload();
+    }
+    else {
+        gl::bind_vertex_array(mesh_impl.upd_vertex_array());
+    }
+    g_graphics_backend_stats.num_instances_drawn += batch.size();
 
     if (shader_impl.maybe_model_mat_uniform_ or shader_impl.maybe_normal_mat_uniform_) {
         // if the shader requires per-instance uniforms, then we *have* to render one
@@ -6888,29 +7510,46 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
             // try binding to uModel (standard)
             if (shader_impl.maybe_model_mat_uniform_) {
                 if (shader_impl.maybe_model_mat_uniform_->shader_type == ShaderPropertyType::Mat4) {
-                    gl::UniformMat4 u{shader_impl.maybe_model_mat_uniform_->location};
-                    gl::set_uniform(u, model_mat4(render_object));
+                    const Mat4 model_matrix = model_mat4(render_object);
+                    ++g_graphics_backend_stats.num_uniforms_set;
+                    if (not recording) {
+                        gl::UniformMat4 u{shader_impl.maybe_model_mat_uniform_->location};
+                        gl::set_uniform(u, model_matrix);
+                    }
                 }
             }
 
             // try binding to uNormalMat (standard)
             if (shader_impl.maybe_normal_mat_uniform_) {
                 if (shader_impl.maybe_normal_mat_uniform_->shader_type == ShaderPropertyType::Mat3) {
-                    gl::UniformMat3 u{shader_impl.maybe_normal_mat_uniform_->location};
-                    gl::set_uniform(u, normal_matrix(render_object));
+                    const Mat3 normal_mat = normal_matrix(render_object);
+                    ++g_graphics_backend_stats.num_uniforms_set;
+                    if (not recording) {
+                        gl::UniformMat3 u{shader_impl.maybe_normal_mat_uniform_->location};
+                        gl::set_uniform(u, normal_mat);
+                    }
                 }
                 else if (shader_impl.maybe_normal_mat_uniform_->shader_type == ShaderPropertyType::Mat4) {
-                    gl::UniformMat4 u{shader_impl.maybe_normal_mat_uniform_->location};
-                    gl::set_uniform(u, normal_matrix4(render_object));
+                    const Mat4 normal_mat = normal_matrix4(render_object);
+                    ++g_graphics_backend_stats.num_uniforms_set;
+                    if (not recording) {
+                        gl::UniformMat4 u{shader_impl.maybe_normal_mat_uniform_->location};
+                        gl::set_uniform(u, normal_mat);
+                    }
                 }
             }
 
-            if (instancing_state) {
-                bind_to_instanced_attributes(shader_impl, *instancing_state);
+            ++g_graphics_backend_stats.num_draw_calls;
+            if (not recording) {
+                if (instancing_state) {
+                    bind_to_instanced_attributes(shader_impl, *instancing_state);
+                }
+                mesh_impl.drawInstanced(1, maybe_submesh_index);
+                if (instancing_state) {
+                    unbind_from_instanced_attributes(shader_impl, *instancing_state);
+                }
             }
-            mesh_impl.drawInstanced(1, maybe_submesh_index);
             if (instancing_state) {
-                unbind_from_instanced_attributes(shader_impl, *instancing_state);
                 instancing_state->base_offset += 1 * instancing_state->stride;
             }
         }
@@ -6918,17 +7557,24 @@ void osc::GraphicsBackend::handle_batch_with_same_submesh(
     else {
         // else: the shader supports instanced data, so we can draw multiple meshes in one call
 
-        if (instancing_state) {
-            bind_to_instanced_attributes(shader_impl, *instancing_state);
+        ++g_graphics_backend_stats.num_draw_calls;
+        if (not recording) {
+            if (instancing_state) {
+                bind_to_instanced_attributes(shader_impl, *instancing_state);
+            }
+            mesh_impl.drawInstanced(batch.size(), maybe_submesh_index);
+            if (instancing_state) {
+                unbind_from_instanced_attributes(shader_impl, *instancing_state);
+            }
         }
-        mesh_impl.drawInstanced(batch.size(), maybe_submesh_index);
         if (instancing_state) {
-            unbind_from_instanced_attributes(shader_impl, *instancing_state);
             instancing_state->base_offset += batch.size() * instancing_state->stride;
         }
     }
 
-    gl::bind_vertex_array();
+    if (not recording) {
+        gl::bind_vertex_array();
+    }
 }
 
 // helper: draw a batch of `RenderObject`s that have the same:
@@ -6994,6 +7640,7 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
     const auto& material_impl = *batch.front().material.impl_;
     const auto& shader_impl = *material_impl.shader_.impl_;
     const FastStringHashtable<ShaderElement>& uniforms = shader_impl.uniforms();
+    const bool recording = is_recording_graphics_backend();
 
     // preemptively upload instance data
     std::optional<InstancingState> maybe_instances = upload_instance_data(batch, shader_impl);
@@ -7001,39 +7648,51 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
     // updated by various batches (which may bind to textures etc.)
     int32_t texture_slot = 0;
 
-    gl::use_program(shader_impl.program());
-
-    if (material_impl.source_blending_factor() != SourceBlendingFactor::Default or
-        material_impl.destination_blending_factor() != DestinationBlendingFactor::Default) {
-
-        glBlendFunc(
-            to_opengl_blend_func(material_impl.source_blending_factor()),
-            to_opengl_blend_func(material_impl.destination_blending_factor())
-        );
-    }
+    // count the program binding, plus each (later reverted) material-specific pipeline state change
+    const bool has_custom_blending =
+        material_impl.source_blending_factor() != SourceBlendingFactor::Default or
+        material_impl.destination_blending_factor() != DestinationBlendingFactor::Default;
+    const size_t num_material_state_changes =
+        static_cast<size_t>(has_custom_blending) +
+        static_cast<size_t>(material_impl.blending_equation() != BlendingEquation::Default) +
+        static_cast<size_t>(material_impl.is_wireframe()) +
+        static_cast<size_t>(material_impl.depth_function() != DepthFunction::Default) +
+        static_cast<size_t>(material_impl.cull_mode() != CullMode::Off);
+    g_graphics_backend_stats.num_state_changes += 1 + 2*num_material_state_changes;
+
+    if (not recording) {
+        gl::use_program(shader_impl.program());
+
+        if (has_custom_blending) {
+            glBlendFunc(
+                to_opengl_blend_func(material_impl.source_blending_factor()),
+                to_opengl_blend_func(material_impl.destination_blending_factor())
+            );
+        }
 
-    if (material_impl.blending_equation() != BlendingEquation::Default) {
-        glBlendEquation(to_opengl_blend_equation(material_impl.blending_equation()));
-    }
+        if (material_impl.blending_equation() != BlendingEquation::Default) {
+            glBlendEquation(to_opengl_blend_equation(material_impl.blending_equation()));
+        }
 
 #ifndef EMSCRIPTEN
-    if (material_impl.is_wireframe()) {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-    }
+        if (material_impl.is_wireframe()) {
+            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        }
 #endif
 
-    if (material_impl.depth_function() != DepthFunction::Default) {
-        glDepthFunc(to_opengl_depth_function_enum(material_impl.depth_function()));
-    }
+        if (material_impl.depth_function() != DepthFunction::Default) {
+            glDepthFunc(to_opengl_depth_function_enum(material_impl.depth_function()));
+        }
 
-    if (material_impl.cull_mode() != CullMode::Off) {
-        glEnable(GL_CULL_FACE);
-        glCullFace(to_opengl_cull_face_enum(material_impl.cull_mode()));
+        if (material_impl.cull_mode() != CullMode::Off) {
+            glEnable(GL_CULL_FACE);
+            glCullFace(to_opengl_cull_face_enum(material_impl.cull_mode()));
 
-        // winding order is assumed to be counter-clockwise
-        //
-        // (it's the initial value as defined by Khronos: https://registry.khronos.org/OpenGL-Refpages/gl4/html/glFrontFace.xhtml)
-        // glFrontFace(GL_CCW);
+            // winding order is assumed to be counter-clockwise
+            //
+            // (it's the initial value as defined by Khronos: https://registry.khronos.org/OpenGL-Refpages/gl4/html/glFrontFace.xhtml)
+            // glFrontFace(GL_CCW);
+        }
     }
 
     // bind material variables
@@ -7041,23 +7700,32 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
         // try binding to uView (standard)
         if (shader_impl.maybe_view_mat_uniform_) {
             if (shader_impl.maybe_view_mat_uniform_->shader_type == ShaderPropertyType::Mat4) {
-                gl::UniformMat4 u{shader_impl.maybe_view_mat_uniform_->location};
-                gl::set_uniform(u, render_pass_state.view_matrix);
+                ++g_graphics_backend_stats.num_uniforms_set;
+                if (not recording) {
+                    gl::UniformMat4 u{shader_impl.maybe_view_mat_uniform_->location};
+                    gl::set_uniform(u, render_pass_state.view_matrix);
+                }
             }
         }
 
         // try binding to uProjection (standard)
         if (shader_impl.maybe_proj_mat_uniform_) {
             if (shader_impl.maybe_proj_mat_uniform_->shader_type == ShaderPropertyType::Mat4) {
-                gl::UniformMat4 u{shader_impl.maybe_proj_mat_uniform_->location};
-                gl::set_uniform(u, render_pass_state.projection_matrix);
+                ++g_graphics_backend_stats.num_uniforms_set;
+                if (not recording) {
+                    gl::UniformMat4 u{shader_impl.maybe_proj_mat_uniform_->location};
+                    gl::set_uniform(u, render_pass_state.projection_matrix);
+                }
             }
         }
 
         if (shader_impl.maybe_view_proj_mat_uniform_) {
             if (shader_impl.maybe_view_proj_mat_uniform_->shader_type == ShaderPropertyType::Mat4) {
-                gl::UniformMat4 u{shader_impl.maybe_view_proj_mat_uniform_->location};
-                gl::set_uniform(u, render_pass_state.view_projection_matrix);
+                ++g_graphics_backend_stats.num_uniforms_set;
+                if (not recording) {
+                    gl::UniformMat4 u{shader_impl.maybe_view_proj_mat_uniform_->location};
+                    gl::set_uniform(u, render_pass_state.view_projection_matrix);
+                }
             }
         }
 
@@ -7078,6 +7746,10 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
         subbatch_begin = subbatch_end;
     }
 
+    if (recording) {
+        return;
+    }
+
     if (material_impl.cull_mode() != CullMode::Off) {
         glCullFace(GL_BACK);  // default from Khronos docs
         glDisable(GL_CULL_FACE);
@@ -7097,9 +7769,7 @@ void osc::GraphicsBackend::handle_batch_with_same_material(
         glBlendEquation(to_opengl_blend_equation(BlendingEquation::Default));
     }
 
-    if (material_impl.source_blending_factor() != SourceBlendingFactor::Default or
-        material_impl.destination_blending_factor() != DestinationBlendingFactor::Default) {
-
+    if (has_custom_blending) {
         glBlendFunc(
             to_opengl_blend_func(SourceBlendingFactor::Default),
             to_opengl_blend_func(DestinationBlendingFactor::Default)
@@ -7135,7 +7805,10 @@ void osc::GraphicsBackend::draw_batched_by_opaqueness(
 
         if (opaque_end != batchIt) {
             // [batchIt..opaqueEnd] contains opaque elements
-            gl::disable(GL_BLEND);
+            ++g_graphics_backend_stats.num_state_changes;
+            if (not is_recording_graphics_backend()) {
+                gl::disable(GL_BLEND);
+            }
             draw_render_objects(render_pass_state, {batchIt, opaque_end});
 
             batchIt = opaque_end;
@@ -7144,7 +7817,10 @@ void osc::GraphicsBackend::draw_batched_by_opaqueness(
         if (opaque_end != batch.end()) {
             // [opaqueEnd..els.end()] contains transparent elements
             const auto transparent_end = find_if(opaque_end, batch.end(), is_opaque);
-            gl::enable(GL_BLEND);
+            ++g_graphics_backend_stats.num_state_changes;
+            if (not is_recording_graphics_backend()) {
+                gl::enable(GL_BLEND);
+            }
             draw_render_objects(render_pass_state, {opaque_end, transparent_end});
 
             batchIt = transparent_end;
@@ -7177,8 +7853,12 @@ void osc::GraphicsBackend::flush_render_queue(Camera::Impl& camera, float aspect
         camera.view_matrix(),
         camera.projection_matrix(aspect_ratio),
     };
+    const bool recording = is_recording_graphics_backend();
 
-    gl::enable(GL_DEPTH_TEST);
+    ++g_graphics_backend_stats.num_state_changes;
+    if (not recording) {
+        gl::enable(GL_DEPTH_TEST);
+    }
 
     // draw by reordering depth-tested elements around the not-depth-tested elements
     auto batchIt = queue.begin();
@@ -7200,9 +7880,14 @@ void osc::GraphicsBackend::flush_render_queue(Camera::Impl& camera, float aspect
             const auto ignore_depth_test_end = find_if(depth_tested_end, queue.end(), is_depth_tested);
 
             // these elements aren't depth-tested and should just be drawn as-is
-            gl::disable(GL_DEPTH_TEST);
+            g_graphics_backend_stats.num_state_changes += 2;
+            if (not recording) {
+                gl::disable(GL_DEPTH_TEST);
+            }
             draw_batched_by_opaqueness(renderPassState, {depth_tested_end, ignore_depth_test_end});
-            gl::enable(GL_DEPTH_TEST);
+            if (not recording) {
+                gl::enable(GL_DEPTH_TEST);
+            }
 
             batchIt = ignore_depth_test_end;
         }
@@ -7563,6 +8248,15 @@ void osc::GraphicsBackend::render_camera_queue(
         maybe_custom_render_target->validate_or_throw();
     }
 
+    ++g_graphics_backend_stats.num_render_passes;
+
+    if (is_recording_graphics_backend()) {
+        // skip binding, clearing, and resolving the render buffers (they have no GPU-side data)
+        const ViewportGeometry viewport_geom = calc_viewport_geometry(camera, maybe_custom_render_target);
+        flush_render_queue(camera, aspect_ratio_of(viewport_geom.dimensions));
+        return;
+    }
+
     const float output_aspect_ratio = setup_top_level_pipeline_state(
         camera,
         maybe_custom_render_target
@@ -7657,7 +8351,7 @@ void osc::GraphicsBackend::blit_to_screen(
     BlitFlags)
 {
     OSC_ASSERT(g_graphics_context_impl);
-    OSC_ASSERT(source.impl_->has_been_rendered_to() && "the input texture has not been rendered to");
+    OSC_ASSERT((is_recording_graphics_backend() or source.impl_->has_been_rendered_to()) && "the input texture has not been rendered to");
 
     Camera camera;
     camera.set_background_color(Color::clear());
@@ -7706,6 +8400,11 @@ void osc::GraphicsBackend::copy_texture(
     CubemapFace face)
 {
     OSC_ASSERT(g_graphics_context_impl);
+
+    if (is_recording_graphics_backend()) {
+        return;  // there's no GPU-side data to copy: leave `destination` as-is
+    }
+
     OSC_ASSERT(source.impl_->has_been_rendered_to() && "the input texture has not been rendered to");
 
     // create a source (read) framebuffer for blitting from the source render texture
@@ -7818,6 +8517,10 @@ void osc::GraphicsBackend::copy_texture(
     OSC_ASSERT(source.dimensionality() == TextureDimensionality::Cube && "provided render texture must be a cubemap to call this method");
     OSC_ASSERT(mip <= max_mipmap_level);
 
+    if (is_recording_graphics_backend()) {
+        return;  // there's no GPU-side data to copy: leave `destination` as-is
+    }
+
     // blit each face of the source cubemap into the output cubemap
     for (size_t face = 0; face < 6; ++face) {
         gl::FrameBuffer readFBO;
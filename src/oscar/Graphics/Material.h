@@ -19,7 +19,9 @@
 #include <oscar/Utils/CopyOnUpdPtr.h>
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <optional>
 #include <span>
@@ -104,6 +106,7 @@ namespace osc
 
         friend std::ostream& operator<<(std::ostream&, const Material&);
         friend class GraphicsBackend;
+        friend struct std::hash<Material>;
 
         class Impl;
         CopyOnUpdPtr<Impl> impl_;
@@ -111,3 +114,11 @@ namespace osc
 
     std::ostream& operator<<(std::ostream&, const Material&);
 }
+
+template<>
+struct std::hash<osc::Material> final {
+    size_t operator()(const osc::Material& material) const
+    {
+        return std::hash<osc::CopyOnUpdPtr<osc::Material::Impl>>{}(material.impl_);
+    }
+};
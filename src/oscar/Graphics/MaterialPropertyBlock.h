@@ -15,7 +15,9 @@
 #include <oscar/Utils/StringName.h>
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <optional>
 #include <ranges>
@@ -148,6 +150,7 @@ namespace osc
         friend bool operator==(const MaterialPropertyBlock&, const MaterialPropertyBlock&);
         friend std::ostream& operator<<(std::ostream&, const MaterialPropertyBlock&);
         friend class GraphicsBackend;
+        friend struct std::hash<MaterialPropertyBlock>;
 
         class Impl;
         CopyOnUpdPtr<Impl> impl_;
@@ -156,3 +159,10 @@ namespace osc
     bool operator==(const MaterialPropertyBlock&, const MaterialPropertyBlock&);
     std::ostream& operator<<(std::ostream&, const MaterialPropertyBlock&);
 }
+
+// hashes the block's properties, rather than its identity, so that it's consistent with
+// `operator==`, which compares the properties
+template<>
+struct std::hash<osc::MaterialPropertyBlock> final {
+    size_t operator()(const osc::MaterialPropertyBlock&) const;
+};
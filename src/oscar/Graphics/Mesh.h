@@ -1,9 +1,11 @@
 #pragma once
 
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshIndicesView.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/MeshUpdateFlags.h>
+#include <oscar/Graphics/VertexAttribute.h>
 #include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/Transform.h>
 #include <oscar/Maths/Triangle.h>
@@ -55,6 +57,16 @@ namespace osc
         void transform_vertices(const Transform&);
         void transform_vertices(const Mat4&);
 
+        // returns a read-only view of the vertices that (usually) doesn't copy them out of
+        // the mesh's vertex buffer (see `MeshAttributeView`)
+        MeshAttributeView<Vec3> vertices_view() const;
+
+        // returns a scoped view that edits the vertices in-place (see `MeshAttributeEdit`)
+        //
+        // the mesh's indices are range-checked, and its bounds are recalculated, once, when
+        // the edit ends
+        MeshAttributeEdit<Vec3> edit_vertices();
+
         // attribute: you can only set an equal amount of normals to the number of
         //            vertices (or zero, which means "clear them")
         bool has_normals() const;
@@ -65,6 +77,8 @@ namespace osc
             set_normals(std::span<const Vec3>{il});
         }
         void transform_normals(const std::function<Vec3(Vec3)>&);
+        MeshAttributeView<Vec3> normals_view() const;
+        MeshAttributeEdit<Vec3> edit_normals();
 
         // attribute: you can only set an equal amount of texture coordinates to
         //            the number of vertices (or zero, which means "clear them")
@@ -76,6 +90,7 @@ namespace osc
             set_tex_coords(std::span<const Vec2>{il});
         }
         void transform_tex_coords(const std::function<Vec2(Vec2)>&);
+        MeshAttributeView<Vec2> tex_coords_view() const;
 
         // attribute: you can only set an equal amount of colors to the number of
         //            vertices (or zero, which means "clear them")
@@ -179,6 +194,7 @@ namespace osc
     private:
         friend class GraphicsBackend;
         friend struct std::hash<Mesh>;
+        friend void detail::on_mesh_attribute_edited(Mesh&, VertexAttribute);
 
         class Impl;
         CopyOnUpdPtr<Impl> impl_;
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <oscar/Graphics/VertexAttribute.h>
+#include <oscar/Graphics/VertexAttributeFormat.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/Vec4.h>
+#include <oscar/Utils/Concepts.h>
+
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace osc { class Mesh; }
+
+namespace osc
+{
+    // satisfied by types that a vertex attribute can be viewed as, in-place, in a `Mesh`'s
+    // vertex buffer (i.e. types that have the same in-memory layout as a `Float32xN` attribute)
+    template<typename T>
+    concept MeshAttributeViewable = IsAnyOf<T, Vec2, Vec3, Vec4>;
+
+    // returns the `VertexAttributeFormat` that has the same in-memory layout as `T`
+    template<MeshAttributeViewable T>
+    constexpr VertexAttributeFormat float_vertex_attribute_format_of()
+    {
+        if constexpr (std::same_as<T, Vec2>) {
+            return VertexAttributeFormat::Float32x2;
+        }
+        else if constexpr (std::same_as<T, Vec3>) {
+            return VertexAttributeFormat::Float32x3;
+        }
+        else {
+            return VertexAttributeFormat::Float32x4;
+        }
+    }
+
+    namespace detail
+    {
+        // a random-access iterator over elements that are `stride` bytes apart
+        template<typename T>
+        class StridedAttributeIterator final {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = std::remove_const_t<T>;
+            using pointer = T*;
+            using reference = T&;
+            using iterator_category = std::random_access_iterator_tag;
+
+            using Byte = std::conditional_t<std::is_const_v<T>, const std::byte, std::byte>;
+
+            StridedAttributeIterator() = default;
+
+            StridedAttributeIterator(Byte* ptr, size_t stride) :
+                ptr_{ptr},
+                stride_{static_cast<difference_type>(stride)}
+            {}
+
+            reference operator*() const { return *reinterpret_cast<pointer>(ptr_); }
+            pointer operator->() const { return reinterpret_cast<pointer>(ptr_); }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            StridedAttributeIterator& operator++() { ptr_ += stride_; return *this; }
+            StridedAttributeIterator operator++(int) { auto copy = *this; ++(*this); return copy; }
+            StridedAttributeIterator& operator--() { ptr_ -= stride_; return *this; }
+            StridedAttributeIterator operator--(int) { auto copy = *this; --(*this); return copy; }
+            StridedAttributeIterator& operator+=(difference_type n) { ptr_ += n*stride_; return *this; }
+            StridedAttributeIterator& operator-=(difference_type n) { ptr_ -= n*stride_; return *this; }
+
+            friend StridedAttributeIterator operator+(StridedAttributeIterator it, difference_type n) { return it += n; }
+            friend StridedAttributeIterator operator+(difference_type n, StridedAttributeIterator it) { return it += n; }
+            friend StridedAttributeIterator operator-(StridedAttributeIterator it, difference_type n) { return it -= n; }
+            friend difference_type operator-(const StridedAttributeIterator& lhs, const StridedAttributeIterator& rhs)
+            {
+                return (lhs.ptr_ - rhs.ptr_) / lhs.stride_;
+            }
+
+            friend bool operator==(const StridedAttributeIterator& lhs, const StridedAttributeIterator& rhs) { return lhs.ptr_ == rhs.ptr_; }
+            friend auto operator<=>(const StridedAttributeIterator& lhs, const StridedAttributeIterator& rhs) { return lhs.ptr_ <=> rhs.ptr_; }
+        private:
+            Byte* ptr_ = nullptr;
+            difference_type stride_ = static_cast<difference_type>(sizeof(T));
+        };
+
+        // called when a `MeshAttributeEdit` ends (see `GraphicsImplementation.cpp`)
+        void on_mesh_attribute_edited(Mesh&, VertexAttribute);
+    }
+
+    // a read-only, strided, view of one vertex attribute (e.g. positions) of a `Mesh`
+    //
+    // the view reads directly from the mesh's (interleaved) vertex buffer, so it's cheaper than
+    // (e.g.) `Mesh::vertices`, which returns a decoded copy. If the attribute isn't stored in
+    // `T`'s format (e.g. a `Vec3` view of a `Float32x4` attribute), the view holds a decoded
+    // copy instead. Like a `std::span`, the view is invalidated if the mesh is modified.
+    template<MeshAttributeViewable T>
+    class MeshAttributeView final {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = const T&;
+        using const_reference = const T&;
+        using iterator = detail::StridedAttributeIterator<const T>;
+        using const_iterator = iterator;
+
+        MeshAttributeView() = default;
+
+        MeshAttributeView(const std::byte* data, size_t stride, size_t size) :
+            data_{data},
+            stride_{stride},
+            size_{size}
+        {}
+
+        explicit MeshAttributeView(std::vector<T> decoded) :
+            decoded_{std::make_shared<const std::vector<T>>(std::move(decoded))},
+            data_{reinterpret_cast<const std::byte*>(decoded_->data())},
+            stride_{sizeof(T)},
+            size_{decoded_->size()}
+        {}
+
+        size_type size() const { return size_; }
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+
+        // returns the number of bytes between consecutive elements
+        size_t stride() const { return stride_; }
+
+        iterator begin() const { return iterator{data_, stride_}; }
+        iterator end() const { return iterator{data_ + size_*stride_, stride_}; }
+
+        const T& operator[](size_type pos) const { return begin()[static_cast<difference_type>(pos)]; }
+
+        const T& at(size_type pos) const
+        {
+            if (pos >= size_) {
+                throw std::out_of_range{"attempted to access a MeshAttributeView with an invalid index"};
+            }
+            return (*this)[pos];
+        }
+
+    private:
+        std::shared_ptr<const std::vector<T>> decoded_;  // only set if the attribute had to be decoded
+        const std::byte* data_ = nullptr;
+        size_t stride_ = sizeof(T);
+        size_t size_ = 0;
+    };
+
+    // a scoped, mutable, strided view of one vertex attribute (e.g. positions) of a `Mesh`
+    //
+    // writes go directly into the mesh's vertex buffer. Any follow-up work (e.g. recalculating
+    // the mesh's bounds after editing its positions) happens once, when the edit is destroyed,
+    // rather than once per write. The mesh shouldn't be copied or modified via other methods
+    // while the edit is alive.
+    template<MeshAttributeViewable T>
+    class MeshAttributeEdit final {
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using reference = T&;
+        using iterator = detail::StridedAttributeIterator<T>;
+
+        MeshAttributeEdit(Mesh& mesh, VertexAttribute attribute, std::byte* data, size_t stride, size_t size) :
+            mesh_{&mesh},
+            attribute_{attribute},
+            data_{data},
+            stride_{stride},
+            size_{size}
+        {}
+        MeshAttributeEdit(const MeshAttributeEdit&) = delete;
+        MeshAttributeEdit(MeshAttributeEdit&& tmp) noexcept :
+            mesh_{std::exchange(tmp.mesh_, nullptr)},
+            attribute_{tmp.attribute_},
+            data_{tmp.data_},
+            stride_{tmp.stride_},
+            size_{tmp.size_}
+        {}
+        MeshAttributeEdit& operator=(const MeshAttributeEdit&) = delete;
+        MeshAttributeEdit& operator=(MeshAttributeEdit&&) noexcept = delete;
+        ~MeshAttributeEdit() noexcept
+        {
+            if (mesh_) {
+                detail::on_mesh_attribute_edited(*mesh_, attribute_);
+            }
+        }
+
+        size_type size() const { return size_; }
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+
+        iterator begin() const { return iterator{data_, stride_}; }
+        iterator end() const { return iterator{data_ + size_*stride_, stride_}; }
+
+        T& operator[](size_type pos) const { return begin()[static_cast<difference_type>(pos)]; }
+
+    private:
+        Mesh* mesh_;
+        VertexAttribute attribute_;
+        std::byte* data_;
+        size_t stride_;
+        size_t size_;
+    };
+}
@@ -1,8 +1,11 @@
 #include "MeshFunctions.h"
 
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Graphics/MeshVertexAdjacency.h>
+#include <oscar/Maths/AABBFunctions.h>
 #include <oscar/Maths/GeometricFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Sphere.h>
@@ -13,10 +16,13 @@
 #include <oscar/Maths/Vec4.h>
 #include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <cstddef>
 #include <cstdint>
 #include <ranges>
+#include <span>
 #include <vector>
 
 using namespace osc;
@@ -34,65 +40,32 @@ Vec3 osc::average_centroid_of(const Mesh& mesh)
     return Vec3{accumulator / static_cast<double>(i)};
 }
 
-std::vector<Vec4> osc::calc_tangent_vectors(
-    const MeshTopology& topology,
-    std::span<const Vec3> vertices,
-    std::span<const Vec3> normals,
-    std::span<const Vec2> tex_coords,
-    const MeshIndicesView& indices)
+namespace
 {
-    // related:
-    //
-    // *initial source: https://learnopengl.com/Advanced-Lighting/Normal-Mapping
-    // https://www.cs.utexas.edu/~fussell/courses/cs384g-spring2016/lectures/normal_mapping_tangent.pdf
-    // https://gamedev.stackexchange.com/questions/68612/how-to-compute-tangent-and-bitangent-vectors
-    // https://stackoverflow.com/questions/25349350/calculating-per-vertex-tangents-for-glsl
-    // http://www.terathon.com/code/tangent.html
-    // http://image.diku.dk/projects/media/morten.mikkelsen.08.pdf
-    // http://www.crytek.com/download/Triangle_mesh_tangent_space_calculation.pdf
-
-    std::vector<Vec4> rv;
-
-    // edge-case: there's insufficient topological/normal/coordinate data, so
-    //            return fallback-filled ({1,0,0,1}) vector
-    if (topology != MeshTopology::Triangles or
-        normals.empty() or
-        tex_coords.empty() or
-        indices.size() < 3) {
-
-        rv.assign(vertices.size(), {1.0f, 0.0f, 0.0f, 1.0f});
-        return rv;
-    }
-
-    // else: there must be enough data to compute the tangents
-    //
-    // (but, just to keep sane, assert that the mesh data is actually valid)
-    OSC_ASSERT_ALWAYS(ranges::all_of(indices, [&vertices, &normals, &tex_coords](auto index)
+    // calls `f` with a typed span of the given indices, so that hot loops don't have to
+    // `std::visit` the index type once per index
+    template<typename F>
+    decltype(auto) visit_typed_indices(const MeshIndicesView& indices, F&& f)
     {
-        return index < vertices.size() and index < normals.size() and index < tex_coords.size();
-    }) && "the provided mesh contains invalid indices");
+        if (indices.is_uint32()) {
+            return f(indices.to_uint32_span());
+        }
+        else {
+            return f(indices.to_uint16_span());
+        }
+    }
 
-    // for smooth shading, vertices, normals, texture coordinates, and tangents
-    // may be shared by multiple triangles. In this case, the tangents must be
-    // averaged, so:
-    //
-    // - initialize all tangent vectors to `{0,0,0,0}`s
-    // - initialize a weights vector filled with `0`s
-    // - every time a tangent vector is computed:
-    //     - accumulate a new average: `tangents[i] = (weights[i]*tangents[i] + new_tangent)/weights[i]+1;`
-    //     - increment weight: `weights[i]++`
-    rv.assign(vertices.size(), Vec4{});
-    std::vector<uint16_t> weights(vertices.size());
-    const auto accumulate_tangent = [&rv, &weights](auto i, const Vec4& new_tangent)
+    // writes the (orthogonalized) tangent of each corner of the triangle that starts at
+    // `triangle_begin` into `out`
+    template<typename Index>
+    void calc_triangle_corner_tangents(
+        const MeshAttributeView<Vec3>& vertices,
+        const MeshAttributeView<Vec3>& normals,
+        const MeshAttributeView<Vec2>& tex_coords,
+        std::span<const Index> indices,
+        size_t triangle_begin,
+        std::span<Vec4, 3> out)
     {
-        rv[i] = (static_cast<float>(weights[i])*rv[i] + new_tangent)/(static_cast<float>(weights[i]+1));
-        weights[i]++;
-    };
-
-    // compute tangent vectors from triangle primitives
-    OSC_ASSERT(indices.size() >= 3 && "insufficient indices provided to compute triangle tangents");  // checked above
-    for (size_t triangle_begin = 0, triangle_end = indices.size()-2; triangle_begin < triangle_end; triangle_begin += 3) {
-
         // compute edge vectors in object and tangent (UV) space
         const Vec3 e1 = vertices[indices[triangle_begin+1]] - vertices[indices[triangle_begin+0]];
         const Vec3 e2 = vertices[indices[triangle_begin+2]] - vertices[indices[triangle_begin+0]];
@@ -131,9 +104,124 @@ std::vector<Vec4> osc::calc_tangent_vectors(
             // (the shader can recompute the bitangent from: `cross(normal, tangent) * w`)
             const float w = dot(cross(normal, ortho_tangent), ortho_bitangent);
 
-            accumulate_tangent(triangle_vertex_index, Vec4{ortho_tangent, w});
+            out[ith_vertex] = Vec4{ortho_tangent, w};
         }
     }
+}
+
+std::vector<Vec4> osc::calc_tangent_vectors(
+    const MeshTopology& topology,
+    std::span<const Vec3> vertices,
+    std::span<const Vec3> normals,
+    std::span<const Vec2> tex_coords,
+    const MeshIndicesView& indices)
+{
+    // edge-case: there's insufficient topological/normal/coordinate data, so
+    //            return fallback-filled ({1,0,0,1}) vector
+    if (topology != MeshTopology::Triangles or
+        normals.empty() or
+        tex_coords.empty() or
+        indices.size() < 3) {
+
+        return std::vector<Vec4>(vertices.size(), {1.0f, 0.0f, 0.0f, 1.0f});
+    }
+
+    // else: there must be enough data to compute the tangents
+    //
+    // (but, just to keep sane, assert that the mesh data is actually valid)
+    OSC_ASSERT_ALWAYS(ranges::all_of(indices, [&vertices, &normals, &tex_coords](auto index)
+    {
+        return index < vertices.size() and index < normals.size() and index < tex_coords.size();
+    }) && "the provided mesh contains invalid indices");
+
+    return calc_tangent_vectors(
+        topology,
+        MeshAttributeView<Vec3>{reinterpret_cast<const std::byte*>(vertices.data()), sizeof(Vec3), vertices.size()},
+        MeshAttributeView<Vec3>{reinterpret_cast<const std::byte*>(normals.data()), sizeof(Vec3), normals.size()},
+        MeshAttributeView<Vec2>{reinterpret_cast<const std::byte*>(tex_coords.data()), sizeof(Vec2), tex_coords.size()},
+        indices,
+        MeshVertexAdjacency{indices, vertices.size()}
+    );
+}
+
+std::vector<Vec4> osc::calc_tangent_vectors(
+    const MeshTopology& topology,
+    const MeshAttributeView<Vec3>& vertices,
+    const MeshAttributeView<Vec3>& normals,
+    const MeshAttributeView<Vec2>& tex_coords,
+    const MeshIndicesView& indices,
+    const MeshVertexAdjacency& adjacency)
+{
+    // related:
+    //
+    // *initial source: https://learnopengl.com/Advanced-Lighting/Normal-Mapping
+    // https://www.cs.utexas.edu/~fussell/courses/cs384g-spring2016/lectures/normal_mapping_tangent.pdf
+    // https://gamedev.stackexchange.com/questions/68612/how-to-compute-tangent-and-bitangent-vectors
+    // https://stackoverflow.com/questions/25349350/calculating-per-vertex-tangents-for-glsl
+    // http://www.terathon.com/code/tangent.html
+    // http://image.diku.dk/projects/media/morten.mikkelsen.08.pdf
+    // http://www.crytek.com/download/Triangle_mesh_tangent_space_calculation.pdf
+
+    // edge-case: there's insufficient topological/normal/coordinate data, so
+    //            return fallback-filled ({1,0,0,1}) vector
+    if (topology != MeshTopology::Triangles or
+        normals.empty() or
+        tex_coords.empty() or
+        indices.size() < 3) {
+
+        return std::vector<Vec4>(vertices.size(), {1.0f, 0.0f, 0.0f, 1.0f});
+    }
+
+    OSC_ASSERT_ALWAYS(adjacency.num_vertices() == vertices.size() and adjacency.num_indices() == indices.size() && "the provided adjacency wasn't built from the provided mesh data");
+    OSC_ASSERT_ALWAYS(normals.size() >= vertices.size() and tex_coords.size() >= vertices.size() && "the provided mesh has fewer normals/texture coordinates than vertices");
+
+    // for smooth shading, vertices, normals, texture coordinates, and tangents
+    // may be shared by multiple triangles. In this case, the tangents must be
+    // averaged. This happens in two (parallelized) passes:
+    //
+    // - compute the tangent of each triangle corner (i.e. per index)
+    // - for each vertex, average the tangents of the corners that reference it
+    //
+    // the second pass visits each vertex's corners in the same (ascending) order that
+    // a serial pass over the triangles would, so the result doesn't depend on how the
+    // work is split between threads
+    constexpr size_t min_triangles_per_chunk = 2048;
+    constexpr size_t min_vertices_per_chunk = 4096;
+    ThreadPool& pool = ThreadPool::global();
+
+    const size_t num_triangles = indices.size()/3;
+    std::vector<Vec4> corner_tangents(3*num_triangles);
+    visit_typed_indices(indices, [&](auto typed_indices)
+    {
+        for_each_chunk_parallel(pool, min_triangles_per_chunk, num_triangles, [&](size_t first_triangle, size_t last_triangle)
+        {
+            for (size_t triangle = first_triangle; triangle < last_triangle; ++triangle) {
+                calc_triangle_corner_tangents(
+                    vertices,
+                    normals,
+                    tex_coords,
+                    typed_indices,
+                    3*triangle,
+                    std::span<Vec4, 3>{corner_tangents.data() + 3*triangle, 3}
+                );
+            }
+        });
+    });
+
+    std::vector<Vec4> rv(vertices.size());
+    for_each_chunk_parallel(pool, min_vertices_per_chunk, rv.size(), [&](size_t first_vertex, size_t last_vertex)
+    {
+        for (size_t vertex = first_vertex; vertex < last_vertex; ++vertex) {
+            // accumulate a running average: `avg = (weight*avg + new_tangent)/(weight+1)`
+            Vec4 average{};
+            size_t weight = 0;
+            for (const uint32_t corner : adjacency.corners_of(vertex)) {
+                average = (static_cast<float>(weight)*average + corner_tangents[corner])/(static_cast<float>(weight+1));
+                ++weight;
+            }
+            rv[vertex] = average;
+        }
+    });
     return rv;
 }
 
@@ -174,5 +262,18 @@ Vec3 osc::mass_center_of(const Mesh& mesh)
 
 Sphere osc::bounding_sphere_of(const Mesh& mesh)
 {
-    return bounding_sphere_of(mesh.vertices());
+    // equivalent to `bounding_sphere_of(mesh.vertices())`, but reads the vertices in-place
+    const MeshAttributeView<Vec3> vertices = mesh.vertices_view();
+    if (vertices.empty()) {
+        return Sphere{.radius = 0.0f};
+    }
+
+    const Vec3 origin = centroid_of(bounding_aabb_of(vertices));
+
+    float r2 = 0.0f;
+    for (const Vec3& vertex : vertices) {
+        r2 = max(r2, length2(vertex - origin));
+    }
+
+    return {.origin = origin, .radius = sqrt(r2)};
 }
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/MeshIndicesView.h>
+#include <oscar/Graphics/MeshVertexAdjacency.h>
 #include <oscar/Maths/Sphere.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
@@ -37,6 +39,19 @@ namespace osc
         const MeshIndicesView&
     );
 
+    // as above, but reads the vertex data via (possibly, strided) views and computes the
+    // tangents in parallel, using an adjacency that was built from the same indices
+    //
+    // the result is identical to the above, regardless of how many threads are used
+    std::vector<Vec4> calc_tangent_vectors(
+        const MeshTopology&,
+        const MeshAttributeView<Vec3>& vertices,
+        const MeshAttributeView<Vec3>& normals,
+        const MeshAttributeView<Vec2>& tex_coords,
+        const MeshIndicesView&,
+        const MeshVertexAdjacency&
+    );
+
     // returns the bounding sphere of the given mesh
     Sphere bounding_sphere_of(const Mesh&);
 }
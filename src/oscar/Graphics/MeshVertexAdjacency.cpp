@@ -0,0 +1,58 @@
+#include "MeshVertexAdjacency.h"
+
+#include <oscar/Graphics/MeshIndicesView.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    template<typename Index>
+    void build_adjacency(
+        std::span<const Index> indices,
+        size_t num_vertices,
+        std::vector<uint32_t>& first_corner,
+        std::vector<uint32_t>& corners)
+    {
+        // counting sort: count each vertex's corners, prefix-sum the counts into offsets, then
+        // scatter each corner (in ascending order) into its vertex's range
+        first_corner.assign(num_vertices + 1, 0);
+        for (const Index index : indices) {
+            if (index >= num_vertices) {
+                throw std::out_of_range{"a mesh index is out-of-range of the mesh's vertices"};
+            }
+            ++first_corner[index + 1];
+        }
+        for (size_t i = 1; i < first_corner.size(); ++i) {
+            first_corner[i] += first_corner[i-1];
+        }
+
+        corners.resize(indices.size());
+        std::vector<uint32_t> cursors(first_corner.begin(), first_corner.end() - 1);
+        for (size_t corner = 0; corner < indices.size(); ++corner) {
+            corners[cursors[indices[corner]]++] = static_cast<uint32_t>(corner);
+        }
+    }
+}
+
+osc::MeshVertexAdjacency::MeshVertexAdjacency(const MeshIndicesView& indices, size_t num_vertices) :
+    num_indices_{indices.size()}
+{
+    const size_t num_triangle_indices = 3*(indices.size()/3);
+    if (num_triangle_indices > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error{"a mesh has too many indices to compute its vertex adjacency"};
+    }
+
+    if (indices.is_uint32()) {
+        build_adjacency(indices.to_uint32_span().first(num_triangle_indices), num_vertices, first_corner_, corners_);
+    }
+    else {
+        build_adjacency(indices.to_uint16_span().first(num_triangle_indices), num_vertices, first_corner_, corners_);
+    }
+}
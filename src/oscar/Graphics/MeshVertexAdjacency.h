@@ -0,0 +1,43 @@
+#pragma once
+
+#include <oscar/Graphics/MeshIndicesView.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace osc
+{
+    // a compressed (CSR) mapping from each vertex of a triangle mesh to the "corners" (offsets
+    // into the mesh's index buffer) that reference it
+    //
+    // each vertex's corners are stored in ascending order, so algorithms that reduce over a
+    // vertex's corners (e.g. averaging face normals) produce the same result as a serial pass
+    // over the mesh's triangles, regardless of how the vertices are split across threads.
+    // Only whole triangles are included: trailing indices that don't form a triangle are ignored.
+    class MeshVertexAdjacency final {
+    public:
+        MeshVertexAdjacency() = default;
+
+        // throws if any of the (triangle) indices are out-of-range of `num_vertices`
+        MeshVertexAdjacency(const MeshIndicesView&, size_t num_vertices);
+
+        // returns the number of vertices that the adjacency was built for
+        size_t num_vertices() const { return first_corner_.empty() ? 0 : first_corner_.size() - 1; }
+
+        // returns the number of indices that the adjacency was built for
+        size_t num_indices() const { return num_indices_; }
+
+        // returns the offsets (in ascending order) of the indices that reference `vertex`
+        std::span<const uint32_t> corners_of(size_t vertex) const
+        {
+            return std::span<const uint32_t>{corners_}.subspan(first_corner_[vertex], first_corner_[vertex+1] - first_corner_[vertex]);
+        }
+
+    private:
+        size_t num_indices_ = 0;
+        std::vector<uint32_t> first_corner_;
+        std::vector<uint32_t> corners_;
+    };
+}
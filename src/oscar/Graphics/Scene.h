@@ -1,6 +1,8 @@
 #pragma once
 
 #include <oscar/Graphics/Scene/CachedSceneRenderer.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+#include <oscar/Graphics/Scene/MeshHitTestData.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
@@ -9,3 +11,4 @@
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Scene/SceneRenderer.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Scene/SceneRendererStats.h>
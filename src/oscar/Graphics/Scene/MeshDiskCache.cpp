@@ -0,0 +1,516 @@
+#include "MeshDiskCache.h"
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/Scene/SceneHelpers.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHNode.h>
+#include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Platform/Log.h>
+#include <oscar/Utils/Concepts.h>
+#include <oscar/Utils/ObjectRepresentation.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    constexpr std::array<char, 8> c_entry_magic = {'O', 'S', 'C', 'M', 'E', 'S', 'H', '\0'};
+    constexpr uint32_t c_entry_format_version = 1;
+    constexpr uint32_t c_entry_byte_order_mark = 0x01020304;
+    constexpr size_t c_entry_section_alignment = 16;
+    constexpr size_t c_io_chunk_size = static_cast<size_t>(1) << 16;
+
+    // fixed-size header at the start of each cache entry file
+    //
+    // it's followed by `c_entry_section_alignment`-aligned sections, in this order: the
+    // source path, vertices, normals, indices (`uint32_t`), BVH nodes, and BVH prims
+    struct EntryHeader final {
+        std::array<char, 8> magic = c_entry_magic;
+        uint32_t format_version = c_entry_format_version;
+        uint32_t byte_order_mark = c_entry_byte_order_mark;
+        uint64_t sizeof_bvh_node = sizeof(BVHNode);
+        uint64_t sizeof_bvh_prim = sizeof(BVHPrim);
+
+        // key
+        uint64_t source_path_size = 0;
+        int64_t source_modification_time = 0;
+        uint64_t source_size = 0;
+        uint64_t source_content_hash = 0;
+
+        // payload
+        uint64_t num_vertices = 0;
+        uint64_t num_normals = 0;
+        uint64_t num_indices = 0;
+        uint64_t num_bvh_nodes = 0;
+        uint64_t num_bvh_prims = 0;
+    };
+    static_assert(BitCastable<EntryHeader>);
+    static_assert(BitCastable<Vec3> and BitCastable<BVHNode> and BitCastable<BVHPrim>);
+
+    // identifies one version of a source mesh file
+    //
+    // the content hash is only computed on demand, because it requires reading the whole
+    // file, whereas the rest of the key only requires a `stat`
+    struct SourceFileKey final {
+        std::string path;
+        std::filesystem::file_time_type modification_time;
+        uint64_t size = 0;
+        mutable std::optional<uint64_t> maybe_content_hash;
+
+        int64_t modification_time_count() const
+        {
+            return static_cast<int64_t>(modification_time.time_since_epoch().count());
+        }
+
+        // returns the hash of the source file's content, or `std::nullopt` if it couldn't be read
+        std::optional<uint64_t> content_hash() const;
+    };
+
+    // filesystem modification times are coarse (e.g. FAT's are 2 s), so an unchanged
+    // modification time can't be trusted if the source file was modified this close to
+    // (or after) its cache entry being written
+    constexpr auto c_modification_time_ambiguity_window = std::chrono::seconds{2};
+
+    // a fast, non-cryptographic, 64-bit hash that's stable between runs/builds (unlike
+    // `std::hash`), which is necessary because it's persisted to disk
+    class ContentHasher final {
+    public:
+        void update(std::span<const char> bytes)
+        {
+            // (callers must only provide a tail on the last call)
+            size_t i = 0;
+            for (; i + sizeof(uint64_t) <= bytes.size(); i += sizeof(uint64_t)) {
+                uint64_t word = 0;
+                std::memcpy(&word, bytes.data() + i, sizeof(word));
+                mix(word);
+            }
+            for (; i < bytes.size(); ++i) {
+                mix(static_cast<uint8_t>(bytes[i]));
+            }
+        }
+
+        uint64_t digest() const { return state_; }
+
+    private:
+        void mix(uint64_t word)
+        {
+            state_ ^= word;
+            state_ *= 0x9e3779b97f4a7c15;
+            state_ ^= state_ >> 32;
+        }
+
+        uint64_t state_ = 0xcbf29ce484222325;
+    };
+
+    std::optional<uint64_t> try_hash_file_content(const std::filesystem::path& path)
+    {
+        std::ifstream in{path, std::ios::binary};
+        if (not in) {
+            return std::nullopt;
+        }
+
+        ContentHasher hasher;
+        std::vector<char> chunk(c_io_chunk_size);
+        while (in) {
+            in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            hasher.update({chunk.data(), static_cast<size_t>(in.gcount())});
+        }
+        return in.eof() ? std::optional{hasher.digest()} : std::nullopt;
+    }
+
+    std::optional<uint64_t> SourceFileKey::content_hash() const
+    {
+        if (not maybe_content_hash) {
+            maybe_content_hash = try_hash_file_content(path);
+        }
+        return maybe_content_hash;
+    }
+
+    std::optional<SourceFileKey> try_compute_key(const std::filesystem::path& mesh_file)
+    {
+        std::error_code ec;
+        const std::filesystem::path absolute_path = std::filesystem::absolute(mesh_file, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const auto modification_time = std::filesystem::last_write_time(absolute_path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        const auto size = std::filesystem::file_size(absolute_path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+
+        return SourceFileKey{
+            .path = absolute_path.string(),
+            .modification_time = modification_time,
+            .size = static_cast<uint64_t>(size),
+            .maybe_content_hash = std::nullopt,
+        };
+    }
+
+    // returns `true` if the entry with the given header was written for the same version of
+    // the source file as `key`
+    //
+    // the source's (path, size, modification time) are checked first, because that only
+    // requires a `stat`. The source's content is only hashed if they're inconclusive, i.e.
+    // if the modification time differs (e.g. the file was `touch`ed or re-checked-out) or
+    // is too close to when the entry was written to be trusted
+    bool is_entry_for(
+        const EntryHeader& header,
+        const std::filesystem::file_time_type& entry_modification_time,
+        const SourceFileKey& key)
+    {
+        if (header.source_path_size != key.path.size() or header.source_size != key.size) {
+            return false;  // (a different size means different content)
+        }
+
+        const bool modification_time_is_unambiguous =
+            header.source_modification_time == key.modification_time_count() and
+            key.modification_time + c_modification_time_ambiguity_window < entry_modification_time;
+
+        if (modification_time_is_unambiguous) {
+            return true;
+        }
+        const auto content_hash = key.content_hash();
+        return content_hash and *content_hash == header.source_content_hash;
+    }
+
+    // updates the source modification time in the header of an existing entry, so that
+    // subsequent lookups don't need to hash the source file's content (best-effort)
+    void try_update_entry_modification_time(const std::filesystem::path& entry_path, const SourceFileKey& key)
+    {
+        std::fstream io{entry_path, std::ios::binary | std::ios::in | std::ios::out};
+        io.seekp(static_cast<std::streamoff>(offsetof(EntryHeader, source_modification_time)));
+        const int64_t modification_time = key.modification_time_count();
+        io.write(reinterpret_cast<const char*>(&modification_time), sizeof(modification_time));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    // returns the path to the entry file for `key` (the other parts of the key are
+    // checked after opening it)
+    std::filesystem::path entry_path_of(const std::filesystem::path& directory, const SourceFileKey& key)
+    {
+        ContentHasher hasher;
+        hasher.update(key.path);
+
+        std::stringstream filename;
+        filename << std::hex << hasher.digest() << ".oscmesh";
+        return directory / filename.str();
+    }
+
+    constexpr size_t aligned_section_offset(size_t offset)
+    {
+        return (offset + c_entry_section_alignment - 1) & ~(c_entry_section_alignment - 1);
+    }
+
+    // returns the expected size, in bytes, of an entry file with the given header
+    size_t entry_size_of(const EntryHeader& header)
+    {
+        size_t rv = sizeof(EntryHeader);
+        rv = aligned_section_offset(rv) + header.source_path_size;
+        rv = aligned_section_offset(rv) + header.num_vertices * sizeof(Vec3);
+        rv = aligned_section_offset(rv) + header.num_normals * sizeof(Vec3);
+        rv = aligned_section_offset(rv) + header.num_indices * sizeof(uint32_t);
+        rv = aligned_section_offset(rv) + header.num_bvh_nodes * sizeof(BVHNode);
+        rv = aligned_section_offset(rv) + header.num_bvh_prims * sizeof(BVHPrim);
+        return rv;
+    }
+
+    // writes aligned sections to an entry file
+    class EntryWriter final {
+    public:
+        explicit EntryWriter(std::ostream& out) : out_{&out} {}
+
+        void write_section(std::span<const std::byte> bytes)
+        {
+            const size_t section_begin = aligned_section_offset(offset_);
+            for (; offset_ < section_begin; ++offset_) {
+                out_->put('\0');
+            }
+            out_->write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            offset_ += bytes.size();
+        }
+
+    private:
+        std::ostream* out_;
+        size_t offset_ = 0;
+    };
+
+    // reads aligned sections from an entry file
+    class EntryReader final {
+    public:
+        // `offset` is the current offset of `in` into the entry file
+        EntryReader(std::istream& in, size_t offset) : in_{&in}, offset_{offset} {}
+
+        // reads `n` elements of `T` from the next section, or returns `false` on error
+        template<BitCastable T>
+        bool read_section(std::vector<T>& out, size_t n, const T& prototype = {})
+        {
+            const size_t section_begin = aligned_section_offset(offset_);
+            in_->ignore(static_cast<std::streamsize>(section_begin - offset_));
+
+            out.assign(n, prototype);
+            const size_t num_bytes = n * sizeof(T);
+            in_->read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(num_bytes));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            offset_ = section_begin + num_bytes;
+            return static_cast<bool>(*in_);
+        }
+
+    private:
+        std::istream* in_;
+        size_t offset_;
+    };
+
+    // returns `true` if the (untrusted, read from disk) data forms a valid triangle mesh + BVH
+    bool is_valid_entry_payload(
+        const std::vector<Vec3>& vertices,
+        const std::vector<Vec3>& normals,
+        const std::vector<uint32_t>& indices,
+        const std::vector<BVHNode>& nodes,
+        const std::vector<BVHPrim>& prims)
+    {
+        if ((not normals.empty() and normals.size() != vertices.size()) or indices.size() % 3 != 0) {
+            return false;
+        }
+        for (uint32_t index : indices) {
+            if (index >= vertices.size()) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const bool in_bounds = nodes[i].is_leaf() ?
+                nodes[i].first_prim_offset() < prims.size() :
+                i + nodes[i].num_lhs_nodes() + 1 < nodes.size();
+            if (not in_bounds) {
+                return false;
+            }
+        }
+        for (const BVHPrim& prim : prims) {
+            if (prim.id() < 0 or static_cast<size_t>(prim.id()) + 2 >= indices.size()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::optional<MeshDiskCacheEntry> try_read_entry(const std::filesystem::path& entry_path, const SourceFileKey& key)
+    {
+        std::error_code ec;
+        const auto entry_size = std::filesystem::file_size(entry_path, ec);
+        if (ec) {
+            return std::nullopt;  // no entry (the usual case for a cache miss)
+        }
+        const auto entry_modification_time = std::filesystem::last_write_time(entry_path, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+
+        std::ifstream in{entry_path, std::ios::binary};
+        if (not in) {
+            return std::nullopt;
+        }
+
+        EntryHeader header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (not in or
+            header.magic != c_entry_magic or
+            header.format_version != c_entry_format_version or
+            header.byte_order_mark != c_entry_byte_order_mark or
+            header.sizeof_bvh_node != sizeof(BVHNode) or
+            header.sizeof_bvh_prim != sizeof(BVHPrim) or
+            entry_size_of(header) != entry_size or
+            not is_entry_for(header, entry_modification_time, key)) {
+
+            return std::nullopt;  // stale, or from an incompatible build
+        }
+
+        EntryReader reader{in, sizeof(header)};
+        std::vector<char> source_path;
+        std::vector<Vec3> vertices;
+        std::vector<Vec3> normals;
+        std::vector<uint32_t> indices;
+        std::vector<BVHNode> nodes;
+        std::vector<BVHPrim> prims;
+
+        const bool ok =
+            reader.read_section(source_path, header.source_path_size) and
+            reader.read_section(vertices, header.num_vertices) and
+            reader.read_section(normals, header.num_normals) and
+            reader.read_section(indices, header.num_indices) and
+            reader.read_section(nodes, header.num_bvh_nodes, BVHNode::leaf({}, 0)) and
+            reader.read_section(prims, header.num_bvh_prims, BVHPrim{0, {}});
+
+        if (not ok or
+            std::string_view{source_path.data(), source_path.size()} != key.path or
+            not is_valid_entry_payload(vertices, normals, indices, nodes, prims)) {
+
+            return std::nullopt;  // hash collision on the path, or corrupted
+        }
+
+        if (header.source_modification_time != key.modification_time_count()) {
+            in.close();
+            try_update_entry_modification_time(entry_path, key);
+        }
+
+        MeshDiskCacheEntry rv;
+        rv.mesh.set_vertices(vertices);
+        rv.mesh.set_normals(normals);
+        rv.mesh.set_indices(indices);
+        rv.bvh.assign(nodes, prims);
+        return rv;
+    }
+
+    bool try_write_entry(const std::filesystem::path& entry_path, const SourceFileKey& key, const Mesh& mesh, const BVH& bvh)
+    {
+        const auto content_hash = key.content_hash();
+        if (not content_hash) {
+            return false;
+        }
+
+        const std::vector<Vec3> vertices = mesh.vertices();
+        const std::vector<Vec3> normals = mesh.normals();
+        std::vector<uint32_t> indices;
+        indices.reserve(mesh.num_indices());
+        for (uint32_t index : mesh.indices()) {
+            indices.push_back(index);
+        }
+
+        const EntryHeader header{
+            .source_path_size = key.path.size(),
+            .source_modification_time = key.modification_time_count(),
+            .source_size = key.size,
+            .source_content_hash = *content_hash,
+            .num_vertices = vertices.size(),
+            .num_normals = normals.size(),
+            .num_indices = indices.size(),
+            .num_bvh_nodes = bvh.nodes().size(),
+            .num_bvh_prims = bvh.prims().size(),
+        };
+
+        // write to a uniquely-named temporary file and then rename it, so that concurrent
+        // readers/writers never see a partially-written entry
+        std::stringstream tmp_suffix;
+        tmp_suffix << ".tmp" << std::this_thread::get_id();
+        std::filesystem::path tmp_path = entry_path;
+        tmp_path += tmp_suffix.str();
+        {
+            std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+            if (not out) {
+                return false;
+            }
+
+            EntryWriter writer{out};
+            writer.write_section(view_object_representation(header));
+            writer.write_section(std::as_bytes(std::span<const char>{key.path}));
+            writer.write_section(view_object_representations(vertices));
+            writer.write_section(view_object_representations(normals));
+            writer.write_section(view_object_representations(indices));
+            writer.write_section(view_object_representations(bvh.nodes()));
+            writer.write_section(view_object_representations(bvh.prims()));
+
+            if (not out.flush()) {
+                out.close();
+                std::error_code ec;
+                std::filesystem::remove(tmp_path, ec);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, entry_path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+        return true;
+    }
+
+    std::optional<MeshDiskCacheEntry> try_load_entry(const std::filesystem::path& directory, const SourceFileKey& key)
+    {
+        try {
+            return try_read_entry(entry_path_of(directory, key), key);
+        }
+        catch (const std::exception& ex) {
+            log_warn("%s: error reading mesh cache entry: %s", key.path.c_str(), ex.what());
+            return std::nullopt;
+        }
+    }
+
+    bool try_store_entry(const std::filesystem::path& directory, const SourceFileKey& key, const Mesh& mesh, const BVH& bvh)
+    {
+        if (mesh.topology() != MeshTopology::Triangles) {
+            return false;  // unsupported
+        }
+
+        try {
+            std::filesystem::create_directories(directory);
+            if (try_write_entry(entry_path_of(directory, key), key, mesh, bvh)) {
+                return true;
+            }
+            log_warn("%s: could not write mesh cache entry to %s", key.path.c_str(), directory.string().c_str());
+        }
+        catch (const std::exception& ex) {
+            log_warn("%s: error writing mesh cache entry: %s", key.path.c_str(), ex.what());
+        }
+        return false;
+    }
+}
+
+osc::MeshDiskCache::MeshDiskCache(std::filesystem::path directory) :
+    directory_{std::move(directory)}
+{}
+
+std::optional<MeshDiskCacheEntry> osc::MeshDiskCache::try_load(const std::filesystem::path& mesh_file) const
+{
+    const auto key = try_compute_key(mesh_file);
+    return key ? try_load_entry(directory_, *key) : std::nullopt;
+}
+
+bool osc::MeshDiskCache::store(const std::filesystem::path& mesh_file, const Mesh& mesh, const BVH& bvh) const
+{
+    const auto key = try_compute_key(mesh_file);
+    return key ? try_store_entry(directory_, *key, mesh, bvh) : false;
+}
+
+MeshDiskCacheEntry osc::MeshDiskCache::load_or_decode(
+    const std::filesystem::path& mesh_file,
+    const std::function<Mesh()>& decoder) const
+{
+    const auto key = try_compute_key(mesh_file);
+    if (key) {
+        if (auto entry = try_load_entry(directory_, *key)) {
+            return std::move(entry).value();
+        }
+    }
+
+    MeshDiskCacheEntry rv;
+    rv.mesh = decoder();
+    rv.bvh = create_triangle_bvh(rv.mesh);
+    if (key) {
+        try_store_entry(directory_, *key, rv.mesh, rv.bvh);
+    }
+    return rv;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/BVH.h>
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+
+namespace osc
+{
+    // a `Mesh` that was decoded from a mesh file, plus its triangle `BVH`
+    struct MeshDiskCacheEntry final {
+        Mesh mesh;
+        BVH bvh;
+    };
+
+    // a persistent, on-disk, cache of decoded mesh files (e.g. `.vtp`, `.obj`, `.stl`) and
+    // their triangle `BVH`s
+    //
+    // entries are keyed by the mesh file's absolute path, modification time, size, and a
+    // hash of its content, so editing the source file invalidates its entry. Lookups only
+    // hash the source file's content if its modification time differs from (or is too
+    // close to) the entry's, so a typical cache hit doesn't read the source file. Each entry
+    // is stored as a single flat binary file with aligned arrays (vertices, normals,
+    // indices, BVH nodes/prims), so that loading it is a handful of bulk reads, rather
+    // than a parse + BVH build.
+    //
+    // only the vertices, normals, and (triangle) indices of a `Mesh` are persisted, which
+    // matches what mesh file loaders (e.g. `LoadMeshViaSimTK`) produce
+    //
+    // the cache is best-effort: I/O errors are logged and handled as cache misses
+    class MeshDiskCache final {
+    public:
+        explicit MeshDiskCache(std::filesystem::path directory);
+
+        // returns the directory that cache entries are written to
+        const std::filesystem::path& directory() const { return directory_; }
+
+        // returns the cached entry for `mesh_file`, or `std::nullopt` if no valid
+        // (i.e. up-to-date) entry exists for it
+        std::optional<MeshDiskCacheEntry> try_load(const std::filesystem::path& mesh_file) const;
+
+        // writes `mesh` and `bvh` to the cache as the entry for `mesh_file`, returning
+        // `true` if it was successfully written
+        bool store(const std::filesystem::path& mesh_file, const Mesh& mesh, const BVH& bvh) const;
+
+        // returns the cached entry for `mesh_file` if it's valid; otherwise, calls `decoder`,
+        // builds the decoded mesh's triangle BVH, stores both in the cache, and returns them
+        MeshDiskCacheEntry load_or_decode(
+            const std::filesystem::path& mesh_file,
+            const std::function<Mesh()>& decoder
+        ) const;
+
+    private:
+        std::filesystem::path directory_;
+    };
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace osc
+{
+    // the data needed to hit-test a triangle `Mesh` without going through the `Mesh`
+    //
+    // `vertices` and `indices` are contiguous copies of the mesh's vertex positions and
+    // triangle indices, so that ray-triangle tests against `triangle_bvh`'s leaves read
+    // straight from memory, rather than fetching each triangle via `Mesh::get_triangle_at`
+    struct MeshHitTestData final {
+        BVH triangle_bvh;
+        std::vector<Vec3> vertices;
+        std::vector<uint32_t> indices;
+    };
+}
@@ -3,6 +3,8 @@
 #include <oscar/Graphics/Geometries.h>
 #include <oscar/Graphics/Materials/MeshBasicMaterial.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+#include <oscar/Graphics/Scene/MeshHitTestData.h>
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 #include <oscar/Graphics/Shader.h>
 #include <oscar/Maths/BVH.h>
@@ -10,14 +12,24 @@
 #include <oscar/Platform/Log.h>
 #include <oscar/Platform/ResourceLoader.h>
 #include <oscar/Platform/ResourcePath.h>
+#include <oscar/Utils/Algorithms.h>
 #include <oscar/Utils/HashHelpers.h>
+#include <oscar/Utils/ScopeGuard.h>
 #include <oscar/Utils/SynchronizedValue.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <ankerl/unordered_dense.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <exception>
+#include <filesystem>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -82,6 +94,99 @@ namespace
         rv.set_indices({0, 1});
         return rv;
     }
+
+    // a lazily-loaded mesh
+    //
+    // each entry has its own mutex, so that loading one mesh doesn't block lookups
+    // (or loads) of other meshes
+    class MeshCacheEntry final {
+    public:
+        explicit MeshCacheEntry(Mesh placeholder) :
+            mesh_{std::move(placeholder)}
+        {}
+
+        // returns the mesh, calling `getter` on the calling thread to load it if it hasn't
+        // already been loaded (blocks if another thread is currently loading it)
+        Mesh get_or_load(const std::function<Mesh()>& getter)
+        {
+            const std::lock_guard lock{mutex_};
+            if (not is_loaded_) {
+                is_loaded_ = true;  // set first, so that the placeholder is used if `getter` throws
+                mesh_ = getter();
+            }
+            return mesh_;
+        }
+
+    private:
+        std::mutex mutex_;
+        bool is_loaded_ = false;
+        Mesh mesh_;
+    };
+
+    // lazily-built hit-testing data (triangle BVH, etc.) for a single mesh
+    //
+    // each entry has its own mutex, so that building one mesh's BVH doesn't block
+    // lookups (or builds) of other meshes' BVHs
+    class BVHCacheEntry final {
+    public:
+        // returns the hit-testing data if it has already been built, or `nullptr` otherwise
+        const MeshHitTestData* try_get() const
+        {
+            return is_built_.load(std::memory_order_acquire) ? &data_ : nullptr;
+        }
+
+        // returns the hit-testing data, building it on the calling thread if necessary
+        const MeshHitTestData& get_or_build(const Mesh& mesh)
+        {
+            if (const MeshHitTestData* data = try_get()) {
+                return *data;
+            }
+
+            const std::lock_guard lock{build_mutex_};
+            if (not is_built_.load(std::memory_order_relaxed)) {
+                data_ = create_mesh_hit_test_data(mesh);
+                is_built_.store(true, std::memory_order_release);
+            }
+            return data_;
+        }
+
+        // returns `true` if the caller should start building the hit-testing data in the
+        // background (i.e. it isn't built and no other background build is in progress), in
+        // which case the caller must call `end_background_build` once the build has finished
+        bool try_begin_background_build()
+        {
+            return not is_built_.load(std::memory_order_acquire) and
+                not is_building_in_background_.exchange(true, std::memory_order_acq_rel);
+        }
+
+        // marks a background build (successful, or not) as finished, so that a failed build
+        // is retried by the next `try_begin_background_build`
+        void end_background_build()
+        {
+            is_building_in_background_.store(false, std::memory_order_release);
+        }
+
+        // sets the hit-testing data to use `bvh` as the mesh's triangle BVH, unless it has
+        // already been built
+        void set_if_not_built(const Mesh& mesh, BVH&& bvh)
+        {
+            const std::lock_guard lock{build_mutex_};
+            if (not is_built_.load(std::memory_order_relaxed)) {
+                data_ = create_mesh_hit_test_data(mesh, std::move(bvh));
+                is_built_.store(true, std::memory_order_release);
+            }
+        }
+
+    private:
+        std::mutex build_mutex_;
+        std::atomic<bool> is_built_ = false;
+        std::atomic<bool> is_building_in_background_ = false;
+        MeshHitTestData data_;
+    };
+
+    // the BVH cache is sharded by mesh hash, so that concurrent lookups of different
+    // meshes are unlikely to contend on the same mutex
+    constexpr size_t c_num_bvh_cache_shards = 16;
 }
 
 template<>
@@ -114,7 +219,9 @@ public:
     void clear_meshes()
     {
         mesh_cache.lock()->clear();
-        bvh_cache.lock()->clear();
+        for (auto& shard : bvh_cache_shards_) {
+            shard.lock()->clear();
+        }
         torus_cache.lock()->clear();
     }
 
@@ -122,14 +229,65 @@ public:
         const std::string& key,
         const std::function<Mesh()>& getter)
     {
-        auto guard = mesh_cache.lock();
+        // the cache-wide lock is only held while finding the entry (not while `getter`
+        // runs), so that slow loads don't block lookups of other meshes
+        std::shared_ptr<MeshCacheEntry> entry;
+        {
+            auto guard = mesh_cache.lock();
+            auto [it, inserted] = guard->try_emplace(key, nullptr);
+            if (inserted) {
+                it->second = std::make_shared<MeshCacheEntry>(cube);
+            }
+            entry = it->second;
+        }
+        return entry->get_or_load(getter);
+    }
 
-        auto [it, inserted] = guard->try_emplace(key, cube);
-        if (inserted) {
-            it->second = getter();
+    void set_mesh_disk_cache(std::shared_ptr<const MeshDiskCache> mesh_disk_cache)
+    {
+        auto guard = mesh_disk_cache_.lock();
+        *guard = std::move(mesh_disk_cache);
+    }
+
+    Mesh get_mesh_file(
+        const std::filesystem::path& mesh_file,
+        const std::function<Mesh()>& getter)
+    {
+        const std::shared_ptr<const MeshDiskCache> mesh_disk_cache = *mesh_disk_cache_.lock();
+        if (not mesh_disk_cache) {
+            return get_mesh(mesh_file.string(), getter);
         }
 
-        return it->second;
+        return get_mesh(mesh_file.string(), [this, &mesh_disk_cache, &mesh_file, &getter]()
+        {
+            MeshDiskCacheEntry entry = mesh_disk_cache->load_or_decode(mesh_file, getter);
+            get_or_insert_bvh_entry(entry.mesh)->set_if_not_built(entry.mesh, std::move(entry.bvh));
+            return entry.mesh;
+        });
+    }
+
+    void preload_mesh_files(
+        std::span<const std::filesystem::path> mesh_files,
+        const std::function<Mesh(const std::filesystem::path&)>& loader)
+    {
+        std::vector<std::future<Mesh>> loads;
+        loads.reserve(mesh_files.size());
+        for (const std::filesystem::path& mesh_file : mesh_files) {
+            // capturing by reference is fine: this function blocks until all loads complete
+            loads.push_back(mesh_loading_pool().submit([this, &mesh_file, &loader]()
+            {
+                return get_mesh_file(mesh_file, [&mesh_file, &loader]() { return loader(mesh_file); });
+            }));
+        }
+
+        for (size_t i = 0; i < loads.size(); ++i) {
+            try {
+                loads[i].get();
+            }
+            catch (const std::exception& ex) {
+                log_error("%s: error loading mesh file: %s", mesh_files[i].string().c_str(), ex.what());
+            }
+        }
     }
 
     Mesh sphere_mesh() { return sphere; }
@@ -164,12 +322,32 @@ public:
 
     const BVH& get_bvh(const Mesh& mesh)
     {
-        auto guard = bvh_cache.lock();
-        auto [it, inserted] = guard->try_emplace(mesh, nullptr);
-        if (inserted) {
-            it->second = std::make_unique<BVH>(create_triangle_bvh(mesh));
+        return get_or_insert_bvh_entry(mesh)->get_or_build(mesh).triangle_bvh;
+    }
+
+    const MeshHitTestData* try_get_hit_test_data(const Mesh& mesh)
+    {
+        std::shared_ptr<BVHCacheEntry> entry = get_or_insert_bvh_entry(mesh);
+        if (const MeshHitTestData* data = entry->try_get()) {
+            return data;
         }
-        return *it->second;
+
+        if (entry->try_begin_background_build()) {
+            // the worker only holds onto the entry + mesh (not `this`), so it's fine
+            // if the cache is cleared/destroyed while the BVH is being built
+            bvh_build_pool().post([entry = std::move(entry), mesh]()
+            {
+                const ScopeGuard guard{[&entry]() { entry->end_background_build(); }};
+                try {
+                    entry->get_or_build(mesh);
+                }
+                catch (const std::exception& ex) {
+                    // the entry stays unbuilt, so the build is retried on the next lookup
+                    log_error("error building a mesh's hit-testing data in the background (it will be retried): %s", ex.what());
+                }
+            });
+        }
+        return nullptr;
     }
 
     const Shader& load(
@@ -226,6 +404,39 @@ public:
     }
 
 private:
+    // returns the cache entry for `mesh`, inserting a new (unbuilt) one if necessary
+    std::shared_ptr<BVHCacheEntry> get_or_insert_bvh_entry(const Mesh& mesh)
+    {
+        auto& shard = bvh_cache_shards_[std::hash<Mesh>{}(mesh) % c_num_bvh_cache_shards];
+
+        auto guard = shard.lock();
+        auto [it, inserted] = guard->try_emplace(mesh, nullptr);
+        if (inserted) {
+            it->second = std::make_shared<BVHCacheEntry>();
+        }
+        return it->second;
+    }
+
+    ThreadPool& bvh_build_pool()
+    {
+        // lazily initialized, because most caches never need background BVH builds
+        std::call_once(bvh_build_pool_initialized_, [this]()
+        {
+            bvh_build_pool_ = std::make_unique<ThreadPool>(max(ThreadPool::default_num_threads()/2, size_t{1}));
+        });
+        return *bvh_build_pool_;
+    }
+
+    ThreadPool& mesh_loading_pool()
+    {
+        // lazily initialized, because most caches never need to (pre)load meshes in bulk
+        std::call_once(mesh_loading_pool_initialized_, [this]()
+        {
+            mesh_loading_pool_ = std::make_unique<ThreadPool>();
+        });
+        return *mesh_loading_pool_;
+    }
+
     Mesh sphere = SphereGeometry{{.num_width_segments = 16, .num_height_segments = 16}};
     Mesh circle = CircleGeometry{{.radius = 1.0f, .num_segments = 16}};
     Mesh cylinder = CylinderGeometry{{.height = 2.0f, .num_radial_segments = 16}};
@@ -239,8 +450,13 @@ private:
     Mesh textured_quad = floor;
 
     SynchronizedValue<ankerl::unordered_dense::map<TorusParameters, Mesh>> torus_cache;
-    SynchronizedValue<ankerl::unordered_dense::map<std::string, Mesh>> mesh_cache;
-    SynchronizedValue<ankerl::unordered_dense::map<Mesh, std::unique_ptr<BVH>>> bvh_cache;
+    SynchronizedValue<ankerl::unordered_dense::map<std::string, std::shared_ptr<MeshCacheEntry>>> mesh_cache;
+    SynchronizedValue<std::shared_ptr<const MeshDiskCache>> mesh_disk_cache_;
+    std::array<SynchronizedValue<ankerl::unordered_dense::map<Mesh, std::shared_ptr<BVHCacheEntry>>>, c_num_bvh_cache_shards> bvh_cache_shards_;
+    std::once_flag bvh_build_pool_initialized_;
+    std::unique_ptr<ThreadPool> bvh_build_pool_;
+    std::once_flag mesh_loading_pool_initialized_;
+    std::unique_ptr<ThreadPool> mesh_loading_pool_;
 
     // shader stuff
     ResourceLoader resource_loader_;
@@ -271,6 +487,25 @@ Mesh osc::SceneCache::get_mesh(
     return impl_->get_mesh(key, getter);
 }
 
+void osc::SceneCache::set_mesh_disk_cache(std::shared_ptr<const MeshDiskCache> mesh_disk_cache)
+{
+    impl_->set_mesh_disk_cache(std::move(mesh_disk_cache));
+}
+
+Mesh osc::SceneCache::get_mesh_file(
+    const std::filesystem::path& mesh_file,
+    const std::function<Mesh()>& getter)
+{
+    return impl_->get_mesh_file(mesh_file, getter);
+}
+
+void osc::SceneCache::preload_mesh_files(
+    std::span<const std::filesystem::path> mesh_files,
+    const std::function<Mesh(const std::filesystem::path&)>& loader)
+{
+    impl_->preload_mesh_files(mesh_files, loader);
+}
+
 Mesh osc::SceneCache::sphere_mesh() { return impl_->sphere_mesh(); }
 Mesh osc::SceneCache::circle_mesh() { return impl_->circle_mesh(); }
 Mesh osc::SceneCache::cylinder_mesh() { return impl_->cylinder_mesh(); }
@@ -292,6 +527,17 @@ const BVH& osc::SceneCache::get_bvh(const Mesh& mesh)
     return impl_->get_bvh(mesh);
 }
 
+const BVH* osc::SceneCache::try_get_bvh(const Mesh& mesh)
+{
+    const MeshHitTestData* data = impl_->try_get_hit_test_data(mesh);
+    return data ? &data->triangle_bvh : nullptr;
+}
+
+const MeshHitTestData* osc::SceneCache::try_get_hit_test_data(const Mesh& mesh)
+{
+    return impl_->try_get_hit_test_data(mesh);
+}
+
 const Shader& osc::SceneCache::get_shader(
     const ResourcePath& vertex_shader_path,
     const ResourcePath& fragment_shader_path)
@@ -3,12 +3,16 @@
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Platform/ResourcePath.h>
 
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 
 namespace osc { class BVH; }
 namespace osc { class MeshBasicMaterial; }
+namespace osc { class MeshDiskCache; }
+namespace osc { struct MeshHitTestData; }
 namespace osc { class ResourceLoader; }
 namespace osc { class Shader; }
 
@@ -35,12 +39,38 @@ namespace osc
         SceneCache& operator=(SceneCache&&) noexcept;
         ~SceneCache() noexcept;
 
-        // clear all cached meshes (can be slow: forces a full reload)
+        // clear all cached meshes and BVHs (can be slow: forces a full reload)
         void clear_meshes();
 
-        // always returns (it will use a dummy cube and print a log error if something fails)
+        // returns the mesh that has the given `key`, calling `getter` to load it if it isn't
+        // already cached (if `getter` throws, a dummy cube is cached for `key` instead)
+        //
+        // the cache isn't locked while `getter` runs, so lookups of other keys don't block
+        // while a mesh is loading. Concurrent lookups of the same key wait for its load.
         Mesh get_mesh(const std::string& key, const std::function<Mesh()>& getter);
 
+        // sets the on-disk cache that `get_mesh_file` should use (`nullptr` disables it)
+        void set_mesh_disk_cache(std::shared_ptr<const MeshDiskCache>);
+
+        // returns a mesh that `getter` decodes from `mesh_file`
+        //
+        // behaves like `get_mesh`, but also tries to load the mesh, and its BVH, from the
+        // on-disk cache (see `set_mesh_disk_cache`) before calling `getter`, and writes
+        // any newly-decoded meshes to it
+        Mesh get_mesh_file(const std::filesystem::path& mesh_file, const std::function<Mesh()>& getter);
+
+        // loads each of `mesh_files` via `loader` concurrently (on a thread pool), adding them
+        // to the cache as-if by calling `get_mesh_file` with each of them, and blocks until
+        // they are all loaded
+        //
+        // this is useful for bulk-loading all meshes up-front (e.g. when a model is opened),
+        // rather than loading them one-by-one when they're first needed. Meshes that are
+        // already cached aren't reloaded and loading errors are logged.
+        void preload_mesh_files(
+            std::span<const std::filesystem::path> mesh_files,
+            const std::function<Mesh(const std::filesystem::path&)>& loader
+        );
+
         Mesh sphere_mesh();
         Mesh circle_mesh();
         Mesh cylinder_mesh();
@@ -54,8 +84,21 @@ namespace osc
         Mesh quad_mesh();
         Mesh torus_mesh(float tube_center_radius, float tube_radius);
 
+        // returns a triangle BVH for the given mesh, building it on the calling thread
+        // if it hasn't already been built (blocking)
         const BVH& get_bvh(const Mesh&);
 
+        // returns a triangle BVH for the given mesh if it has already been built;
+        // otherwise, schedules building it on a background thread and returns `nullptr`
+        //
+        // this is useful for latency-sensitive code (e.g. hit-testing in the UI), which
+        // can fall back to something cheaper (e.g. AABB-only tests) while the BVH builds
+        const BVH* try_get_bvh(const Mesh&);
+
+        // returns the hit-testing data (triangle BVH + contiguous triangles) for the given mesh
+        // if it has already been built; otherwise, behaves like `try_get_bvh`
+        const MeshHitTestData* try_get_hit_test_data(const Mesh&);
+
         // returns a `Shader` loaded via the `ResourceLoader` that was provided to the constructor
         const Shader& get_shader(
             const ResourcePath& vertex_shader_path,
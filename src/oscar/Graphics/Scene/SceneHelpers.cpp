@@ -4,32 +4,45 @@
 #include <oscar/Graphics/Camera.h>
 #include <oscar/Graphics/Color.h>
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshIndicesView.h>
 #include <oscar/Graphics/MeshTopology.h>
+#include <oscar/Graphics/Scene/MeshHitTestData.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Scene/SceneRendererStats.h>
 #include <oscar/Maths/AABB.h>
 #include <oscar/Maths/Angle.h>
 #include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHBuildStrategy.h>
+#include <oscar/Maths/BVHPrim.h>
 #include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/CommonFunctions.h>
 #include <oscar/Maths/GeometricFunctions.h>
 #include <oscar/Maths/Line.h>
 #include <oscar/Maths/LineSegment.h>
+#include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/PlaneFunctions.h>
 #include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Maths/Quat.h>
 #include <oscar/Maths/RayCollision.h>
 #include <oscar/Maths/Rect.h>
+#include <oscar/Maths/Sphere.h>
 #include <oscar/Maths/Transform.h>
 #include <oscar/Maths/TrigonometricFunctions.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Maths/Vec4.h>
 #include <oscar/Utils/Algorithms.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
 #include <optional>
+#include <span>
+#include <utility>
 #include <vector>
 
 using namespace osc::literals;
@@ -230,6 +243,19 @@ void osc::update_scene_bvh(std::span<const SceneDecoration> decorations, BVH& bv
     bvh.build_from_aabbs(aabbs);
 }
 
+void osc::refit_scene_bvh(std::span<const SceneDecoration> decorations, BVH& bvh)
+{
+    std::vector<AABB> aabbs;
+    aabbs.reserve(decorations.size());
+    for (const SceneDecoration& decoration : decorations) {
+        aabbs.push_back(worldspace_bounds_of(decoration));
+    }
+
+    if (not bvh.refit_from_aabbs(aabbs)) {
+        bvh.build_from_aabbs(aabbs);
+    }
+}
+
 std::vector<SceneCollision> osc::get_all_ray_collisions_with_scene(
     const BVH& scene_bvh,
     SceneCache& cache,
@@ -239,16 +265,29 @@ std::vector<SceneCollision> osc::get_all_ray_collisions_with_scene(
     std::vector<SceneCollision> rv;
     scene_bvh.for_each_ray_aabb_collision(worldspace_ray, [&cache, &decorations, &worldspace_ray, &rv](BVHCollision scene_collision)
     {
-        // perform ray-triangle intersection tests on the scene collisions
         const SceneDecoration& decoration = at(decorations, scene_collision.id);
-        const BVH& decoration_triangle_bvh = cache.get_bvh(decoration.mesh);
+        if (decoration.mesh.topology() != MeshTopology::Triangles) {
+            return;  // only triangles are hittable
+        }
 
-        const std::optional<RayCollision> maybe_triangle_collision = get_closest_worldspace_ray_triangle_collision(
-            decoration.mesh,
-            decoration_triangle_bvh,
-            decoration.transform,
-            worldspace_ray
-        );
+        std::optional<RayCollision> maybe_triangle_collision;
+        if (const MeshHitTestData* hit_test_data = cache.try_get_hit_test_data(decoration.mesh)) {
+            // perform ray-triangle intersection tests on the scene collisions
+            maybe_triangle_collision = get_closest_worldspace_ray_triangle_collision(
+                *hit_test_data,
+                decoration.transform,
+                worldspace_ray
+            );
+        }
+        else {
+            // the mesh's triangle BVH is still being built in the background, fall back
+            // to the (less precise) worldspace AABB collision, so that the caller isn't
+            // blocked until it's ready
+            maybe_triangle_collision = RayCollision{
+                scene_collision.distance,
+                worldspace_ray.origin + scene_collision.distance*worldspace_ray.direction,
+            };
+        }
 
         if (maybe_triangle_collision) {
             rv.push_back({
@@ -262,6 +301,78 @@ std::vector<SceneCollision> osc::get_all_ray_collisions_with_scene(
     return rv;
 }
 
+std::optional<SceneCollision> osc::get_closest_ray_collision_with_scene(
+    const BVH& scene_bvh,
+    SceneCache& cache,
+    std::span<const SceneDecoration> decorations,
+    const Line& worldspace_ray,
+    const std::function<bool(const SceneDecoration&)>& is_hittable)
+{
+    // decorations whose mesh doesn't have hit-testing data yet (it's still being built in the
+    // background) fall back to the (less precise) worldspace AABB collision, but those hits
+    // aren't reported to the BVH, because they would shrink the ray's search range and,
+    // therefore, could hide a closer exact (triangle) hit that's within the AABB
+    std::optional<BVHCollision> closest_aabb_only_collision;
+    const std::optional<BVHCollision> exact_collision = scene_bvh.closest_ray_collision(worldspace_ray, [&cache, &decorations, &worldspace_ray, &is_hittable, &closest_aabb_only_collision](const BVHCollision& scene_collision) -> std::optional<RayCollision>
+    {
+        const SceneDecoration& decoration = at(decorations, scene_collision.id);
+        if (decoration.mesh.topology() != MeshTopology::Triangles) {
+            return std::nullopt;  // only triangles are hittable
+        }
+        if (not is_hittable(decoration)) {
+            return std::nullopt;
+        }
+
+        if (const MeshHitTestData* hit_test_data = cache.try_get_hit_test_data(decoration.mesh)) {
+            return get_closest_worldspace_ray_triangle_collision(*hit_test_data, decoration.transform, worldspace_ray);
+        }
+
+        if (not closest_aabb_only_collision or scene_collision.distance < closest_aabb_only_collision->distance) {
+            closest_aabb_only_collision = scene_collision;
+        }
+        return std::nullopt;
+    });
+
+    std::optional<BVHCollision> collision = exact_collision;
+    if (closest_aabb_only_collision and (not collision or closest_aabb_only_collision->distance < collision->distance)) {
+        collision = closest_aabb_only_collision;
+    }
+    if (not collision) {
+        return std::nullopt;
+    }
+
+    const auto decoration_index = static_cast<size_t>(collision->id);
+    return SceneCollision{
+        .decoration_id = decorations[decoration_index].id,
+        .decoration_index = decoration_index,
+        .worldspace_location = collision->position,
+        .distance_from_ray_origin = collision->distance,
+    };
+}
+
+std::optional<RayCollision> osc::get_closest_worldspace_ray_triangle_collision(
+    const MeshHitTestData& hit_test_data,
+    const Transform& transform,
+    const Line& worldspace_ray)
+{
+    // map the ray into the mesh's modelspace, so that the triangles can be tested as-stored
+    const Line modelspace_ray = inverse_transform_line(worldspace_ray, transform);
+
+    const std::optional<BVHCollision> modelspace_collision = hit_test_data.triangle_bvh.closest_ray_indexed_triangle_collision(
+        hit_test_data.vertices,
+        hit_test_data.indices,
+        modelspace_ray
+    );
+    if (not modelspace_collision) {
+        return std::nullopt;
+    }
+
+    // (affine transforms preserve the order of points along the ray, so the modelspace
+    // closest collision is also the worldspace closest collision)
+    const Vec3 worldspace_location = transform * modelspace_collision->position;
+    return RayCollision{length(worldspace_location - worldspace_ray.origin), worldspace_location};
+}
+
 std::optional<RayCollision> osc::get_closest_worldspace_ray_triangle_collision(
     const Mesh& mesh,
     const BVH& triangle_bvh,
@@ -336,18 +447,23 @@ BVH osc::create_triangle_bvh(const Mesh& mesh)
 {
     const auto indices = mesh.indices();
 
-    BVH rv;
+    // triangle BVHs are typically built once and then queried many times (e.g. for hit
+    // testing), so it's worth spending a little more time building a higher-quality tree
+    BVH rv{BVHBuildStrategy::BinnedSAH};
     if (indices.empty()) {
         return rv;
     }
     else if (mesh.topology() != MeshTopology::Triangles) {
         return rv;
     }
-    else if (indices.is_uint32()) {
-        rv.build_from_indexed_triangles(mesh.vertices() , indices.to_uint32_span());
+
+    // build directly from the mesh's (strided) vertex buffer, rather than from a copy
+    const MeshAttributeView<Vec3> vertices = mesh.vertices_view();
+    if (indices.is_uint32()) {
+        rv.build_from_indexed_triangles(vertices, indices.to_uint32_span());
     }
     else {
-        rv.build_from_indexed_triangles(mesh.vertices(), indices.to_uint16_span());
+        rv.build_from_indexed_triangles(vertices, indices.to_uint16_span());
     }
     return rv;
 }
@@ -375,3 +491,133 @@ FrustumPlanes osc::calc_frustum_planes(const Camera& camera, float aspect_ratio)
         to_analytic_plane(pos                  , -normalize(cross(front_mult_far + up*half_v_size, right))),  // bottom
     };
 }
+
+FrustumPlanes osc::calc_frustum_planes(const Mat4& view_projection_matrix)
+{
+    // Gribb & Hartmann: each clipping plane is a sum/difference of the matrix's rows, such
+    // that `dot(row, Vec4{p, 1.0f}) >= 0` for points `p` that are inside the frustum
+    const auto row = [&view_projection_matrix](Mat4::size_type i)
+    {
+        return Vec4{view_projection_matrix[0][i], view_projection_matrix[1][i], view_projection_matrix[2][i], view_projection_matrix[3][i]};
+    };
+    const auto to_outward_plane = [](const Vec4& inward)
+    {
+        const float len = length(Vec3{inward});
+        return AnalyticPlane{.distance = inward.w / len, .normal = -Vec3{inward} / len};
+    };
+
+    const Vec4 x = row(0);
+    const Vec4 y = row(1);
+    const Vec4 z = row(2);
+    const Vec4 w = row(3);
+    return {
+        to_outward_plane(w + z),  // near
+        to_outward_plane(w - z),  // far
+        to_outward_plane(w - x),  // right
+        to_outward_plane(w + x),  // left
+        to_outward_plane(w - y),  // top
+        to_outward_plane(w + y),  // bottom
+    };
+}
+
+std::optional<float> osc::calc_screen_diameter_in_pixels(const AABB& aabb, const SceneRendererParams& params)
+{
+    const Sphere sphere = bounding_sphere_of(aabb);
+    const Vec4 view_pos = params.view_matrix * Vec4{sphere.origin, 1.0f};
+    const Vec4 clip_pos = params.projection_matrix * view_pos;
+    if (clip_pos.w <= 0.0f) {
+        return std::nullopt;  // behind the camera
+    }
+
+    // the projection's Y scaling maps view-space distances to NDC (-1 to 1) distances, which
+    // are then scaled by half of the output's height to get pixels
+    const float ndc_diameter = 2.0f * sphere.radius * abs(params.projection_matrix[1][1]) / clip_pos.w;
+    return 0.5f * ndc_diameter * static_cast<float>(params.dimensions.y);
+}
+
+SceneRendererPassStats osc::calc_decoration_culling(
+    std::span<const SceneDecoration> decorations,
+    const SceneRendererParams& params,
+    const BVH* scene_bvh,
+    std::vector<SceneDecorationCulling>& out_culling)
+{
+    out_culling.assign(decorations.size(), SceneDecorationCulling::None);
+    SceneRendererPassStats rv;
+
+    if (params.cull_offscreen_decorations) {
+        const FrustumPlanes frustum = calc_frustum_planes(params.projection_matrix * params.view_matrix);
+
+        // decorations in the BVH are culled, unless the BVH reports that they intersect the frustum
+        //
+        // (the BVH's prims are looked up by ID, rather than assuming that they're a prefix of
+        // `decorations`, because the BVH doesn't contain decorations with point/empty bounds)
+        std::vector<bool> is_in_bvh(decorations.size(), false);
+        if (scene_bvh) {
+            for (const BVHPrim& prim : scene_bvh->prims()) {
+                if (0 <= prim.id() and static_cast<size_t>(prim.id()) < decorations.size()) {
+                    is_in_bvh[static_cast<size_t>(prim.id())] = true;
+                    out_culling[static_cast<size_t>(prim.id())] = SceneDecorationCulling::Frustum;
+                }
+            }
+            scene_bvh->for_each_frustum_aabb_collision(frustum, [&out_culling](const BVHPrim& prim)
+            {
+                if (0 <= prim.id() and static_cast<size_t>(prim.id()) < out_culling.size()) {
+                    out_culling[static_cast<size_t>(prim.id())] = SceneDecorationCulling::None;
+                }
+            });
+        }
+
+        // any other decorations (e.g. overlays that were added after the BVH was built, or
+        // decorations that the BVH skipped) are tested individually
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            if (not is_in_bvh[i] and not is_intersecting(frustum, worldspace_bounds_of(decorations[i]))) {
+                out_culling[i] = SceneDecorationCulling::Frustum;
+            }
+        }
+
+        rv.num_frustum_culled = static_cast<size_t>(std::count(out_culling.begin(), out_culling.end(), SceneDecorationCulling::Frustum));
+    }
+
+    if (params.small_feature_culling_threshold_in_pixels > 0.0f) {
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            if (out_culling[i] != SceneDecorationCulling::None) {
+                continue;  // already culled
+            }
+            const std::optional<float> diameter = calc_screen_diameter_in_pixels(worldspace_bounds_of(decorations[i]), params);
+            if (diameter and *diameter < params.small_feature_culling_threshold_in_pixels) {
+                out_culling[i] = SceneDecorationCulling::SmallFeature;
+                ++rv.num_small_feature_culled;
+            }
+        }
+    }
+
+    return rv;
+}
+
+MeshHitTestData osc::create_mesh_hit_test_data(const Mesh& mesh)
+{
+    MeshHitTestData rv = create_mesh_hit_test_data(mesh, BVH{});
+
+    // the hit-test data has to keep contiguous copies of the vertices and indices anyway (the
+    // mesh's vertex buffer may change after this returns), so build from them, rather than
+    // from the mesh's (strided) vertex buffer
+    rv.triangle_bvh.set_build_strategy(BVHBuildStrategy::BinnedSAH);  // see `create_triangle_bvh`
+    if (not rv.indices.empty()) {
+        rv.triangle_bvh.build_from_indexed_triangles(rv.vertices, rv.indices);
+    }
+    return rv;
+}
+
+MeshHitTestData osc::create_mesh_hit_test_data(const Mesh& mesh, BVH triangle_bvh)
+{
+    MeshHitTestData rv;
+    rv.triangle_bvh = std::move(triangle_bvh);
+    if (mesh.topology() != MeshTopology::Triangles) {
+        return rv;  // only triangles are hittable
+    }
+    const MeshAttributeView<Vec3> vertices = mesh.vertices_view();
+    rv.vertices.assign(vertices.begin(), vertices.end());
+    const auto indices = mesh.indices();
+    rv.indices.assign(indices.begin(), indices.end());
+    return rv;
+}
@@ -6,10 +6,12 @@
 #include <oscar/Graphics/Scene/SceneCollision.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Scene/SceneRendererStats.h>
 #include <oscar/Maths/AABB.h>
 #include <oscar/Maths/BVH.h>
 #include <oscar/Maths/FrustumPlanes.h>
 #include <oscar/Maths/Line.h>
+#include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/RayCollision.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
@@ -17,11 +19,13 @@
 #include <functional>
 #include <optional>
 #include <span>
+#include <vector>
 
 namespace osc { struct AABB; }
 namespace osc { class BVH; }
 namespace osc { class Camera; }
 namespace osc { class Mesh; }
+namespace osc { struct MeshHitTestData; }
 namespace osc { struct PolarPerspectiveCamera; }
 namespace osc { struct Rect; }
 namespace osc { struct LineSegment; }
@@ -106,7 +110,17 @@ namespace osc
         BVH&
     );
 
+    // as above, but refits the given BVH's existing hierarchy to the decorations, rather than
+    // rebuilding it, if the BVH was built from the same number of (moved) decorations
+    void refit_scene_bvh(
+        std::span<const SceneDecoration>,
+        BVH&
+    );
+
     // returns all collisions along `worldspace_ray`
+    //
+    // this doesn't block on building triangle BVHs: if a decoration's triangle BVH isn't
+    // ready yet (see `SceneCache::try_get_bvh`), then its worldspace AABB is used instead
     std::vector<SceneCollision> get_all_ray_collisions_with_scene(
         const BVH& scene_bvh,
         SceneCache&,
@@ -114,6 +128,28 @@ namespace osc
         const Line& worldspace_ray
     );
 
+    // returns the closest collision along `worldspace_ray` with a decoration for which
+    // `is_hittable` returns `true`
+    //
+    // unlike filtering the result of `get_all_ray_collisions_with_scene`, this traverses the
+    // scene (and each decoration's triangles) front-to-back, so decorations that are further
+    // away than the closest hit found so far are skipped. Like `get_all_ray_collisions_with_scene`,
+    // it doesn't block on building triangle BVHs. `worldspace_ray.direction` should be normalized.
+    std::optional<SceneCollision> get_closest_ray_collision_with_scene(
+        const BVH& scene_bvh,
+        SceneCache&,
+        std::span<const SceneDecoration>,
+        const Line& worldspace_ray,
+        const std::function<bool(const SceneDecoration&)>& is_hittable = [](const SceneDecoration&) { return true; }
+    );
+
+    // returns closest ray-triangle collision along `worldspace_ray`
+    std::optional<RayCollision> get_closest_worldspace_ray_triangle_collision(
+        const MeshHitTestData&,
+        const Transform&,
+        const Line& worldspace_ray
+    );
+
     // returns closest ray-triangle collision along `worldspace_ray`
     std::optional<RayCollision> get_closest_worldspace_ray_triangle_collision(
         const Mesh&,
@@ -142,7 +178,38 @@ namespace osc
     // returns a triangle BVH for the given triangle mesh, or an empty BVH if the mesh is non-triangular or empty
     BVH create_triangle_bvh(const Mesh&);
 
+    // returns the hit-testing data for the given mesh, building its triangle BVH
+    MeshHitTestData create_mesh_hit_test_data(const Mesh&);
+
+    // returns the hit-testing data for the given mesh, using an already-built triangle BVH
+    // (e.g. one that was loaded from a `MeshDiskCache`)
+    MeshHitTestData create_mesh_hit_test_data(const Mesh&, BVH triangle_bvh);
+
     // returns `FrustumPlanes` that represent the clipping planes of `camera` when rendering to an
     // output that has an aspect ratio of `aspect_ratio`
     FrustumPlanes calc_frustum_planes(const Camera& camera, float aspect_ratio);
+
+    // returns `FrustumPlanes` that represent the clipping planes of the given (worldspace-to-clipspace)
+    // view-projection matrix
+    FrustumPlanes calc_frustum_planes(const Mat4& view_projection_matrix);
+
+    // returns the approximate on-screen diameter, in pixels, of `aabb` when it's rendered with the given
+    // scene renderer parameters, or `std::nullopt` if it's behind the camera
+    std::optional<float> calc_screen_diameter_in_pixels(const AABB&, const SceneRendererParams&);
+
+    // assigns `out_culling[i]` to whether (and why) `decorations[i]` can be culled when rendering with
+    // `params`, because it's outside of the view frustum, or because it's smaller than the small feature
+    // culling threshold
+    //
+    // `scene_bvh`, if provided, must have been built from (a prefix of) `decorations` via
+    // `update_scene_bvh`, and is used to frustum-cull whole subtrees of decorations at once. Any
+    // decorations that aren't in it (e.g. because they have point bounds) are tested individually
+    //
+    // returns the number of culled decorations (`num_submitted` is left as zero)
+    SceneRendererPassStats calc_decoration_culling(
+        std::span<const SceneDecoration> decorations,
+        const SceneRendererParams& params,
+        const BVH* scene_bvh,
+        std::vector<SceneDecorationCulling>& out_culling
+    );
 }
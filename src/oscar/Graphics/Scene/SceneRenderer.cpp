@@ -19,13 +19,16 @@
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Graphics/Scene/SceneDecorationFlags.h>
 #include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Scene/SceneRendererStats.h>
 #include <oscar/Maths/Angle.h>
+#include <oscar/Maths/BVH.h>
 #include <oscar/Maths/Mat4.h>
 #include <oscar/Maths/MatFunctions.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/PolarPerspectiveCamera.h>
 #include <oscar/Maths/QuaternionFunctions.h>
 #include <oscar/Maths/Rect.h>
+#include <oscar/Maths/Sphere.h>
 #include <oscar/Maths/Transform.h>
 #include <oscar/Maths/Vec2.h>
 #include <oscar/Maths/Vec3.h>
@@ -37,6 +40,7 @@
 #include <memory>
 #include <span>
 #include <utility>
+#include <vector>
 
 using namespace osc::literals;
 using namespace osc;
@@ -208,8 +212,15 @@ public:
 
     void render(
         std::span<const SceneDecoration> decorations,
-        const SceneRendererParams& params)
+        const SceneRendererParams& params,
+        const BVH* scene_bvh)
     {
+        OSC_PERF("SceneRenderer/render");
+
+        // figure out which decorations can be seen by the scene camera
+        stats_ = {};
+        stats_.main_pass = calc_decoration_culling(decorations, params, scene_bvh, culling_);
+
         // render any other perspectives on the scene (shadows, rim highlights, etc.)
         const std::optional<RimHighlights> maybe_rims = try_generate_rims(decorations, params);
         const std::optional<Shadows> maybe_shadowmap = try_generate_shadowmap(decorations, params);
@@ -250,10 +261,15 @@ public:
             MaterialPropertyBlock prop_block;
             MaterialPropertyBlock wireframe_prop_block;
             Color previous_color = {-1.0f, -1.0f, -1.0f, 0.0f};
-            for (const SceneDecoration& dec : decorations) {
+            for (size_t i = 0; i < decorations.size(); ++i) {
+                const SceneDecoration& dec = decorations[i];
                 if (dec.flags & SceneDecorationFlag::NoDrawInScene) {
                     continue;  // skip this
                 }
+                if (culling_[i] != SceneDecorationCulling::None) {
+                    continue;  // culled
+                }
+                ++stats_.main_pass.num_submitted;
 
                 Color color_guess = Color::white();
                 std::visit(Overload{
@@ -346,6 +362,11 @@ public:
         return output_rendertexture_;
     }
 
+    const SceneRendererStats& last_render_stats() const
+    {
+        return stats_;
+    }
+
 private:
     std::optional<RimHighlights> try_generate_rims(
         std::span<const SceneDecoration> decorations,
@@ -420,7 +441,23 @@ private:
         // draw all selected geometry in a solid color
         std::unordered_map<Color, MeshBasicMaterial::PropertyBlock> block_cache;
         block_cache.reserve(3);  // guess
-        for (const SceneDecoration& decoration : decorations) {
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            const SceneDecoration& decoration = decorations[i];
+            if (not decoration.is_rim_highlighted()) {
+                continue;
+            }
+
+            // the rims are drawn from the scene camera's perspective, so they can be culled in
+            // the same way as the main pass
+            if (culling_[i] == SceneDecorationCulling::Frustum) {
+                ++stats_.rim_pass.num_frustum_culled;
+                continue;
+            }
+            if (culling_[i] == SceneDecorationCulling::SmallFeature) {
+                ++stats_.rim_pass.num_small_feature_culled;
+                continue;
+            }
+
             Color color = Color::black();
 
             static_assert(SceneRendererParams::num_rim_groups() == 2);
@@ -434,6 +471,7 @@ private:
             if (color != Color::black()) {
                 const auto& prop_block = block_cache.try_emplace(color, color).first->second;
                 graphics::draw(decoration.mesh, decoration.transform, rim_filler_material_, camera_, prop_block);
+                ++stats_.rim_pass.num_submitted;
             }
         }
 
@@ -482,15 +520,15 @@ private:
         camera_.reset();
 
         // compute the bounds of everything that casts a shadow
-        //
-        // (also, while doing that, draw each mesh - to prevent multipass)
         std::optional<AABB> shadowcaster_aabbs;
+        shadowcaster_worldspace_aabbs_.clear();
         for (const SceneDecoration& decoration : decorations) {
             if (decoration.flags & SceneDecorationFlag::NoCastsShadows) {
+                shadowcaster_worldspace_aabbs_.emplace_back();  // (unused: keeps indices aligned)
                 continue;  // this decoration shouldn't cast shadows
             }
-            shadowcaster_aabbs = bounding_aabb_of(shadowcaster_aabbs, worldspace_bounds_of(decoration));
-            graphics::draw(decoration.mesh, decoration.transform, depth_writer_material_, camera_);
+            const AABB& aabb = shadowcaster_worldspace_aabbs_.emplace_back(worldspace_bounds_of(decoration));
+            shadowcaster_aabbs = bounding_aabb_of(shadowcaster_aabbs, aabb);
         }
 
         if (not shadowcaster_aabbs) {
@@ -502,6 +540,27 @@ private:
         // compute camera matrices for the orthogonal (direction) camera used for lighting
         const ShadowCameraMatrices matrices = calc_shadow_camera_matrices(*shadowcaster_aabbs, params.light_direction);
 
+        // draw each shadow caster into the shadowmap
+        //
+        // casters can't be culled against the scene camera's frustum, because off-screen casters
+        // can cast shadows onto on-screen geometry. However, casters that are smaller than a
+        // texel of the shadowmap (which is fitted to all casters) can't meaningfully contribute
+        // to it, so they're culled
+        const float shadowmap_texel_size = 2.0f * bounding_sphere_of(*shadowcaster_aabbs).radius / static_cast<float>(shadowmap_render_buffer_.dimensions().x);
+        const float min_caster_diameter = params.small_feature_culling_threshold_in_pixels * shadowmap_texel_size;
+        for (size_t i = 0; i < decorations.size(); ++i) {
+            const SceneDecoration& decoration = decorations[i];
+            if (decoration.flags & SceneDecorationFlag::NoCastsShadows) {
+                continue;  // this decoration shouldn't cast shadows
+            }
+            if (2.0f * bounding_sphere_of(shadowcaster_worldspace_aabbs_[i]).radius < min_caster_diameter) {
+                ++stats_.shadow_pass.num_small_feature_culled;
+                continue;
+            }
+            graphics::draw(decoration.mesh, decoration.transform, depth_writer_material_, camera_);
+            ++stats_.shadow_pass.num_submitted;
+        }
+
         camera_.set_view_matrix_override(matrices.view_mat);
         camera_.set_projection_matrix_override(matrices.projection_mat);
         camera_.render_to(RenderTarget{
@@ -528,6 +587,11 @@ private:
         .dimensions = {1024, 1024},
     }};
     RenderTexture output_rendertexture_;
+
+    // per-render scratch space
+    std::vector<SceneDecorationCulling> culling_;
+    std::vector<AABB> shadowcaster_worldspace_aabbs_;
+    SceneRendererStats stats_;
 };
 
 
@@ -545,10 +609,23 @@ void osc::SceneRenderer::render(
     std::span<const SceneDecoration> decorations,
     const SceneRendererParams& params)
 {
-    impl_->render(decorations, params);
+    impl_->render(decorations, params, nullptr);
+}
+
+void osc::SceneRenderer::render(
+    std::span<const SceneDecoration> decorations,
+    const SceneRendererParams& params,
+    const BVH& scene_bvh)
+{
+    impl_->render(decorations, params, &scene_bvh);
 }
 
 RenderTexture& osc::SceneRenderer::upd_render_texture()
 {
     return impl_->upd_render_texture();
 }
+
+const SceneRendererStats& osc::SceneRenderer::last_render_stats() const
+{
+    return impl_->last_render_stats();
+}
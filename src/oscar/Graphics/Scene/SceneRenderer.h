@@ -6,9 +6,11 @@
 #include <memory>
 #include <span>
 
+namespace osc { class BVH; }
 namespace osc { struct SceneDecoration; }
 namespace osc { class SceneCache; }
 namespace osc { struct SceneRendererParams; }
+namespace osc { struct SceneRendererStats; }
 namespace osc { class RenderTexture; }
 
 namespace osc
@@ -25,8 +27,16 @@ namespace osc
         ~SceneRenderer() noexcept;
 
         void render(std::span<const SceneDecoration>, const SceneRendererParams&);
+
+        // as above, but uses `scene_bvh` (which must have been built from (a prefix of) the
+        // decorations via `update_scene_bvh`) to accelerate culling
+        void render(std::span<const SceneDecoration>, const SceneRendererParams&, const BVH& scene_bvh);
+
         RenderTexture& upd_render_texture();
 
+        // returns statistics (e.g. how many decorations were culled) from the most recent render
+        const SceneRendererStats& last_render_stats() const;
+
     private:
         class Impl;
         std::unique_ptr<Impl> impl_;
@@ -74,5 +74,15 @@ namespace osc
         // scene parameters
         Vec3 floor_location = default_floor_location();
         float fixup_scale_factor = 1.0f;
+
+        // culling parameters
+        //
+        // decorations that are entirely outside of the view frustum, or whose on-screen bounds
+        // are smaller than the threshold (in pixels, <= 0.0f disables it), aren't drawn
+        //
+        // both are opt-in, because they only pay for themselves in scenes that contain many
+        // decorations, and small feature culling can visibly drop (e.g.) thin lines
+        bool cull_offscreen_decorations = false;
+        float small_feature_culling_threshold_in_pixels = 0.0f;
     };
 }
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osc
+{
+    // whether (and why) a `SceneDecoration` was culled from a `SceneRenderer` pass
+    enum class SceneDecorationCulling : uint8_t {
+        None,
+        Frustum,
+        SmallFeature,
+    };
+
+    // counts of how many `SceneDecoration`s were submitted to, or culled from, one pass of a `SceneRenderer`
+    struct SceneRendererPassStats final {
+
+        friend bool operator==(const SceneRendererPassStats&, const SceneRendererPassStats&) = default;
+
+        size_t num_culled() const { return num_frustum_culled + num_small_feature_culled; }
+
+        size_t num_submitted = 0;
+        size_t num_frustum_culled = 0;
+        size_t num_small_feature_culled = 0;
+    };
+
+    // statistics from the most recent call to `SceneRenderer::render`
+    struct SceneRendererStats final {
+
+        friend bool operator==(const SceneRendererStats&, const SceneRendererStats&) = default;
+
+        SceneRendererPassStats main_pass;
+        SceneRendererPassStats shadow_pass;
+        SceneRendererPassStats rim_pass;
+    };
+}
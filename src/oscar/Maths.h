@@ -5,9 +5,11 @@
 #include <oscar/Maths/AnalyticPlane.h>
 #include <oscar/Maths/Angle.h>
 #include <oscar/Maths/BVH.h>
+#include <oscar/Maths/BVHBuildStrategy.h>
 #include <oscar/Maths/BVHCollision.h>
 #include <oscar/Maths/BVHNode.h>
 #include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/BVHWideNode.h>
 #include <oscar/Maths/Circle.h>
 #include <oscar/Maths/ClosedInterval.h>
 #include <oscar/Maths/CollisionTests.h>
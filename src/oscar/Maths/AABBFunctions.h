@@ -42,6 +42,13 @@ namespace osc
         return dims.x * dims.y * dims.z;
     }
 
+    // returns the surface area of `aabb`
+    constexpr float surface_area_of(const AABB& aabb)
+    {
+        const Vec3 dims = dimensions_of(aabb);
+        return 2.0f * (dims.x*dims.y + dims.y*dims.z + dims.z*dims.x);
+    }
+
     // tests if `aabb` has zero width along all of its edges
     constexpr bool is_point(const AABB& aabb)
     {
@@ -1,18 +1,30 @@
 #pragma once
 
 #include <oscar/Maths/AABB.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/BVHBuildStrategy.h>
 #include <oscar/Maths/BVHCollision.h>
 #include <oscar/Maths/BVHNode.h>
 #include <oscar/Maths/BVHPrim.h>
+#include <oscar/Maths/BVHWideNode.h>
+#include <oscar/Maths/RayCollision.h>
+#include <oscar/Maths/Triangle.h>
+#include <oscar/Maths/TriangleFunctions.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/Concepts.h>
 
+#include <concepts>
 #include <cstdint>
 #include <cstddef>
 #include <functional>
 #include <optional>
+#include <ranges>
 #include <span>
+#include <utility>
 #include <vector>
 
+namespace osc { struct FrustumPlanes; }
 namespace osc { struct Line; }
 
 namespace osc
@@ -22,6 +34,16 @@ namespace osc
     // the `AABB`s may be computed from triangles, commonly called a "triangle BVH"
     class BVH final {
     public:
+        // constructs an empty `BVH` that uses `BVHBuildStrategy::Default` when built
+        BVH() = default;
+
+        // constructs an empty `BVH` that uses `build_strategy` when built
+        explicit BVH(BVHBuildStrategy build_strategy);
+
+        // returns/sets the strategy used by subsequent calls to `build_from_*`
+        BVHBuildStrategy build_strategy() const;
+        void set_build_strategy(BVHBuildStrategy);
+
         void clear();
 
         // triangle `BVH`es
@@ -36,7 +58,38 @@ namespace osc
             std::span<const uint32_t> indices
         );
 
+        // as above, but the vertices may be non-contiguous (e.g. a strided view of a `Mesh`'s
+        // vertex buffer), so that they don't have to be copied into a contiguous buffer first
+        template<std::ranges::random_access_range Vertices, typename TIndex>
+        requires
+            std::ranges::sized_range<const Vertices> and
+            std::same_as<std::ranges::range_value_t<Vertices>, Vec3> and
+            (not std::ranges::contiguous_range<Vertices>) and
+            IsAnyOf<TIndex, uint16_t, uint32_t>
+        void build_from_indexed_triangles(
+            const Vertices& vertices,
+            std::span<const TIndex> indices)
+        {
+            std::vector<BVHPrim> prims;
+            prims.reserve(indices.size()/3);  // guess: upper limit
+            for (size_t i = 0; (i+2) < indices.size(); i += 3) {
+                const Triangle triangle{
+                    at(vertices, indices[i]),
+                    at(vertices, indices[i+1]),
+                    at(vertices, indices[i+2]),
+                };
+
+                if (can_form_triangle(triangle.p0, triangle.p1, triangle.p2)) {
+                    prims.emplace_back(static_cast<ptrdiff_t>(i), bounding_aabb_of(triangle));
+                }
+            }
+            build_from_prims(std::move(prims));
+        }
+
         // returns the location of the closest ray-triangle collision along the ray, if any
+        //
+        // the hierarchy is traversed front-to-back, so this is typically much cheaper than
+        // testing every `AABB` hit by the ray (e.g. via `for_each_ray_aabb_collision`)
         std::optional<BVHCollision> closest_ray_indexed_triangle_collision(
             std::span<const Vec3> vertices,
             std::span<const uint16_t> indices,
@@ -53,10 +106,50 @@ namespace osc
         // `prim.id()` will refer to the index of the `AABB`
         void build_from_aabbs(std::span<const AABB>);
 
+        // updates the bounds of the `BVH`'s prims and nodes from `aabbs`, without changing
+        // the structure of the hierarchy, which is typically much cheaper than rebuilding it
+        //
+        // returns `false` (and leaves the `BVH` unmodified) if the `BVH` can't be refit from
+        // `aabbs`, because they'd produce a different set of prims than the ones that the `BVH`
+        // was built from (e.g. because there are more `AABB`s, or an `AABB` that was previously
+        // skipped for being a point now isn't one), in which case, the caller should rebuild it
+        //
+        // the quality of the hierarchy degrades if the `AABB`s move a lot relative to each other
+        bool refit_from_aabbs(std::span<const AABB>);
+
         // calls the callback with each collision between the line and an `AABB` in
-        // the `BVH`
+        // the `BVH`, in depth-first order
         void for_each_ray_aabb_collision(const Line&, const std::function<void(BVHCollision)>&) const;
 
+        // returns the closest collision along the ray that `test_prim` reports, if any
+        //
+        // `test_prim` is called with each ray-`AABB` collision, front-to-back, and should return
+        // the location of the ray's collision with whatever the `AABB` bounds (e.g. a mesh), if
+        // any. `AABB`s that are further away than the closest reported collision are skipped, so
+        // this is typically much cheaper than `for_each_ray_aabb_collision` + testing every hit
+        std::optional<BVHCollision> closest_ray_collision(
+            const Line&,
+            const std::function<std::optional<RayCollision>(const BVHCollision&)>& test_prim
+        ) const;
+
+        // calls the callback with each primitive whose `AABB` intersects (or is inside) the frustum
+        //
+        // subtrees that are entirely outside of the frustum are skipped, and subtrees that are
+        // entirely inside of it are emitted without testing their primitives
+        void for_each_frustum_aabb_collision(const FrustumPlanes&, const std::function<void(const BVHPrim&)>&) const;
+
+        // flattened `BVH`es
+        //
+        // assigns the `BVH` from `nodes` and `prims` that were previously returned by
+        // `nodes()` and `prims()` (e.g. after they were serialized to disk)
+        void assign(std::span<const BVHNode> nodes, std::span<const BVHPrim> prims);
+
+        // returns the flattened (depth-first) nodes of the hierarchy
+        std::span<const BVHNode> nodes() const;
+
+        // returns the primitives that the nodes reference
+        std::span<const BVHPrim> prims() const;
+
         // returns `true` if the `BVH` contains no `BVHNode`s
         [[nodiscard]] bool empty() const;
 
@@ -74,10 +167,19 @@ namespace osc
         void for_each_leaf_or_inner_node(const std::function<void(const BVHNode&)>&) const;
 
     private:
+        // assigns `prims` and builds the hierarchy from them
+        void build_from_prims(std::vector<BVHPrim>&& prims);
+
         // nodes in the hierarchy
         std::vector<BVHNode> nodes_;
 
         // primitives (triangles, `AABB`s) that the nodes reference
         std::vector<BVHPrim> prims_;
+
+        // how prims are partitioned into nodes when the BVH is built
+        BVHBuildStrategy build_strategy_ = BVHBuildStrategy::Default;
+
+        // `nodes_`, but collapsed into a wide hierarchy, which is used for ray traversal
+        std::vector<BVHWideNode> wide_nodes_;
     };
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace osc
+{
+    // the algorithm that a `BVH` uses to partition its primitives into nodes
+    enum class BVHBuildStrategy {
+
+        // split each node on the midpoint of the longest axis of its `AABB`
+        //
+        // fast to build, but can produce poorly-balanced trees for (e.g.) long, thin, meshes
+        Midpoint,
+
+        // split each node on the plane that minimizes a binned surface area heuristic (SAH)
+        //
+        // slower to build, but produces trees that are cheaper to traverse, which makes it
+        // a better fit for hierarchies that are built once and queried many times (e.g.
+        // triangle BVHs of meshes)
+        BinnedSAH,
+
+        NUM_OPTIONS,
+
+        Default = Midpoint,
+    };
+}
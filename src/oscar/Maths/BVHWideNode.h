@@ -0,0 +1,104 @@
+#pragma once
+
+#include <oscar/Maths/AABB.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace osc
+{
+    // a node in a "wide" (4-ary) BVH
+    //
+    // this is a collapsed form of a binary hierarchy of `BVHNode`s that is used during
+    // ray traversal: the `AABB`s of all children are stored in structure-of-arrays form,
+    // so that one ray can be tested against all of them at once (which compilers can
+    // emit as SIMD instructions)
+    class BVHWideNode final {
+    public:
+        static constexpr size_t max_children() { return 4; }
+
+        // returns the number of children (<= `max_children()`) in this node
+        size_t num_children() const { return num_children_; }
+
+        // returns the minimum coordinate along `axis` of each child's `AABB`
+        const std::array<float, 4>& mins(size_t axis) const { return mins_[axis]; }
+
+        // returns the maximum coordinate along `axis` of each child's `AABB`
+        const std::array<float, 4>& maxs(size_t axis) const { return maxs_[axis]; }
+
+        // returns the `AABB` of the `i`th child
+        AABB child_bounds(size_t i) const
+        {
+            return AABB{
+                .min = {mins_[0][i], mins_[1][i], mins_[2][i]},
+                .max = {maxs_[0][i], maxs_[1][i], maxs_[2][i]},
+            };
+        }
+
+        // returns `true` if the `i`th child is a leaf (i.e. references a `BVHPrim`)
+        bool is_leaf(size_t i) const
+        {
+            return (children_[i] & c_leaf_mask) != 0;
+        }
+
+        // returns `true` if the `i`th child is an inner node (i.e. references a `BVHWideNode`)
+        bool is_node(size_t i) const
+        {
+            return not is_leaf(i);
+        }
+
+        // returns the index of the `i`th child's `BVHWideNode` (requires `!is_leaf(i)`)
+        size_t child_node_index(size_t i) const
+        {
+            return children_[i];
+        }
+
+        // returns the offset of the `i`th child's `BVHPrim` (requires `is_leaf(i)`)
+        size_t child_prim_offset(size_t i) const
+        {
+            return children_[i] & ~c_leaf_mask;
+        }
+
+        // appends a leaf child that references the `BVHPrim` at `prim_offset`
+        void push_leaf(const AABB& bounds, size_t prim_offset)
+        {
+            push(bounds, static_cast<uint32_t>(prim_offset) | c_leaf_mask);
+        }
+
+        // appends an inner child that references the `BVHWideNode` at `node_index`
+        void push_node(const AABB& bounds, size_t node_index)
+        {
+            push(bounds, static_cast<uint32_t>(node_index) & ~c_leaf_mask);
+        }
+
+        // updates the `BVHWideNode` index of the `i`th (inner) child
+        void set_child_node_index(size_t i, size_t node_index)
+        {
+            children_[i] = static_cast<uint32_t>(node_index) & ~c_leaf_mask;
+        }
+
+    private:
+        static inline constexpr uint32_t c_leaf_mask = static_cast<uint32_t>(1) << 31;
+
+        void push(const AABB& bounds, uint32_t child_data)
+        {
+            const size_t i = num_children_++;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                mins_[axis][i] = bounds.min[axis];
+                maxs_[axis][i] = bounds.max[axis];
+            }
+            children_[i] = child_data;
+        }
+
+        // per-axis, per-child, bounds (i.e. `mins_[axis][child]`)
+        std::array<std::array<float, 4>, 3> mins_{};
+        std::array<std::array<float, 4>, 3> maxs_{};
+
+        // per-child bit-packed data (leaf flag + prim offset, or node index)
+        std::array<uint32_t, 4> children_{};
+
+        // number of populated children
+        size_t num_children_ = 0;
+    };
+}
@@ -1,6 +1,8 @@
 #include <oscar/Maths.h>
 
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/ParalellizationHelpers.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <cmath>
 #include <algorithm>
@@ -44,176 +46,412 @@ namespace
         return not (t.p0 == t.p1 or t.p0 == t.p2 or t.p1 == t.p2);
     }
 
-    // recursively build the BVH
-    void bvh_recursive_build(
-        std::vector<BVHNode>& nodes,
-        std::vector<BVHPrim>& prims,
-        const ptrdiff_t begin,
-        const ptrdiff_t n)
+    // returns the centroid of `prim`'s bounds, multiplied by two (avoids a multiply)
+    Vec3 centroid_x2_of(const BVHPrim& prim)
     {
-        if (n == 1) {
-            // recursion bottomed out: create a leaf node
-            nodes.push_back(BVHNode::leaf(
-                prims.at(begin).bounds(),
-                begin
-            ));
-            return;
-        }
+        return prim.bounds().min + prim.bounds().max;
+    }
 
-        // else: `n >= 2`, so partition the data appropriately and allocate an internal node
+    // partitions `prims` on the midpoint of the longest axis of `aabb` and returns the
+    // number of prims in the left-hand partition
+    size_t bvh_partition_midpoint(std::span<BVHPrim> prims, const AABB& aabb)
+    {
+        // compute slicing position along the longest dimension
+        const auto longest_dim_index = max_element_index(dimensions_of(aabb));
+        const float midpoint_x2 = aabb.min[longest_dim_index] + aabb.max[longest_dim_index];
 
-        ptrdiff_t midpoint = -1;
-        ptrdiff_t internal_node_loc = -1;
+        // returns `true` if a given primitive is below the midpoint along the dim
+        const auto is_below_midpoint = [longest_dim_index, midpoint_x2](const BVHPrim& p)
         {
-            // allocate an appropriate internal node
+            return centroid_x2_of(p)[longest_dim_index] <= midpoint_x2;
+        };
 
-            // compute bounding box of remaining (children) prims
-            const AABB aabb = bounding_aabb_of(
-                std::span<const BVHPrim>{prims.begin() + begin, static_cast<size_t>(n)},
-                &BVHPrim::bounds
-            );
+        // partition prims into above/below the midpoint
+        const auto it = std::partition(prims.begin(), prims.end(), is_below_midpoint);
+        return static_cast<size_t>(std::distance(prims.begin(), it));
+    }
 
-            // compute slicing position along the longest dimension
-            const auto longest_dim_index = max_element_index(dimensions_of(aabb));
-            const float midpoint_x2 = aabb.min[longest_dim_index] + aabb.max[longest_dim_index];
+    // partitions `prims` on the plane that minimizes a surface area heuristic (SAH) and
+    // returns the number of prims in the left-hand partition
+    //
+    // candidate planes are found by binning the prims' centroids along each axis, so this is
+    // `O(n)` per node, rather than the `O(n log n)` of a full sweep, which is a good-enough
+    // approximation for this codebase's typical inputs (e.g. triangle meshes)
+    size_t bvh_partition_binned_sah(std::span<BVHPrim> prims)
+    {
+        constexpr size_t c_num_bins = 16;
 
-            // returns `true` if a given primitive is below the midpoint along the dim
-            const auto is_below_midpoint = [longest_dim_index, midpoint_x2](const BVHPrim& p)
-            {
-                const float prim_midpoint_x2 = p.bounds().min[longest_dim_index] + p.bounds().max[longest_dim_index];
-                return prim_midpoint_x2 <= midpoint_x2;
-            };
+        struct Bin final {
+            std::optional<AABB> bounds;
+            size_t num_prims = 0;
+        };
+
+        const auto surface_area_or_zero = [](const std::optional<AABB>& aabb)
+        {
+            return aabb ? surface_area_of(*aabb) : 0.0f;
+        };
 
-            // partition prims into above/below the midpoint
-            const ptrdiff_t end = begin + n;
-            const auto it = std::partition(prims.begin() + begin, prims.begin() + end, is_below_midpoint);
+        const AABB centroid_bounds = bounding_aabb_of(prims, centroid_x2_of);
 
-            midpoint = std::distance(prims.begin(), it);
-            if (midpoint == begin or midpoint == end) {
-                // edge-case: failed to spacially partition: just naievely partition
-                midpoint = begin + n/2;
+        // returns the bin that `prim` falls into along `axis`
+        const auto bin_index_of = [&centroid_bounds](const BVHPrim& prim, size_t axis, float scale)
+        {
+            const float bin = (centroid_x2_of(prim)[axis] - centroid_bounds.min[axis]) * scale;
+            return min(static_cast<size_t>(bin), c_num_bins - 1);
+        };
+
+        float best_cost = std::numeric_limits<float>::max();
+        size_t best_axis = 0;
+        size_t best_split = 0;  // bins before this index go into the left-hand partition
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+            if (not (extent > 0.0f)) {
+                continue;  // all centroids lie on the same plane along this axis
             }
+            const float scale = static_cast<float>(c_num_bins) / extent;
 
-            internal_node_loc = std::ssize(nodes);
+            std::array<Bin, c_num_bins> bins{};
+            for (const BVHPrim& prim : prims) {
+                Bin& bin = bins[bin_index_of(prim, axis, scale)];
+                bin.bounds = bounding_aabb_of(bin.bounds, prim.bounds());
+                ++bin.num_prims;
+            }
 
-            // push the internal node
-            nodes.push_back(BVHNode::node(
-                aabb,
-                0  // the number of left-hand nodes is set later
-            ));
-        }
+            // sweep left-to-right to get the cost of each left-hand partition
+            std::array<float, c_num_bins> lhs_costs{};
+            std::array<size_t, c_num_bins> lhs_counts{};
+            {
+                std::optional<AABB> lhs_bounds;
+                size_t lhs_count = 0;
+                for (size_t i = 1; i < c_num_bins; ++i) {
+                    lhs_bounds = maybe_bounding_aabb_of(lhs_bounds, bins[i-1].bounds);
+                    lhs_count += bins[i-1].num_prims;
+                    lhs_costs[i] = static_cast<float>(lhs_count) * surface_area_or_zero(lhs_bounds);
+                    lhs_counts[i] = lhs_count;
+                }
+            }
 
-        // build left-hand subtree
-        bvh_recursive_build(nodes, prims, begin, midpoint-begin);
+            // sweep right-to-left to get the total cost of splitting before bin `i`
+            std::optional<AABB> rhs_bounds;
+            size_t rhs_count = 0;
+            for (size_t i = c_num_bins - 1; i > 0; --i) {
+                rhs_bounds = maybe_bounding_aabb_of(rhs_bounds, bins[i].bounds);
+                rhs_count += bins[i].num_prims;
+                if (lhs_counts[i] == 0 or rhs_count == 0) {
+                    continue;  // not a split
+                }
+
+                const float cost = lhs_costs[i] + static_cast<float>(rhs_count) * surface_area_or_zero(rhs_bounds);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = i;
+                }
+            }
+        }
 
-        // the left-hand build allocated nodes for the left hand side contiguously in memory
-        const ptrdiff_t num_lhs_nodes = (std::ssize(nodes) - 1) - internal_node_loc;
-        OSC_ASSERT(num_lhs_nodes > 0);
-        nodes[internal_node_loc].set_num_lhs_nodes(num_lhs_nodes);
+        if (best_split == 0) {
+            return 0;  // couldn't find a split (e.g. all centroids are at the same location)
+        }
 
-        // build right node
-        bvh_recursive_build(nodes, prims, midpoint, (begin + n) - midpoint);
-        OSC_ASSERT(internal_node_loc+num_lhs_nodes < std::ssize(nodes));
+        const float scale = static_cast<float>(c_num_bins) / (centroid_bounds.max[best_axis] - centroid_bounds.min[best_axis]);
+        const auto it = std::partition(prims.begin(), prims.end(), [&](const BVHPrim& prim)
+        {
+            return bin_index_of(prim, best_axis, scale) < best_split;
+        });
+        return static_cast<size_t>(std::distance(prims.begin(), it));
     }
 
-    // returns `true` if something hit (recursively)
+    // the minimum number of prims a subtree must have before it's built as a separate task on the global pool
+    constexpr size_t c_min_prims_per_parallel_build = 8192;
+
+    // recursively build the BVH
     //
-    // populates outparam with all `AABB` hits in depth-first order
-    bool bvh_for_each_ray_aabb_collisions_recursive(
-        std::span<const BVHNode> nodes,
-        std::span<const BVHPrim> prims,
-        const Line& ray,
-        ptrdiff_t node_index,
-        const std::function<void(BVHCollision)>& callback)
+    // because each leaf holds exactly one prim, a (sub)tree of `n` prims always contains
+    // `2n - 1` nodes. This means that the location of each subtree in `nodes` is known
+    // before it's built, so that subtrees can be built independently (e.g. in parallel)
+    void bvh_recursive_build(
+        std::span<BVHNode> nodes,
+        std::span<BVHPrim> prims,
+        size_t first_prim_offset,
+        BVHBuildStrategy strategy,
+        size_t max_parallel_depth)
     {
-        const BVHNode& node = nodes[node_index];
+        OSC_ASSERT(nodes.size() == 2*prims.size() - 1);
 
-        // check ray-AABB intersection with the BVH node
-        const std::optional<RayCollision> maybe_collision = find_collision(ray, node.bounds());
-        if (not maybe_collision) {
-            return false;  // no intersection with this node at all
+        if (prims.size() == 1) {
+            // recursion bottomed out: create a leaf node
+            nodes.front() = BVHNode::leaf(prims.front().bounds(), first_prim_offset);
+            return;
         }
 
-        if (node.is_leaf()) {
-            // it's a leaf node, so we've sucessfully found the `AABB` that intersected
-            callback(BVHCollision{
-                maybe_collision->distance,
-                maybe_collision->position,
-                prims[node.first_prim_offset()].id(),
-            });
-            return true;
+        // else: `n >= 2`, so partition the data appropriately and allocate an internal node
+
+        // compute bounding box of remaining (children) prims
+        const AABB aabb = bounding_aabb_of(prims, &BVHPrim::bounds);
+
+        size_t num_lhs_prims = strategy == BVHBuildStrategy::BinnedSAH ?
+            bvh_partition_binned_sah(prims) :
+            bvh_partition_midpoint(prims, aabb);
+
+        if (num_lhs_prims == 0 or num_lhs_prims == prims.size()) {
+            // edge-case: failed to spacially partition: just naievely partition
+            num_lhs_prims = prims.size()/2;
         }
 
-        // else: we've "hit" an internal node and need to recurse to find the leaf
-        const bool lhs_hit = bvh_for_each_ray_aabb_collisions_recursive(nodes, prims, ray, node_index+1, callback);
-        const bool rhs_hit = bvh_for_each_ray_aabb_collisions_recursive(nodes, prims, ray, node_index+node.num_lhs_nodes()+1, callback);
-        return lhs_hit or rhs_hit;
+        const size_t num_lhs_nodes = 2*num_lhs_prims - 1;
+        nodes.front() = BVHNode::node(aabb, num_lhs_nodes);
+
+        const auto build_lhs = [=]()
+        {
+            bvh_recursive_build(
+                nodes.subspan(1, num_lhs_nodes),
+                prims.first(num_lhs_prims),
+                first_prim_offset,
+                strategy,
+                max_parallel_depth > 0 ? max_parallel_depth - 1 : 0
+            );
+        };
+        const auto build_rhs = [=]()
+        {
+            bvh_recursive_build(
+                nodes.subspan(1 + num_lhs_nodes),
+                prims.subspan(num_lhs_prims),
+                first_prim_offset + num_lhs_prims,
+                strategy,
+                max_parallel_depth > 0 ? max_parallel_depth - 1 : 0
+            );
+        };
+
+        if (max_parallel_depth > 0 and min(num_lhs_prims, prims.size() - num_lhs_prims) >= c_min_prims_per_parallel_build) {
+            // both subtrees are large: build them as separate tasks on the global pool (the
+            // calling thread also builds one, so this is safe when already on the pool)
+            for_each_chunk_parallel(ThreadPool::global(), 1, 2, [&build_lhs, &build_rhs](size_t begin, size_t)
+            {
+                begin == 0 ? build_lhs() : build_rhs();
+            });
+        }
+        else {
+            build_lhs();
+            build_rhs();
+        }
     }
 
-    template<std::unsigned_integral TIndex>
-    std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision_recursive(
-        std::span<const BVHNode> nodes,
-        std::span<const BVHPrim> prims,
-        std::span<const Vec3> vertices,
-        std::span<const TIndex> indices,
-        const Line& ray,
-        float& closest,
-        ptrdiff_t node_index)
+    // (re)builds `nodes` from `prims`
+    void bvh_build(
+        std::vector<BVHNode>& nodes,
+        std::vector<BVHPrim>& prims,
+        BVHBuildStrategy strategy)
     {
-        const BVHNode& node = nodes[node_index];
-        const std::optional<RayCollision> node_collision = find_collision(ray, node.bounds());
+        nodes.clear();
+        if (prims.empty()) {
+            return;
+        }
 
-        if (not node_collision) {
-            return std::nullopt;  // didn't hit this node at all
+        // only the SAH builder is parallelized, because the midpoint one is typically used
+        // for small, rapidly-rebuilt, hierarchies (e.g. scenes) where threading isn't worth it
+        size_t max_parallel_depth = 0;
+        if (strategy == BVHBuildStrategy::BinnedSAH) {
+            for (size_t n = ThreadPool::global().num_threads(); n > 1; n /= 2) {
+                ++max_parallel_depth;
+            }
         }
 
-        if (node_collision->distance > closest) {
-            return std::nullopt;  // this AABB can't contain something closer
+        nodes.assign(2*prims.size() - 1, BVHNode::leaf(AABB{}, 0));
+        bvh_recursive_build(nodes, prims, 0, strategy, max_parallel_depth);
+    }
+
+    // collapses a (binary, depth-first) hierarchy of `BVHNode`s into a hierarchy of
+    // `BVHWideNode`s, which is what's actually used during ray traversal
+    //
+    // the children of each `BVHWideNode` are kept in depth-first order, so that traversal
+    // algorithms can emit results in the same order as they would from the binary tree
+    void bvh_build_wide_nodes(
+        std::span<const BVHNode> nodes,
+        std::vector<BVHWideNode>& wide_nodes)
+    {
+        wide_nodes.clear();
+        if (nodes.empty()) {
+            return;
         }
 
-        if (node.is_leaf()) {
-            // leaf node: check ray-triangle intersection
+        const auto lhs_of = [](size_t node_index) { return node_index + 1; };
+        const auto rhs_of = [&nodes](size_t node_index) { return node_index + nodes[node_index].num_lhs_nodes() + 1; };
+
+        // a binary node that still needs to be collapsed into a `BVHWideNode`, plus
+        // where the index of that `BVHWideNode` should be written to once it's known
+        struct PendingNode final {
+            size_t node_index;
+            size_t parent_wide_node_index;
+            size_t parent_child_index;
+        };
+        constexpr size_t c_no_parent = std::numeric_limits<size_t>::max();
+
+        std::vector<PendingNode> pending = {{0, c_no_parent, c_no_parent}};
+        while (not pending.empty()) {
+            const PendingNode current = pending.back();
+            pending.pop_back();
+
+            const size_t wide_node_index = wide_nodes.size();
+            if (current.parent_wide_node_index != c_no_parent) {
+                wide_nodes[current.parent_wide_node_index].set_child_node_index(current.parent_child_index, wide_node_index);
+            }
 
-            const BVHPrim& prim = at(prims, node.first_prim_offset());
+            // gather up to `max_children()` children by repeatedly replacing the inner child
+            // with the largest surface area with its two children (in-place, so that the
+            // children stay in depth-first order)
+            std::array<size_t, BVHWideNode::max_children()> children{};
+            size_t num_children = 0;
+            if (nodes[current.node_index].is_leaf()) {
+                children[num_children++] = current.node_index;  // edge-case: the root is a leaf
+            }
+            else {
+                children[num_children++] = lhs_of(current.node_index);
+                children[num_children++] = rhs_of(current.node_index);
+            }
 
-            const Triangle triangle = {
-                at(vertices, at(indices, prim.id())),
-                at(vertices, at(indices, prim.id()+1)),
-                at(vertices, at(indices, prim.id()+2)),
-            };
+            while (num_children < children.size()) {
+                std::optional<size_t> largest_inner_child;
+                float largest_area = std::numeric_limits<float>::lowest();
+                for (size_t i = 0; i < num_children; ++i) {
+                    const BVHNode& child = nodes[children[i]];
+                    if (child.is_node() and surface_area_of(child.bounds()) > largest_area) {
+                        largest_inner_child = i;
+                        largest_area = surface_area_of(child.bounds());
+                    }
+                }
+                if (not largest_inner_child) {
+                    break;  // all children are leaves
+                }
+
+                const size_t expanded = children[*largest_inner_child];
+                std::shift_right(children.begin() + *largest_inner_child + 1, children.begin() + num_children + 1, 1);
+                children[*largest_inner_child] = lhs_of(expanded);
+                children[*largest_inner_child + 1] = rhs_of(expanded);
+                ++num_children;
+            }
 
-            const std::optional<RayCollision> triangle_collision = find_collision(ray, triangle);
+            BVHWideNode& wide_node = wide_nodes.emplace_back();
+            for (size_t i = 0; i < num_children; ++i) {
+                const BVHNode& child = nodes[children[i]];
+                if (child.is_leaf()) {
+                    wide_node.push_leaf(child.bounds(), child.first_prim_offset());
+                }
+                else {
+                    wide_node.push_node(child.bounds(), 0);  // the node index is set when it's popped from `pending`
+                }
+            }
 
-            if (triangle_collision and triangle_collision->distance < closest) {
-                closest = triangle_collision->distance;
-                return BVHCollision{triangle_collision->distance, triangle_collision->position, prim.id()};
+            // push inner children in reverse, so that they're popped (allocated) in depth-first order
+            for (size_t i = num_children; i-- > 0;) {
+                if (nodes[children[i]].is_node()) {
+                    pending.push_back({children[i], wide_node_index, i});
+                }
             }
-            else {
-                return std::nullopt;  // it didn't collide with the triangle
+        }
+
+        wide_nodes.shrink_to_fit();
+    }
+
+    // tests `ray` against the `AABB` of each child in `node`
+    //
+    // returns a bitmask that has bit `i` set if the ray intersects child `i`, and writes
+    // the distance along the ray to each child into `out_distances`. This produces the
+    // same result as calling `find_collision(const Line&, const AABB&)` for each child,
+    // but is written so that compilers can vectorize it (all children at once)
+    uint32_t find_collisions(
+        const Line& ray,
+        const Vec3& inverse_direction,
+        const BVHWideNode& node,
+        std::array<float, BVHWideNode::max_children()>& out_distances)
+    {
+        constexpr size_t width = BVHWideNode::max_children();
+
+        std::array<float, width> t0;
+        std::array<float, width> t1;
+        t0.fill(std::numeric_limits<float>::lowest());
+        t1.fill(std::numeric_limits<float>::max());
+
+        for (size_t axis = 0; axis < 3; ++axis) {
+            const std::array<float, width>& mins = node.mins(axis);
+            const std::array<float, width>& maxs = node.maxs(axis);
+            const float origin = ray.origin[axis];
+            const float inv_dir = inverse_direction[axis];
+
+            for (size_t i = 0; i < width; ++i) {
+                const float t_near = (mins[i] - origin) * inv_dir;
+                const float t_far = (maxs[i] - origin) * inv_dir;
+                const float lo = t_near > t_far ? t_far : t_near;
+                const float hi = t_near > t_far ? t_near : t_far;
+                t0[i] = t0[i] < lo ? lo : t0[i];
+                t1[i] = hi < t1[i] ? hi : t1[i];
             }
         }
 
-        // else: `is_node`, so recurse
-        const std::optional<BVHCollision> lhs = bvh_get_closest_ray_indexed_triangle_collision_recursive(
-            nodes,
-            prims,
-            vertices,
-            indices,
-            ray,
-            closest,
-            node_index+1
-        );
-        const std::optional<BVHCollision> rhs = bvh_get_closest_ray_indexed_triangle_collision_recursive(
-            nodes,
-            prims,
-            vertices,
-            indices,
-            ray,
-            closest,
-            node_index+node.num_lhs_nodes()+1
-        );
-
-        return rhs ? rhs : lhs;
+        uint32_t hits = 0;
+        for (size_t i = 0; i < node.num_children(); ++i) {
+            if (not (t0[i] > t1[i])) {
+                hits |= static_cast<uint32_t>(1) << i;
+            }
+        }
+        out_distances = t0;
+        return hits;
+    }
+
+    // returns the reciprocal of each component of the ray's direction (for slab tests)
+    Vec3 inverse_direction_of(const Line& ray)
+    {
+        return Vec3{1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z};
+    }
+
+    // emits all `AABB` hits in depth-first order
+    void bvh_for_each_ray_aabb_collision(
+        std::span<const BVHWideNode> nodes,
+        std::span<const BVHPrim> prims,
+        const Line& ray,
+        const std::function<void(BVHCollision)>& callback)
+    {
+        const Vec3 inverse_direction = inverse_direction_of(ray);
+
+        // a wide node that needs traversing, or a leaf hit that needs emitting (deferred, so
+        // that hits are emitted in the same order as a recursive depth-first traversal)
+        struct StackEntry final {
+            size_t node_index_or_prim_offset;
+            float distance;
+            bool is_leaf_hit;
+        };
+
+        std::vector<StackEntry> stack;
+        stack.reserve(64);
+        stack.push_back({0, 0.0f, false});
+
+        std::array<float, BVHWideNode::max_children()> distances{};
+        while (not stack.empty()) {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+
+            if (entry.is_leaf_hit) {
+                callback(BVHCollision{
+                    entry.distance,
+                    ray.origin + entry.distance*ray.direction,
+                    prims[entry.node_index_or_prim_offset].id(),
+                });
+                continue;
+            }
+
+            const BVHWideNode& node = nodes[entry.node_index_or_prim_offset];
+            const uint32_t hits = find_collisions(ray, inverse_direction, node, distances);
+            for (size_t i = node.num_children(); i-- > 0;) {
+                if (hits & (static_cast<uint32_t>(1) << i)) {
+                    if (node.is_leaf(i)) {
+                        stack.push_back({node.child_prim_offset(i), distances[i], true});
+                    }
+                    else {
+                        stack.push_back({node.child_node_index(i), distances[i], false});
+                    }
+                }
+            }
+        }
     }
 
     template<std::unsigned_integral TIndex>
@@ -221,7 +459,8 @@ namespace
         std::vector<BVHNode>& nodes,
         std::vector<BVHPrim>& prims,
         std::span<const Vec3> vertices,
-        std::span<const TIndex> indices)
+        std::span<const TIndex> indices,
+        BVHBuildStrategy strategy)
     {
         // clear out any old data
         nodes.clear();
@@ -241,29 +480,128 @@ namespace
             }
         }
 
-        nodes.reserve(2 * prims.size());  // guess
-        if (not prims.empty()) {
-            bvh_recursive_build(nodes, prims, 0, std::ssize(prims));
+        prims.shrink_to_fit();
+        bvh_build(nodes, prims, strategy);
+    }
+
+    // returns the closest collision that `test_prim` reports for a prim hit by the ray
+    //
+    // `test_prim` is called with the offset of each prim whose `AABB` is hit by the ray,
+    // front-to-back, and returns the location of the ray's collision with the prim's
+    // contents (e.g. a triangle), if any. Subtrees and prims that are further away than
+    // the closest reported collision are skipped.
+    template<std::invocable<size_t, float> TestPrim>
+    std::optional<BVHCollision> bvh_get_closest_ray_collision(
+        std::span<const BVHWideNode> nodes,
+        std::span<const BVHPrim> prims,
+        const Line& ray,
+        TestPrim&& test_prim)
+    {
+        if (nodes.empty() or prims.empty()) {
+            return std::nullopt;
         }
 
-        prims.shrink_to_fit();
-        nodes.shrink_to_fit();
+        const Vec3 inverse_direction = inverse_direction_of(ray);
+
+        std::optional<BVHCollision> rv;
+        float closest = std::numeric_limits<float>::max();
+
+        // prims are stored in depth-first order, so equidistant hits are tie-broken on
+        // this, so that the result is independent of the (front-to-back) traversal order
+        size_t closest_prim_offset = std::numeric_limits<size_t>::max();
+
+        // tests the prim at `prim_offset`, whose `AABB` is `aabb_distance` along the ray
+        const auto test = [&](size_t prim_offset, float aabb_distance)
+        {
+            const std::optional<RayCollision> collision = test_prim(prim_offset, aabb_distance);
+            if (not collision) {
+                return;
+            }
+            const bool is_closer = collision->distance < closest;
+            const bool is_tie_winner = rv and collision->distance == closest and prim_offset < closest_prim_offset;
+            if (is_closer or is_tie_winner) {
+                closest = collision->distance;
+                closest_prim_offset = prim_offset;
+                rv = BVHCollision{collision->distance, collision->position, prims[prim_offset].id()};
+            }
+        };
+
+        struct StackEntry final {
+            size_t node_index;
+            float distance;
+        };
+        std::vector<StackEntry> stack;
+        stack.reserve(64);
+        stack.push_back({0, std::numeric_limits<float>::lowest()});
+
+        std::array<float, BVHWideNode::max_children()> distances{};
+        while (not stack.empty()) {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+
+            if (entry.distance > closest) {
+                continue;  // something closer was found after this node was pushed
+            }
+
+            const BVHWideNode& node = nodes[entry.node_index];
+            const uint32_t hits = find_collisions(ray, inverse_direction, node, distances);
+
+            // sort the hit children front-to-back (insertion sort: there's <= 4 of them)
+            std::array<size_t, BVHWideNode::max_children()> order{};
+            size_t num_hits = 0;
+            for (size_t i = 0; i < node.num_children(); ++i) {
+                if (not (hits & (static_cast<uint32_t>(1) << i))) {
+                    continue;
+                }
+                size_t j = num_hits++;
+                for (; j > 0 and distances[order[j-1]] > distances[i]; --j) {
+                    order[j] = order[j-1];
+                }
+                order[j] = i;
+            }
+
+            // test leaves immediately (front-to-back), which may shrink `closest`
+            for (size_t k = 0; k < num_hits; ++k) {
+                const size_t i = order[k];
+                if (node.is_leaf(i) and not (distances[i] > closest)) {
+                    test(node.child_prim_offset(i), distances[i]);
+                }
+            }
+
+            // push inner children back-to-front, so that the nearest one is popped first
+            for (size_t k = num_hits; k-- > 0;) {
+                const size_t i = order[k];
+                if (node.is_node(i) and not (distances[i] > closest)) {
+                    stack.push_back({node.child_node_index(i), distances[i]});
+                }
+            }
+        }
+
+        return rv;
     }
 
     template<std::unsigned_integral TIndex>
     std::optional<BVHCollision> bvh_get_closest_ray_indexed_triangle_collision(
-        std::span<const BVHNode> nodes,
+        std::span<const BVHWideNode> nodes,
         std::span<const BVHPrim> prims,
         std::span<const Vec3> vertices,
         std::span<const TIndex> indices,
         const Line& ray)
     {
-        if (nodes.empty() or prims.empty() or indices.empty()) {
+        if (indices.empty()) {
             return std::nullopt;
         }
 
-        float closest = std::numeric_limits<float>::max();
-        return bvh_get_closest_ray_indexed_triangle_collision_recursive(nodes, prims, vertices, indices, ray, closest, 0);
+        return bvh_get_closest_ray_collision(nodes, prims, ray, [&prims, &vertices, &indices, &ray](size_t prim_offset, float)
+        {
+            const BVHPrim& prim = prims[prim_offset];
+            const Triangle triangle = {
+                at(vertices, at(indices, prim.id())),
+                at(vertices, at(indices, prim.id()+1)),
+                at(vertices, at(indices, prim.id()+2)),
+            };
+            return find_collision(ray, triangle);
+        });
     }
 
     // describes the direction of each cube face and which direction is "up"
@@ -287,10 +625,25 @@ namespace
     }
 }
 
+osc::BVH::BVH(BVHBuildStrategy build_strategy) :
+    build_strategy_{build_strategy}
+{}
+
+BVHBuildStrategy osc::BVH::build_strategy() const
+{
+    return build_strategy_;
+}
+
+void osc::BVH::set_build_strategy(BVHBuildStrategy build_strategy)
+{
+    build_strategy_ = build_strategy;
+}
+
 void osc::BVH::clear()
 {
     nodes_.clear();
     prims_.clear();
+    wide_nodes_.clear();
 }
 
 void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint16_t> indices)
@@ -299,8 +652,10 @@ void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std:
         nodes_,
         prims_,
         vertices,
-        indices
+        indices,
+        build_strategy_
     );
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
 }
 
 void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std::span<const uint32_t> indices)
@@ -309,8 +664,10 @@ void osc::BVH::build_from_indexed_triangles(std::span<const Vec3> vertices, std:
         nodes_,
         prims_,
         vertices,
-        indices
+        indices,
+        build_strategy_
     );
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
 }
 
 std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
@@ -319,7 +676,7 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
     const Line& line) const
 {
     return bvh_get_closest_ray_indexed_triangle_collision<uint16_t>(
-        nodes_,
+        wide_nodes_,
         prims_,
         vertices,
         indices,
@@ -333,7 +690,7 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
     const Line& line) const
 {
     return bvh_get_closest_ray_indexed_triangle_collision<uint32_t>(
-        nodes_,
+        wide_nodes_,
         prims_,
         vertices,
         indices,
@@ -341,6 +698,16 @@ std::optional<BVHCollision> osc::BVH::closest_ray_indexed_triangle_collision(
     );
 }
 
+std::optional<BVHCollision> osc::BVH::closest_ray_collision(
+    const Line& line,
+    const std::function<std::optional<RayCollision>(const BVHCollision&)>& test_prim) const
+{
+    return bvh_get_closest_ray_collision(wide_nodes_, prims_, line, [this, &line, &test_prim](size_t prim_offset, float aabb_distance)
+    {
+        return test_prim(BVHCollision{aabb_distance, line.origin + aabb_distance*line.direction, prims_[prim_offset].id()});
+    });
+}
+
 void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs)
 {
     // clear out any old data
@@ -354,32 +721,153 @@ void osc::BVH::build_from_aabbs(std::span<const AABB> aabbs)
         }
     }
 
-    nodes_.reserve(2 * prims_.size());
-    if (not prims_.empty()) {
-        bvh_recursive_build(nodes_, prims_, 0, ssize(prims_));
-    }
+    prims_.shrink_to_fit();
+    bvh_build(nodes_, prims_, build_strategy_);
 
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
+}
+
+void osc::BVH::build_from_prims(std::vector<BVHPrim>&& prims)
+{
+    clear();
+    prims_ = std::move(prims);
     prims_.shrink_to_fit();
-    nodes_.shrink_to_fit();
+    bvh_build(nodes_, prims_, build_strategy_);
+
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
+}
+
+bool osc::BVH::refit_from_aabbs(std::span<const AABB> aabbs)
+{
+    // check that refitting would produce the same prims as rebuilding (excluding ordering)
+    std::vector<bool> has_prim(aabbs.size(), false);
+    for (const BVHPrim& prim : prims_) {
+        if (prim.id() < 0 or prim.id() >= ssize(aabbs)) {
+            return false;  // the prim refers to an `AABB` that doesn't exist
+        }
+        has_prim[static_cast<size_t>(prim.id())] = true;
+    }
+    for (size_t i = 0; i < aabbs.size(); ++i) {
+        if (not has_prim[i] and not is_point(aabbs[i])) {
+            return false;  // the `AABB` would be a new prim
+        }
+    }
+
+    // update the prims
+    for (BVHPrim& prim : prims_) {
+        prim = BVHPrim{prim.id(), aabbs[static_cast<size_t>(prim.id())]};
+    }
+
+    // update the nodes bottom-up: the hierarchy is stored depth-first, so each node's
+    // children are always after it
+    for (size_t i = nodes_.size(); i-- > 0;) {
+        const BVHNode& node = nodes_[i];
+        if (node.is_leaf()) {
+            nodes_[i] = BVHNode::leaf(prims_[node.first_prim_offset()].bounds(), node.first_prim_offset());
+        }
+        else {
+            const AABB& lhs = nodes_[i + 1].bounds();
+            const AABB& rhs = nodes_[i + 1 + node.num_lhs_nodes()].bounds();
+            nodes_[i] = BVHNode::node(bounding_aabb_of(lhs, rhs), node.num_lhs_nodes());
+        }
+    }
+
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
+    return true;
+}
+
+void osc::BVH::assign(std::span<const BVHNode> nodes, std::span<const BVHPrim> prims)
+{
+    nodes_.assign(nodes.begin(), nodes.end());
+    prims_.assign(prims.begin(), prims.end());
+    bvh_build_wide_nodes(nodes_, wide_nodes_);
+}
+
+std::span<const BVHNode> osc::BVH::nodes() const
+{
+    return nodes_;
+}
+
+std::span<const BVHPrim> osc::BVH::prims() const
+{
+    return prims_;
 }
 
 void osc::BVH::for_each_ray_aabb_collision(
     const Line& ray,
     const std::function<void(BVHCollision)>& callback) const
 {
-    if (nodes_.empty() or prims_.empty()) {
+    if (wide_nodes_.empty() or prims_.empty()) {
         return;
     }
 
-    bvh_for_each_ray_aabb_collisions_recursive(
-        nodes_,
+    bvh_for_each_ray_aabb_collision(
+        wide_nodes_,
         prims_,
         ray,
-        0,
         callback
     );
 }
 
+void osc::BVH::for_each_frustum_aabb_collision(
+    const FrustumPlanes& frustum,
+    const std::function<void(const BVHPrim&)>& callback) const
+{
+    if (nodes_.empty() or prims_.empty()) {
+        return;
+    }
+
+    enum class Containment { Outside, Intersecting, Inside };
+    const auto containment_of = [&frustum](const AABB& aabb)
+    {
+        const Vec3 centroid = centroid_of(aabb);
+        const Vec3 half_widths = half_widths_of(aabb);
+
+        Containment rv = Containment::Inside;
+        for (const AnalyticPlane& plane : frustum) {
+            const float r = dot(half_widths, abs(plane.normal));
+            const float d = signed_distance_between(plane, centroid);
+            if (d > r) {
+                return Containment::Outside;  // entirely in front of an (outward-facing) plane
+            }
+            if (d >= -r) {
+                rv = Containment::Intersecting;
+            }
+        }
+        return rv;
+    };
+
+    // (node index, whether the node is already known to be entirely inside the frustum)
+    std::vector<std::pair<size_t, bool>> stack;
+    stack.reserve(64);
+    stack.emplace_back(0, false);
+
+    while (not stack.empty()) {
+        const auto [node_index, is_inside] = stack.back();
+        stack.pop_back();
+
+        const BVHNode& node = nodes_[node_index];
+
+        bool children_inside = is_inside;
+        if (not is_inside) {
+            const Containment containment = containment_of(node.bounds());
+            if (containment == Containment::Outside) {
+                continue;
+            }
+            children_inside = containment == Containment::Inside;
+        }
+
+        if (node.is_leaf()) {
+            callback(prims_[node.first_prim_offset()]);
+        }
+        else {
+            // push the RHS first, so that the LHS is emitted first (depth-first order)
+            stack.emplace_back(node_index + node.num_lhs_nodes() + 1, children_inside);
+            stack.emplace_back(node_index + 1, children_inside);
+        }
+    }
+}
+
 bool osc::BVH::empty() const
 {
     return nodes_.empty();
@@ -28,11 +28,13 @@
 #include <oscar/Utils/PerfClock.h>
 #include <oscar/Utils/PerfMeasurement.h>
 #include <oscar/Utils/PerfMeasurementMetadata.h>
+#include <oscar/Utils/RadixSort.h>
 #include <oscar/Utils/ScopedLifetime.h>
 #include <oscar/Utils/ScopeGuard.h>
 #include <oscar/Utils/SharedLifetimeBlock.h>
 #include <oscar/Utils/SharedPreHashedString.h>
 #include <oscar/Utils/Spsc.h>
+#include <oscar/Utils/SpscQueue.h>
 #include <oscar/Utils/StdVariantHelpers.h>
 #include <oscar/Utils/StringHelpers.h>
 #include <oscar/Utils/StringName.h>
@@ -40,6 +42,7 @@
 #include <oscar/Utils/SynchronizedValueGuard.h>
 #include <oscar/Utils/TemporaryFile.h>
 #include <oscar/Utils/TemporaryFileParameters.h>
+#include <oscar/Utils/ThreadPool.h>
 #include <oscar/Utils/TransparentStringHasher.h>
 #include <oscar/Utils/Typelist.h>
 #include <oscar/Utils/UID.h>
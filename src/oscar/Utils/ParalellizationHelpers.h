@@ -1,10 +1,15 @@
 #pragma once
 
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/ThreadPool.h>
 
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
+#include <exception>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <span>
 #include <thread>
 #include <vector>
@@ -63,4 +68,90 @@ namespace osc
             }
         }
     }
+
+    // calls `f(chunk_begin, chunk_end)` for each chunk of the index range [0, `n`), where
+    // each chunk contains at least `min_chunk_size` indices (apart from, possibly, the last
+    // one), in parallel on `pool`, and blocks until all chunks have been processed
+    //
+    // the calling thread also processes chunks, which means that it's safe to call this from
+    // within one of `pool`'s tasks (e.g. in a nested parallel algorithm). If `f` throws, the
+    // remaining chunks are skipped and the first exception is rethrown to the caller.
+    template<std::invocable<size_t, size_t> F>
+    void for_each_chunk_parallel(
+        ThreadPool& pool,
+        size_t min_chunk_size,
+        size_t n,
+        const F& f)
+    {
+        min_chunk_size = max(min_chunk_size, size_t{1});
+        const size_t chunk_size = max(min_chunk_size, n/(4*pool.num_threads()) + 1);  // >1 chunk per thread, for load balancing
+        const size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+
+        if (num_chunks <= 1) {
+            if (n > 0) {
+                f(size_t{0}, n);
+            }
+            return;
+        }
+
+        // shared with the pool's tasks, which may outlive this call if they start after
+        // all chunks have already been claimed
+        struct SharedState final {
+            std::mutex mutex;
+            std::condition_variable chunk_completed;
+            size_t next_chunk = 0;
+            size_t num_chunks_in_progress = 0;
+            std::exception_ptr exception;
+        };
+        auto state = std::make_shared<SharedState>();
+
+        // claims and processes chunks until there are none left (`f` is only accessed
+        // while a chunk is in progress, which the caller waits for)
+        const auto process_chunks = [state, num_chunks, chunk_size, n, fptr = &f]()
+        {
+            while (true) {
+                size_t chunk = 0;
+                {
+                    const std::lock_guard lock{state->mutex};
+                    if (state->next_chunk >= num_chunks) {
+                        return;
+                    }
+                    chunk = state->next_chunk++;
+                    ++state->num_chunks_in_progress;
+                }
+
+                std::exception_ptr exception;
+                try {
+                    const size_t begin = chunk * chunk_size;
+                    (*fptr)(begin, min(begin + chunk_size, n));
+                }
+                catch (...) {
+                    exception = std::current_exception();
+                }
+
+                const std::lock_guard lock{state->mutex};
+                if (exception) {
+                    if (not state->exception) {
+                        state->exception = exception;
+                    }
+                    state->next_chunk = num_chunks;  // skip the remaining chunks
+                }
+                --state->num_chunks_in_progress;
+                state->chunk_completed.notify_all();
+            }
+        };
+
+        const size_t num_helpers = min(pool.num_threads(), num_chunks - 1);
+        for (size_t i = 0; i < num_helpers; ++i) {
+            pool.post(process_chunks);
+        }
+        process_chunks();
+
+        // wait for any chunks that are still being processed by the pool's threads
+        std::unique_lock lock{state->mutex};
+        state->chunk_completed.wait(lock, [&state]() { return state->num_chunks_in_progress == 0; });
+        if (state->exception) {
+            std::rethrow_exception(state->exception);
+        }
+    }
 }
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // stably sorts the elements of `r` in ascending order of `proj(element)`, which must be an
+    // unsigned 64-bit key, using a least-significant-digit radix sort
+    //
+    // this is O(n) in the number of elements, rather than O(n log n), and skips digits that are
+    // the same for every key, so it's typically much faster than a comparison sort for large
+    // ranges of keys that only use a few bits (e.g. bit-packed IDs). `scratch` is used as
+    // temporary storage, so that callers that repeatedly sort can reuse its allocation
+    template<
+        std::ranges::random_access_range R,
+        std::regular_invocable<const std::ranges::range_value_t<R>&> Proj
+    >
+    requires std::same_as<std::invoke_result_t<Proj, const std::ranges::range_value_t<R>&>, uint64_t>
+    void radix_sort(R&& r, Proj proj, std::vector<std::ranges::range_value_t<R>>& scratch)
+    {
+        constexpr size_t num_digit_bits = 8;
+        constexpr size_t num_buckets = size_t{1} << num_digit_bits;
+        constexpr size_t num_digits = 64/num_digit_bits;
+
+        const auto first = std::ranges::begin(r);
+        const size_t n = std::ranges::size(r);
+        if (n <= 1) {
+            return;
+        }
+        if (n <= 256) {
+            // the fixed cost of the histograms outweighs the O(n log n) cost of a comparison sort
+            std::ranges::stable_sort(r, std::ranges::less{}, std::ref(proj));
+            return;
+        }
+
+        // compute a histogram of each digit in a single pass over the keys
+        std::array<std::array<size_t, num_buckets>, num_digits> histograms{};
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t key = std::invoke(proj, std::as_const(first[i]));
+            for (size_t digit = 0; digit < num_digits; ++digit) {
+                ++histograms[digit][(key >> (digit*num_digit_bits)) & (num_buckets-1)];
+            }
+        }
+
+        scratch.clear();
+        scratch.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            scratch.push_back(std::move(first[i]));
+        }
+
+        // scatter `scratch` into `r` (and back) once per digit, least-significant first
+        bool sorted_elements_are_in_scratch = true;
+        for (size_t digit = 0; digit < num_digits; ++digit) {
+            std::array<size_t, num_buckets>& histogram = histograms[digit];
+            if (std::ranges::find(histogram, n) != histogram.end()) {
+                continue;  // every key has the same value for this digit
+            }
+
+            // convert the counts into exclusive offsets
+            size_t offset = 0;
+            for (size_t& count : histogram) {
+                offset += std::exchange(count, offset);
+            }
+
+            const auto scatter = [&](auto&& src, auto&& dest)
+            {
+                for (size_t i = 0; i < n; ++i) {
+                    const uint64_t key = std::invoke(proj, std::as_const(src[i]));
+                    dest[histogram[(key >> (digit*num_digit_bits)) & (num_buckets-1)]++] = std::move(src[i]);
+                }
+            };
+            if (sorted_elements_are_in_scratch) {
+                scatter(scratch, first);
+            }
+            else {
+                scatter(first, scratch);
+            }
+            sorted_elements_are_in_scratch = not sorted_elements_are_in_scratch;
+        }
+
+        if (sorted_elements_are_in_scratch) {
+            std::ranges::move(scratch, first);
+        }
+    }
+
+    // as above, but allocates its own temporary storage
+    template<
+        std::ranges::random_access_range R,
+        std::regular_invocable<const std::ranges::range_value_t<R>&> Proj
+    >
+    requires std::same_as<std::invoke_result_t<Proj, const std::ranges::range_value_t<R>&>, uint64_t>
+    void radix_sort(R&& r, Proj proj)
+    {
+        std::vector<std::ranges::range_value_t<R>> scratch;
+        radix_sort(std::forward<R>(r), std::move(proj), scratch);
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace osc
+{
+    // an unbounded, lock-free, single-producer single-consumer (SPSC) queue
+    //
+    // elements are stored in a linked list of fixed-size chunks: the producer only writes
+    // into the tail chunk and the consumer only reads from the head chunk, so `push` and
+    // `try_pop` never block (or wait on) each other, and the producer is never slowed down
+    // by a consumer that isn't keeping up.
+    //
+    // at most one thread may `push` and at most one (other) thread may `try_pop`/`pop_all`
+    // at any given time. Another thread may take over either role, provided that there's a
+    // happens-before relationship between it and the previous thread (e.g. `std::thread::join`).
+    template<typename T, size_t ChunkSize = 64>
+    requires (ChunkSize > 0)
+    class SpscQueue final {
+    public:
+        SpscQueue() :
+            producer_{new Chunk{}, 0},
+            consumer_{producer_.tail, 0}
+        {}
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue(SpscQueue&&) noexcept = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+        SpscQueue& operator=(SpscQueue&&) noexcept = delete;
+        ~SpscQueue() noexcept
+        {
+            while (consumer_.head) {
+                Chunk* next = consumer_.head->next.load(std::memory_order_relaxed);
+                delete consumer_.head;
+                consumer_.head = next;
+            }
+        }
+
+        // (producer) enqueues `value`
+        void push(T value)
+        {
+            if (producer_.num_written == ChunkSize) {
+                auto* chunk = new Chunk{};
+                producer_.tail->next.store(chunk, std::memory_order_release);
+                producer_.tail = chunk;  // (the consumer may delete the old tail from here on)
+                producer_.num_written = 0;
+            }
+            producer_.tail->slots[producer_.num_written].emplace(std::move(value));
+            producer_.tail->num_written.store(++producer_.num_written, std::memory_order_release);
+        }
+
+        // (consumer) dequeues the oldest element, or returns `std::nullopt` if the queue is empty
+        std::optional<T> try_pop()
+        {
+            if (consumer_.num_read == ChunkSize) {
+                Chunk* next = consumer_.head->next.load(std::memory_order_acquire);
+                if (not next) {
+                    return std::nullopt;
+                }
+                delete consumer_.head;
+                consumer_.head = next;
+                consumer_.num_read = 0;
+            }
+
+            if (consumer_.num_read == consumer_.head->num_written.load(std::memory_order_acquire)) {
+                return std::nullopt;
+            }
+
+            std::optional<T>& slot = consumer_.head->slots[consumer_.num_read++];
+            std::optional<T> rv = std::move(slot);
+            slot.reset();
+            return rv;
+        }
+
+        // (consumer) dequeues all currently-available elements, in order, into `consumer`,
+        // and returns the number of elements that were dequeued
+        template<std::invocable<T&&> Consumer>
+        size_t pop_all(Consumer&& consumer)
+        {
+            size_t n = 0;
+            while (std::optional<T> element = try_pop()) {
+                consumer(std::move(*element));
+                ++n;
+            }
+            return n;
+        }
+
+    private:
+        struct Chunk final {
+            std::array<std::optional<T>, ChunkSize> slots{};
+            std::atomic<size_t> num_written = 0;
+            std::atomic<Chunk*> next = nullptr;
+        };
+
+        // the producer's and consumer's state is on separate cache lines, so that they
+        // don't (falsely) share them
+        struct alignas(64) ProducerState final {
+            Chunk* tail = nullptr;
+            size_t num_written = 0;
+        };
+        struct alignas(64) ConsumerState final {
+            Chunk* head = nullptr;
+            size_t num_read = 0;
+        };
+
+        ProducerState producer_;
+        ConsumerState consumer_;
+    };
+}
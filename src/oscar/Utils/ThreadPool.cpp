@@ -0,0 +1,80 @@
+#include "ThreadPool.h"
+
+#include <oscar/Utils/Algorithms.h>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+size_t osc::ThreadPool::default_num_threads()
+{
+    // `hardware_concurrency` is allowed to return 0 if it can't figure it out
+    return max(static_cast<size_t>(std::thread::hardware_concurrency()), size_t{1});
+}
+
+osc::ThreadPool& osc::ThreadPool::global()
+{
+    static ThreadPool s_global_pool;
+    return s_global_pool;
+}
+
+osc::ThreadPool::ThreadPool() :
+    ThreadPool{default_num_threads()}
+{}
+
+osc::ThreadPool::ThreadPool(size_t num_threads)
+{
+    num_threads = max(num_threads, size_t{1});
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_main, this);
+    }
+}
+
+osc::ThreadPool::~ThreadPool() noexcept
+{
+    {
+        const std::lock_guard lock{mutex_};
+        stop_requested_ = true;
+        tasks_.clear();
+    }
+    condition_variable_.notify_all();
+
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+}
+
+void osc::ThreadPool::post(std::function<void()> task)
+{
+    {
+        const std::lock_guard lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    condition_variable_.notify_one();
+}
+
+void osc::ThreadPool::worker_main()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock{mutex_};
+            condition_variable_.wait(lock, [this]() { return stop_requested_ or not tasks_.empty(); });
+            if (stop_requested_) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        try {
+            task();
+        }
+        catch (...) {
+            // swallow: there's nowhere sensible to propagate it to (use `submit` instead)
+        }
+    }
+}
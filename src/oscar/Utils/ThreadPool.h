@@ -0,0 +1,73 @@
+#pragma once
+
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace osc
+{
+    // a fixed-size pool of worker threads that execute tasks in FIFO order
+    //
+    // on destruction, any tasks that have not yet started are discarded and the
+    // destructor blocks until all currently-running tasks have completed
+    class ThreadPool final {
+    public:
+        // returns a sensible default number of worker threads for the current machine
+        static size_t default_num_threads();
+
+        // returns a process-wide pool with `default_num_threads()` worker threads, which is
+        // intended for (short) CPU-bound work, so that parallel algorithms don't have to spawn
+        // new threads each time they're called
+        static ThreadPool& global();
+
+        // constructs a pool with `default_num_threads()` worker threads
+        ThreadPool();
+
+        // constructs a pool with `num_threads` worker threads (minimum: 1)
+        explicit ThreadPool(size_t num_threads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) noexcept = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+        ~ThreadPool() noexcept;
+
+        // returns the number of worker threads in the pool
+        size_t num_threads() const { return threads_.size(); }
+
+        // enqueues `task` for execution on a worker thread
+        //
+        // `task` should not throw: any exceptions thrown by it are swallowed
+        void post(std::function<void()> task);
+
+        // enqueues `f` for execution on a worker thread and returns a `std::future` that
+        // can be used to retrieve its result (or exception)
+        template<std::invocable F>
+        std::future<std::invoke_result_t<F>> submit(F&& f)
+        {
+            // `std::function` requires copyable callables, so the task is shared
+            auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(f));
+            auto rv = task->get_future();
+            post([task = std::move(task)]() { (*task)(); });
+            return rv;
+        }
+
+    private:
+        void worker_main();
+
+        std::mutex mutex_;
+        std::condition_variable condition_variable_;
+        std::deque<std::function<void()>> tasks_;
+        bool stop_requested_ = false;
+        std::vector<std::thread> threads_;
+    };
+}
@@ -318,10 +318,10 @@ namespace
         void implementMeshFileGeometry(const SimTK::DecorativeMeshFile& d) final
         {
             const std::string& path = d.getMeshFile();
-            const auto meshLoader = [&d](){ return ToOscMesh(d.getMesh()); };
+            const auto meshLoader = [&path](){ return LoadMesh(path); };
 
             m_Consumer(SceneDecoration{
-                .mesh = m_MeshCache.get_mesh(path, meshLoader),
+                .mesh = m_MeshCache.get_mesh_file(path, meshLoader),
                 .transform = ToOscTransform(d),
                 .shading = GetColor(d),
                 .flags = GetFlags(d),
@@ -4,6 +4,9 @@
 
 #include <SimTKcommon/internal/DecorativeGeometry.h>
 #include <SimTKcommon/internal/PolygonalMesh.h>
+#include <oscar/Formats/OBJ.h>
+#include <oscar/Formats/STL.h>
+#include <oscar/Formats/VTP.h>
 #include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/VertexAttribute.h>
@@ -13,12 +16,19 @@
 #include <oscar/Maths/Triangle.h>
 #include <oscar/Maths/TriangleFunctions.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Platform/Log.h>
 #include <oscar/Utils/Assertions.h>
+#include <oscar/Utils/Perf.h>
+#include <oscar/Utils/StringHelpers.h>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <fstream>
+#include <istream>
 #include <ranges>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -30,6 +40,27 @@ namespace
 {
     constexpr auto c_supported_mesh_extensions = std::to_array({"obj"sv, "vtp"sv, "stl"sv, "stla"sv});
 
+    using NativeMeshReader = Mesh(*)(std::istream&);
+
+    // returns oscar's native reader for the given mesh file, or `nullptr` if it has no
+    // reader for the file's format
+    NativeMeshReader NativeMeshReaderFor(const std::filesystem::path& p)
+    {
+        const std::string extension = p.extension().string();
+        if (is_equal_case_insensitive(extension, ".obj")) {
+            return read_as_obj;
+        }
+        else if (is_equal_case_insensitive(extension, ".stl") or is_equal_case_insensitive(extension, ".stla")) {
+            return read_as_stl;
+        }
+        else if (is_equal_case_insensitive(extension, ".vtp")) {
+            return read_as_vtp;
+        }
+        else {
+            return nullptr;
+        }
+    }
+
     struct OutputMeshMetrics {
         size_t numVertices = 0;
         size_t numIndices = 0;
@@ -166,6 +197,25 @@ Mesh osc::LoadMeshViaSimTK(const std::filesystem::path& p)
     return ToOscMesh(mesh);
 }
 
+Mesh osc::LoadMesh(const std::filesystem::path& p)
+{
+    OSC_PERF("LoadMesh");
+
+    if (const NativeMeshReader reader = NativeMeshReaderFor(p)) {
+        try {
+            std::ifstream in{p, std::ios::binary};
+            if (in) {
+                return reader(in);
+            }
+        }
+        catch (const std::exception& ex) {
+            // e.g. a non-ASCII VTP file
+            log_warn("%s: could not be read by the native mesh reader (%s): falling back to SimTK", p.string().c_str(), ex.what());
+        }
+    }
+    return LoadMeshViaSimTK(p);
+}
+
 void osc::AssignIndexedVerts(SimTK::PolygonalMesh& mesh, std::span<const Vec3> vertices, MeshIndicesView indices)
 {
     mesh.clear();
@@ -22,6 +22,10 @@ namespace osc
     // returns an `Mesh` loaded from disk via SimTK's APIs
     Mesh LoadMeshViaSimTK(const std::filesystem::path&);
 
+    // returns an `Mesh` loaded from disk via oscar's (faster) native mesh readers if they
+    // support the file, falling back to loading it via SimTK's APIs otherwise
+    Mesh LoadMesh(const std::filesystem::path&);
+
     // populate the `SimTK::PolygonalMesh` from the given indexed mesh data
     void AssignIndexedVerts(SimTK::PolygonalMesh&, std::span<const Vec3>, MeshIndicesView);
 }
@@ -3,19 +3,38 @@
 #include <oscar_simbody/SimTKConverters.h>
 
 #include <Simbody.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/VecFunctions.h>
 #include <oscar/Maths/Vec3.h>
 #include <oscar/Utils/Algorithms.h>
+#include <oscar/Utils/Assertions.h>
 #include <oscar/Utils/ParalellizationHelpers.h>
 #include <oscar/Utils/Perf.h>
+#include <oscar/Utils/ThreadPool.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <limits>
 #include <ranges>
 #include <span>
+#include <utility>
 #include <vector>
 
+// the AVX2 kernel is compiled with a function-level target attribute and selected at
+// runtime, so that the rest of the codebase doesn't need to be compiled with AVX2 enabled
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define OSC_TPS3D_HAS_AVX2_KERNEL
+    #include <immintrin.h>
+#endif
+
 using namespace osc;
+namespace rgs = std::ranges;
 
 namespace
 {
@@ -37,6 +56,476 @@ namespace
     }
 }
 
+namespace
+{
+    // a read-only view of the SoA storage of the non-affine terms in `TPSEvaluator3D`
+    struct NonAffineTermsView final {
+        std::span<const float> controlPointsX;
+        std::span<const float> controlPointsY;
+        std::span<const float> controlPointsZ;
+        std::span<const float> weightsX;
+        std::span<const float> weightsY;
+        std::span<const float> weightsZ;
+    };
+
+    // the number of non-affine terms that kernels accumulate in single precision before
+    // accumulating the block's sum in double precision
+    constexpr size_t c_NumTermsPerAccumulationBlock = 64;
+
+    // writes the sum of the non-affine terms (`SUM{ wi * U(||controlPoint_i - p||) }`) of each
+    // point in `points` to the corresponding element in `sums`
+    using SumNonAffineTermsKernel = void(*)(const NonAffineTermsView&, std::span<const Vec3> points, std::span<Vec3d> sums);
+
+    void SumNonAffineTermsScalar(const NonAffineTermsView& terms, std::span<const Vec3> points, std::span<Vec3d> sums)
+    {
+        const size_t numTerms = terms.controlPointsX.size();
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Vec3 p = points[i];
+
+            Vec3d sum{};
+            for (size_t blockBegin = 0; blockBegin < numTerms; blockBegin += c_NumTermsPerAccumulationBlock) {
+                const size_t blockEnd = min(blockBegin + c_NumTermsPerAccumulationBlock, numTerms);
+                Vec3 blockSum{};
+                for (size_t j = blockBegin; j < blockEnd; ++j) {
+                    const float dx = terms.controlPointsX[j] - p.x;
+                    const float dy = terms.controlPointsY[j] - p.y;
+                    const float dz = terms.controlPointsZ[j] - p.z;
+                    const float u = std::sqrt(dx*dx + dy*dy + dz*dz);  // see: `RadialBasisFunction3D`
+                    blockSum.x += terms.weightsX[j] * u;
+                    blockSum.y += terms.weightsY[j] * u;
+                    blockSum.z += terms.weightsZ[j] * u;
+                }
+                sum += Vec3d{blockSum};
+            }
+            sums[i] = sum;
+        }
+    }
+
+#ifdef OSC_TPS3D_HAS_AVX2_KERNEL
+    bool IsAVX2KernelSupported()
+    {
+        static const bool s_IsSupported = __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma");
+        return s_IsSupported;
+    }
+
+    // evaluates 8 points at a time (one per SIMD lane) against each (broadcasted) term
+    __attribute__((target("avx2,fma")))
+    void SumNonAffineTermsAVX2(const NonAffineTermsView& terms, std::span<const Vec3> points, std::span<Vec3d> sums)
+    {
+        constexpr size_t c_NumLanes = 8;
+        const size_t numTerms = terms.controlPointsX.size();
+
+        for (size_t batchBegin = 0; batchBegin < points.size(); batchBegin += c_NumLanes) {
+            const size_t batchSize = min(c_NumLanes, points.size() - batchBegin);
+
+            // transpose the (AoS) batch of points into SoA lanes (padding with the last point)
+            alignas(32) std::array<float, c_NumLanes> xs{};
+            alignas(32) std::array<float, c_NumLanes> ys{};
+            alignas(32) std::array<float, c_NumLanes> zs{};
+            for (size_t lane = 0; lane < c_NumLanes; ++lane) {
+                const Vec3& p = points[batchBegin + min(lane, batchSize - 1)];
+                xs[lane] = p.x;
+                ys[lane] = p.y;
+                zs[lane] = p.z;
+            }
+            const __m256 px = _mm256_load_ps(xs.data());
+            const __m256 py = _mm256_load_ps(ys.data());
+            const __m256 pz = _mm256_load_ps(zs.data());
+
+            // double-precision sums of the lower/upper 4 lanes
+            __m256d sumXLo = _mm256_setzero_pd();
+            __m256d sumXHi = _mm256_setzero_pd();
+            __m256d sumYLo = _mm256_setzero_pd();
+            __m256d sumYHi = _mm256_setzero_pd();
+            __m256d sumZLo = _mm256_setzero_pd();
+            __m256d sumZHi = _mm256_setzero_pd();
+
+            for (size_t blockBegin = 0; blockBegin < numTerms; blockBegin += c_NumTermsPerAccumulationBlock) {
+                const size_t blockEnd = min(blockBegin + c_NumTermsPerAccumulationBlock, numTerms);
+
+                __m256 blockSumX = _mm256_setzero_ps();
+                __m256 blockSumY = _mm256_setzero_ps();
+                __m256 blockSumZ = _mm256_setzero_ps();
+                for (size_t j = blockBegin; j < blockEnd; ++j) {
+                    const __m256 dx = _mm256_sub_ps(_mm256_broadcast_ss(&terms.controlPointsX[j]), px);
+                    const __m256 dy = _mm256_sub_ps(_mm256_broadcast_ss(&terms.controlPointsY[j]), py);
+                    const __m256 dz = _mm256_sub_ps(_mm256_broadcast_ss(&terms.controlPointsZ[j]), pz);
+                    const __m256 u = _mm256_sqrt_ps(_mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+                    blockSumX = _mm256_fmadd_ps(_mm256_broadcast_ss(&terms.weightsX[j]), u, blockSumX);
+                    blockSumY = _mm256_fmadd_ps(_mm256_broadcast_ss(&terms.weightsY[j]), u, blockSumY);
+                    blockSumZ = _mm256_fmadd_ps(_mm256_broadcast_ss(&terms.weightsZ[j]), u, blockSumZ);
+                }
+
+                sumXLo = _mm256_add_pd(sumXLo, _mm256_cvtps_pd(_mm256_castps256_ps128(blockSumX)));
+                sumXHi = _mm256_add_pd(sumXHi, _mm256_cvtps_pd(_mm256_extractf128_ps(blockSumX, 1)));
+                sumYLo = _mm256_add_pd(sumYLo, _mm256_cvtps_pd(_mm256_castps256_ps128(blockSumY)));
+                sumYHi = _mm256_add_pd(sumYHi, _mm256_cvtps_pd(_mm256_extractf128_ps(blockSumY, 1)));
+                sumZLo = _mm256_add_pd(sumZLo, _mm256_cvtps_pd(_mm256_castps256_ps128(blockSumZ)));
+                sumZHi = _mm256_add_pd(sumZHi, _mm256_cvtps_pd(_mm256_extractf128_ps(blockSumZ, 1)));
+            }
+
+            alignas(32) std::array<double, c_NumLanes> sumsX{};
+            alignas(32) std::array<double, c_NumLanes> sumsY{};
+            alignas(32) std::array<double, c_NumLanes> sumsZ{};
+            _mm256_store_pd(sumsX.data(), sumXLo);
+            _mm256_store_pd(sumsX.data() + 4, sumXHi);
+            _mm256_store_pd(sumsY.data(), sumYLo);
+            _mm256_store_pd(sumsY.data() + 4, sumYHi);
+            _mm256_store_pd(sumsZ.data(), sumZLo);
+            _mm256_store_pd(sumsZ.data() + 4, sumZHi);
+            for (size_t lane = 0; lane < batchSize; ++lane) {
+                sums[batchBegin + lane] = {sumsX[lane], sumsY[lane], sumsZ[lane]};
+            }
+        }
+    }
+#endif
+
+    TPSEvaluatorKernel3D ResolveKernel(TPSEvaluatorKernel3D kernel)
+    {
+#ifdef OSC_TPS3D_HAS_AVX2_KERNEL
+        if ((kernel == TPSEvaluatorKernel3D::Fastest or kernel == TPSEvaluatorKernel3D::AVX2) and IsAVX2KernelSupported()) {
+            return TPSEvaluatorKernel3D::AVX2;
+        }
+#endif
+        (void)kernel;
+        return TPSEvaluatorKernel3D::Scalar;
+    }
+
+    SumNonAffineTermsKernel GetKernelFunction(TPSEvaluatorKernel3D kernel)
+    {
+#ifdef OSC_TPS3D_HAS_AVX2_KERNEL
+        if (kernel == TPSEvaluatorKernel3D::AVX2) {
+            return SumNonAffineTermsAVX2;
+        }
+#endif
+        (void)kernel;
+        return SumNonAffineTermsScalar;
+    }
+}
+
+namespace
+{
+    // pivots (during low-rank updates) that are smaller than this, relative to the magnitude
+    // of the terms that they're computed from, indicate that the update is unstable
+    constexpr double c_MinRelativeUpdatePivot = 1e-8;
+
+    // solutions with a larger residual than this (relative to `||L||*||[w a]|| + ||[v o]||`)
+    // are treated as inaccurate
+    constexpr double c_MaxRelativeResidual = 1e-9;
+
+    // the maximum number of consecutive incremental updates that `TPSCoefficientSolver3D`
+    // applies before fully re-solving (to bound error accumulation)
+    constexpr size_t c_MaxIncrementalUpdatesBetweenFullSolves = 1024;
+
+    // the maximum number of moved landmarks that `TPSCoefficientSolver3D::setInputs` updates
+    // incrementally (each is O(N^2), a full solve is O(N^3))
+    constexpr size_t c_MaxIncrementallyMovedLandmarks = 8;
+
+    // returns the number of rows/columns in L for the given number of landmarks
+    constexpr size_t SystemSize(size_t numLandmarks)
+    {
+        return numLandmarks + 4;
+    }
+
+    // returns the `i`th column (== row, because L is symmetric) of L, but with the `i`th
+    // landmark's source located at `source`
+    std::vector<double> CalcSystemMatrixColumn(std::span<const LandmarkPair3D> landmarks, size_t i, const Vec3& source)
+    {
+        std::vector<double> rv;
+        rv.reserve(SystemSize(landmarks.size()));
+        for (size_t j = 0; j < landmarks.size(); ++j) {
+            rv.push_back(j == i ? 0.0 : static_cast<double>(RadialBasisFunction3D(source, landmarks[j].source)));
+        }
+        rv.insert(rv.end(), {1.0, static_cast<double>(source.x), static_cast<double>(source.y), static_cast<double>(source.z)});
+        return rv;
+    }
+
+    // returns row-major storage of L (see `CalcCoefficients` for its layout)
+    std::vector<double> CalcSystemMatrix(std::span<const LandmarkPair3D> landmarks)
+    {
+        const size_t n = SystemSize(landmarks.size());
+        std::vector<double> rv(n*n, 0.0);
+        for (size_t i = 0; i < landmarks.size(); ++i) {
+            const std::vector<double> column = CalcSystemMatrixColumn(landmarks, i, landmarks[i].source);
+            for (size_t j = 0; j < n; ++j) {
+                rv[i*n + j] = column[j];
+                rv[j*n + i] = column[j];
+            }
+        }
+        return rv;
+    }
+
+    // returns `m * v`, where `m` is a row-major `n`x`n` matrix
+    std::vector<double> Multiply(std::span<const double> m, size_t n, std::span<const double> v)
+    {
+        std::vector<double> rv(n, 0.0);
+        for (size_t row = 0; row < n; ++row) {
+            double sum = 0.0;
+            for (size_t col = 0; col < n; ++col) {
+                sum += m[row*n + col] * v[col];
+            }
+            rv[row] = sum;
+        }
+        return rv;
+    }
+
+    // returns the row-major `n`x`n` matrix `m` with `rowAndColumn` (`n+1` elements) inserted
+    // as both its `k`th row and `k`th column
+    std::vector<double> WithRowAndColumnInserted(std::span<const double> m, size_t n, size_t k, std::span<const double> rowAndColumn)
+    {
+        const size_t newN = n + 1;
+        std::vector<double> rv(newN*newN);
+        for (size_t row = 0; row < newN; ++row) {
+            for (size_t col = 0; col < newN; ++col) {
+                if (row == k) {
+                    rv[row*newN + col] = rowAndColumn[col];
+                }
+                else if (col == k) {
+                    rv[row*newN + col] = rowAndColumn[row];
+                }
+                else {
+                    rv[row*newN + col] = m[(row - (row > k ? 1 : 0))*n + (col - (col > k ? 1 : 0))];
+                }
+            }
+        }
+        return rv;
+    }
+
+    // returns the row-major `n`x`n` matrix `m` with its `k`th row and `k`th column erased
+    std::vector<double> WithRowAndColumnErased(std::span<const double> m, size_t n, size_t k)
+    {
+        std::vector<double> rv;
+        rv.reserve((n-1)*(n-1));
+        for (size_t row = 0; row < n; ++row) {
+            for (size_t col = 0; col < n; ++col) {
+                if (row != k and col != k) {
+                    rv.push_back(m[row*n + col]);
+                }
+            }
+        }
+        return rv;
+    }
+}
+
+namespace
+{
+    // octree nodes with this many (or fewer) terms aren't subdivided
+    constexpr size_t c_MaxTermsPerOctreeLeaf = 64;
+
+    // octree nodes at this depth aren't subdivided (e.g. because of duplicate control points)
+    constexpr size_t c_MaxOctreeDepth = 24;
+
+    // bounds the error of `TPSApproximateEvaluator3D`'s second-order expansion of `U`
+    //
+    // for a term at `center + d` (`|d| <= radius`), the expansion's (Taylor) remainder is
+    // `h'''(t)/6` for some `t` in [0, 1], where `h(t) = |p - center - t*d|`. Differentiating
+    // gives `|h'''(t)| = 3 * |d|^3 * |cos(a)| * sin(a)^2 / h(t)^2 <= (2/sqrt(3)) * |d|^3 / h(t)^2`,
+    // and `h(t) >= r - radius`, so each term's error is at most this factor multiplied by
+    // `|wi| * radius^3 / (r - radius)^2`
+    constexpr double c_ExpansionErrorBoundFactor = 0.2;  // >= 1/(3*sqrt(3))
+
+    // the (maximum) number of points in each block that `TPSApproximateEvaluator3D` evaluates together
+    constexpr size_t c_PointsPerApproximationBlock = 128;
+
+    // returns the center of the bounds of the given points
+    Vec3d BoundsCenter(std::span<const Vec3> points)
+    {
+        Vec3 minCorner = points.front();
+        Vec3 maxCorner = points.front();
+        for (const Vec3& p : points) {
+            minCorner = elementwise_min(minCorner, p);
+            maxCorner = elementwise_max(maxCorner, p);
+        }
+        return 0.5*(Vec3d{minCorner} + Vec3d{maxCorner});
+    }
+
+    // returns `x`'s lower 10 bits, spread such that there are two zero bits between each bit
+    constexpr uint32_t SpreadBits(uint32_t x)
+    {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8))  & 0x0300f00f;
+        x = (x | (x << 4))  & 0x030c30c3;
+        x = (x | (x << 2))  & 0x09249249;
+        return x;
+    }
+
+    // returns the indices of `numPoints` points (where `pointAt(i)` returns the `i`th point),
+    // sorted by their location along a Morton (Z-order) curve, so that consecutive indices
+    // tend to be close to each other
+    template<std::invocable<size_t> GetPoint>
+    std::vector<size_t> SpatiallySortedIndices(size_t numPoints, const GetPoint& pointAt)
+    {
+        if (numPoints == 0) {
+            return {};
+        }
+
+        Vec3 minCorner = pointAt(0);
+        Vec3 maxCorner = minCorner;
+        for (size_t i = 1; i < numPoints; ++i) {
+            minCorner = elementwise_min(minCorner, pointAt(i));
+            maxCorner = elementwise_max(maxCorner, pointAt(i));
+        }
+        const Vec3 dimensions = maxCorner - minCorner;
+        const float scale = 1023.0f / max(max(dimensions.x, max(dimensions.y, dimensions.z)), std::numeric_limits<float>::min());
+
+        std::vector<std::pair<uint32_t, size_t>> codes;
+        codes.reserve(numPoints);
+        for (size_t i = 0; i < numPoints; ++i) {
+            const Vec3 quantized = scale * (pointAt(i) - minCorner);
+            const uint32_t code =
+                SpreadBits(static_cast<uint32_t>(quantized.x)) |
+                (SpreadBits(static_cast<uint32_t>(quantized.y)) << 1) |
+                (SpreadBits(static_cast<uint32_t>(quantized.z)) << 2);
+            codes.emplace_back(code, i);
+        }
+        rgs::sort(codes);
+
+        std::vector<size_t> rv;
+        rv.reserve(codes.size());
+        for (const auto& [code, i] : codes) {
+            rv.push_back(i);
+        }
+        return rv;
+    }
+}
+
+namespace
+{
+    // the solution to the TPS system `L * [w a] = [v o]` (see `CalcCoefficients`)
+    struct QTZSolution final {
+        SimTK::Vector Cx;
+        SimTK::Vector Cy;
+        SimTK::Vector Cz;
+
+        // row-major storage of L's inverse (empty if it wasn't requested, or if L is rank-deficient)
+        std::vector<double> LInverse;
+    };
+
+    // solves the (non-empty) TPS system with SimTK's QTZ factorization, which is also used to
+    // compute L's inverse if `computeInverse` is `true` and L has full rank
+    QTZSolution SolveWithQTZ(const TPSCoefficientSolverInputs3D& inputs, bool computeInverse)
+    {
+        const int numPairs = static_cast<int>(inputs.landmarks.size());
+
+        // construct matrix L
+        SimTK::Matrix L(numPairs + 4, numPairs + 4);
+
+        // populate the K part of matrix L (upper-left)
+        for (int row = 0; row < numPairs; ++row) {
+            for (int col = 0; col < numPairs; ++col) {
+                const Vec3& pis = inputs.landmarks[row].source;
+                const Vec3& pj = inputs.landmarks[col].source;
+
+                L(row, col) = RadialBasisFunction3D(pis, pj);
+            }
+        }
+
+        // populate the P part of matrix L (upper-right)
+        {
+            const int pStartColumn = numPairs;
+
+            for (int row = 0; row < numPairs; ++row) {
+                L(row, pStartColumn)     = 1.0;
+                L(row, pStartColumn + 1) = inputs.landmarks[row].source.x;
+                L(row, pStartColumn + 2) = inputs.landmarks[row].source.y;
+                L(row, pStartColumn + 3) = inputs.landmarks[row].source.z;
+            }
+        }
+
+        // populate the PT part of matrix L (bottom-left)
+        {
+            const int ptStartRow = numPairs;
+
+            for (int col = 0; col < numPairs; ++col) {
+                L(ptStartRow, col)     = 1.0;
+                L(ptStartRow + 1, col) = inputs.landmarks[col].source.x;
+                L(ptStartRow + 2, col) = inputs.landmarks[col].source.y;
+                L(ptStartRow + 3, col) = inputs.landmarks[col].source.z;
+            }
+        }
+
+        // populate the 0 part of matrix L (bottom-right)
+        {
+            const int zeroStartRow = numPairs;
+            const int zeroStartCol = numPairs;
+
+            for (int row = 0; row < 4; ++row) {
+                for (int col = 0; col < 4; ++col) {
+                    L(zeroStartRow + row, zeroStartCol + col) = 0.0;
+                }
+            }
+        }
+
+        // construct "result" vectors Vx and Vy (these hold the landmark destinations)
+        SimTK::Vector Vx(numPairs + 4, 0.0);
+        SimTK::Vector Vy(numPairs + 4, 0.0);
+        SimTK::Vector Vz(numPairs + 4, 0.0);
+        for (int row = 0; row < numPairs; ++row) {
+            Vx[row] = inputs.landmarks[row].destination.x;
+            Vy[row] = inputs.landmarks[row].destination.y;
+            Vz[row] = inputs.landmarks[row].destination.z;
+        }
+
+        // create a linear solver that can be used to solve `L*Cn = Vn` for `Cn` (where `n` is a dimension)
+        const SimTK::FactorQTZ F{L};
+
+        // solve for each dimension
+        QTZSolution rv;
+        rv.Cx = SimTK::Vector(numPairs + 4, 0.0);
+        F.solve(Vx, rv.Cx);
+        rv.Cy = SimTK::Vector(numPairs + 4, 0.0);
+        F.solve(Vy, rv.Cy);
+        rv.Cz = SimTK::Vector(numPairs + 4, 0.0);
+        F.solve(Vz, rv.Cz);
+
+        if (computeInverse and F.getQTZRank() == numPairs + 4) {
+            SimTK::Matrix LInverse;
+            F.inverse(LInverse);
+
+            const auto n = static_cast<size_t>(numPairs + 4);
+            rv.LInverse.resize(n*n);
+            for (size_t row = 0; row < n; ++row) {
+                for (size_t col = 0; col < n; ++col) {
+                    rv.LInverse[row*n + col] = LInverse(static_cast<int>(row), static_cast<int>(col));
+                }
+            }
+        }
+        return rv;
+    }
+
+    // returns the coefficients of the TPS equation from the solution of its system
+    TPSCoefficients3D ToCoefficients(const TPSCoefficientSolverInputs3D& inputs, const QTZSolution& solution)
+    {
+        const int numPairs = static_cast<int>(inputs.landmarks.size());
+        const SimTK::Vector& Cx = solution.Cx;
+        const SimTK::Vector& Cy = solution.Cy;
+        const SimTK::Vector& Cz = solution.Cz;
+
+        // `Cx/Cy/Cz` contain the solved coefficients (e.g. for X): [w1, w2, ... wx, a0, a1x, a1y a1z]
+        //
+        // extract the coefficients into the return value
+
+        TPSCoefficients3D rv;
+
+        // populate affine a1, a2, a3, and a4 terms
+        rv.a1 = {Cx[numPairs],   Cy[numPairs]  , Cz[numPairs]  };
+        rv.a2 = {Cx[numPairs+1], Cy[numPairs+1], Cz[numPairs+1]};
+        rv.a3 = {Cx[numPairs+2], Cy[numPairs+2], Cz[numPairs+2]};
+        rv.a4 = {Cx[numPairs+3], Cy[numPairs+3], Cz[numPairs+3]};
+
+        // populate `wi` coefficients (+ control points, needed at evaluation-time)
+        rv.nonAffineTerms.reserve(numPairs);
+        for (int i = 0; i < numPairs; ++i) {
+            const Vec3 weight = {Cx[i], Cy[i], Cz[i]};
+            const Vec3& controlPoint = inputs.landmarks[i].source;
+            rv.nonAffineTerms.emplace_back(weight, controlPoint);
+        }
+
+        return rv;
+    }
+}
+
 std::ostream& osc::operator<<(std::ostream& o, const TPSCoefficientSolverInputs3D& inputs)
 {
     o << "TPSCoefficientSolverInputs3D{landmarks = [";
@@ -115,104 +604,361 @@ TPSCoefficients3D osc::CalcCoefficients(const TPSCoefficientSolverInputs3D& inpu
 
     OSC_PERF("CalcCoefficients");
 
-    const int numPairs = static_cast<int>(inputs.landmarks.size());
-
-    if (numPairs == 0) {
+    if (inputs.landmarks.empty()) {
         // edge-case: there are no pairs, so return an identity-like transform
         return TPSCoefficients3D{};
     }
+    return ToCoefficients(inputs, SolveWithQTZ(inputs, false));
+}
 
-    // construct matrix L
-    SimTK::Matrix L(numPairs + 4, numPairs + 4);
+osc::TPSCoefficientSolver3D::TPSCoefficientSolver3D(TPSCoefficientSolverInputs3D inputs) :
+    m_Inputs{std::move(inputs)}
+{
+    solveFully();
+}
 
-    // populate the K part of matrix L (upper-left)
-    for (int row = 0; row < numPairs; ++row) {
-        for (int col = 0; col < numPairs; ++col) {
-            const Vec3& pis = inputs.landmarks[row].source;
-            const Vec3& pj = inputs.landmarks[col].source;
+void osc::TPSCoefficientSolver3D::setInputs(const TPSCoefficientSolverInputs3D& inputs)
+{
+    const std::vector<LandmarkPair3D>& current = m_Inputs.landmarks;
+    const std::vector<LandmarkPair3D>& next = inputs.landmarks;
 
-            L(row, col) = RadialBasisFunction3D(pis, pj);
+    if (next.size() == current.size()) {
+        std::vector<size_t> movedLandmarks;
+        for (size_t i = 0; i < next.size() and movedLandmarks.size() <= c_MaxIncrementallyMovedLandmarks; ++i) {
+            if (next[i] != current[i]) {
+                movedLandmarks.push_back(i);
+            }
+        }
+        if (movedLandmarks.size() <= c_MaxIncrementallyMovedLandmarks) {
+            for (size_t i : movedLandmarks) {
+                setLandmark(i, next[i]);
+            }
+            return;
+        }
+    }
+    else if (next.size() == current.size() + 1) {
+        const auto i = static_cast<size_t>(rgs::mismatch(current, next).in1 - current.begin());
+        if (rgs::equal(current | std::views::drop(i), next | std::views::drop(i+1))) {
+            insertLandmark(i, next[i]);
+            return;
+        }
+    }
+    else if (next.size() + 1 == current.size()) {
+        const auto i = static_cast<size_t>(rgs::mismatch(next, current).in1 - next.begin());
+        if (rgs::equal(current | std::views::drop(i+1), next | std::views::drop(i))) {
+            eraseLandmark(i);
+            return;
         }
     }
 
-    // populate the P part of matrix L (upper-right)
-    {
-        const int pStartColumn = numPairs;
+    // the inputs have changed too much to update incrementally
+    m_Inputs = inputs;
+    solveFully();
+}
 
-        for (int row = 0; row < numPairs; ++row) {
-            L(row, pStartColumn)     = 1.0;
-            L(row, pStartColumn + 1) = inputs.landmarks[row].source.x;
-            L(row, pStartColumn + 2) = inputs.landmarks[row].source.y;
-            L(row, pStartColumn + 3) = inputs.landmarks[row].source.z;
+void osc::TPSCoefficientSolver3D::setLandmark(size_t i, const LandmarkPair3D& landmark)
+{
+    const LandmarkPair3D previous = m_Inputs.landmarks.at(i);
+    if (landmark == previous) {
+        return;
+    }
+
+    m_Inputs.landmarks[i] = landmark;
+    if (not (canUpdateIncrementally() and tryUpdateLandmark(i, previous))) {
+        solveFully();
+    }
+}
+
+void osc::TPSCoefficientSolver3D::insertLandmark(size_t i, const LandmarkPair3D& landmark)
+{
+    OSC_ASSERT_ALWAYS(i <= m_Inputs.landmarks.size() && "tried to insert a TPS landmark at an out-of-bounds location");
+
+    m_Inputs.landmarks.insert(m_Inputs.landmarks.begin() + static_cast<ptrdiff_t>(i), landmark);
+    if (not (canUpdateIncrementally() and tryInsertLandmark(i))) {
+        solveFully();
+    }
+}
+
+void osc::TPSCoefficientSolver3D::eraseLandmark(size_t i)
+{
+    OSC_ASSERT_ALWAYS(i < m_Inputs.landmarks.size() && "tried to erase an out-of-bounds TPS landmark");
+
+    m_Inputs.landmarks.erase(m_Inputs.landmarks.begin() + static_cast<ptrdiff_t>(i));
+    if (not (canUpdateIncrementally() and tryEraseLandmark(i))) {
+        solveFully();
+    }
+}
+
+void osc::TPSCoefficientSolver3D::solveFully()
+{
+    OSC_PERF("TPSCoefficientSolver3D::solveFully");
+
+    ++m_NumFullSolves;
+    m_NumUpdatesSinceFullSolve = 0;
+    m_L.clear();
+    m_LInverse.clear();
+    m_Solution.clear();
+
+    if (m_Inputs.landmarks.empty()) {
+        m_Coefficients = TPSCoefficients3D{};
+        return;
+    }
+
+    // solve the system in the same way as `CalcCoefficients`, so that full solves produce the
+    // same coefficients, but also keep L's inverse and the solution for incremental updates
+    QTZSolution solution = SolveWithQTZ(m_Inputs, true);
+    m_Coefficients = ToCoefficients(m_Inputs, solution);
+    if (solution.LInverse.empty()) {
+        return;  // L is rank-deficient (e.g. <4 landmarks, or they're coplanar): can't update it incrementally
+    }
+
+    const size_t n = SystemSize(m_Inputs.landmarks.size());
+    m_L = CalcSystemMatrix(m_Inputs.landmarks);
+    m_LInverse = std::move(solution.LInverse);
+    m_Solution.reserve(3*n);
+    for (int row = 0; row < static_cast<int>(n); ++row) {
+        m_Solution.insert(m_Solution.end(), {solution.Cx[row], solution.Cy[row], solution.Cz[row]});
+    }
+
+    if (not hasAccurateSolution()) {
+        // L is too ill-conditioned to (accurately) update incrementally
+        m_L.clear();
+        m_LInverse.clear();
+        m_Solution.clear();
+    }
+}
+
+bool osc::TPSCoefficientSolver3D::canUpdateIncrementally() const
+{
+    return not m_LInverse.empty() and m_NumUpdatesSinceFullSolve < c_MaxIncrementalUpdatesBetweenFullSolves;
+}
+
+bool osc::TPSCoefficientSolver3D::tryUpdateLandmark(size_t i, const LandmarkPair3D& previous)
+{
+    OSC_PERF("TPSCoefficientSolver3D::tryUpdateLandmark");
+
+    const size_t n = SystemSize(m_Inputs.landmarks.size());
+    const LandmarkPair3D& landmark = m_Inputs.landmarks[i];
+
+    if (landmark.source == previous.source) {
+        // only the destination moved, which only changes the right-hand side of the system,
+        // so the solution changes by the destination's delta multiplied by L^-1's `i`th column
+        const Vec3d delta = Vec3d{landmark.destination} - Vec3d{previous.destination};
+        for (size_t row = 0; row < n; ++row) {
+            for (size_t dim = 0; dim < 3; ++dim) {
+                m_Solution[3*row + dim] += m_LInverse[row*n + i] * delta[dim];
+            }
         }
+        updateCoefficientsFromSolution();
+        onIncrementalUpdate();
+        return true;
     }
 
-    // populate the PT part of matrix L (bottom-left)
-    {
-        const int ptStartRow = numPairs;
+    // the source moved, which changes L's `i`th row and column (by `d`), i.e. a symmetric
+    // rank-2 update `L' = L + e_i*d^T + d*e_i^T`, so use the Sherman-Morrison-Woodbury
+    // formula to update L^-1
+    std::vector<double> d = CalcSystemMatrixColumn(m_Inputs.landmarks, i, landmark.source);
+    for (size_t row = 0; row < n; ++row) {
+        d[row] -= m_L[row*n + i];
+    }
+
+    const std::vector<double> a(m_LInverse.begin() + static_cast<ptrdiff_t>(i*n), m_LInverse.begin() + static_cast<ptrdiff_t>((i+1)*n));  // L^-1's `i`th column (== row)
+    const std::vector<double> ad = Multiply(m_LInverse, n, d);
+    double alpha = 0.0;
+    double beta = 0.0;
+    for (size_t row = 0; row < n; ++row) {
+        alpha += d[row] * a[row];
+        beta += d[row] * ad[row];
+    }
+    const double gamma = a[i];
 
-        for (int col = 0; col < numPairs; ++col) {
-            L(ptStartRow, col)     = 1.0;
-            L(ptStartRow + 1, col) = inputs.landmarks[col].source.x;
-            L(ptStartRow + 2, col) = inputs.landmarks[col].source.y;
-            L(ptStartRow + 3, col) = inputs.landmarks[col].source.z;
+    // the 2x2 "capacitance" matrix is `|1+alpha beta; gamma 1+alpha|`
+    const double det = (1.0 + alpha)*(1.0 + alpha) - beta*gamma;
+    if (not (std::abs(det) > c_MinRelativeUpdatePivot * ((1.0 + alpha)*(1.0 + alpha) + std::abs(beta*gamma)))) {
+        return false;  // the update is unstable
+    }
+
+    for (size_t row = 0; row < n; ++row) {
+        for (size_t col = 0; col < n; ++col) {
+            const double correction =
+                a[row] * ((1.0 + alpha)*ad[col] - beta*a[col]) +
+                ad[row] * ((1.0 + alpha)*a[col] - gamma*ad[col]);
+            m_LInverse[row*n + col] -= correction / det;
         }
     }
+    for (size_t row = 0; row < n; ++row) {
+        m_L[row*n + i] += d[row];
+        m_L[i*n + row] = m_L[row*n + i];
+    }
 
-    // populate the 0 part of matrix L (bottom-right)
-    {
-        const int zeroStartRow = numPairs;
-        const int zeroStartCol = numPairs;
+    updateSolutionFromInverse();
+    if (not hasAccurateSolution()) {
+        return false;
+    }
+    updateCoefficientsFromSolution();
+    onIncrementalUpdate();
+    return true;
+}
 
-        for (int row = 0; row < 4; ++row) {
-            for (int col = 0; col < 4; ++col) {
-                L(zeroStartRow + row, zeroStartCol + col) = 0.0;
-            }
+bool osc::TPSCoefficientSolver3D::tryInsertLandmark(size_t i)
+{
+    OSC_PERF("TPSCoefficientSolver3D::tryInsertLandmark");
+
+    // inserting a landmark borders L with a new row+column, `|L b; b^T 0|` (after permuting
+    // it to the end), so use the block-inverse formula (via the Schur complement of L)
+    const size_t n = SystemSize(m_Inputs.landmarks.size() - 1);  // i.e. before the insertion
+    const std::vector<double> rowAndColumn = CalcSystemMatrixColumn(m_Inputs.landmarks, i, m_Inputs.landmarks[i].source);
+
+    std::vector<double> b = rowAndColumn;
+    b.erase(b.begin() + static_cast<ptrdiff_t>(i));
+    const std::vector<double> ab = Multiply(m_LInverse, n, b);
+
+    double bab = 0.0;
+    double babMagnitude = 0.0;
+    for (size_t row = 0; row < n; ++row) {
+        bab += b[row] * ab[row];
+        babMagnitude += std::abs(b[row] * ab[row]);
+    }
+    const double schurComplement = rowAndColumn[i] - bab;
+    if (not (std::abs(schurComplement) > c_MinRelativeUpdatePivot * babMagnitude)) {
+        return false;  // the update is unstable
+    }
+
+    std::vector<double> borderedInverseRowAndColumn(n + 1);
+    for (size_t row = 0; row < n + 1; ++row) {
+        borderedInverseRowAndColumn[row] = row == i ?
+            1.0 / schurComplement :
+            -ab[row - (row > i ? 1 : 0)] / schurComplement;
+    }
+    for (size_t row = 0; row < n; ++row) {
+        for (size_t col = 0; col < n; ++col) {
+            m_LInverse[row*n + col] += ab[row] * ab[col] / schurComplement;
         }
     }
+    m_LInverse = WithRowAndColumnInserted(m_LInverse, n, i, borderedInverseRowAndColumn);
+    m_L = WithRowAndColumnInserted(m_L, n, i, rowAndColumn);
 
-    // construct "result" vectors Vx and Vy (these hold the landmark destinations)
-    SimTK::Vector Vx(numPairs + 4, 0.0);
-    SimTK::Vector Vy(numPairs + 4, 0.0);
-    SimTK::Vector Vz(numPairs + 4, 0.0);
-    for (int row = 0; row < numPairs; ++row) {
-        Vx[row] = inputs.landmarks[row].destination.x;
-        Vy[row] = inputs.landmarks[row].destination.y;
-        Vz[row] = inputs.landmarks[row].destination.z;
+    updateSolutionFromInverse();
+    if (not hasAccurateSolution()) {
+        return false;
     }
+    updateCoefficientsFromSolution();
+    onIncrementalUpdate();
+    return true;
+}
 
-    // create a linear solver that can be used to solve `L*Cn = Vn` for `Cn` (where `n` is a dimension)
-    const SimTK::FactorQTZ F{L};
+bool osc::TPSCoefficientSolver3D::tryEraseLandmark(size_t i)
+{
+    OSC_PERF("TPSCoefficientSolver3D::tryEraseLandmark");
 
-    // solve for each dimension
-    SimTK::Vector Cx(numPairs + 4, 0.0);
-    F.solve(Vx, Cx);
-    SimTK::Vector Cy(numPairs + 4, 0.0);
-    F.solve(Vy, Cy);
-    SimTK::Vector Cz(numPairs + 4, 0.0);
-    F.solve(Vz, Cz);
+    // erasing a landmark removes a row+column from L, so the inverse of what remains is
+    // `A - b*b^T/c`, where `|A b; b^T c|` is L^-1 (after permuting the erased row+column
+    // to the end)
+    const size_t n = SystemSize(m_Inputs.landmarks.size() + 1);  // i.e. before the erasure
+    const double c = m_LInverse[i*n + i];
 
-    // `Cx/Cy/Cz` now contain the solved coefficients (e.g. for X): [w1, w2, ... wx, a0, a1x, a1y a1z]
-    //
-    // extract the coefficients into the return value
+    double maxAbsB = 0.0;
+    for (size_t row = 0; row < n; ++row) {
+        maxAbsB = max(maxAbsB, std::abs(m_LInverse[row*n + i]));
+    }
+    if (not (std::abs(c) > c_MinRelativeUpdatePivot * maxAbsB)) {
+        return false;  // the update is unstable
+    }
+
+    const std::vector<double> b(m_LInverse.begin() + static_cast<ptrdiff_t>(i*n), m_LInverse.begin() + static_cast<ptrdiff_t>((i+1)*n));
+    for (size_t row = 0; row < n; ++row) {
+        for (size_t col = 0; col < n; ++col) {
+            m_LInverse[row*n + col] -= b[row] * b[col] / c;
+        }
+    }
+    m_LInverse = WithRowAndColumnErased(m_LInverse, n, i);
+    m_L = WithRowAndColumnErased(m_L, n, i);
 
-    TPSCoefficients3D rv;
+    updateSolutionFromInverse();
+    if (not hasAccurateSolution()) {
+        return false;
+    }
+    updateCoefficientsFromSolution();
+    onIncrementalUpdate();
+    return true;
+}
 
-    // populate affine a1, a2, a3, and a4 terms
-    rv.a1 = {Cx[numPairs],   Cy[numPairs]  , Cz[numPairs]  };
-    rv.a2 = {Cx[numPairs+1], Cy[numPairs+1], Cz[numPairs+1]};
-    rv.a3 = {Cx[numPairs+2], Cy[numPairs+2], Cz[numPairs+2]};
-    rv.a4 = {Cx[numPairs+3], Cy[numPairs+3], Cz[numPairs+3]};
+void osc::TPSCoefficientSolver3D::updateSolutionFromInverse()
+{
+    // `[w a] = L^-1 * [v o]`, where `o` is all zeroes
+    const size_t numLandmarks = m_Inputs.landmarks.size();
+    const size_t n = SystemSize(numLandmarks);
 
-    // populate `wi` coefficients (+ control points, needed at evaluation-time)
-    rv.nonAffineTerms.reserve(numPairs);
-    for (int i = 0; i < numPairs; ++i) {
-        const Vec3 weight = {Cx[i], Cy[i], Cz[i]};
-        const Vec3& controlPoint = inputs.landmarks[i].source;
-        rv.nonAffineTerms.emplace_back(weight, controlPoint);
+    m_Solution.assign(3*n, 0.0);
+    for (size_t row = 0; row < n; ++row) {
+        Vec3d sum{};
+        for (size_t j = 0; j < numLandmarks; ++j) {
+            sum += m_LInverse[row*n + j] * Vec3d{m_Inputs.landmarks[j].destination};
+        }
+        m_Solution[3*row]     = sum.x;
+        m_Solution[3*row + 1] = sum.y;
+        m_Solution[3*row + 2] = sum.z;
     }
+}
 
-    return rv;
+bool osc::TPSCoefficientSolver3D::hasAccurateSolution() const
+{
+    // checks the residual, `L * [w a] - [v o]`, against the magnitudes that it's computed from
+    const size_t numLandmarks = m_Inputs.landmarks.size();
+    const size_t n = SystemSize(numLandmarks);
+
+    double maxAbsResidual = 0.0;
+    double normL = 0.0;
+    for (size_t row = 0; row < n; ++row) {
+        Vec3d residual = row < numLandmarks ? -Vec3d{m_Inputs.landmarks[row].destination} : Vec3d{};
+        double rowSum = 0.0;
+        for (size_t col = 0; col < n; ++col) {
+            const double l = m_L[row*n + col];
+            residual += l * Vec3d{m_Solution[3*col], m_Solution[3*col + 1], m_Solution[3*col + 2]};
+            rowSum += std::abs(l);
+        }
+        maxAbsResidual = max(maxAbsResidual, max(std::abs(residual.x), max(std::abs(residual.y), std::abs(residual.z))));
+        normL = max(normL, rowSum);
+    }
+
+    double normSolution = 0.0;
+    for (double v : m_Solution) {
+        normSolution = max(normSolution, std::abs(v));
+    }
+    double normDestinations = 0.0;
+    for (const LandmarkPair3D& landmark : m_Inputs.landmarks) {
+        const Vec3& v = landmark.destination;
+        normDestinations = max(normDestinations, static_cast<double>(max(std::abs(v.x), max(std::abs(v.y), std::abs(v.z)))));
+    }
+
+    return maxAbsResidual <= c_MaxRelativeResidual * (normL*normSolution + normDestinations);
+}
+
+void osc::TPSCoefficientSolver3D::updateCoefficientsFromSolution()
+{
+    // `m_Solution` contains the solved coefficients as rows of [w1, w2, ... wx, a1, a2, a3, a4]
+    const size_t numLandmarks = m_Inputs.landmarks.size();
+    const auto solutionRow = [this](size_t row)
+    {
+        return Vec3{Vec3d{m_Solution[3*row], m_Solution[3*row + 1], m_Solution[3*row + 2]}};
+    };
+
+    m_Coefficients.a1 = solutionRow(numLandmarks);
+    m_Coefficients.a2 = solutionRow(numLandmarks + 1);
+    m_Coefficients.a3 = solutionRow(numLandmarks + 2);
+    m_Coefficients.a4 = solutionRow(numLandmarks + 3);
+
+    m_Coefficients.nonAffineTerms.clear();
+    m_Coefficients.nonAffineTerms.reserve(numLandmarks);
+    for (size_t i = 0; i < numLandmarks; ++i) {
+        m_Coefficients.nonAffineTerms.emplace_back(solutionRow(i), m_Inputs.landmarks[i].source);
+    }
+}
+
+void osc::TPSCoefficientSolver3D::onIncrementalUpdate()
+{
+    ++m_NumUpdatesSinceFullSolve;
+    ++m_NumIncrementalUpdates;
 }
 
 // evaluates the TPS equation with the given coefficients and input point
@@ -233,20 +979,468 @@ Vec3 osc::EvaluateTPSEquation(const TPSCoefficients3D& coefs, Vec3 p)
     return rv;
 }
 
+osc::TPSEvaluator3D::TPSEvaluator3D(
+    const TPSCoefficients3D& coefs,
+    TPSEvaluatorKernel3D kernel) :
+
+    m_Kernel{ResolveKernel(kernel)},
+    m_A1{coefs.a1},
+    m_A2{coefs.a2},
+    m_A3{coefs.a3},
+    m_A4{coefs.a4}
+{
+    const size_t numTerms = coefs.nonAffineTerms.size();
+    for (auto* v : {&m_ControlPointsX, &m_ControlPointsY, &m_ControlPointsZ, &m_WeightsX, &m_WeightsY, &m_WeightsZ}) {
+        v->reserve(numTerms);
+    }
+    for (const TPSNonAffineTerm3D& term : coefs.nonAffineTerms) {
+        m_ControlPointsX.push_back(term.controlPoint.x);
+        m_ControlPointsY.push_back(term.controlPoint.y);
+        m_ControlPointsZ.push_back(term.controlPoint.z);
+        m_WeightsX.push_back(term.weight.x);
+        m_WeightsY.push_back(term.weight.y);
+        m_WeightsZ.push_back(term.weight.z);
+    }
+}
+
+Vec3 osc::TPSEvaluator3D::evaluate(Vec3 p) const
+{
+    evaluateChunkInPlace({&p, 1}, 1.0f);
+    return p;
+}
+
+void osc::TPSEvaluator3D::evaluateInPlace(std::span<Vec3> points, float blendingFactor) const
+{
+    for_each_chunk_parallel(ThreadPool::global(), calcMinPointsPerParallelChunk(), points.size(), [this, points, blendingFactor](size_t begin, size_t end)
+    {
+        evaluateChunkInPlace(points.subspan(begin, end - begin), blendingFactor);
+    });
+}
+
+void osc::TPSEvaluator3D::evaluateInPlace(const MeshAttributeEdit<Vec3>& points, float blendingFactor) const
+{
+    // the points are strided (e.g. interleaved with other vertex attributes), so each chunk
+    // copies a few of them at a time into a small contiguous buffer for the kernel
+    for_each_chunk_parallel(ThreadPool::global(), calcMinPointsPerParallelChunk(), points.size(), [this, &points, blendingFactor](size_t begin, size_t end)
+    {
+        std::array<Vec3, 256> scratch;
+        for (size_t batchBegin = begin; batchBegin < end; batchBegin += scratch.size()) {
+            const size_t batchSize = min(scratch.size(), end - batchBegin);
+            for (size_t i = 0; i < batchSize; ++i) {
+                scratch[i] = points[batchBegin + i];
+            }
+            evaluateChunkInPlace({scratch.data(), batchSize}, blendingFactor);
+            for (size_t i = 0; i < batchSize; ++i) {
+                points[batchBegin + i] = scratch[i];
+            }
+        }
+    });
+}
+
+size_t osc::TPSEvaluator3D::calcMinPointsPerParallelChunk() const
+{
+    // the cost of evaluating a point scales with the number of terms, so fewer points
+    // are required to make a chunk worth handing to another thread when there are many
+    return max(size_t{64}, size_t{1<<18} / (m_WeightsX.size() + 1));
+}
+
+void osc::TPSEvaluator3D::evaluateChunkInPlace(std::span<Vec3> points, float blendingFactor) const
+{
+    const NonAffineTermsView terms{
+        .controlPointsX = m_ControlPointsX,
+        .controlPointsY = m_ControlPointsY,
+        .controlPointsZ = m_ControlPointsZ,
+        .weightsX = m_WeightsX,
+        .weightsY = m_WeightsY,
+        .weightsZ = m_WeightsZ,
+    };
+    const SumNonAffineTermsKernel sumNonAffineTerms = GetKernelFunction(m_Kernel);
+
+    std::array<Vec3d, 256> sums;  // evaluate in small batches, to keep this on the stack
+    for (size_t batchBegin = 0; batchBegin < points.size(); batchBegin += sums.size()) {
+        const std::span<Vec3> batch = points.subspan(batchBegin, min(sums.size(), points.size() - batchBegin));
+
+        sumNonAffineTerms(terms, batch, {sums.data(), batch.size()});
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const Vec3 p = batch[i];
+            const Vec3d affine = m_A1 + m_A2*static_cast<double>(p.x) + m_A3*static_cast<double>(p.y) + m_A4*static_cast<double>(p.z);
+            batch[i] = lerp(p, Vec3{affine + sums[i]}, blendingFactor);
+        }
+    }
+}
+
+// per-thread scratch space that's reused between blocks
+struct osc::TPSApproximateEvaluator3D::BlockScratch final {
+    std::vector<size_t> stack;
+    std::vector<std::pair<double, size_t>> candidates;  // (errorBound, nodeIndex) of leaves that might be aggregated
+    std::vector<std::pair<size_t, size_t>> exactRanges;  // (firstTerm, numTerms) of terms that are evaluated exactly
+
+    // SoA copy of the terms that are evaluated exactly
+    std::vector<float> controlPointsX;
+    std::vector<float> controlPointsY;
+    std::vector<float> controlPointsZ;
+    std::vector<float> weightsX;
+    std::vector<float> weightsY;
+    std::vector<float> weightsZ;
+};
+
+osc::TPSApproximateEvaluator3D::TPSApproximateEvaluator3D(
+    const TPSCoefficients3D& coefs,
+    float maxAbsoluteError) :
+
+    m_MaxAbsoluteError{max(maxAbsoluteError, 0.0f)},
+    m_Kernel{ResolveKernel(TPSEvaluatorKernel3D::Fastest)},
+    m_A1{coefs.a1},
+    m_A2{coefs.a2},
+    m_A3{coefs.a3},
+    m_A4{coefs.a4}
+{
+    OSC_PERF("TPSApproximateEvaluator3D::TPSApproximateEvaluator3D");
+
+    std::vector<Vec3> controlPoints;
+    std::vector<Vec3> weights;
+    controlPoints.reserve(coefs.nonAffineTerms.size());
+    weights.reserve(coefs.nonAffineTerms.size());
+    double sumAbsWeights = 0.0;
+    for (const TPSNonAffineTerm3D& term : coefs.nonAffineTerms) {
+        controlPoints.push_back(term.controlPoint);
+        weights.push_back(term.weight);
+        sumAbsWeights += std::sqrt(dot(Vec3d{term.weight}, Vec3d{term.weight}));
+    }
+
+    // allot each aggregated node an error that's proportional to its share of `SUM{ |wi| }`,
+    // so that the total expansion error of an evaluated point is at most `maxAbsoluteError`
+    // (the near terms' single-precision rounding error is separate: see the class's docs)
+    m_AggregationCriterion = m_MaxAbsoluteError > 0.0f ?
+        c_ExpansionErrorBoundFactor * sumAbsWeights / static_cast<double>(m_MaxAbsoluteError) :
+        std::numeric_limits<double>::infinity();
+
+    if (not controlPoints.empty()) {
+        m_Nodes.emplace_back();
+        buildNode(controlPoints, weights, 0, 0, controlPoints.size(), 0);
+    }
+
+    // store the (now reordered) terms as SoA, so that near terms can be copied in ranges
+    for (auto* v : {&m_ControlPointsX, &m_ControlPointsY, &m_ControlPointsZ, &m_WeightsX, &m_WeightsY, &m_WeightsZ}) {
+        v->reserve(controlPoints.size());
+    }
+    for (size_t i = 0; i < controlPoints.size(); ++i) {
+        m_ControlPointsX.push_back(controlPoints[i].x);
+        m_ControlPointsY.push_back(controlPoints[i].y);
+        m_ControlPointsZ.push_back(controlPoints[i].z);
+        m_WeightsX.push_back(weights[i].x);
+        m_WeightsY.push_back(weights[i].y);
+        m_WeightsZ.push_back(weights[i].z);
+    }
+}
+
+Vec3 osc::TPSApproximateEvaluator3D::evaluate(Vec3 p) const
+{
+    std::vector<Vec3> points = {p};
+    evaluateInPlace(points);
+    return points.front();
+}
+
+void osc::TPSApproximateEvaluator3D::evaluateInPlace(std::span<Vec3> points, float blendingFactor) const
+{
+    evaluateInPlaceImpl(points, blendingFactor);
+}
+
+void osc::TPSApproximateEvaluator3D::evaluateInPlace(const MeshAttributeEdit<Vec3>& points, float blendingFactor) const
+{
+    evaluateInPlaceImpl(points, blendingFactor);
+}
+
+template<typename RandomAccessPoints>
+void osc::TPSApproximateEvaluator3D::evaluateInPlaceImpl(const RandomAccessPoints& points, float blendingFactor) const
+{
+    OSC_PERF("TPSApproximateEvaluator3D::evaluateInPlace");
+
+    // group the points into spatially-coherent blocks, so that each block is small
+    const std::vector<size_t> order = SpatiallySortedIndices(points.size(), [&points](size_t i) { return Vec3{points[i]}; });
+
+    const size_t minPointsPerChunk = 4 * c_PointsPerApproximationBlock;
+    for_each_chunk_parallel(ThreadPool::global(), minPointsPerChunk, order.size(), [this, &points, blendingFactor, &order](size_t begin, size_t end)
+    {
+        BlockScratch scratch;
+        std::array<Vec3, c_PointsPerApproximationBlock> block{};
+        std::array<Vec3d, c_PointsPerApproximationBlock> sums{};
+
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += block.size()) {
+            const size_t blockSize = min(block.size(), end - blockBegin);
+            for (size_t i = 0; i < blockSize; ++i) {
+                block[i] = points[order[blockBegin + i]];
+            }
+
+            sumNonAffineTermsOfBlock({block.data(), blockSize}, {sums.data(), blockSize}, scratch);
+
+            for (size_t i = 0; i < blockSize; ++i) {
+                const Vec3 p = block[i];
+                const Vec3d affine = m_A1 + m_A2*static_cast<double>(p.x) + m_A3*static_cast<double>(p.y) + m_A4*static_cast<double>(p.z);
+                points[order[blockBegin + i]] = lerp(p, Vec3{affine + sums[i]}, blendingFactor);
+            }
+        }
+    });
+}
+
+void osc::TPSApproximateEvaluator3D::buildNode(
+    std::span<Vec3> allControlPoints,
+    std::span<Vec3> allWeights,
+    size_t nodeIndex,
+    size_t firstTerm,
+    size_t numTerms,
+    size_t depth)
+{
+    const std::span<Vec3> controlPoints = allControlPoints.subspan(firstTerm, numTerms);
+    const std::span<Vec3> weights = allWeights.subspan(firstTerm, numTerms);
+
+    Node node;
+    node.firstTerm = firstTerm;
+    node.numTerms = numTerms;
+    node.center = BoundsCenter(controlPoints);
+    for (size_t i = 0; i < numTerms; ++i) {
+        const Vec3d d = Vec3d{controlPoints[i]} - node.center;
+        const Vec3d w{weights[i]};
+        node.radius = max(node.radius, std::sqrt(dot(d, d)));
+        node.sumWeights += w;
+        node.sumAbsWeights += std::sqrt(dot(w, w));
+        node.sumWeightedD[0] += d.x * w;
+        node.sumWeightedD[1] += d.y * w;
+        node.sumWeightedD[2] += d.z * w;
+        node.sumWeightedDDT[0] += d.x*d.x * w;
+        node.sumWeightedDDT[1] += d.y*d.y * w;
+        node.sumWeightedDDT[2] += d.z*d.z * w;
+        node.sumWeightedDDT[3] += d.x*d.y * w;
+        node.sumWeightedDDT[4] += d.x*d.z * w;
+        node.sumWeightedDDT[5] += d.y*d.z * w;
+    }
+
+    if (numTerms <= c_MaxTermsPerOctreeLeaf or depth >= c_MaxOctreeDepth) {
+        m_Nodes[nodeIndex] = node;
+        return;
+    }
+
+    // partition the terms into octants around the center (stably, so that it's deterministic)
+    const auto octantOf = [center = node.center](const Vec3& p)
+    {
+        return
+            (static_cast<double>(p.x) > center.x ? size_t{1} : size_t{0}) |
+            (static_cast<double>(p.y) > center.y ? size_t{2} : size_t{0}) |
+            (static_cast<double>(p.z) > center.z ? size_t{4} : size_t{0});
+    };
+    std::array<size_t, 8> octantSizes{};
+    for (const Vec3& controlPoint : controlPoints) {
+        ++octantSizes[octantOf(controlPoint)];
+    }
+    const auto numChildren = static_cast<size_t>(rgs::count_if(octantSizes, [](size_t octantSize) { return octantSize > 0; }));
+    if (numChildren <= 1) {
+        m_Nodes[nodeIndex] = node;  // all control points are (effectively) coincident
+        return;
+    }
+
+    std::array<size_t, 8> octantOffsets{};
+    for (size_t octant = 1; octant < octantOffsets.size(); ++octant) {
+        octantOffsets[octant] = octantOffsets[octant-1] + octantSizes[octant-1];
+    }
+    {
+        std::vector<Vec3> partitionedControlPoints(numTerms);
+        std::vector<Vec3> partitionedWeights(numTerms);
+        std::array<size_t, 8> cursors = octantOffsets;
+        for (size_t i = 0; i < numTerms; ++i) {
+            const size_t destination = cursors[octantOf(controlPoints[i])]++;
+            partitionedControlPoints[destination] = controlPoints[i];
+            partitionedWeights[destination] = weights[i];
+        }
+        rgs::copy(partitionedControlPoints, controlPoints.begin());
+        rgs::copy(partitionedWeights, weights.begin());
+    }
+
+    // allocate the children contiguously, then build them (which may append more nodes)
+    node.firstChild = m_Nodes.size();
+    node.numChildren = numChildren;
+    m_Nodes[nodeIndex] = node;
+    m_Nodes.resize(m_Nodes.size() + numChildren);
+
+    size_t childIndex = node.firstChild;
+    for (size_t octant = 0; octant < octantSizes.size(); ++octant) {
+        if (octantSizes[octant] > 0) {
+            buildNode(allControlPoints, allWeights, childIndex++, firstTerm + octantOffsets[octant], octantSizes[octant], depth + 1);
+        }
+    }
+}
+
+void osc::TPSApproximateEvaluator3D::sumNonAffineTermsOfBlock(
+    std::span<const Vec3> block,
+    std::span<Vec3d> sums,
+    BlockScratch& scratch) const
+{
+    // the sum of the aggregated nodes' terms is a quadratic function of `e = p - blockCenter`:
+    //
+    //     local0 + SUM_k{ e[k]*local1[k] } + 0.5*SUM_ab{ e[a]*e[b]*local2[ab] }
+    //
+    // where each term (`wi * |p - center - d_i|`, i.e. `wi * |R + e - d_i|`, where `R` is
+    // `blockCenter - center`) is expanded to second order around `R`, and then summed
+    const Vec3d blockCenter = BoundsCenter(block);
+    double blockRadius = 0.0;
+    for (const Vec3& p : block) {
+        const Vec3d e = Vec3d{p} - blockCenter;
+        blockRadius = max(blockRadius, std::sqrt(dot(e, e)));
+    }
+    Vec3d local0{};
+    std::array<Vec3d, 3> local1{};
+    std::array<Vec3d, 6> local2{};  // xx, yy, zz, xy, xz, yz
+
+    const auto aggregate = [&local0, &local1, &local2, blockCenter](const Node& node)
+    {
+        // uses `U(R + x) ~= r + u.x + 0.5*x'Hx`, where `u = R/r`, `H = (I - u*u')/r`, and `x = e - d_i`
+        const Vec3d R = blockCenter - node.center;
+        const double r = std::sqrt(dot(R, R));
+        const Vec3d u = R / r;
+        const std::array<double, 6> H = {
+            (1.0 - u.x*u.x)/r, (1.0 - u.y*u.y)/r, (1.0 - u.z*u.z)/r,
+            -u.x*u.y/r, -u.x*u.z/r, -u.y*u.z/r,
+        };
+        const std::array<Vec3d, 3>& M1 = node.sumWeightedD;
+        const std::array<Vec3d, 6>& Q = node.sumWeightedDDT;
+
+        const Vec3d uM1 = u.x*M1[0] + u.y*M1[1] + u.z*M1[2];
+        const Vec3d HQ = H[0]*Q[0] + H[1]*Q[1] + H[2]*Q[2] + 2.0*(H[3]*Q[3] + H[4]*Q[4] + H[5]*Q[5]);
+        local0 += r*node.sumWeights - uM1 + 0.5*HQ;
+        local1[0] += u.x*node.sumWeights - (H[0]*M1[0] + H[3]*M1[1] + H[4]*M1[2]);
+        local1[1] += u.y*node.sumWeights - (H[3]*M1[0] + H[1]*M1[1] + H[5]*M1[2]);
+        local1[2] += u.z*node.sumWeights - (H[4]*M1[0] + H[5]*M1[1] + H[2]*M1[2]);
+        for (size_t i = 0; i < local2.size(); ++i) {
+            local2[i] += H[i]*node.sumWeights;
+        }
+    };
+    const auto evaluateExactly = [&scratch](const Node& node)
+    {
+        scratch.exactRanges.emplace_back(node.firstTerm, node.numTerms);
+    };
+    const auto errorBoundOf = [](const Node& node, double reach, double separation)
+    {
+        return c_ExpansionErrorBoundFactor * node.sumAbsWeights * reach*reach*reach / (separation*separation);
+    };
+
+    scratch.stack.clear();
+    scratch.candidates.clear();
+    scratch.exactRanges.clear();
+
+    // first, aggregate every node that fits within its share of the error budget, while
+    // keeping track of how much of the budget was actually used
+    double usedErrorBudget = 0.0;
+    if (not m_Nodes.empty()) {
+        scratch.stack.push_back(0);
+    }
+    while (not scratch.stack.empty()) {
+        const size_t nodeIndex = scratch.stack.back();
+        const Node& node = m_Nodes[nodeIndex];
+        scratch.stack.pop_back();
+
+        const Vec3d R = blockCenter - node.center;
+        const double r = std::sqrt(dot(R, R));
+        const double reach = node.radius + blockRadius;
+        const double separation = r - reach;
+
+        if (separation > 0.0 and separation*separation >= reach*reach*reach*m_AggregationCriterion) {
+            aggregate(node);
+            usedErrorBudget += errorBoundOf(node, reach, separation);
+        }
+        else if (node.numChildren == 0) {
+            if (separation > 0.0) {
+                scratch.candidates.emplace_back(errorBoundOf(node, reach, separation), nodeIndex);
+            }
+            else {
+                evaluateExactly(node);
+            }
+        }
+        else {
+            for (size_t child = node.firstChild; child < node.firstChild + node.numChildren; ++child) {
+                scratch.stack.push_back(child);
+            }
+        }
+    }
+
+    // then spend whatever's left of the budget (typically, most of it, because far-away nodes
+    // use much less than their share) on aggregating the cheapest-to-aggregate leaves
+    const double remainingErrorBudget = static_cast<double>(m_MaxAbsoluteError) - usedErrorBudget;
+    const auto unaffordable = rgs::partition(scratch.candidates, [remainingErrorBudget](const auto& candidate)
+    {
+        return candidate.first <= remainingErrorBudget;
+    });
+    for (auto it = unaffordable.begin(); it != scratch.candidates.end(); ++it) {
+        evaluateExactly(m_Nodes[it->second]);
+    }
+    scratch.candidates.erase(unaffordable.begin(), scratch.candidates.end());
+    rgs::sort(scratch.candidates);
+    for (const auto& [errorBound, nodeIndex] : scratch.candidates) {
+        if (usedErrorBudget + errorBound <= static_cast<double>(m_MaxAbsoluteError)) {
+            aggregate(m_Nodes[nodeIndex]);
+            usedErrorBudget += errorBound;
+        }
+        else {
+            evaluateExactly(m_Nodes[nodeIndex]);
+        }
+    }
+
+    // gather the remaining terms (in order, so that the copies are mostly sequential) and
+    // evaluate them exactly
+    rgs::sort(scratch.exactRanges);
+    for (auto* v : {&scratch.controlPointsX, &scratch.controlPointsY, &scratch.controlPointsZ, &scratch.weightsX, &scratch.weightsY, &scratch.weightsZ}) {
+        v->clear();
+    }
+    for (const auto& [firstTerm, numTerms] : scratch.exactRanges) {
+        const auto append = [firstTerm, numTerms](std::vector<float>& destination, const std::vector<float>& source)
+        {
+            const auto first = source.begin() + static_cast<ptrdiff_t>(firstTerm);
+            destination.insert(destination.end(), first, first + static_cast<ptrdiff_t>(numTerms));
+        };
+        append(scratch.controlPointsX, m_ControlPointsX);
+        append(scratch.controlPointsY, m_ControlPointsY);
+        append(scratch.controlPointsZ, m_ControlPointsZ);
+        append(scratch.weightsX, m_WeightsX);
+        append(scratch.weightsY, m_WeightsY);
+        append(scratch.weightsZ, m_WeightsZ);
+    }
+    const NonAffineTermsView nearTerms{
+        .controlPointsX = scratch.controlPointsX,
+        .controlPointsY = scratch.controlPointsY,
+        .controlPointsZ = scratch.controlPointsZ,
+        .weightsX = scratch.weightsX,
+        .weightsY = scratch.weightsY,
+        .weightsZ = scratch.weightsZ,
+    };
+    GetKernelFunction(m_Kernel)(nearTerms, block, sums);
+
+    for (size_t i = 0; i < block.size(); ++i) {
+        const Vec3d e = Vec3d{block[i]} - blockCenter;
+        const Vec3d quadratic =
+            e.x*e.x*local2[0] + e.y*e.y*local2[1] + e.z*e.z*local2[2] +
+            2.0*(e.x*e.y*local2[3] + e.x*e.z*local2[4] + e.y*e.z*local2[5]);
+        sums[i] += local0 + e.x*local1[0] + e.y*local1[1] + e.z*local1[2] + 0.5*quadratic;
+    }
+}
+
 // returns a mesh that is the equivalent of applying the 3D TPS warp to each vertex of the mesh
-Mesh osc::ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D& coefs, const Mesh& mesh, float blendingFactor)
+Mesh osc::ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D& coefs, const Mesh& mesh, float blendingFactor, float maxApproximationError)
 {
     OSC_PERF("ApplyThinPlateWarpToMeshVertices");
 
     Mesh rv = mesh;  // make a local copy of the input mesh
 
-    // copy out the vertices
-
-    // parallelize function evaluation, because the mesh may contain *a lot* of
-    // vertices and the TPS equation may contain *a lot* of coefficients
-    auto vertices = rv.vertices();
-    ApplyThinPlateWarpToPointsInPlace(coefs, vertices, blendingFactor);
-    rv.set_vertices(vertices);
+    // warp the vertices in-place in the mesh's vertex buffer: the evaluators parallelize over
+    // the (strided) vertices, because the mesh may contain *a lot* of vertices and the TPS
+    // equation may contain *a lot* of coefficients
+    {
+        const MeshAttributeEdit<Vec3> vertices = rv.edit_vertices();
+        if (maxApproximationError > 0.0f) {
+            TPSApproximateEvaluator3D{coefs, maxApproximationError}.evaluateInPlace(vertices, blendingFactor);
+        }
+        else {
+            TPSEvaluator3D{coefs}.evaluateInPlace(vertices, blendingFactor);
+        }
+    }  // the edit ends here, which recalculates the mesh's bounds
 
     return rv;
 }
@@ -254,21 +1448,33 @@ Mesh osc::ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D& coefs, const
 std::vector<Vec3> osc::ApplyThinPlateWarpToPoints(
     const TPSCoefficients3D& coefs,
     std::span<const Vec3> points,
-    float blendingFactor)
+    float blendingFactor,
+    float maxApproximationError)
 {
     std::vector<Vec3> rv(points.begin(), points.end());
-    ApplyThinPlateWarpToPointsInPlace(coefs, rv, blendingFactor);
+    ApplyThinPlateWarpToPointsInPlace(coefs, rv, blendingFactor, maxApproximationError);
     return rv;
 }
 
 void osc::ApplyThinPlateWarpToPointsInPlace(
     const TPSCoefficients3D& coefs,
     std::span<Vec3> points,
-    float blendingFactor)
+    float blendingFactor,
+    float maxApproximationError)
 {
     OSC_PERF("ApplyThinPlateWarpToPointsInPlace");
-    for_each_parallel_unsequenced(8192, points, [&coefs, blendingFactor](Vec3& vert)
+    if (maxApproximationError > 0.0f) {
+        TPSApproximateEvaluator3D{coefs, maxApproximationError}.evaluateInPlace(points, blendingFactor);
+        return;
+    }
+
+    // these points can be precision-sensitive (e.g. the model warper uses this to warp stations,
+    // frames, and muscle points), so they're evaluated with `EvaluateTPSEquation`, which accumulates
+    // every term in double precision, rather than with `TPSEvaluator3D`'s single-precision blocks
+    for_each_chunk_parallel(ThreadPool::global(), 8192, points.size(), [&coefs, points, blendingFactor](size_t begin, size_t end)
     {
-        vert = lerp(vert, EvaluateTPSEquation(coefs, vert), blendingFactor);
+        for (Vec3& point : points.subspan(begin, end - begin)) {
+            point = lerp(point, EvaluateTPSEquation(coefs, point), blendingFactor);
+        }
     });
 }
@@ -3,8 +3,11 @@
 #include <oscar_simbody/LandmarkPair3D.h>
 
 #include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Maths/Vec3.h>
 
+#include <array>
+#include <cstddef>
 #include <iosfwd>
 #include <span>
 #include <utility>
@@ -79,15 +82,240 @@ namespace osc
     // computes all coefficients of the 3D TPS equation (a1, a2, a3, a4, and all the w's)
     TPSCoefficients3D CalcCoefficients(const TPSCoefficientSolverInputs3D&);
 
+    // incrementally computes the coefficients of the 3D TPS equation as its inputs change
+    //
+    // `CalcCoefficients` solves the whole (N+4)x(N+4) linear system (matrix L) from scratch,
+    // which is O(N^3). This instead keeps the inverse of L between changes, so that moving,
+    // inserting, or erasing a single landmark is an O(N^2) low-rank update of that inverse
+    // (moving a landmark is a symmetric rank-2 change to L, inserting/erasing one borders it
+    // with a row+column), and moving only a landmark's destination is O(N)
+    //
+    // full solves use the same QTZ factorization as `CalcCoefficients` (so they produce the
+    // same coefficients), which is also used to compute the initial inverse. The solver falls
+    // back to a full solve whenever an update is numerically unstable (i.e. a pivot is too
+    // small, or the updated solution's residual is too large), and after many consecutive
+    // updates (to bound error accumulation). If L is rank-deficient (e.g. all landmarks are
+    // coplanar) or ill-conditioned, every change is fully solved
+    class TPSCoefficientSolver3D final {
+    public:
+        TPSCoefficientSolver3D() = default;
+        explicit TPSCoefficientSolver3D(TPSCoefficientSolverInputs3D);
+
+        const TPSCoefficientSolverInputs3D& getInputs() const { return m_Inputs; }
+        const TPSCoefficients3D& getCoefficients() const { return m_Coefficients; }
+
+        // sets the inputs to the solver
+        //
+        // if the new inputs only differ from the current ones by a few moved landmarks, or by
+        // one inserted/erased landmark, then the coefficients are updated incrementally;
+        // otherwise, they are fully re-solved
+        void setInputs(const TPSCoefficientSolverInputs3D&);
+
+        // sets the `i`th landmark (e.g. because the user dragged it)
+        void setLandmark(size_t i, const LandmarkPair3D&);
+
+        // inserts a landmark before the `i`th landmark (`i == N` appends it)
+        void insertLandmark(size_t i, const LandmarkPair3D&);
+
+        // erases the `i`th landmark
+        void eraseLandmark(size_t i);
+
+        // returns the number of times the solver has fully (re)solved the coefficients
+        size_t getNumFullSolves() const { return m_NumFullSolves; }
+
+        // returns the number of times the solver has incrementally updated the coefficients
+        size_t getNumIncrementalUpdates() const { return m_NumIncrementalUpdates; }
+
+    private:
+        void solveFully();
+        bool canUpdateIncrementally() const;
+        bool tryUpdateLandmark(size_t i, const LandmarkPair3D& previous);
+        bool tryInsertLandmark(size_t i);
+        bool tryEraseLandmark(size_t i);
+        void updateSolutionFromInverse();
+        bool hasAccurateSolution() const;
+        void updateCoefficientsFromSolution();
+        void onIncrementalUpdate();
+
+        TPSCoefficientSolverInputs3D m_Inputs;
+        TPSCoefficients3D m_Coefficients;
+
+        // row-major (N+4)x(N+4) storage of L and its inverse (empty if L is singular)
+        std::vector<double> m_L;
+        std::vector<double> m_LInverse;
+
+        // row-major (N+4)x3 storage of the solution to `L * [w a] = [v o]` (i.e. `[w a]`)
+        std::vector<double> m_Solution;
+
+        size_t m_NumUpdatesSinceFullSolve = 0;
+        size_t m_NumFullSolves = 0;
+        size_t m_NumIncrementalUpdates = 0;
+    };
+
     // evaluates the TPS equation with the given coefficients and input point
     Vec3 EvaluateTPSEquation(const TPSCoefficients3D&, Vec3);
 
+    // the kernel that a `TPSEvaluator3D` uses to evaluate points
+    enum class TPSEvaluatorKernel3D {
+        Fastest,  // the fastest kernel that the current CPU supports
+        Scalar,   // a portable (non-SIMD) kernel
+        AVX2,     // an x86-64 AVX2+FMA kernel (falls back to `Scalar` if the CPU doesn't support it)
+        NUM_OPTIONS,
+
+        Default = Fastest,
+    };
+
+    // evaluates the 3D TPS equation for many points (e.g. mesh vertices)
+    //
+    // this is faster than calling `EvaluateTPSEquation` for each point, because the non-affine
+    // terms are stored in a structure-of-arrays (SoA) layout, points are evaluated in batches
+    // with a SIMD kernel (AVX2, where supported), and large inputs are split across the
+    // process-wide `ThreadPool`
+    //
+    // non-affine terms are accumulated in single precision in short blocks, which are then
+    // accumulated in double precision, so results aren't bitwise-equal to `EvaluateTPSEquation`:
+    // for unit-scale inputs with hundreds of terms, they agree to within a relative error of
+    // ~1e-4, and the error grows with the number and magnitude of the non-affine terms
+    class TPSEvaluator3D final {
+    public:
+        explicit TPSEvaluator3D(
+            const TPSCoefficients3D&,
+            TPSEvaluatorKernel3D = TPSEvaluatorKernel3D::Default
+        );
+
+        // returns the kernel that's actually used (i.e. `Fastest` is resolved to a specific
+        // kernel, and unsupported kernels are resolved to `Scalar`)
+        TPSEvaluatorKernel3D getKernel() const { return m_Kernel; }
+
+        // evaluates the TPS equation at the given point
+        Vec3 evaluate(Vec3) const;
+
+        // evaluates the TPS equation at each point and linearly blends each point towards
+        // its result by `blendingFactor`
+        void evaluateInPlace(std::span<Vec3>, float blendingFactor = 1.0f) const;
+
+        // as above, but for (strided) points that are edited in-place (e.g. a mesh's vertices)
+        void evaluateInPlace(const MeshAttributeEdit<Vec3>&, float blendingFactor = 1.0f) const;
+
+    private:
+        size_t calcMinPointsPerParallelChunk() const;
+        void evaluateChunkInPlace(std::span<Vec3>, float blendingFactor) const;
+
+        TPSEvaluatorKernel3D m_Kernel;
+        Vec3d m_A1;
+        Vec3d m_A2;
+        Vec3d m_A3;
+        Vec3d m_A4;
+
+        // SoA storage of the non-affine terms (control points and weights)
+        std::vector<float> m_ControlPointsX;
+        std::vector<float> m_ControlPointsY;
+        std::vector<float> m_ControlPointsZ;
+        std::vector<float> m_WeightsX;
+        std::vector<float> m_WeightsY;
+        std::vector<float> m_WeightsZ;
+    };
+
+    // approximately evaluates the 3D TPS equation for many points, with a bounded error
+    //
+    // exact evaluation is O(points x terms), which is slow when there are thousands of
+    // landmarks (e.g. dense semilandmarks). This groups the control points into an octree and
+    // the evaluated points into small, spatially-coherent, blocks. For each block, the terms
+    // in each octree node that's far enough away from the block are aggregated (via a
+    // second-order Taylor expansion of `U` around the node's and block's centers) into one
+    // quadratic function of the point's location, which is cheap to evaluate for each point.
+    // Only nearby terms are evaluated exactly (with the same SIMD kernel as `TPSEvaluator3D`).
+    //
+    // a node is only aggregated when the sum of the (per-block) bounds on the expansions'
+    // errors stays within `maxAbsoluteError` (in the same units as the points), so the error
+    // that the approximation introduces is at most `maxAbsoluteError` per evaluated point. That
+    // bound doesn't include the rounding error of the exactly-evaluated (near) terms, which are
+    // accumulated in single precision, exactly like `TPSEvaluator3D` (i.e. they add a relative
+    // error of ~1e-4 that grows with the number and magnitude of those terms), so the total
+    // error relative to `EvaluateTPSEquation` can slightly exceed `maxAbsoluteError`. The
+    // expansion bounds assume the worst case, so the actual approximation error is typically
+    // 10-100x smaller, and the near field dominates when the tolerance is tight relative to the
+    // warp's displacements (i.e. it's worth using when there are many landmarks and a looser
+    // tolerance is acceptable). `maxAbsoluteError == 0` evaluates all terms exactly (with the
+    // same single-precision rounding as `TPSEvaluator3D`).
+    class TPSApproximateEvaluator3D final {
+    public:
+        TPSApproximateEvaluator3D(const TPSCoefficients3D&, float maxAbsoluteError);
+
+        float getMaxAbsoluteError() const { return m_MaxAbsoluteError; }
+
+        // evaluates the TPS equation at the given point
+        Vec3 evaluate(Vec3) const;
+
+        // evaluates the TPS equation at each point and linearly blends each point towards
+        // its result by `blendingFactor`
+        void evaluateInPlace(std::span<Vec3>, float blendingFactor = 1.0f) const;
+
+        // as above, but for (strided) points that are edited in-place (e.g. a mesh's vertices)
+        void evaluateInPlace(const MeshAttributeEdit<Vec3>&, float blendingFactor = 1.0f) const;
+
+    private:
+        template<typename RandomAccessPoints>
+        void evaluateInPlaceImpl(const RandomAccessPoints&, float blendingFactor) const;
+
+        struct Node final {
+            Vec3d center;
+            double radius = 0.0;
+
+            // moments of the node's terms, relative to `center` (where `d_i` is the offset of
+            // the `i`th control point from `center`)
+            Vec3d sumWeights;                     // SUM{ wi }
+            double sumAbsWeights = 0.0;           // SUM{ |wi| }
+            std::array<Vec3d, 3> sumWeightedD;    // SUM{ wi * d_i[k] } (one per `k`)
+            std::array<Vec3d, 6> sumWeightedDDT;  // SUM{ wi * d_i[a]*d_i[b] } (xx, yy, zz, xy, xz, yz)
+
+            size_t firstTerm = 0;
+            size_t numTerms = 0;
+            size_t firstChild = 0;
+            size_t numChildren = 0;
+        };
+        struct BlockScratch;
+
+        void buildNode(std::span<Vec3> allControlPoints, std::span<Vec3> allWeights, size_t nodeIndex, size_t firstTerm, size_t numTerms, size_t depth);
+        void sumNonAffineTermsOfBlock(std::span<const Vec3> block, std::span<Vec3d> sums, BlockScratch&) const;
+
+        float m_MaxAbsoluteError;
+        TPSEvaluatorKernel3D m_Kernel;
+        Vec3d m_A1;
+        Vec3d m_A2;
+        Vec3d m_A3;
+        Vec3d m_A4;
+
+        // nodes are only aggregated when `(r - reach)^2 >= reach^3 * m_AggregationCriterion`,
+        // where `r` is the distance between the node's and the block's centers, and `reach` is
+        // the sum of their radii
+        double m_AggregationCriterion = 0.0;
+
+        std::vector<Node> m_Nodes;  // `m_Nodes[0]` is the root (if there are any terms)
+
+        // the non-affine terms (SoA), reordered such that each node's terms are contiguous
+        std::vector<float> m_ControlPointsX;
+        std::vector<float> m_ControlPointsY;
+        std::vector<float> m_ControlPointsZ;
+        std::vector<float> m_WeightsX;
+        std::vector<float> m_WeightsY;
+        std::vector<float> m_WeightsZ;
+    };
+
     // returns a mesh that is the equivalent of applying the 3D TPS warp to the mesh
-    Mesh ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D&, const Mesh&, float blendingFactor);
+    //
+    // the vertices are evaluated with a `TPSEvaluator3D` (i.e. with its single-precision
+    // accumulation, which is fine for rendering), or, if `maxApproximationError` is greater
+    // than zero, the warp is approximated (see `TPSApproximateEvaluator3D`), which is faster
+    // when there are many landmarks
+    Mesh ApplyThinPlateWarpToMeshVertices(const TPSCoefficients3D&, const Mesh&, float blendingFactor, float maxApproximationError = 0.0f);
 
     // returns points that are the equivalent of applying the 3D TPS warp to each input point
-    std::vector<Vec3> ApplyThinPlateWarpToPoints(const TPSCoefficients3D&, std::span<const Vec3>, float blendingFactor);
+    //
+    // unlike `ApplyThinPlateWarpToMeshVertices`, each point is evaluated with `EvaluateTPSEquation`
+    // (i.e. with double-precision accumulation) unless `maxApproximationError` is greater than zero
+    std::vector<Vec3> ApplyThinPlateWarpToPoints(const TPSCoefficients3D&, std::span<const Vec3>, float blendingFactor, float maxApproximationError = 0.0f);
 
-    // applies the 3D TPS warp in-place to each SimTK::Vec3 in the provided span
-    void ApplyThinPlateWarpToPointsInPlace(const TPSCoefficients3D&, std::span<Vec3>, float blendingFactor);
+    // applies the 3D TPS warp in-place to each SimTK::Vec3 in the provided span (see `ApplyThinPlateWarpToPoints`)
+    void ApplyThinPlateWarpToPointsInPlace(const TPSCoefficients3D&, std::span<Vec3>, float blendingFactor, float maxApproximationError = 0.0f);
 }
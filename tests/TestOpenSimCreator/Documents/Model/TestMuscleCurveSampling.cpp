@@ -0,0 +1,113 @@
+#include <OpenSimCreator/Documents/Model/MuscleCurveSampling.h>
+
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/Muscle.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Shims/Cpp20/stop_token.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::unique_ptr<OpenSim::Model> LoadArm26()
+    {
+        GloballyInitOpenSim();
+        auto rv = LoadModel(std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim");
+        InitializeModel(*rv);
+        InitializeState(*rv);
+        return rv;
+    }
+
+    std::vector<MuscleCurveRequest> ElbowCurves()
+    {
+        const OpenSim::ComponentPath elbow{"/jointset/r_elbow/r_elbow_flex"};
+        return {
+            {elbow, OpenSim::ComponentPath{"/forceset/BIClong"}, GetMomentArm},
+            {elbow, OpenSim::ComponentPath{"/forceset/TRIlong"}, GetMomentArm},
+            {elbow, OpenSim::ComponentPath{"/forceset/BRA"}, GetFiberLength},
+        };
+    }
+}
+
+TEST(SampleMuscleCurves, SamplesTheRequestedNumberOfDataPointsPerCurve)
+{
+    const auto model = LoadArm26();
+    const auto curves = SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 17});
+
+    ASSERT_EQ(curves.size(), 3);
+    for (const auto& curve : curves) {
+        ASSERT_EQ(curve.size(), 17);
+    }
+}
+
+TEST(SampleMuscleCurves, ParallelSamplingProducesTheSameCurvesAsSerialSampling)
+{
+    const auto model = LoadArm26();
+    const auto serial = SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 24, .numThreads = 1});
+    const auto parallel = SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 24, .numThreads = 4});
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t curve = 0; curve < serial.size(); ++curve) {
+        ASSERT_EQ(serial[curve].size(), parallel[curve].size());
+        for (size_t i = 0; i < serial[curve].size(); ++i) {
+            ASSERT_EQ(serial[curve][i], parallel[curve][i]);
+        }
+    }
+}
+
+TEST(SampleMuscleCurves, RepeatedParallelSamplingProducesIdenticalCurves)
+{
+    // fiber lengths depend on muscle equilibrium, which would otherwise depend on
+    // whichever point a worker happened to sample previously
+    const auto model = LoadArm26();
+    const auto first = SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 48, .numThreads = 3});
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        ASSERT_EQ(SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 48, .numThreads = 5}), first);
+    }
+}
+
+TEST(SampleMuscleCurves, EmitsDataPointsInIncreasingXOrder)
+{
+    const auto model = LoadArm26();
+    const auto curves = SampleMuscleCurves(*model, ElbowCurves(), {.numDataPoints = 32, .numThreads = 4});
+
+    for (const auto& curve : curves) {
+        for (size_t i = 1; i < curve.size(); ++i) {
+            ASSERT_LT(curve[i-1].x, curve[i].x);
+        }
+    }
+}
+
+TEST(SampleMuscleCurves, ThrowsIfARequestRefersToAMissingMuscle)
+{
+    const auto model = LoadArm26();
+    const std::vector<MuscleCurveRequest> requests = {
+        {OpenSim::ComponentPath{"/jointset/r_elbow/r_elbow_flex"}, OpenSim::ComponentPath{"/forceset/does_not_exist"}, GetMomentArm},
+    };
+    ASSERT_THROW({ SampleMuscleCurves(*model, requests, {.numThreads = 2}); }, std::runtime_error);
+}
+
+TEST(SampleMuscleCurves, ReturnsFalseAndEmitsNothingIfAlreadyCancelled)
+{
+    const auto model = LoadArm26();
+    cpp20::stop_source stopSource;
+    stopSource.request_stop();
+
+    size_t numEmitted = 0;
+    const bool finished = SampleMuscleCurves(*model, ElbowCurves(), {}, [&numEmitted](size_t, Vec2) { ++numEmitted; }, stopSource.get_token());
+
+    ASSERT_FALSE(finished);
+    ASSERT_EQ(numEmitted, 0);
+}
@@ -0,0 +1,204 @@
+#include <OpenSimCreator/Documents/Model/MuscleMatrixService.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Model/MuscleCurveSampling.h>
+#include <OpenSimCreator/Documents/Model/UndoableModelStatePair.h>
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Utils/UID.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::filesystem::path GetArm26Path()
+    {
+        return std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim";
+    }
+
+    BasicModelStatePair LoadArm26()
+    {
+        return BasicModelStatePair{GetArm26Path()};
+    }
+
+    std::shared_ptr<const MuscleMatrix> ComputeMatrix(const BasicModelStatePair& msp, const MuscleMatrixParams& params)
+    {
+        MuscleMatrixService service;
+        const auto task = service.request(msp, params);
+        task->wait();
+        return task->getResult();
+    }
+
+    size_t IndexOf(const std::vector<std::string>& paths, const std::string& path)
+    {
+        return static_cast<size_t>(std::distance(paths.begin(), std::find(paths.begin(), paths.end(), path)));
+    }
+}
+
+TEST(MuscleMatrixService, ComputesEveryMuscleAgainstEveryCoordinate)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const auto matrix = ComputeMatrix(arm26, {.numDataPoints = 8});
+
+    ASSERT_NE(matrix, nullptr);
+    ASSERT_EQ(matrix->musclePaths.size(), 6);
+    ASSERT_EQ(matrix->coordinatePaths.size(), 2);
+    ASSERT_EQ(matrix->numDataPoints, 8);
+    ASSERT_EQ(matrix->coordinateValues.size(), 2 * 8);
+    ASSERT_EQ(matrix->values.size(), 6 * 2 * 8);
+}
+
+TEST(MuscleMatrixService, ComputesTheSameValuesAsSamplingTheCurveDirectly)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const auto matrix = ComputeMatrix(arm26, {.quantity = MuscleMatrixQuantity::MomentArm, .numDataPoints = 8});
+    ASSERT_NE(matrix, nullptr);
+
+    const MuscleCurveRequest request{
+        .coordinatePath = OpenSim::ComponentPath{"/jointset/r_elbow/r_elbow_flex"},
+        .musclePath = OpenSim::ComponentPath{"/forceset/BIClong"},
+        .output = GetMomentArm,
+    };
+    const auto curves = SampleMuscleCurves(arm26.getModel(), {&request, 1}, {.numDataPoints = 8});
+
+    const size_t muscle = IndexOf(matrix->musclePaths, "/forceset/BIClong");
+    const size_t coordinate = IndexOf(matrix->coordinatePaths, "/jointset/r_elbow/r_elbow_flex");
+    ASSERT_LT(muscle, matrix->musclePaths.size());
+    ASSERT_LT(coordinate, matrix->coordinatePaths.size());
+    for (size_t i = 0; i < 8; ++i) {
+        ASSERT_FLOAT_EQ(matrix->coordinateValues.at(coordinate * 8 + i), curves.front().at(i).x);
+        ASSERT_NEAR(matrix->at(muscle, coordinate, i), curves.front().at(i).y, 1e-5);
+    }
+}
+
+TEST(MuscleMatrixService, ReturnsTheCachedTaskForTheSameModelVersionAndParams)
+{
+    const UndoableModelStatePair arm26{GetArm26Path()};
+    MuscleMatrixService service;
+
+    const auto first = service.request(arm26, {.numDataPoints = 4});
+    const auto second = service.request(arm26, {.numDataPoints = 4});
+    const auto third = service.request(arm26, {.quantity = MuscleMatrixQuantity::FiberLength, .numDataPoints = 4});
+
+    ASSERT_EQ(first, second);
+    ASSERT_NE(first, third);
+}
+
+TEST(MuscleMatrixService, RecomputesTheMatrixWhenTheModelVersionChanges)
+{
+    UndoableModelStatePair arm26{GetArm26Path()};
+    MuscleMatrixService service;
+
+    const auto first = service.request(arm26, {.numDataPoints = 4});
+    arm26.setModelVersion(UID{});
+    const auto second = service.request(arm26, {.numDataPoints = 4});
+
+    ASSERT_NE(first, second);
+}
+
+TEST(MuscleMatrixService, CanBeCancelled)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    MuscleMatrixService service;
+
+    const auto task = service.request(arm26, {.numDataPoints = 512});
+    task->requestCancellation();
+    task->wait();
+
+    // (it may have finished before the cancellation was requested)
+    ASSERT_NE(task->getStatus(), MuscleMatrixTaskStatus::Running);
+    ASSERT_NE(task->getStatus(), MuscleMatrixTaskStatus::Error);
+}
+
+TEST(MuscleMatrixService, DoesNotCancelATaskWhenTheCallersHandleIsDropped)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    MuscleMatrixService service;
+
+    const MuscleMatrixTask* firstTask = service.request(arm26, {.numDataPoints = 4}).get();  // (the handle is dropped)
+    const auto task = service.request(arm26, {.numDataPoints = 4});
+    task->wait();
+
+    ASSERT_EQ(task.get(), firstTask);
+    ASSERT_EQ(task->getStatus(), MuscleMatrixTaskStatus::Finished);
+    ASSERT_NE(task->getResult(), nullptr);
+}
+
+TEST(MuscleMatrixService, CancelsTasksThatAreEvictedFromItsCache)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    MuscleMatrixService service;
+
+    const auto evicted = service.request(arm26, {.numDataPoints = 1024});
+    for (size_t numDataPoints = 1; numDataPoints <= 8; ++numDataPoints) {
+        service.request(arm26, {.numDataPoints = numDataPoints});
+    }
+    evicted->wait();
+
+    // (it may have finished before it was evicted)
+    ASSERT_NE(evicted->getStatus(), MuscleMatrixTaskStatus::Running);
+    ASSERT_NE(evicted->getStatus(), MuscleMatrixTaskStatus::Error);
+    ASSERT_NE(service.request(arm26, {.numDataPoints = 1024}), evicted);
+}
+
+TEST(WriteMuscleMatrixAsCSV, WritesAHeaderAndOneRowPerElement)
+{
+    MuscleMatrix matrix;
+    matrix.quantity = MuscleMatrixQuantity::FiberLength;
+    matrix.numDataPoints = 2;
+    matrix.musclePaths = {"/forceset/a", "/forceset/b"};
+    matrix.coordinatePaths = {"/jointset/j/q"};
+    matrix.coordinateValues = {0.0f, 1.0f};
+    matrix.values = {0.1f, 0.2f, 0.3f, 0.4f};
+
+    std::stringstream ss;
+    WriteMuscleMatrixAsCSV(ss, matrix);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(ss, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 1 + 4);
+    ASSERT_EQ(lines.front(), "muscle,coordinate,coordinate_value,fiber_length");
+}
+
+TEST(ReadMuscleMatrixBinary, RoundTripsWithWriteMuscleMatrixAsBinary)
+{
+    MuscleMatrix matrix;
+    matrix.quantity = MuscleMatrixQuantity::TendonLength;
+    matrix.numDataPoints = 3;
+    matrix.musclePaths = {"/forceset/a"};
+    matrix.coordinatePaths = {"/jointset/j/q", "/jointset/k/r"};
+    matrix.coordinateValues = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    matrix.values = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f};
+
+    std::stringstream ss;
+    WriteMuscleMatrixAsBinary(ss, matrix);
+    const MuscleMatrix parsed = ReadMuscleMatrixBinary(ss);
+
+    ASSERT_EQ(parsed.quantity, matrix.quantity);
+    ASSERT_EQ(parsed.numDataPoints, matrix.numDataPoints);
+    ASSERT_EQ(parsed.musclePaths, matrix.musclePaths);
+    ASSERT_EQ(parsed.coordinatePaths, matrix.coordinatePaths);
+    ASSERT_EQ(parsed.coordinateValues, matrix.coordinateValues);
+    ASSERT_EQ(parsed.values, matrix.values);
+}
+
+TEST(ReadMuscleMatrixBinary, ThrowsIfTheInputIsNotAMuscleMatrix)
+{
+    std::stringstream ss{"this is definitely not a muscle matrix"};
+    ASSERT_THROW({ ReadMuscleMatrixBinary(ss); }, std::runtime_error);
+}
@@ -0,0 +1,179 @@
+#include <OpenSimCreator/Documents/Simulation/BatchSimulation.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    BasicModelStatePair LoadArm26()
+    {
+        return BasicModelStatePair{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+    }
+
+    std::vector<BatchSimulationPoint> MakeShortPoints(size_t n)
+    {
+        std::vector<BatchSimulationPoint> rv(n);
+        for (auto& point : rv) {
+            point.params.finalTime = SimulationClock::start() + SimulationClock::duration{0.01};
+            point.params.reportingInterval = SimulationClock::duration{0.005};
+        }
+        return rv;
+    }
+}
+
+TEST(RunBatchSimulation, RunsEachPointExactlyOnce)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const std::vector<BatchSimulationPoint> points = MakeShortPoints(7);
+
+    std::mutex mutex;
+    std::multiset<size_t> completedPoints;
+    const BatchSimulationSummary summary = RunBatchSimulation(arm26, points, {.numThreads = 3}, [&](const BatchSimulationPointResult& result)
+    {
+        const std::lock_guard lock{mutex};
+        completedPoints.insert(result.pointIndex);
+    });
+
+    ASSERT_EQ(summary.numPoints, points.size());
+    ASSERT_EQ(summary.numCompleted, points.size());
+    ASSERT_EQ(summary.numFailed, 0);
+    ASSERT_EQ(completedPoints.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(completedPoints.count(i), 1);
+    }
+}
+
+TEST(RunBatchSimulation, RunsThePointsOnAtMostNumThreadsThreads)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const std::vector<BatchSimulationPoint> points = MakeShortPoints(8);
+    constexpr size_t numThreads = 2;
+
+    std::set<std::thread::id> threadIDs;
+    RunBatchSimulation(arm26, points, {.numThreads = numThreads}, [&threadIDs](const BatchSimulationPointResult&)
+    {
+        threadIDs.insert(std::this_thread::get_id());  // the callback is never called concurrently
+    });
+
+    ASSERT_FALSE(threadIDs.empty());
+    ASSERT_LE(threadIDs.size(), numThreads);
+    ASSERT_FALSE(threadIDs.contains(std::this_thread::get_id())) << "the points should be ran on the batch's own threads";
+}
+
+TEST(RunBatchSimulation, ReportsTotalSimulatedTimeAndThroughput)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const std::vector<BatchSimulationPoint> points = MakeShortPoints(2);
+
+    const BatchSimulationSummary summary = RunBatchSimulation(arm26, points, {.numThreads = 2});
+
+    ASSERT_NEAR(summary.simulatedTime.count(), 0.02, 1e-9);
+    ASSERT_GT(summary.getThroughput(), 0.0);
+}
+
+TEST(RunBatchSimulation, ThrowsIfAPointReferencesAMissingCoordinate)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    std::vector<BatchSimulationPoint> points = MakeShortPoints(1);
+    points.front().initialCoordinateValues.emplace_back("does_not_exist", 0.5);
+
+    ASSERT_THROW({ RunBatchSimulation(arm26, points, {}); }, std::runtime_error);
+}
+
+TEST(RunBatchSimulation, StopsRemainingPointsAndRethrowsIfAWorkerThrows)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const std::vector<BatchSimulationPoint> points = MakeShortPoints(24);
+    constexpr size_t numThreads = 3;
+
+    std::atomic<size_t> numCallbacks = 0;
+    const auto throwingCallback = [&numCallbacks](const BatchSimulationPointResult&)
+    {
+        ++numCallbacks;
+        throw std::runtime_error{"some error"};
+    };
+    ASSERT_THROW({ RunBatchSimulation(arm26, points, {.numThreads = numThreads}, throwingCallback); }, std::runtime_error);
+
+    // each worker may finish the point it was running when the first worker threw, but shouldn't start another
+    ASSERT_LE(numCallbacks.load(), numThreads);
+}
+
+TEST(RunBatchSimulation, StreamsEachPointToTheOutputDirectory)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    std::vector<BatchSimulationPoint> points = MakeShortPoints(2);
+    points.back().initialCoordinateValues.emplace_back("r_elbow_flex", 0.5);
+
+    const std::filesystem::path outputDirectory = std::filesystem::temp_directory_path() / "TestOpenSimCreator_RunBatchSimulation";
+    std::filesystem::remove_all(outputDirectory);
+
+    RunBatchSimulation(arm26, points, {.numThreads = 2, .outputDirectory = outputDirectory});
+
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "summary.csv"));
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "point_0.csv"));
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "point_1.csv"));
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+TEST(ReadBatchSimulationPointsCSV, ReadsParamsAndCoordinateColumns)
+{
+    std::istringstream csv{"final_time,integrator_accuracy,r_elbow_flex\n1.5,0.001,0.25\n2.5,0.01,0.5\n"};
+    const std::vector<BatchSimulationPoint> points = ReadBatchSimulationPointsCSV(csv);
+
+    ASSERT_EQ(points.size(), 2);
+    ASSERT_EQ(points[0].params.finalTime, SimulationClock::start() + SimulationClock::duration{1.5});
+    ASSERT_EQ(points[0].params.integratorAccuracy, 0.001);
+    ASSERT_EQ(points[1].params.finalTime, SimulationClock::start() + SimulationClock::duration{2.5});
+    ASSERT_EQ(points[1].initialCoordinateValues.size(), 1);
+    ASSERT_EQ(points[1].initialCoordinateValues.front().first, "r_elbow_flex");
+    ASSERT_EQ(points[1].initialCoordinateValues.front().second, 0.5);
+}
+
+TEST(ReadBatchSimulationPointsCSV, UsesDefaultsForParamsThatArentInTheHeader)
+{
+    ForwardDynamicSimulatorParams defaults;
+    defaults.integratorStepLimit = 1337;
+
+    std::istringstream csv{"final_time\n3.0\n"};
+    const std::vector<BatchSimulationPoint> points = ReadBatchSimulationPointsCSV(csv, defaults);
+
+    ASSERT_EQ(points.size(), 1);
+    ASSERT_EQ(points.front().params.integratorStepLimit, 1337);
+}
+
+TEST(ReadBatchSimulationPointsCSV, ThrowsIfAValueIsNotANumber)
+{
+    std::istringstream csv{"final_time\nnot_a_number\n"};
+    ASSERT_THROW({ ReadBatchSimulationPointsCSV(csv); }, std::runtime_error);
+}
+
+TEST(ReadBatchSimulationPointsCSV, ThrowsIfARowHasTheWrongNumberOfColumns)
+{
+    std::istringstream csv{"final_time,r_elbow_flex\n1.0\n"};
+    ASSERT_THROW({ ReadBatchSimulationPointsCSV(csv); }, std::runtime_error);
+}
+
+TEST(ReadBatchSimulationPointsCSV, ThrowsIfEmpty)
+{
+    std::istringstream csv;
+    ASSERT_THROW({ ReadBatchSimulationPointsCSV(csv); }, std::runtime_error);
+}
@@ -0,0 +1,231 @@
+#include <OpenSimCreator/Documents/Simulation/OutputValueCache.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/OutputExtractors/ConstantOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/IOutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputExtractor.h>
+#include <OpenSimCreator/Documents/OutputExtractors/OutputValueExtractor.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulation.h>
+#include <OpenSimCreator/Documents/Simulation/ForwardDynamicSimulatorParams.h>
+#include <OpenSimCreator/Documents/Simulation/ISimulation.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClocks.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationStatus.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Maths/Vec2.h>
+#include <oscar/Utils/CStringView.h>
+#include <oscar/Utils/HashHelpers.h>
+#include <oscar/Variant/Variant.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // an output extractor that emits the time of each report (so that the order of
+    // values in a column can be checked)
+    class TimeOutputExtractor final : public IOutputExtractor {
+    private:
+        CStringView implGetName() const final { return "time"; }
+        CStringView implGetDescription() const final { return {}; }
+        OutputExtractorDataType implGetOutputType() const final { return OutputExtractorDataType::Float; }
+        OutputValueExtractor implGetOutputValueExtractor(const OpenSim::Component&) const final
+        {
+            return OutputValueExtractor{[](const SimulationReport& report)
+            {
+                return Variant{static_cast<float>(report.getTime().time_since_epoch().count())};
+            }};
+        }
+        size_t implGetHash() const final { return hash_of(std::string_view{"time"}); }
+        bool implEquals(const IOutputExtractor& other) const final { return dynamic_cast<const TimeOutputExtractor*>(&other) != nullptr; }
+    };
+
+    // an `ISimulation` that forwards to another simulation, but counts how many times a
+    // report is fetched from it (fetching a report can be expensive, because it can
+    // require realizing a state)
+    class ReportCountingSimulation final : public ISimulation {
+    public:
+        explicit ReportCountingSimulation(const ISimulation& inner) : m_Inner{&inner} {}
+
+        size_t getNumReportsFetched() const { return m_NumReportsFetched; }
+    private:
+        SynchronizedValueGuard<const OpenSim::Model> implGetModel() const final { return m_Inner->getModel(); }
+        ptrdiff_t implGetNumReports() const final { return static_cast<ptrdiff_t>(m_Inner->getNumReports()); }
+        SimulationReport implGetSimulationReport(ptrdiff_t reportIndex) const final
+        {
+            ++m_NumReportsFetched;
+            return m_Inner->getSimulationReport(reportIndex);
+        }
+        std::vector<SimulationReport> implGetAllSimulationReports() const final
+        {
+            m_NumReportsFetched += m_Inner->getNumReports();
+            return m_Inner->getAllSimulationReports();
+        }
+        SimulationClock::time_point implGetSimulationReportTime(ptrdiff_t reportIndex) const final
+        {
+            return m_Inner->getSimulationReportTime(reportIndex);
+        }
+        SimulationStatus implGetStatus() const final { return m_Inner->getStatus(); }
+        SimulationClocks implGetClocks() const final
+        {
+            return SimulationClocks{{m_Inner->getStartTime(), m_Inner->getEndTime()}, m_Inner->getCurTime()};
+        }
+        const ParamBlock& implGetParams() const final { return m_Inner->getParams(); }
+        std::span<const OutputExtractor> implGetOutputExtractors() const final { return m_Inner->getOutputExtractors(); }
+        float implGetFixupScaleFactor() const final { return m_Inner->getFixupScaleFactor(); }
+        void implSetFixupScaleFactor(float) final {}
+        std::shared_ptr<Environment> implUpdAssociatedEnvironment() final { return nullptr; }
+
+        const ISimulation* m_Inner;
+        mutable size_t m_NumReportsFetched = 0;
+    };
+
+    ForwardDynamicSimulation RunSimulationForNSeconds(int n)
+    {
+        ForwardDynamicSimulatorParams params;
+        params.finalTime = SimulationClock::start() + std::chrono::seconds{n};
+        params.reportingInterval = std::chrono::seconds{1};
+
+        ForwardDynamicSimulation sim{BasicModelStatePair{}, params};
+        sim.join();
+        return sim;
+    }
+}
+
+TEST(OutputValueCache, IsEmptyWhenDefaultConstructed)
+{
+    ASSERT_EQ(OutputValueCache{}.getNumColumns(), 0);
+}
+
+TEST(OutputValueCache, GetValuesFloatReturnsOneValuePerReport)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(2);
+    const OutputExtractor output{ConstantOutputExtractor{"constant", 7.0f}};
+
+    OutputValueCache cache;
+    const auto values = cache.getValuesFloat(sim, output);
+
+    ASSERT_EQ(values.size(), sim.getNumReports());
+    ASSERT_TRUE(std::ranges::all_of(values, [](float v) { return v == 7.0f; }));
+    ASSERT_EQ(cache.getNumColumns(), 1);
+}
+
+TEST(OutputValueCache, GetValuesVec2ReturnsOneValuePerReport)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(2);
+    const OutputExtractor output{ConstantOutputExtractor{"constant", Vec2{1.0f, 2.0f}}};
+
+    OutputValueCache cache;
+    const auto values = cache.getValuesVec2(sim, output);
+
+    ASSERT_EQ(values.size(), sim.getNumReports());
+    ASSERT_TRUE(std::ranges::all_of(values, [](Vec2 v) { return v == Vec2{1.0f, 2.0f}; }));
+}
+
+TEST(OutputValueCache, RepeatedlyRequestingTheSameOutputReusesTheSameColumn)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(2);
+    const OutputExtractor output{ConstantOutputExtractor{"constant", 7.0f}};
+
+    OutputValueCache cache;
+    const float* firstData = cache.getValuesFloat(sim, output).data();
+    const float* secondData = cache.getValuesFloat(sim, output).data();
+
+    ASSERT_EQ(firstData, secondData);
+    ASSERT_EQ(cache.getNumColumns(), 1);
+}
+
+TEST(OutputValueCache, AppendsNewReportsWhenSimulationIsExtended)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(1);
+    const OutputExtractor output{TimeOutputExtractor{}};
+
+    OutputValueCache cache;
+    ASSERT_EQ(cache.getValuesFloat(sim, output).size(), 2);
+
+    sim.requestNewEndTime(SimulationClock::start() + std::chrono::seconds{3});
+    sim.join();
+
+    const auto values = cache.getValuesFloat(sim, output);
+    ASSERT_EQ(values.size(), 4);
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], static_cast<float>(i));
+    }
+}
+
+TEST(OutputValueCache, ReExtractsColumnWhenSimulationIsTruncated)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(3);
+    const OutputExtractor output{TimeOutputExtractor{}};
+
+    OutputValueCache cache;
+    ASSERT_EQ(cache.getValuesFloat(sim, output).size(), 4);
+
+    sim.requestNewEndTime(SimulationClock::start() + std::chrono::seconds{1});
+
+    const auto values = cache.getValuesFloat(sim, output);
+    ASSERT_EQ(values.size(), 2);
+    ASSERT_EQ(values[0], 0.0f);
+    ASSERT_EQ(values[1], 1.0f);
+}
+
+TEST(OutputValueCache, ClearRemovesAllColumns)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(1);
+
+    OutputValueCache cache;
+    cache.getValuesFloat(sim, OutputExtractor{ConstantOutputExtractor{"a", 1.0f}});
+    cache.getValuesVec2(sim, OutputExtractor{ConstantOutputExtractor{"b", Vec2{}}});
+    ASSERT_EQ(cache.getNumColumns(), 2);
+
+    cache.clear();
+    ASSERT_EQ(cache.getNumColumns(), 0);
+}
+
+TEST(OutputValueCache, FetchesEachReportOnceRegardlessOfTheNumberOfColumns)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(3);
+    const ReportCountingSimulation countingSim{sim};
+
+    OutputValueCache cache;
+    cache.getValuesFloat(countingSim, OutputExtractor{ConstantOutputExtractor{"a", 1.0f}});
+    cache.getValuesFloat(countingSim, OutputExtractor{ConstantOutputExtractor{"b", 2.0f}});
+    cache.getValuesFloat(countingSim, OutputExtractor{TimeOutputExtractor{}});
+    cache.getValuesVec2(countingSim, OutputExtractor{ConstantOutputExtractor{"c", Vec2{}}});
+    ASSERT_EQ(cache.getNumColumns(), 4);
+
+    ASSERT_EQ(countingSim.getNumReportsFetched(), sim.getNumReports());
+}
+
+TEST(OutputValueCache, FetchesOnlyNewReportsOnceWhenSimulationIsExtended)
+{
+    ForwardDynamicSimulation sim = RunSimulationForNSeconds(1);
+    const ReportCountingSimulation countingSim{sim};
+    const OutputExtractor a{ConstantOutputExtractor{"a", 1.0f}};
+    const OutputExtractor b{TimeOutputExtractor{}};
+
+    OutputValueCache cache;
+    cache.getValuesFloat(countingSim, a);
+    cache.getValuesFloat(countingSim, b);
+    const size_t numReportsBefore = sim.getNumReports();
+    ASSERT_EQ(countingSim.getNumReportsFetched(), numReportsBefore);
+
+    sim.requestNewEndTime(SimulationClock::start() + std::chrono::seconds{3});
+    sim.join();
+
+    cache.getValuesFloat(countingSim, a);
+    const auto values = cache.getValuesFloat(countingSim, b);
+    ASSERT_EQ(countingSim.getNumReportsFetched(), sim.getNumReports());
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(values[i], static_cast<float>(i));
+    }
+}
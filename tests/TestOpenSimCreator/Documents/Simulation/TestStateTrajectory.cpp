@@ -0,0 +1,177 @@
+#include <OpenSimCreator/Documents/Simulation/StateTrajectory.h>
+
+#include <OpenSimCreator/Documents/Model/BasicModelStatePair.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationClock.h>
+#include <OpenSimCreator/Documents/Simulation/SimulationReport.h>
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <oscar/Utils/UID.h>
+#include <Simbody.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace osc;
+
+namespace
+{
+    BasicModelStatePair LoadArm26()
+    {
+        return BasicModelStatePair{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+    }
+
+    // returns a report with a state that has a unique time and (slightly) perturbed continuous state variables
+    SimulationReport MakeReport(const BasicModelStatePair& p, size_t i, std::unordered_map<UID, float> auxiliaryValues = {})
+    {
+        SimTK::State state = p.getState();
+        state.setTime(static_cast<double>(i));
+        SimTK::Vector& y = state.updY();
+        for (int j = 0; j < y.size(); ++j) {
+            y[j] += 0.0001 * static_cast<double>(i);
+        }
+        return SimulationReport{std::move(state), std::move(auxiliaryValues)};
+    }
+
+    bool IsEqual(const SimTK::Vector& a, const SimTK::Vector& b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (int i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(StateTrajectory, IsEmptyWhenDefaultConstructed)
+{
+    const StateTrajectory trajectory;
+    ASSERT_TRUE(trajectory.empty());
+    ASSERT_EQ(trajectory.size(), 0);
+}
+
+TEST(StateTrajectory, PushBackIncreasesSizeAndRecordsTime)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory;
+    trajectory.push_back(MakeReport(arm26, 0));
+    trajectory.push_back(MakeReport(arm26, 1));
+
+    ASSERT_EQ(trajectory.size(), 2);
+    ASSERT_EQ(trajectory.getTime(0), SimulationClock::start());
+    ASSERT_EQ(trajectory.getTime(1), SimulationClock::start() + SimulationClock::duration{1.0});
+}
+
+TEST(StateTrajectory, GetReportRebuildsTheContinuousStateVariables)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory;
+    for (size_t i = 0; i < 3; ++i) {
+        trajectory.push_back(MakeReport(arm26, i));
+    }
+
+    const SimulationReport expected = MakeReport(arm26, 1);
+    const SimulationReport rebuilt = trajectory.getReport(1, arm26.getModel());
+
+    ASSERT_EQ(rebuilt.getTime(), expected.getTime());
+    ASSERT_TRUE(IsEqual(rebuilt.getState().getY(), expected.getState().getY()));
+    ASSERT_GE(rebuilt.getState().getSystemStage(), SimTK::Stage::Report);
+}
+
+TEST(StateTrajectory, GetReportWithFloatPrecisionIsApproximatelyEqual)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory{StateTrajectoryPrecision::Float};
+    trajectory.push_back(MakeReport(arm26, 7));
+
+    const SimulationReport expectedReport = MakeReport(arm26, 7);
+    const SimulationReport rebuiltReport = trajectory.getReport(0, arm26.getModel());
+    const SimTK::Vector& expected = expectedReport.getState().getY();
+    const SimTK::Vector& rebuilt = rebuiltReport.getState().getY();
+    ASSERT_EQ(rebuilt.size(), expected.size());
+    for (int i = 0; i < rebuilt.size(); ++i) {
+        ASSERT_NEAR(rebuilt[i], expected[i], 1e-5);
+    }
+}
+
+TEST(StateTrajectory, GetReportReturnsCachedReportWhenRequestedAgain)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory;
+    trajectory.push_back(MakeReport(arm26, 0));
+
+    ASSERT_EQ(trajectory.getReport(0, arm26.getModel()), trajectory.getReport(0, arm26.getModel()));
+}
+
+TEST(StateTrajectory, GetReportEvictsLeastRecentlyUsedReport)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory{StateTrajectoryPrecision::Double, 1};
+    trajectory.push_back(MakeReport(arm26, 0));
+    trajectory.push_back(MakeReport(arm26, 1));
+
+    const SimulationReport first = trajectory.getReport(0, arm26.getModel());
+    trajectory.getReport(1, arm26.getModel());  // evicts `first`
+
+    ASSERT_NE(trajectory.getReport(0, arm26.getModel()), first);  // rebuilt
+    ASSERT_TRUE(IsEqual(trajectory.getReport(0, arm26.getModel()).getState().getY(), first.getState().getY()));
+}
+
+TEST(StateTrajectory, RecordsAuxiliaryValues)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const UID a;
+    const UID b;
+
+    StateTrajectory trajectory;
+    trajectory.push_back(MakeReport(arm26, 0, {{a, 1.0f}}));
+    trajectory.push_back(MakeReport(arm26, 1, {{a, 2.0f}, {b, 3.0f}}));
+
+    ASSERT_EQ(trajectory.getAuxiliaryValue(0, a), 1.0f);
+    ASSERT_EQ(trajectory.getAuxiliaryValue(0, b), std::nullopt);
+    ASSERT_EQ(trajectory.getAuxiliaryValue(1, a), 2.0f);
+    ASSERT_EQ(trajectory.getAuxiliaryValue(1, b), 3.0f);
+    ASSERT_EQ(trajectory.getReport(1, arm26.getModel()).getAuxiliaryValue(b), 3.0f);
+    ASSERT_EQ(trajectory.getReport(0, arm26.getModel()).getAuxiliaryValue(b), std::nullopt);
+}
+
+TEST(StateTrajectory, TruncateRemovesTrailingReports)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    StateTrajectory trajectory;
+    for (size_t i = 0; i < 5; ++i) {
+        trajectory.push_back(MakeReport(arm26, i));
+    }
+    trajectory.getReport(4, arm26.getModel());  // cache it
+
+    trajectory.truncate(2);
+
+    ASSERT_EQ(trajectory.size(), 2);
+    ASSERT_THROW({ trajectory.getReport(4, arm26.getModel()); }, std::out_of_range);
+
+    trajectory.push_back(MakeReport(arm26, 9));
+    ASSERT_TRUE(IsEqual(trajectory.getReport(2, arm26.getModel()).getState().getY(), MakeReport(arm26, 9).getState().getY()));
+}
+
+TEST(StateTrajectory, GetTimeThrowsIfOutOfBounds)
+{
+    const StateTrajectory trajectory;
+    ASSERT_THROW({ trajectory.getTime(0); }, std::out_of_range);
+}
+
+TEST(StateTrajectory, PushBackThrowsIfStateHasADifferentNumberOfStateVariables)
+{
+    const BasicModelStatePair arm26 = LoadArm26();
+    const BasicModelStatePair blank;
+
+    StateTrajectory trajectory;
+    trajectory.push_back(MakeReport(arm26, 0));
+    ASSERT_THROW({ trajectory.push_back(MakeReport(blank, 1)); }, std::runtime_error);
+}
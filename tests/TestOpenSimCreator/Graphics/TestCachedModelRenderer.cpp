@@ -0,0 +1,217 @@
+#include <OpenSimCreator/Graphics/CachedModelRenderer.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+#include <OpenSim/Common/ComponentPath.h>
+#include <OpenSim/Simulation/Model/Marker.h>
+#include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
+#include <OpenSimCreator/Documents/Model/IModelStatePair.h>
+#include <OpenSimCreator/Graphics/ComponentSceneDecorationFlagsTagger.h>
+#include <OpenSimCreator/Graphics/ModelRendererParams.h>
+#include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
+#include <OpenSimCreator/Utils/OpenSimHelpers.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
+#include <oscar/Graphics/GraphicsContext.h>
+#include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneDecorationFlags.h>
+#include <oscar/Maths/AABB.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/Functors.h>
+#include <oscar/Platform/FilesystemResourceLoader.h>
+#include <oscar/Platform/ResourceLoader.h>
+#include <oscar/Utils/UID.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+// these tests use a recording graphics backend, so that they can run on machines that don't have a GPU
+namespace
+{
+    // an `IModelStatePair` that explicitly versions its model and state, and counts how many
+    // times its model or state are accessed (i.e. how many times decorations are generated)
+    class VersionedModelStatePair final : public IModelStatePair {
+    public:
+        explicit VersionedModelStatePair(const std::filesystem::path& osimPath) :
+            m_Model{std::make_unique<OpenSim::Model>(osimPath.string())}
+        {
+            InitializeModel(*m_Model);
+            InitializeState(*m_Model);
+        }
+
+        // sets the value of a coordinate in the state, which only changes the state's version
+        void setCoordinateValue(const std::string& coordinatePath, double newValue)
+        {
+            const auto* coordinate = FindComponent<OpenSim::Coordinate>(*m_Model, coordinatePath);
+            ASSERT_NE(coordinate, nullptr);
+            SimTK::State& state = m_Model->updWorkingState();
+            coordinate->setValue(state, newValue);
+            m_Model->equilibrateMuscles(state);
+            m_Model->realizeDynamics(state);
+            m_StateVersion = UID{};
+        }
+
+        size_t getNumModelOrStateAccesses() const { return m_NumModelOrStateAccesses; }
+
+    private:
+        const OpenSim::Model& implGetModel() const final
+        {
+            ++m_NumModelOrStateAccesses;
+            return *m_Model;
+        }
+        const SimTK::State& implGetState() const final
+        {
+            ++m_NumModelOrStateAccesses;
+            return m_Model->getWorkingState();
+        }
+        bool implCanUpdModel() const final { return true; }
+        OpenSim::Model& implUpdModel() final
+        {
+            m_ModelVersion = UID{};
+            m_StateVersion = UID{};
+            return *m_Model;
+        }
+        UID implGetModelVersion() const final { return m_ModelVersion; }
+        void implSetModelVersion(UID newVersion) final { m_ModelVersion = newVersion; }
+        UID implGetStateVersion() const final { return m_StateVersion; }
+        const OpenSim::Component* implGetSelected() const final { return m_Selected; }
+        void implSetSelected(const OpenSim::Component* c) final { m_Selected = c; }
+        const OpenSim::Component* implGetHovered() const final { return m_Hovered; }
+        void implSetHovered(const OpenSim::Component* c) final { m_Hovered = c; }
+
+        std::unique_ptr<OpenSim::Model> m_Model;
+        UID m_ModelVersion;
+        UID m_StateVersion;
+        const OpenSim::Component* m_Selected = nullptr;
+        const OpenSim::Component* m_Hovered = nullptr;
+        mutable size_t m_NumModelOrStateAccesses = 0;
+    };
+
+    // holds everything that's needed to render arm26, which has meshes, muscles, and wrapping
+    class CachedModelRendererFixture : public ::testing::Test {
+    protected:
+        static void SetUpTestSuite()
+        {
+            GloballyInitOpenSim();
+            GloballyAddDirectoryToOpenSimGeometrySearchPath(std::filesystem::path{OSC_RESOURCES_DIR} / "geometry");
+        }
+
+        // updates `renderer` to reflect the current model+state and returns a copy of its drawlist
+        std::vector<SceneDecoration> update(CachedModelRenderer& renderer)
+        {
+            renderer.autoFocusCamera(modelState, params, 1.0f);
+            const std::span<const SceneDecoration> drawlist = renderer.getDrawlist();
+            return {drawlist.begin(), drawlist.end()};
+        }
+
+        // returns the drawlist of a renderer that has never seen the model before
+        std::vector<SceneDecoration> generateFromScratch()
+        {
+            CachedModelRenderer freshRenderer{sceneCache};
+            return update(freshRenderer);
+        }
+
+        // the context must outlive (and be initialized before) every other graphics object
+        GraphicsContext context{GraphicsBackendType::Recording};
+        std::shared_ptr<SceneCache> sceneCache = std::make_shared<SceneCache>(make_resource_loader<FilesystemResourceLoader>(OSC_RESOURCES_DIR));
+        VersionedModelStatePair modelState{std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim"};
+        ModelRendererParams params;
+        CachedModelRenderer renderer{sceneCache};
+    };
+}
+
+TEST_F(CachedModelRendererFixture, SelectionAndHoverChangeOnlyRetagsExistingDecorations)
+{
+    const std::vector<SceneDecoration> before = update(renderer);
+    const std::optional<AABB> boundsBefore = renderer.bounds();
+    ASSERT_FALSE(before.empty());
+
+    modelState.setSelected(FindComponent(modelState.getModel(), std::string{"/bodyset/r_humerus"}));
+    modelState.setHovered(FindComponent(modelState.getModel(), std::string{"/forceset/BIClong"}));
+    ASSERT_NE(modelState.getSelected(), nullptr);
+    ASSERT_NE(modelState.getHovered(), nullptr);
+    const size_t numAccessesAfterSelecting = modelState.getNumModelOrStateAccesses();
+
+    const std::vector<SceneDecoration> after = update(renderer);
+
+    // nothing should've been regenerated (i.e. the model and state weren't accessed), and the
+    // geometry (and, therefore, the BVH) should be unchanged
+    ASSERT_EQ(modelState.getNumModelOrStateAccesses(), numAccessesAfterSelecting) << "the decorations were regenerated";
+    ASSERT_EQ(renderer.bounds(), boundsBefore);
+    ASSERT_EQ(after.size(), before.size());
+
+    // only the flags should change, and they should be what the tagger computes for each component
+    const ComponentSceneDecorationFlagsTagger tagger{modelState.getSelected(), modelState.getHovered()};
+    size_t numHighlighted = 0;
+    for (size_t i = 0; i < before.size(); ++i) {
+        SceneDecoration expected = before[i];
+        if (const OpenSim::Component* component = not expected.id.empty() ? FindComponent(modelState.getModel(), expected.id) : nullptr) {
+            expected.flags = expected.flags.without(SceneDecorationFlag::AllRimHighlightGroups) | tagger.computeFlags(*component);
+        }
+        ASSERT_EQ(after[i], expected) << "decoration " << i << " (" << before[i].id << ") was incorrectly retagged";
+        if (after[i].flags & SceneDecorationFlag::AllRimHighlightGroups) {
+            ++numHighlighted;
+        }
+    }
+    ASSERT_GT(numHighlighted, 0) << "selecting/hovering should highlight something";
+
+    // and the result should be the same as if the decorations were generated from scratch
+    ASSERT_EQ(after, generateFromScratch());
+
+    // un-selecting/hovering should also only retag (back to the original decorations)
+    modelState.setSelected(nullptr);
+    modelState.setHovered(nullptr);
+    const size_t numAccessesAfterDeselecting = modelState.getNumModelOrStateAccesses();
+    ASSERT_EQ(update(renderer), before);
+    ASSERT_EQ(modelState.getNumModelOrStateAccesses(), numAccessesAfterDeselecting) << "the decorations were regenerated";
+}
+
+TEST_F(CachedModelRendererFixture, StateChangeUpdatesDecorations)
+{
+    const std::vector<SceneDecoration> before = update(renderer);
+    const size_t numAccessesBefore = modelState.getNumModelOrStateAccesses();
+
+    modelState.setCoordinateValue("/jointset/r_elbow/r_elbow_flex", 1.5);
+    const std::vector<SceneDecoration> after = update(renderer);
+
+    ASSERT_GT(modelState.getNumModelOrStateAccesses(), numAccessesBefore) << "the decorations weren't updated";
+    ASSERT_NE(after, before);
+
+    // rigidly-attached decorations are moved (rather than regenerated), so their transforms can
+    // differ from a regeneration by a rounding error
+    const std::vector<SceneDecoration> expected = generateFromScratch();
+    ASSERT_EQ(after.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(after[i].id, expected[i].id) << "decoration " << i << " is in a different order";
+        ASSERT_EQ(after[i].flags, expected[i].flags) << "decoration " << i << " (" << expected[i].id << ") has different flags";
+        ASSERT_TRUE(all_of(equal_within_absdiff(after[i].transform.position, expected[i].transform.position, 1e-4f))) << "decoration " << i << " (" << expected[i].id << ") is in a different position";
+    }
+}
+
+TEST_F(CachedModelRendererFixture, ModelChangeRegeneratesDecorations)
+{
+    const std::vector<SceneDecoration> before = update(renderer);
+    const size_t numAccessesBefore = modelState.getNumModelOrStateAccesses();
+
+    OpenSim::Model& model = modelState.updModel();
+    auto* marker = FindComponentMut<OpenSim::Marker>(model, OpenSim::ComponentPath{"/markerset/r_acromion"});
+    ASSERT_NE(marker, nullptr);
+    marker->set_location(marker->get_location() + SimTK::Vec3{0.1, 0.0, 0.0});
+    InitializeModel(model);
+    InitializeState(model);
+
+    const std::vector<SceneDecoration> after = update(renderer);
+
+    ASSERT_GT(modelState.getNumModelOrStateAccesses(), numAccessesBefore) << "the decorations weren't regenerated";
+    ASSERT_NE(after, before);
+    ASSERT_EQ(after, generateFromScratch());
+}
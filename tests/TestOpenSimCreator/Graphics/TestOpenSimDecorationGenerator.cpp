@@ -3,20 +3,31 @@
 #include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
 
 #include <OpenSim/Simulation/Model/Geometry.h>
+#include <OpenSim/Simulation/Model/GeometryPath.h>
 #include <OpenSim/Simulation/Model/Ligament.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/SimbodyEngine/Coordinate.h>
 #include <OpenSimCreator/Graphics/MuscleColoringStyle.h>
 #include <OpenSimCreator/Graphics/OpenSimDecorationOptions.h>
 #include <OpenSimCreator/Platform/OpenSimCreatorApp.h>
 #include <OpenSimCreator/Utils/OpenSimHelpers.h>
 #include <gtest/gtest.h>
 #include <oscar/Maths/MathHelpers.h>
+#include <oscar/Maths/Quat.h>
+#include <oscar/Maths/QuaternionFunctions.h>
+#include <oscar/Maths/Transform.h>
+#include <oscar/Maths/TransformFunctions.h>
+#include <oscar/Maths/Vec3.h>
 #include <oscar/Platform/Log.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
 #include <oscar/Graphics/Scene/SceneDecoration.h>
 #include <oscar/Utils/StringHelpers.h>
+#include <oscar_simbody/SimTKConverters.h>
 
+#include <cmath>
+#include <cstddef>
 #include <filesystem>
+#include <string>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -300,3 +311,155 @@ TEST(OpenSimDecorationGenerator, GenerateDecorationsForLigamentGeneratesLigament
     );
     ASSERT_EQ(numDecorationsTaggedWithLigament, 1);
 }
+
+TEST(OpenSimDecorationGenerator, GenerateDecorationsForComponentsGeneratesSameDecorationsInSameOrderAsGenerateModelDecorations)
+{
+    GloballyInitOpenSim();  // ensure component registry is initialized
+    GloballyAddDirectoryToOpenSimGeometrySearchPath(std::filesystem::path{OSC_RESOURCES_DIR} / "geometry");
+
+    // a model with meshes, muscles, and wrapping
+    const std::filesystem::path modelPath = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim";
+    OpenSim::Model model{modelPath.string()};
+    InitializeModel(model);
+    InitializeState(model);
+    SceneCache meshCache;
+    OpenSimDecorationOptions opts;
+    opts.setShouldShowEffectiveMuscleLineOfActionForOrigin(true);
+
+    std::vector<std::pair<const OpenSim::Component*, SceneDecoration>> expected;
+    GenerateModelDecorations(
+        meshCache,
+        model,
+        model.getWorkingState(),
+        opts,
+        1.0f,
+        [&expected](const OpenSim::Component& c, SceneDecoration&& dec)
+        {
+            expected.emplace_back(&c, std::move(dec));
+        }
+    );
+
+    std::vector<const OpenSim::Component*> components;
+    for (const OpenSim::Component& c : model.getComponentList()) {
+        components.push_back(&c);
+    }
+
+    std::vector<std::pair<const OpenSim::Component*, SceneDecoration>> got;
+    GenerateDecorationsForComponents(
+        meshCache,
+        model,
+        model.getWorkingState(),
+        components,
+        opts,
+        1.0f,
+        [&got, &components](size_t componentIndex, const OpenSim::Component& c, SceneDecoration&& dec)
+        {
+            ASSERT_LT(componentIndex, components.size());
+            got.emplace_back(&c, std::move(dec));
+        }
+    );
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(got[i].first, expected[i].first) << "decoration " << i << " has a different associated component";
+        ASSERT_EQ(got[i].second, expected[i].second) << "decoration " << i << " (" << expected[i].first->getAbsolutePathString() << ") differs";
+    }
+}
+
+TEST(OpenSimDecorationGenerator, DecorationsOfComponentsWithARigidDecorationFrameMoveWithThatFrame)
+{
+    GloballyInitOpenSim();  // ensure component registry is initialized
+
+    const std::filesystem::path modelPath = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "RajagopalModel" / "Rajagopal2015.osim";
+    OpenSim::Model model{modelPath.string()};
+    InitializeModel(model);
+    SimTK::State& initialState = InitializeState(model);
+    SceneCache meshCache;
+    OpenSimDecorationOptions opts;
+
+    // a second state, where every (unlocked) coordinate is moved to the middle of its range
+    SimTK::State movedState{initialState};
+    for (const OpenSim::Coordinate& coordinate : model.getComponentList<OpenSim::Coordinate>()) {
+        if (not coordinate.getLocked(movedState)) {
+            coordinate.setValue(movedState, 0.5*(coordinate.getRangeMin() + coordinate.getRangeMax()), false);
+        }
+    }
+    model.realizeReport(movedState);
+
+    std::vector<const OpenSim::Component*> components;
+    for (const OpenSim::Component& c : model.getComponentList()) {
+        components.push_back(&c);
+    }
+
+    const auto generate = [&](const SimTK::State& state)
+    {
+        std::vector<std::pair<size_t, SceneDecoration>> rv;
+        GenerateDecorationsForComponents(
+            meshCache,
+            model,
+            state,
+            components,
+            opts,
+            1.0f,
+            [&rv](size_t componentIndex, const OpenSim::Component&, SceneDecoration&& dec)
+            {
+                rv.emplace_back(componentIndex, std::move(dec));
+            }
+        );
+        return rv;
+    };
+    const auto initialDecorations = generate(initialState);
+    const auto movedDecorations = generate(movedState);
+
+    // the rigid components should generate the same decorations, but moved with their frame
+    const auto rigidDecorationsOf = [&components](const auto& decorations)
+    {
+        std::vector<std::pair<size_t, SceneDecoration>> rv;
+        for (const auto& [componentIndex, decoration] : decorations) {
+            if (FindRigidDecorationFrame(*components[componentIndex])) {
+                rv.emplace_back(componentIndex, decoration);
+            }
+        }
+        return rv;
+    };
+    const auto initialRigid = rigidDecorationsOf(initialDecorations);
+    const auto movedRigid = rigidDecorationsOf(movedDecorations);
+
+    ASSERT_FALSE(initialRigid.empty());
+    ASSERT_LT(initialRigid.size(), initialDecorations.size()) << "some decorations (e.g. muscles) shouldn't be rigid";
+    ASSERT_EQ(initialRigid.size(), movedRigid.size());
+    for (size_t i = 0; i < initialRigid.size(); ++i) {
+        const auto& [componentIndex, initial] = initialRigid[i];
+        const auto& [movedComponentIndex, moved] = movedRigid[i];
+        ASSERT_EQ(componentIndex, movedComponentIndex);
+
+        const OpenSim::Frame& frame = *FindRigidDecorationFrame(*components[componentIndex]);
+        const Transform initialFrame = to<Transform>(frame.getTransformInGround(initialState));
+        const Transform movedFrame = to<Transform>(frame.getTransformInGround(movedState));
+
+        const Vec3 expectedPosition = movedFrame * inverse_transform_point(initialFrame, initial.transform.position);
+        const Quat expectedRotation = movedFrame.rotation * conjugate(initialFrame.rotation) * initial.transform.rotation;
+
+        ASSERT_EQ(initial.mesh, moved.mesh) << components[componentIndex]->getAbsolutePathString();
+        ASSERT_TRUE(all_of(equal_within_absdiff(moved.transform.position, expectedPosition, 1e-4f))) << components[componentIndex]->getAbsolutePathString();
+        ASSERT_NEAR(std::abs(dot(moved.transform.rotation, expectedRotation)), 1.0f, 1e-4f) << components[componentIndex]->getAbsolutePathString();
+        ASSERT_TRUE(all_of(equal_within_absdiff(moved.transform.scale, initial.transform.scale, 1e-6f))) << components[componentIndex]->getAbsolutePathString();
+    }
+}
+
+TEST(OpenSimDecorationGenerator, FindRigidDecorationFrameReturnsNullptrForGeometryPaths)
+{
+    GloballyInitOpenSim();  // ensure component registry is initialized
+
+    const std::filesystem::path modelPath = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Tug_of_War" / "Tug_of_War.osim";
+    OpenSim::Model model{modelPath.string()};
+    InitializeModel(model);
+
+    size_t numPathsChecked = 0;
+    for (const OpenSim::GeometryPath& path : model.getComponentList<OpenSim::GeometryPath>()) {
+        ASSERT_EQ(FindRigidDecorationFrame(path), nullptr);
+        ++numPathsChecked;
+    }
+    ASSERT_GT(numPathsChecked, 0);
+}
@@ -0,0 +1,132 @@
+#include <OpenSimCreator/Platform/HeadlessCommands.h>
+
+#include <TestOpenSimCreator/TestOpenSimCreatorConfig.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::filesystem::path GetOutputDirectory(std::string_view name)
+    {
+        const std::filesystem::path rv = std::filesystem::temp_directory_path() / ("TestOpenSimCreator_HeadlessCommands_" + std::string{name});
+        std::filesystem::remove_all(rv);
+        return rv;
+    }
+
+    int Run(std::vector<std::string_view> args)
+    {
+        std::stringstream out;
+        std::stringstream err;
+        return RunHeadlessCommand(args, out, err);
+    }
+}
+
+TEST(IsHeadlessCommand, ReturnsTrueForKnownCommands)
+{
+    ASSERT_TRUE(IsHeadlessCommand("simulate"));
+    ASSERT_TRUE(IsHeadlessCommand("batch-fd"));
+    ASSERT_TRUE(IsHeadlessCommand("warp-model"));
+    ASSERT_TRUE(IsHeadlessCommand("warp-mesh"));
+    ASSERT_TRUE(IsHeadlessCommand("load-sto"));
+    ASSERT_TRUE(IsHeadlessCommand("muscle-matrix"));
+}
+
+TEST(IsHeadlessCommand, ReturnsFalseForModelFilesAndUnknownCommands)
+{
+    ASSERT_FALSE(IsHeadlessCommand("fd"));
+    ASSERT_FALSE(IsHeadlessCommand("model.osim"));
+    ASSERT_FALSE(IsHeadlessCommand(""));
+}
+
+TEST(RunHeadlessCommand, FailsWithUnknownOption)
+{
+    ASSERT_EQ(Run({"simulate", "--not-an-option", "1", "model.osim"}), EXIT_FAILURE);
+}
+
+TEST(RunHeadlessCommand, FailsIfModelDoesNotExist)
+{
+    ASSERT_EQ(Run({"simulate", "--threads", "1", "does-not-exist.osim"}), EXIT_FAILURE);
+}
+
+TEST(RunHeadlessCommand, SimulateWritesStatesAndTimingSummary)
+{
+    const std::filesystem::path model = std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim";
+    const std::filesystem::path outputDirectory = GetOutputDirectory("simulate");
+    const std::string modelString = model.string();
+    const std::string outputDirectoryString = outputDirectory.string();
+
+    std::stringstream out;
+    std::stringstream err;
+    const std::vector<std::string_view> args = {"simulate", "--final-time", "0.01", "--output", outputDirectoryString, modelString};
+    const int rv = RunHeadlessCommand(args, out, err);
+
+    ASSERT_EQ(rv, EXIT_SUCCESS) << err.str();
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "arm26" / "point_0.csv"));
+    ASSERT_NE(out.str().find("timing summary"), std::string::npos);
+    ASSERT_NE(out.str().find("throughput"), std::string::npos);
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+TEST(RunHeadlessCommand, SimulateRunsEachModelWhenRanOnMultipleThreads)
+{
+    const std::filesystem::path models = std::filesystem::path{OSC_RESOURCES_DIR} / "models";
+    const std::string arm26 = (models / "Arm26" / "arm26.osim").string();
+    const std::string pendulum = (models / "DoublePendulum" / "double_pendulum.osim").string();
+    const std::string tugOfWar = (models / "Tug_of_War" / "Tug_of_War.osim").string();
+
+    std::stringstream out;
+    std::stringstream err;
+    const std::vector<std::string_view> args = {"simulate", "--final-time", "0.01", "--threads", "3", arm26, pendulum, tugOfWar};
+    const int rv = RunHeadlessCommand(args, out, err);
+
+    ASSERT_EQ(rv, EXIT_SUCCESS) << err.str();
+    for (const std::string& model : {arm26, pendulum, tugOfWar}) {
+        ASSERT_NE(out.str().find(model + ": simulated"), std::string::npos) << model;
+    }
+}
+
+TEST(RunHeadlessCommand, WarpMeshWritesWarpedMeshes)
+{
+    const std::filesystem::path fixtures = std::filesystem::path{OSC_TESTING_RESOURCES_DIR} / "Document" / "ModelWarper" / "Paired";
+    const std::string sourceLandmarks = (fixtures / "Geometry" / "sphere.landmarks.csv").string();
+    const std::string destinationLandmarks = (fixtures / "DestinationGeometry" / "sphere.landmarks.csv").string();
+    const std::string mesh = (fixtures / "Geometry" / "sphere.obj").string();
+    const std::filesystem::path outputDirectory = GetOutputDirectory("warp-mesh");
+    const std::string outputDirectoryString = outputDirectory.string();
+
+    ASSERT_EQ(Run({"warp-mesh", "--threads", "2", "--output", outputDirectoryString, sourceLandmarks, destinationLandmarks, mesh}), EXIT_SUCCESS);
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "sphere_warped.obj"));
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+TEST(RunHeadlessCommand, MuscleMatrixWritesEachModelsMatrix)
+{
+    const std::string model = (std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim").string();
+    const std::filesystem::path outputDirectory = GetOutputDirectory("muscle-matrix");
+    const std::string outputDirectoryString = outputDirectory.string();
+
+    ASSERT_EQ(Run({"muscle-matrix", "--quantity", "fiber_length", "--data-points", "4", "--threads", "2", "--output", outputDirectoryString, model}), EXIT_SUCCESS);
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "arm26_fiber_length.csv"));
+
+    ASSERT_EQ(Run({"muscle-matrix", "--data-points", "4", "--format", "binary", "--output", outputDirectoryString, model}), EXIT_SUCCESS);
+    ASSERT_TRUE(std::filesystem::exists(outputDirectory / "arm26_moment_arm.bin"));
+
+    std::filesystem::remove_all(outputDirectory);
+}
+
+TEST(RunHeadlessCommand, MuscleMatrixFailsWithUnknownQuantity)
+{
+    const std::string model = (std::filesystem::path{OSC_RESOURCES_DIR} / "models" / "Arm26" / "arm26.osim").string();
+    ASSERT_EQ(Run({"muscle-matrix", "--quantity", "not_a_quantity", model}), EXIT_FAILURE);
+}
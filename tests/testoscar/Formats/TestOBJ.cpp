@@ -0,0 +1,117 @@
+#include <oscar/Formats/OBJ.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Geometries/BoxGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    Mesh read_as_obj_from_string(const std::string& content)
+    {
+        std::stringstream ss{content};
+        return read_as_obj(ss);
+    }
+}
+
+TEST(read_as_obj, returns_empty_mesh_for_empty_input)
+{
+    ASSERT_EQ(read_as_obj_from_string("").num_indices(), 0);
+}
+
+TEST(read_as_obj, reads_vertices_and_triangle_face)
+{
+    const Mesh mesh = read_as_obj_from_string(
+        "# a comment\n"
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        "f 1 2 3\n"
+    );
+
+    const std::vector<Vec3> expected_vertices = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+    ASSERT_EQ(mesh.vertices(), expected_vertices);
+    ASSERT_EQ(mesh.num_indices(), 3);
+    ASSERT_TRUE(mesh.has_normals());
+}
+
+TEST(read_as_obj, ignores_texture_coordinate_and_normal_indices_in_faces)
+{
+    const Mesh mesh = read_as_obj_from_string(
+        "v 0 0 0\r\n"
+        "v 1 0 0\r\n"
+        "v 0 1 0\r\n"
+        "vn 0 0 1\r\n"
+        "vt 0 0\r\n"
+        "f 1/1/1 2//1 3/1\r\n"
+    );
+    ASSERT_EQ(mesh.num_indices(), 3);
+}
+
+TEST(read_as_obj, resolves_negative_indices_relative_to_preceding_vertices)
+{
+    const Mesh mesh = read_as_obj_from_string(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        "f -3 -2 -1\n"
+        "v 0 0 1\n"
+        "f -4 -3 -1\n"
+    );
+
+    const auto indices = mesh.indices();
+    ASSERT_EQ(indices.size(), 6);
+    ASSERT_EQ(indices[0], 0);
+    ASSERT_EQ(indices[1], 1);
+    ASSERT_EQ(indices[2], 2);
+    ASSERT_EQ(indices[3], 0);
+    ASSERT_EQ(indices[4], 1);
+    ASSERT_EQ(indices[5], 3);
+}
+
+TEST(read_as_obj, triangulates_quad_faces_into_two_triangles)
+{
+    const Mesh mesh = read_as_obj_from_string(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 1 0\n"
+        "f 1 2 3 4\n"
+    );
+    ASSERT_EQ(mesh.num_indices(), 6);
+}
+
+TEST(read_as_obj, skips_faces_with_out_of_bounds_indices)
+{
+    const Mesh mesh = read_as_obj_from_string(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1 0\n"
+        "f 1 2 4\n"
+        "f 1 2 3\n"
+    );
+    ASSERT_EQ(mesh.num_indices(), 3);
+}
+
+TEST(read_as_obj, throws_if_vertex_cannot_be_parsed)
+{
+    ASSERT_THROW({ read_as_obj_from_string("v 0 zero 0\n"); }, std::runtime_error);
+}
+
+TEST(read_as_obj, can_read_output_of_write_as_obj)
+{
+    const Mesh box = BoxGeometry{};
+
+    std::stringstream ss;
+    write_as_obj(ss, box, ObjMetadata{});
+    const Mesh mesh = read_as_obj(ss);
+
+    ASSERT_EQ(mesh.num_vertices(), box.num_vertices());
+    ASSERT_EQ(mesh.num_indices(), box.num_indices());
+}
@@ -0,0 +1,75 @@
+#include <oscar/Formats/STL.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Geometries/BoxGeometry.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Triangle.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    Mesh read_as_stl_from_string(const std::string& content)
+    {
+        std::stringstream ss{content};
+        return read_as_stl(ss);
+    }
+
+    std::vector<Triangle> indexed_triangles_of(const Mesh& mesh)
+    {
+        std::vector<Triangle> rv;
+        mesh.for_each_indexed_triangle([&rv](const Triangle& t) { rv.push_back(t); });
+        return rv;
+    }
+}
+
+TEST(read_as_stl, reads_ascii_stl)
+{
+    const Mesh mesh = read_as_stl_from_string(
+        "solid test\n"
+        "  facet normal 0 0 1\n"
+        "    outer loop\n"
+        "      vertex 0 0 0\n"
+        "      vertex 1 0 0\n"
+        "      vertex 0 1 0\n"
+        "    endloop\n"
+        "  endfacet\n"
+        "  facet normal 0 0 1\n"
+        "    outer loop\n"
+        "      vertex 1 0 0\n"
+        "      vertex 1 1 0\n"
+        "      vertex 0 1 0\n"
+        "    endloop\n"
+        "  endfacet\n"
+        "endsolid test\n"
+    );
+
+    ASSERT_EQ(mesh.num_indices(), 6);
+    ASSERT_EQ(mesh.num_vertices(), 4) << "should merge bitwise-equal vertices";
+    ASSERT_TRUE(mesh.has_normals());
+}
+
+TEST(read_as_stl, throws_if_ascii_stl_contains_incomplete_triangle)
+{
+    ASSERT_THROW({ read_as_stl_from_string("solid test\nvertex 0 0 0\nvertex 1 0 0\nendsolid test\n"); }, std::runtime_error);
+}
+
+TEST(read_as_stl, throws_if_given_data_that_isnt_stl)
+{
+    ASSERT_THROW({ read_as_stl_from_string("not an stl file"); }, std::runtime_error);
+}
+
+TEST(read_as_stl, reads_exact_triangles_from_output_of_write_as_stl)
+{
+    const Mesh box = BoxGeometry{};
+
+    std::stringstream ss;
+    write_as_stl(ss, box, StlMetadata{});
+    const Mesh mesh = read_as_stl(ss);
+
+    ASSERT_EQ(indexed_triangles_of(mesh), indexed_triangles_of(box));
+}
@@ -0,0 +1,95 @@
+#include <oscar/Formats/VTP.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/Vec3.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    Mesh read_as_vtp_from_string(const std::string& content)
+    {
+        std::stringstream ss{content};
+        return read_as_vtp(ss);
+    }
+
+    // returns the content of a minimal VTP file with the given points and polys
+    std::string minimal_vtp(
+        const std::string& points,
+        const std::string& connectivity,
+        const std::string& offsets,
+        const std::string& format = "ascii")
+    {
+        return
+            "<?xml version=\"1.0\"?>\r\n"
+            "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\r\n"
+            "  <PolyData>\r\n"
+            "    <Piece NumberOfPoints=\"4\" NumberOfPolys=\"1\">\r\n"
+            "      <PointData>\r\n"
+            "      </PointData>\r\n"
+            "      <Points>\r\n"
+            "        <DataArray type=\"Float32\" Name=\"Points\" NumberOfComponents=\"3\" format=\"" + format + "\" RangeMin=\"0\" RangeMax=\"1\">\r\n"
+            "          " + points + "\r\n"
+            "        </DataArray>\r\n"
+            "      </Points>\r\n"
+            "      <Lines>\r\n"
+            "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"ascii\" RangeMin=\"1e+299\" RangeMax=\"-1e+299\">\r\n"
+            "        </DataArray>\r\n"
+            "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"ascii\" RangeMin=\"1e+299\" RangeMax=\"-1e+299\">\r\n"
+            "        </DataArray>\r\n"
+            "      </Lines>\r\n"
+            "      <Polys>\r\n"
+            "        <DataArray type=\"Int64\" Name=\"connectivity\" format=\"ascii\" RangeMin=\"0\" RangeMax=\"3\">\r\n"
+            "          " + connectivity + "\r\n"
+            "        </DataArray>\r\n"
+            "        <DataArray type=\"Int64\" Name=\"offsets\" format=\"ascii\" RangeMin=\"0\" RangeMax=\"3\">\r\n"
+            "          " + offsets + "\r\n"
+            "        </DataArray>\r\n"
+            "      </Polys>\r\n"
+            "    </Piece>\r\n"
+            "  </PolyData>\r\n"
+            "</VTKFile>\r\n";
+    }
+}
+
+TEST(read_as_vtp, reads_points_and_triangle_polys)
+{
+    const Mesh mesh = read_as_vtp_from_string(minimal_vtp("0 0 0 1 0 0 0 1 0 0 0 1", "0 1 2 0 1 3", "3 6"));
+
+    const std::vector<Vec3> expected_vertices = {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+    };
+    ASSERT_EQ(mesh.vertices(), expected_vertices);
+    ASSERT_EQ(mesh.num_indices(), 6);
+    ASSERT_TRUE(mesh.has_normals());
+}
+
+TEST(read_as_vtp, triangulates_quad_polys_into_two_triangles)
+{
+    const Mesh mesh = read_as_vtp_from_string(minimal_vtp("0 0 0 1 0 0 1 1 0 0 1 0", "0 1 2 3", "4"));
+    ASSERT_EQ(mesh.num_indices(), 6);
+}
+
+TEST(read_as_vtp, throws_if_offsets_are_out_of_bounds)
+{
+    ASSERT_THROW({ read_as_vtp_from_string(minimal_vtp("0 0 0 1 0 0 0 1 0", "0 1 2", "4")); }, std::runtime_error);
+}
+
+TEST(read_as_vtp, throws_if_data_array_is_not_ascii)
+{
+    ASSERT_THROW({ read_as_vtp_from_string(minimal_vtp("AAAA", "0 1 2", "3", "binary")); }, std::runtime_error);
+}
+
+TEST(read_as_vtp, throws_if_given_data_that_isnt_vtp)
+{
+    ASSERT_THROW({ read_as_vtp_from_string("not a vtp file"); }, std::runtime_error);
+}
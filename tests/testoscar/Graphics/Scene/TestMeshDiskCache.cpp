@@ -0,0 +1,190 @@
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
+
+#include <testoscar/TestingHelpers.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ScopeGuard.h>
+#include <oscar/Utils/TemporaryFile.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace osc;
+using namespace osc::testing;
+
+namespace
+{
+    // returns a new (empty) directory that is deleted when the test finishes
+    std::filesystem::path create_empty_cache_directory()
+    {
+        const std::filesystem::path rv = std::filesystem::temp_directory_path() / ("testoscar_MeshDiskCache_" + std::to_string(generate<int>()));
+        std::filesystem::remove_all(rv);
+        return rv;
+    }
+
+    // returns a temporary "mesh file" (its content doesn't matter: it only needs to exist)
+    TemporaryFile create_mesh_file(const std::string& content)
+    {
+        TemporaryFile rv;
+        rv.stream() << content;
+        rv.close();
+        return rv;
+    }
+
+    Mesh generate_triangle_mesh(size_t num_triangles)
+    {
+        Mesh rv;
+        rv.set_vertices(generate_vertices(3*num_triangles));
+        rv.set_indices(iota_index_range(0, 3*num_triangles));
+        rv.recalculate_normals();
+        return rv;
+    }
+}
+
+TEST(MeshDiskCache, try_load_returns_nullopt_for_nonexistent_mesh_file)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+
+    ASSERT_FALSE(MeshDiskCache{directory}.try_load(directory / "doesnt-exist.obj"));
+}
+
+TEST(MeshDiskCache, load_or_decode_only_calls_decoder_on_first_load)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+    const Mesh mesh = generate_triangle_mesh(100);
+
+    size_t num_decoder_calls = 0;
+    const auto decoder = [&num_decoder_calls, &mesh]() { ++num_decoder_calls; return mesh; };
+
+    const MeshDiskCacheEntry cold = cache.load_or_decode(mesh_file.absolute_path(), decoder);
+    const MeshDiskCacheEntry warm = cache.load_or_decode(mesh_file.absolute_path(), decoder);
+
+    ASSERT_EQ(num_decoder_calls, 1);
+    ASSERT_EQ(warm.mesh.vertices(), mesh.vertices());
+    ASSERT_EQ(warm.mesh.normals(), mesh.normals());
+    ASSERT_TRUE(std::ranges::equal(warm.mesh.indices(), mesh.indices()));
+    ASSERT_EQ(warm.bvh.nodes().size(), cold.bvh.nodes().size());
+    ASSERT_EQ(warm.bvh.bounds(), cold.bvh.bounds());
+}
+
+TEST(MeshDiskCache, loaded_BVH_gives_same_ray_collisions_as_decoded_BVH)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    const MeshDiskCacheEntry cold = cache.load_or_decode(mesh_file.absolute_path(), []() { return generate_triangle_mesh(500); });
+    const std::optional<MeshDiskCacheEntry> warm = cache.try_load(mesh_file.absolute_path());
+    ASSERT_TRUE(warm);
+
+    const std::vector<Vec3> vertices = cold.mesh.vertices();
+    const std::vector<uint32_t> indices(cold.mesh.indices().begin(), cold.mesh.indices().end());
+    for (size_t i = 0; i < 100; ++i) {
+        const Line ray{.origin = 4.0f*generate<Vec3>() - 2.0f, .direction = normalize(generate<Vec3>() - 0.5f)};
+        const auto expected = cold.bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+        const auto got = warm->bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+
+        ASSERT_EQ(got.has_value(), expected.has_value());
+        if (expected) {
+            ASSERT_EQ(got->distance, expected->distance);
+            ASSERT_EQ(got->id, expected->id);
+        }
+    }
+}
+
+TEST(MeshDiskCache, modifying_mesh_file_invalidates_its_entry)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    ASSERT_TRUE(cache.store(mesh_file.absolute_path(), generate_triangle_mesh(10), BVH{}));
+    ASSERT_TRUE(cache.try_load(mesh_file.absolute_path()));
+
+    std::ofstream{mesh_file.absolute_path(), std::ios::app} << "some more data";
+
+    ASSERT_FALSE(cache.try_load(mesh_file.absolute_path()));
+}
+
+TEST(MeshDiskCache, truncated_entry_is_treated_as_a_cache_miss)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    ASSERT_TRUE(cache.store(mesh_file.absolute_path(), generate_triangle_mesh(10), BVH{}));
+    for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+        std::filesystem::resize_file(entry.path(), entry.file_size() - 1);
+    }
+
+    ASSERT_FALSE(cache.try_load(mesh_file.absolute_path()));
+}
+
+TEST(MeshDiskCache, touching_mesh_file_without_modifying_its_content_is_still_a_cache_hit)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    ASSERT_TRUE(cache.store(mesh_file.absolute_path(), generate_triangle_mesh(10), BVH{}));
+    std::filesystem::last_write_time(mesh_file.absolute_path(), std::filesystem::last_write_time(mesh_file.absolute_path()) + std::chrono::hours{1});
+
+    ASSERT_TRUE(cache.try_load(mesh_file.absolute_path()));
+}
+
+TEST(MeshDiskCache, same_size_edit_that_preserves_an_ambiguous_modification_time_invalidates_its_entry)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    // the mesh file was modified just before the entry was written, so its modification time
+    // can't be trusted to detect subsequent edits (e.g. on filesystems with coarse timestamps)
+    ASSERT_TRUE(cache.store(mesh_file.absolute_path(), generate_triangle_mesh(10), BVH{}));
+
+    const auto modification_time = std::filesystem::last_write_time(mesh_file.absolute_path());
+    std::ofstream{mesh_file.absolute_path(), std::ios::trunc} << "some mesh DATA";
+    std::filesystem::last_write_time(mesh_file.absolute_path(), modification_time);
+
+    ASSERT_FALSE(cache.try_load(mesh_file.absolute_path()));
+}
+
+TEST(MeshDiskCache, lookups_dont_hash_mesh_file_content_if_its_size_and_modification_time_are_unambiguous)
+{
+    const auto directory = create_empty_cache_directory();
+    const ScopeGuard cleanup{[&directory]() { std::filesystem::remove_all(directory); }};
+    const TemporaryFile mesh_file = create_mesh_file("some mesh data");
+    const MeshDiskCache cache{directory};
+
+    const auto modification_time = std::filesystem::last_write_time(mesh_file.absolute_path()) - std::chrono::hours{1};
+    std::filesystem::last_write_time(mesh_file.absolute_path(), modification_time);
+    ASSERT_TRUE(cache.store(mesh_file.absolute_path(), generate_triangle_mesh(10), BVH{}));
+
+    // an edit that preserves the mesh file's (unambiguous) size and modification time can
+    // only be detected by reading the file, which lookups should skip
+    std::ofstream{mesh_file.absolute_path(), std::ios::trunc} << "some mesh DATA";
+    std::filesystem::last_write_time(mesh_file.absolute_path(), modification_time);
+
+    ASSERT_TRUE(cache.try_load(mesh_file.absolute_path()));
+}
@@ -1,16 +1,30 @@
 #include <oscar/Graphics/Scene/SceneCache.h>
 
+#include <testoscar/TestingHelpers.h>
+
+#include <oscar/Graphics/Scene/MeshDiskCache.h>
 #include <oscar/Maths/AABB.h>
 #include <oscar/Maths/BVH.h>
 #include <oscar/Maths/MathHelpers.h>
 #include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ScopeGuard.h>
+#include <oscar/Utils/TemporaryFile.h>
 
 #include <gtest/gtest.h>
 
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace osc;
+using namespace osc::testing;
 
 TEST(SceneCache, get_bvh_on_empty_mesh_returns_empty_bvh)
 {
@@ -42,3 +56,175 @@ TEST(SceneCache, get_bvh_on_nonempty_mesh_returns_expected_root_node)
     ASSERT_FALSE(bvh.empty());
     ASSERT_EQ(expected_root, bvh.bounds());
 }
+
+TEST(SceneCache, try_get_bvh_eventually_returns_same_bvh_as_get_bvh)
+{
+    Mesh m;
+    m.set_vertices(generate_vertices(300));
+    m.set_indices(iota_index_range(0, 300));
+
+    SceneCache c;
+
+    const BVH* bvh = c.try_get_bvh(m);
+    for (auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10}; not bvh and std::chrono::steady_clock::now() < deadline;) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        bvh = c.try_get_bvh(m);
+    }
+
+    ASSERT_NE(bvh, nullptr) << "the BVH should eventually be built in the background";
+    ASSERT_EQ(bvh, &c.get_bvh(m));
+    ASSERT_EQ(bvh->bounds(), bounding_aabb_of(m.vertices()));
+}
+
+TEST(SceneCache, try_get_bvh_returns_BVH_immediately_if_already_built_by_get_bvh)
+{
+    Mesh m;
+    m.set_vertices(generate_vertices(30));
+    m.set_indices(iota_index_range(0, 30));
+
+    SceneCache c;
+    const BVH& bvh = c.get_bvh(m);
+
+    ASSERT_EQ(c.try_get_bvh(m), &bvh);
+}
+
+TEST(SceneCache, get_bvh_works_while_the_same_BVH_is_being_built_in_the_background)
+{
+    Mesh m;
+    m.set_vertices(generate_vertices(3*20000));
+    m.set_indices(iota_index_range(0, 3*20000));
+
+    SceneCache c;
+    const BVH* background_bvh = c.try_get_bvh(m);  // probably schedules a background build
+    const BVH& bvh = c.get_bvh(m);                 // should block until it's built
+
+    ASSERT_FALSE(bvh.empty());
+    ASSERT_TRUE(background_bvh == nullptr or background_bvh == &bvh);
+}
+
+TEST(SceneCache, clear_meshes_and_destruction_while_BVHs_are_being_built_in_the_background_is_fine)
+{
+    std::vector<Mesh> meshes(8);
+    for (Mesh& m : meshes) {
+        m.set_vertices(generate_vertices(3*5000));
+        m.set_indices(iota_index_range(0, 3*5000));
+    }
+
+    {
+        SceneCache c;
+        for (const Mesh& m : meshes) {
+            c.try_get_bvh(m);
+        }
+        c.clear_meshes();
+        for (const Mesh& m : meshes) {
+            c.try_get_bvh(m);
+        }
+    }  // destructor should cancel/join any in-flight builds
+}
+
+TEST(SceneCache, get_mesh_file_with_mesh_disk_cache_makes_BVH_immediately_available)
+{
+    const std::filesystem::path cache_directory = std::filesystem::temp_directory_path() / "testoscar_SceneCache_mesh_disk_cache";
+    std::filesystem::remove_all(cache_directory);
+    const ScopeGuard cleanup{[&cache_directory]() { std::filesystem::remove_all(cache_directory); }};
+
+    TemporaryFile mesh_file;
+    mesh_file.stream() << "some mesh data";
+    mesh_file.close();
+
+    const auto decoder = []()
+    {
+        Mesh m;
+        m.set_vertices(generate_vertices(30));
+        m.set_indices(iota_index_range(0, 30));
+        return m;
+    };
+
+    for (size_t i = 0; i < 2; ++i) {  // cold + warm
+        SceneCache c;
+        c.set_mesh_disk_cache(std::make_shared<MeshDiskCache>(cache_directory));
+        const Mesh mesh = c.get_mesh_file(mesh_file.absolute_path(), decoder);
+
+        ASSERT_EQ(mesh.num_indices(), 30);
+        ASSERT_NE(c.try_get_bvh(mesh), nullptr) << "the BVH should've been loaded/built alongside the mesh";
+    }
+}
+
+TEST(SceneCache, get_mesh_calls_getter_once_and_then_returns_cached_mesh)
+{
+    SceneCache c;
+    size_t num_calls = 0;
+    const auto getter = [&num_calls]()
+    {
+        ++num_calls;
+        Mesh m;
+        m.set_vertices(generate_vertices(3));
+        return m;
+    };
+
+    const Mesh first = c.get_mesh("key", getter);
+    const Mesh second = c.get_mesh("key", getter);
+
+    ASSERT_EQ(num_calls, 1);
+    ASSERT_EQ(first, second);
+}
+
+TEST(SceneCache, get_mesh_for_other_key_does_not_block_while_a_getter_is_running)
+{
+    SceneCache c;
+    std::promise<void> getter_started;
+    std::promise<void> allow_getter_to_finish;
+
+    auto slow_load = std::async(std::launch::async, [&]()
+    {
+        return c.get_mesh("slow", [&]()
+        {
+            getter_started.set_value();
+            allow_getter_to_finish.get_future().wait();
+            return Mesh{};
+        });
+    });
+    getter_started.get_future().wait();
+
+    // this would deadlock if `get_mesh` held the cache's lock while the slow getter runs
+    c.get_mesh("fast", []() { return Mesh{}; });
+    allow_getter_to_finish.set_value();
+    slow_load.get();
+}
+
+TEST(SceneCache, preload_mesh_files_loads_each_mesh_file_such_that_get_mesh_file_does_not_reload_them)
+{
+    const auto mesh_files = std::to_array<std::filesystem::path>({"a.obj", "b.stl", "c.vtp", "d.vtp"});
+
+    SceneCache c;
+    std::atomic<size_t> num_loads = 0;
+    c.preload_mesh_files(mesh_files, [&num_loads](const std::filesystem::path&)
+    {
+        ++num_loads;
+        Mesh m;
+        m.set_vertices(generate_vertices(3));
+        return m;
+    });
+    ASSERT_EQ(num_loads, mesh_files.size());
+
+    for (const std::filesystem::path& mesh_file : mesh_files) {
+        const Mesh mesh = c.get_mesh_file(mesh_file, []() -> Mesh { throw std::runtime_error{"should not be called"}; });
+        ASSERT_EQ(mesh.num_vertices(), 3);
+    }
+}
+
+TEST(SceneCache, preload_mesh_files_does_not_throw_if_a_mesh_file_fails_to_load)
+{
+    const auto mesh_files = std::to_array<std::filesystem::path>({"ok.obj", "broken.obj"});
+
+    SceneCache c;
+    ASSERT_NO_THROW({
+        c.preload_mesh_files(mesh_files, [](const std::filesystem::path& p)
+        {
+            if (p == "broken.obj") {
+                throw std::runtime_error{"some loading error"};
+            }
+            return Mesh{};
+        });
+    });
+}
@@ -1,10 +1,19 @@
 #include <oscar/Graphics/Scene/SceneHelpers.h>
 
+#include <oscar/Graphics/Geometries/SphereGeometry.h>
+#include <oscar/Graphics/Mesh.h>
 #include <oscar/Graphics/Scene/SceneCache.h>
+#include <oscar/Graphics/Scene/SceneDecoration.h>
+#include <oscar/Graphics/Scene/SceneRendererParams.h>
+#include <oscar/Graphics/Scene/SceneRendererStats.h>
+#include <oscar/Maths/BVH.h>
+#include <oscar/Maths/Line.h>
 
 #include <gtest/gtest.h>
 
 #include <cstddef>
+#include <optional>
+#include <vector>
 
 using namespace osc;
 
@@ -26,3 +35,192 @@ TEST(draw_arrow, generates_nothing_if_length_between_start_and_end_is_zero)
 
     ASSERT_EQ(num_decorations_generated, 0);
 }
+
+TEST(calc_decoration_culling, culls_decorations_that_are_outside_of_the_view_frustum)
+{
+    SceneCache cache;
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}}},
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}, .position = {10.0f, 0.0f, 0.0f}}},
+    };
+    SceneRendererParams params;  // identity view + projection: the frustum is the [-1, 1] cube
+    params.dimensions = {100, 100};
+    params.cull_offscreen_decorations = true;
+
+    std::vector<SceneDecorationCulling> culling;
+    const SceneRendererPassStats stats = calc_decoration_culling(decorations, params, nullptr, culling);
+
+    ASSERT_EQ(culling, std::vector<SceneDecorationCulling>({SceneDecorationCulling::None, SceneDecorationCulling::Frustum}));
+    ASSERT_EQ(stats.num_frustum_culled, 1);
+    ASSERT_EQ(stats.num_small_feature_culled, 0);
+}
+
+TEST(calc_decoration_culling, culls_decorations_that_are_smaller_than_the_small_feature_threshold)
+{
+    SceneCache cache;
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}}},
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.001f}}},  // ~0.2 px on-screen
+    };
+    SceneRendererParams params;
+    params.dimensions = {100, 100};
+    params.small_feature_culling_threshold_in_pixels = 1.0f;
+
+    std::vector<SceneDecorationCulling> culling;
+    const SceneRendererPassStats stats = calc_decoration_culling(decorations, params, nullptr, culling);
+    ASSERT_EQ(culling, std::vector<SceneDecorationCulling>({SceneDecorationCulling::None, SceneDecorationCulling::SmallFeature}));
+    ASSERT_EQ(stats.num_small_feature_culled, 1);
+
+    params.small_feature_culling_threshold_in_pixels = 0.0f;  // disables small feature culling
+    calc_decoration_culling(decorations, params, nullptr, culling);
+    ASSERT_EQ(culling, std::vector<SceneDecorationCulling>(2, SceneDecorationCulling::None));
+}
+
+TEST(calc_decoration_culling, produces_same_result_when_given_a_scene_BVH)
+{
+    SceneCache cache;
+    std::vector<SceneDecoration> decorations;
+    for (int i = -10; i <= 10; ++i) {
+        decorations.push_back({.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.05f}, .position = {0.25f*static_cast<float>(i), 0.0f, 0.0f}}});
+    }
+    BVH bvh;
+    update_scene_bvh(std::span{decorations}.first(15), bvh);  // e.g. overlays are appended after building the BVH
+    SceneRendererParams params;
+    params.dimensions = {100, 100};
+    params.cull_offscreen_decorations = true;
+    params.small_feature_culling_threshold_in_pixels = 1.0f;
+
+    std::vector<SceneDecorationCulling> without_bvh;
+    const SceneRendererPassStats stats_without_bvh = calc_decoration_culling(decorations, params, nullptr, without_bvh);
+    std::vector<SceneDecorationCulling> with_bvh;
+    const SceneRendererPassStats stats_with_bvh = calc_decoration_culling(decorations, params, &bvh, with_bvh);
+
+    ASSERT_EQ(without_bvh, with_bvh);
+    ASSERT_EQ(stats_without_bvh.num_culled(), stats_with_bvh.num_culled());
+    ASSERT_GT(stats_with_bvh.num_frustum_culled, 0);
+}
+
+TEST(calc_decoration_culling, individually_tests_decorations_that_the_scene_BVH_skipped)
+{
+    SceneCache cache;
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.0f}}},  // point bounds: not in the BVH, but on-screen
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}}},
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}, .position = {10.0f, 0.0f, 0.0f}}},
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.0f}, .position = {10.0f, 0.0f, 0.0f}}},  // point bounds: off-screen
+    };
+    BVH bvh;
+    update_scene_bvh(decorations, bvh);
+    ASSERT_EQ(bvh.prims().size(), 2);
+    SceneRendererParams params;
+    params.dimensions = {100, 100};
+    params.cull_offscreen_decorations = true;
+
+    std::vector<SceneDecorationCulling> culling;
+    calc_decoration_culling(decorations, params, &bvh, culling);
+
+    const std::vector<SceneDecorationCulling> expected = {
+        SceneDecorationCulling::None,
+        SceneDecorationCulling::None,
+        SceneDecorationCulling::Frustum,
+        SceneDecorationCulling::Frustum,
+    };
+    ASSERT_EQ(culling, expected);
+}
+
+TEST(calc_decoration_culling, culls_nothing_by_default)
+{
+    SceneCache cache;
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.1f}, .position = {10.0f, 0.0f, 0.0f}}},  // off-screen
+        {.mesh = cache.brick_mesh(), .transform = {.scale = Vec3{0.001f}}},  // sub-pixel
+    };
+    SceneRendererParams params;
+    params.dimensions = {100, 100};
+
+    std::vector<SceneDecorationCulling> culling;
+    const SceneRendererPassStats stats = calc_decoration_culling(decorations, params, nullptr, culling);
+
+    ASSERT_EQ(culling, std::vector<SceneDecorationCulling>(2, SceneDecorationCulling::None));
+    ASSERT_EQ(stats.num_culled(), 0);
+}
+
+TEST(get_closest_ray_collision_with_scene, returns_closest_of_all_ray_collisions_with_scene)
+{
+    SceneCache cache;
+    std::vector<SceneDecoration> decorations;
+    for (int i = 0; i < 10; ++i) {
+        decorations.push_back({.mesh = cache.sphere_mesh(), .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, -static_cast<float>(i)}}});
+    }
+    cache.get_bvh(cache.sphere_mesh());  // ensure triangle tests are used (rather than the AABB fallback)
+    BVH scene_bvh;
+    update_scene_bvh(decorations, scene_bvh);
+    const Line ray = {.origin = {0.1f, 0.1f, 5.0f}, .direction = {0.0f, 0.0f, -1.0f}};
+
+    const std::vector<SceneCollision> all = get_all_ray_collisions_with_scene(scene_bvh, cache, decorations, ray);
+    ASSERT_EQ(all.size(), decorations.size());
+    const SceneCollision* expected = &all.front();
+    for (const SceneCollision& collision : all) {
+        if (collision.distance_from_ray_origin < expected->distance_from_ray_origin) {
+            expected = &collision;
+        }
+    }
+
+    const std::optional<SceneCollision> got = get_closest_ray_collision_with_scene(scene_bvh, cache, decorations, ray);
+    ASSERT_TRUE(got);
+    ASSERT_EQ(got->decoration_index, expected->decoration_index);
+    ASSERT_EQ(got->distance_from_ray_origin, expected->distance_from_ray_origin);
+}
+
+TEST(get_closest_ray_collision_with_scene, skips_decorations_that_are_not_hittable)
+{
+    SceneCache cache;
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.sphere_mesh(), .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, 0.0f}}},
+        {.mesh = cache.sphere_mesh(), .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, -1.0f}}},
+    };
+    BVH scene_bvh;
+    update_scene_bvh(decorations, scene_bvh);
+    const Line ray = {.origin = {0.0f, 0.0f, 5.0f}, .direction = {0.0f, 0.0f, -1.0f}};
+
+    const auto is_hittable = [&decorations](const SceneDecoration& decoration) { return &decoration != &decorations.front(); };
+    const std::optional<SceneCollision> got = get_closest_ray_collision_with_scene(scene_bvh, cache, decorations, ray, is_hittable);
+    ASSERT_TRUE(got);
+    ASSERT_EQ(got->decoration_index, 1);
+}
+
+TEST(get_closest_ray_collision_with_scene, prefers_closer_exact_hit_over_further_decoration_without_hit_test_data)
+{
+    SceneCache cache;
+    const Mesh mesh_without_hit_test_data = SphereGeometry{};  // never seen by the cache before
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = mesh_without_hit_test_data, .transform = {.scale = Vec3{2.0f}, .position = {0.0f, 0.0f, -2.5f}}},
+        {.mesh = cache.sphere_mesh(), .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, 0.0f}}},
+    };
+    cache.get_bvh(cache.sphere_mesh());  // ensure the sphere is hit-tested exactly
+    BVH scene_bvh;
+    update_scene_bvh(decorations, scene_bvh);
+    const Line ray = {.origin = {0.0f, 0.0f, 5.0f}, .direction = {0.0f, 0.0f, -1.0f}};
+
+    const std::optional<SceneCollision> got = get_closest_ray_collision_with_scene(scene_bvh, cache, decorations, ray);
+    ASSERT_TRUE(got);
+    ASSERT_EQ(got->decoration_index, 1);
+}
+
+TEST(get_closest_ray_collision_with_scene, falls_back_to_AABB_hit_for_closer_decoration_without_hit_test_data)
+{
+    SceneCache cache;
+    const Mesh mesh_without_hit_test_data = SphereGeometry{};  // never seen by the cache before
+    const std::vector<SceneDecoration> decorations = {
+        {.mesh = cache.sphere_mesh(), .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, -1.0f}}},
+        {.mesh = mesh_without_hit_test_data, .transform = {.scale = Vec3{0.4f}, .position = {0.0f, 0.0f, 1.0f}}},
+    };
+    cache.get_bvh(cache.sphere_mesh());  // ensure the sphere is hit-tested exactly
+    BVH scene_bvh;
+    update_scene_bvh(decorations, scene_bvh);
+    const Line ray = {.origin = {0.0f, 0.0f, 5.0f}, .direction = {0.0f, 0.0f, -1.0f}};
+
+    const std::optional<SceneCollision> got = get_closest_ray_collision_with_scene(scene_bvh, cache, decorations, ray);
+    ASSERT_TRUE(got);
+    ASSERT_EQ(got->decoration_index, 1);
+}
@@ -0,0 +1,161 @@
+#include <oscar/Graphics/GraphicsContext.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Camera.h>
+#include <oscar/Graphics/Geometries/PlaneGeometry.h>
+#include <oscar/Graphics/Graphics.h>
+#include <oscar/Graphics/GraphicsBackendStats.h>
+#include <oscar/Graphics/GraphicsBackendType.h>
+#include <oscar/Graphics/Material.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Graphics/RenderTexture.h>
+#include <oscar/Graphics/Shader.h>
+#include <oscar/Graphics/ShaderPropertyType.h>
+#include <oscar/Maths/Transform.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/CStringView.h>
+
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+using namespace osc;
+
+// these tests use a recording backend, so that they can run on machines that don't have a GPU
+namespace
+{
+    constexpr CStringView c_instanced_vertex_shader_src = R"(
+        #version 330 core
+
+        uniform mat4 uViewProjMat;
+        uniform vec3 uLightDirs[3];  // arrays should be parsed
+        uniform float uShininess = 8;  // initializers should be ignored
+
+        layout (location = 0) in vec3 aPos;
+        layout (location = 6) in mat4 aModelMat;
+        layout (location = 10) in mat3 aNormalMat;
+
+        void main()
+        {
+            gl_Position = uViewProjMat * aModelMat * vec4(aPos, 1.0);
+        }
+    )";
+
+    constexpr CStringView c_per_instance_vertex_shader_src = R"(
+        #version 330 core
+
+        uniform mat4 uViewProjMat;
+        uniform mat4 uModelMat;
+
+        layout (location = 0) in vec3 aPos;
+
+        void main()
+        {
+            gl_Position = uViewProjMat * uModelMat * vec4(aPos, 1.0);
+        }
+    )";
+
+    constexpr CStringView c_fragment_shader_src = R"(
+        #version 330 core
+
+        uniform vec4 uColor;
+        uniform sampler2D uTexture;
+        // uniform float uCommentedOut;
+
+        out vec4 FragColor;
+
+        void main()
+        {
+            FragColor = uColor;
+        }
+    )";
+
+    // the number of bytes of per-instance data (`aModelMat` + `aNormalMat`) in `c_instanced_vertex_shader_src`
+    constexpr size_t c_instanced_shader_bytes_per_instance = sizeof(float) * (16 + 9);
+}
+
+TEST(GraphicsContext, CanBeConstructedWithARecordingBackend)
+{
+    const GraphicsContext context{GraphicsBackendType::Recording};
+    ASSERT_EQ(context.backend_type(), GraphicsBackendType::Recording);
+    ASSERT_EQ(context.backend_stats(), GraphicsBackendStats{});
+}
+
+TEST(GraphicsContext, ThrowsIfConstructedWithAnOpenGLBackendButNoWindow)
+{
+    ASSERT_THROW({ GraphicsContext context{GraphicsBackendType::OpenGL}; }, std::invalid_argument);
+}
+
+TEST(GraphicsContext, ThrowsIfASecondContextIsConstructed)
+{
+    const GraphicsContext context{GraphicsBackendType::Recording};
+    ASSERT_THROW({ GraphicsContext second{GraphicsBackendType::Recording}; }, std::runtime_error);
+}
+
+TEST(GraphicsContext, RecordingBackendParsesShaderPropertiesFromSourceCode)
+{
+    const GraphicsContext context{GraphicsBackendType::Recording};
+    const Shader shader{c_instanced_vertex_shader_src, c_fragment_shader_src};
+
+    ASSERT_EQ(shader.num_properties(), 5);
+    for (const auto& [name, type] : {
+        std::pair{"uViewProjMat", ShaderPropertyType::Mat4},
+        std::pair{"uLightDirs", ShaderPropertyType::Vec3},
+        std::pair{"uShininess", ShaderPropertyType::Float},
+        std::pair{"uColor", ShaderPropertyType::Vec4},
+        std::pair{"uTexture", ShaderPropertyType::Sampler2D}}) {
+
+        const auto index = shader.property_index(name);
+        ASSERT_TRUE(index.has_value()) << name;
+        ASSERT_EQ(shader.property_type(*index), type) << name;
+    }
+    ASSERT_FALSE(shader.property_index("uCommentedOut"));
+}
+
+TEST(GraphicsContext, RecordingBackendBatchesInstancedDrawsIntoOneDrawCall)
+{
+    GraphicsContext context{GraphicsBackendType::Recording};
+    const Material material{Shader{c_instanced_vertex_shader_src, c_fragment_shader_src}};
+    const Mesh mesh = PlaneGeometry{};
+
+    Camera camera;
+    RenderTexture render_texture;
+    const auto render = [&]()
+    {
+        for (int i = 0; i < 10; ++i) {
+            graphics::draw(mesh, Transform{.position = Vec3{static_cast<float>(i)}}, material, camera);
+        }
+        camera.render_to(render_texture);
+    };
+
+    render();
+    ASSERT_EQ(context.backend_stats().num_render_passes, 1);
+    ASSERT_EQ(context.backend_stats().num_draw_calls, 1);
+    ASSERT_EQ(context.backend_stats().num_instances_drawn, 10);
+    ASSERT_GT(context.backend_stats().num_bytes_uploaded, 10 * c_instanced_shader_bytes_per_instance) << "should also upload the mesh";
+
+    // re-rendering shouldn't re-upload the (unchanged) mesh: only the instance data
+    context.reset_backend_stats();
+    render();
+    ASSERT_EQ(context.backend_stats().num_draw_calls, 1);
+    ASSERT_EQ(context.backend_stats().num_bytes_uploaded, 10 * c_instanced_shader_bytes_per_instance);
+}
+
+TEST(GraphicsContext, RecordingBackendIssuesADrawCallPerInstanceForShadersWithPerInstanceUniforms)
+{
+    GraphicsContext context{GraphicsBackendType::Recording};
+    const Material material{Shader{c_per_instance_vertex_shader_src, c_fragment_shader_src}};
+    const Mesh mesh = PlaneGeometry{};
+
+    Camera camera;
+    for (int i = 0; i < 3; ++i) {
+        graphics::draw(mesh, Transform{.position = Vec3{static_cast<float>(i)}}, material, camera);
+    }
+    RenderTexture render_texture;
+    camera.render_to(render_texture);
+
+    ASSERT_EQ(context.backend_stats().num_draw_calls, 3);
+    ASSERT_EQ(context.backend_stats().num_instances_drawn, 3);
+    ASSERT_EQ(context.backend_stats().num_uniforms_set, 1 + 3) << "should set `uViewProjMat` once, and `uModelMat` per instance";
+}
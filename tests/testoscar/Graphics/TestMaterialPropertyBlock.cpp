@@ -11,6 +11,7 @@
 #include <oscar/Maths/Mat4.h>
 #include <oscar/Utils/StringHelpers.h>
 
+#include <functional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -317,3 +318,34 @@ TEST(MaterialPropertyBlock, MaterialPropertyBlockPrintingToOutputStreamMentionsM
 
     ASSERT_TRUE(contains(ss.str(), "MaterialPropertyBlock"));
 }
+
+TEST(MaterialPropertyBlock, IndependentlyConstructedEqualBlocksHaveTheSameHash)
+{
+    const Color color = generate<Color>();
+    const float value = generate<float>();
+    const Texture2D texture = generate_red_texture();
+
+    MaterialPropertyBlock m1;
+    m1.set<Color>("color", color);
+    m1.set<float>("value", value);
+    m1.set<Texture2D>("texture", texture);
+
+    // set in a different order, so that the block's internal ordering may differ
+    MaterialPropertyBlock m2;
+    m2.set<Texture2D>("texture", texture);
+    m2.set<float>("value", value);
+    m2.set<Color>("color", color);
+
+    ASSERT_EQ(m1, m2);
+    ASSERT_EQ(std::hash<MaterialPropertyBlock>{}(m1), std::hash<MaterialPropertyBlock>{}(m2));
+}
+
+TEST(MaterialPropertyBlock, BlocksWithDifferentValuesTypicallyHaveDifferentHashes)
+{
+    MaterialPropertyBlock m1;
+    m1.set<Color>("color", Color::red());
+    MaterialPropertyBlock m2;
+    m2.set<Color>("color", Color::blue());
+
+    ASSERT_NE(std::hash<MaterialPropertyBlock>{}(m1), std::hash<MaterialPropertyBlock>{}(m2));
+}
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 #include <oscar/Graphics/Color.h>
+#include <oscar/Graphics/MeshAttributeView.h>
 #include <oscar/Graphics/MeshTopology.h>
 #include <oscar/Graphics/SubMeshDescriptor.h>
 #include <oscar/Graphics/VertexFormat.h>
@@ -2099,3 +2100,173 @@ TEST(Mesh, recalculate_tangents_gives_expected_results_in_basic_case)
     ASSERT_EQ(tangents.at(1), Vec4(1.0f, 0.0f, 0.0f, 0.0f));
     ASSERT_EQ(tangents.at(2), Vec4(1.0f, 0.0f, 0.0f, 0.0f));
 }
+
+TEST(Mesh, recalculate_normals_on_a_large_mesh_gives_same_results_as_a_serial_calculation)
+{
+    // this mesh is large enough that the calculation is split across threads, so this checks
+    // that the split doesn't change the result (e.g. by summing normals in a different order)
+
+    constexpr size_t grid_size = 256;
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_real_distribution<float> height_dist{-0.5f, 0.5f};
+
+    std::vector<Vec3> vertices;
+    for (size_t row = 0; row < grid_size; ++row) {
+        for (size_t col = 0; col < grid_size; ++col) {
+            vertices.emplace_back(static_cast<float>(col), height_dist(rng), static_cast<float>(row));
+        }
+    }
+    std::vector<uint32_t> indices;
+    for (size_t row = 0; row < grid_size-1; ++row) {
+        for (size_t col = 0; col < grid_size-1; ++col) {
+            const auto i = static_cast<uint32_t>(row*grid_size + col);
+            const auto below = static_cast<uint32_t>(i + grid_size);
+            indices.insert(indices.end(), {i, below, i+1,  i+1, below, below+1});
+        }
+    }
+    indices.insert(indices.end(), {0, 0, 0});  // degenerate triangles shouldn't contribute
+
+    // serially sum each triangle's normal into its vertices
+    std::vector<Vec3> expected(vertices.size());
+    std::vector<size_t> counts(vertices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const Vec3 normal = triangle_normal(Triangle{vertices[indices[i]], vertices[indices[i+1]], vertices[indices[i+2]]}).unwrap();
+        if (any_of(isnan(normal))) {
+            continue;
+        }
+        for (size_t j = i; j < i+3; ++j) {
+            expected[indices[j]] = counts[indices[j]]++ == 0 ? normal : expected[indices[j]] + normal;
+        }
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (counts[i] > 1) {
+            expected[i] = normalize(expected[i]);
+        }
+    }
+
+    Mesh mesh;
+    mesh.set_vertices(vertices);
+    mesh.set_indices(indices);
+    mesh.recalculate_normals();
+
+    ASSERT_EQ(mesh.normals(), expected);
+}
+
+TEST(Mesh, recalculate_normals_uses_edited_vertices)
+{
+    const auto vertices = generate_vertices(30);
+
+    Mesh mesh;
+    mesh.set_vertices(vertices);
+    mesh.set_indices(iota_index_range(0, 30));
+    mesh.recalculate_normals();
+
+    // warp the vertices in-place, which keeps the mesh's indices (topology)
+    std::vector<Vec3> warped_vertices;
+    {
+        const MeshAttributeEdit<Vec3> edit = mesh.edit_vertices();
+        for (Vec3& vertex : edit) {
+            vertex = Vec3{vertex.z, 2.0f*vertex.x, vertex.y};
+            warped_vertices.push_back(vertex);
+        }
+    }
+    mesh.recalculate_normals();
+
+    Mesh expected;
+    expected.set_vertices(warped_vertices);
+    expected.set_indices(iota_index_range(0, 30));
+    expected.recalculate_normals();
+
+    ASSERT_EQ(mesh.normals(), expected.normals());
+}
+
+TEST(Mesh, recalculate_tangents_uses_new_indices_after_indices_are_reassigned)
+{
+    Mesh mesh;
+    mesh.set_vertices(generate_vertices(6));
+    mesh.set_normals(generate_normals(6));
+    mesh.set_tex_coords(generate_texture_coordinates(6));
+    mesh.set_indices({0, 1, 2,  3, 4, 5});
+    mesh.recalculate_tangents();
+
+    mesh.set_indices({0, 2, 4,  1, 3, 5});  // same number of indices, different topology
+    mesh.recalculate_tangents();
+
+    Mesh expected;
+    expected.set_vertices(mesh.vertices());
+    expected.set_normals(mesh.normals());
+    expected.set_tex_coords(mesh.tex_coords());
+    expected.set_indices({0, 2, 4,  1, 3, 5});
+    expected.recalculate_tangents();
+
+    ASSERT_EQ(mesh.tangents(), expected.tangents());
+}
+
+TEST(Mesh, vertices_view_is_empty_on_default_construction)
+{
+    ASSERT_TRUE(Mesh{}.vertices_view().empty());
+}
+
+TEST(Mesh, vertices_view_and_normals_view_return_same_values_as_copying_accessors)
+{
+    const auto verts = generate_vertices(9);
+    const auto normals = generate_normals(9);
+
+    Mesh m;
+    m.set_vertices(verts);
+    m.set_normals(normals);  // i.e. the vertex buffer is interleaved
+
+    const MeshAttributeView<Vec3> vertices_view = m.vertices_view();
+    ASSERT_EQ(vertices_view.stride(), 2*sizeof(Vec3));
+    ASSERT_EQ(std::vector<Vec3>(vertices_view.begin(), vertices_view.end()), verts);
+
+    const MeshAttributeView<Vec3> normals_view = m.normals_view();
+    ASSERT_EQ(std::vector<Vec3>(normals_view.begin(), normals_view.end()), m.normals());
+}
+
+TEST(Mesh, vertices_view_decodes_vertices_that_are_not_stored_as_Float32x3)
+{
+    const auto verts = generate_vertices(6);
+
+    Mesh m;
+    m.set_vertices(verts);
+    m.set_vertex_buffer_params(6, {
+        {VertexAttribute::Position, VertexAttributeFormat::Float32x4}
+    });
+
+    const MeshAttributeView<Vec3> view = m.vertices_view();
+    ASSERT_EQ(std::vector<Vec3>(view.begin(), view.end()), verts);
+}
+
+TEST(Mesh, edit_vertices_writes_vertices_in_place_and_recalculates_bounds_once_edit_ends)
+{
+    Mesh m;
+    m.set_vertices({Vec3{0.0f}, Vec3{1.0f}, Vec3{2.0f}});
+    m.set_normals({Vec3{0.0f, 1.0f, 0.0f}, Vec3{0.0f, 1.0f, 0.0f}, Vec3{0.0f, 1.0f, 0.0f}});
+    m.set_indices({0, 1, 2});
+
+    {
+        const MeshAttributeEdit<Vec3> vertices = m.edit_vertices();
+        ASSERT_EQ(vertices.size(), 3);
+        for (Vec3& vertex : vertices) {
+            vertex *= 2.0f;
+        }
+    }
+
+    ASSERT_EQ(m.vertices(), std::vector<Vec3>({Vec3{0.0f}, Vec3{2.0f}, Vec3{4.0f}}));
+    ASSERT_EQ(m.normals(), std::vector<Vec3>(3, Vec3{0.0f, 1.0f, 0.0f})) << "interleaved attributes shouldn't be affected";
+    ASSERT_EQ(m.bounds(), (AABB{.min = Vec3{0.0f}, .max = Vec3{4.0f}}));
+}
+
+TEST(Mesh, edit_vertices_does_not_affect_copies_of_the_mesh)
+{
+    Mesh m;
+    m.set_vertices({Vec3{1.0f}});
+    const Mesh copy = m;
+
+    m.edit_vertices()[0] = Vec3{2.0f};
+
+    ASSERT_EQ(m.vertices(), std::vector<Vec3>({Vec3{2.0f}}));
+    ASSERT_EQ(copy.vertices(), std::vector<Vec3>({Vec3{1.0f}}));
+    ASSERT_NE(m, copy);
+}
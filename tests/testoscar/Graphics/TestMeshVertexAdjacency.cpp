@@ -0,0 +1,65 @@
+#include <oscar/Graphics/MeshVertexAdjacency.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/MeshIndicesView.h>
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<uint32_t> to_vector(std::span<const uint32_t> corners)
+    {
+        return std::vector<uint32_t>(corners.begin(), corners.end());
+    }
+}
+
+TEST(MeshVertexAdjacency, default_constructed_has_no_vertices_or_indices)
+{
+    const MeshVertexAdjacency adjacency;
+    ASSERT_EQ(adjacency.num_vertices(), 0);
+    ASSERT_EQ(adjacency.num_indices(), 0);
+}
+
+TEST(MeshVertexAdjacency, corners_of_returns_offsets_of_indices_that_reference_the_vertex_in_ascending_order)
+{
+    const auto indices = std::to_array<uint16_t>({2, 0, 1,  1, 2, 3,  3, 2, 0});
+    const MeshVertexAdjacency adjacency{indices, 5};
+
+    ASSERT_EQ(adjacency.num_vertices(), 5);
+    ASSERT_EQ(adjacency.num_indices(), indices.size());
+    ASSERT_EQ(to_vector(adjacency.corners_of(0)), std::vector<uint32_t>({1, 8}));
+    ASSERT_EQ(to_vector(adjacency.corners_of(1)), std::vector<uint32_t>({2, 3}));
+    ASSERT_EQ(to_vector(adjacency.corners_of(2)), std::vector<uint32_t>({0, 4, 7}));
+    ASSERT_EQ(to_vector(adjacency.corners_of(3)), std::vector<uint32_t>({5, 6}));
+    ASSERT_TRUE(adjacency.corners_of(4).empty()) << "unreferenced vertices have no corners";
+}
+
+TEST(MeshVertexAdjacency, works_with_32_bit_indices)
+{
+    const auto indices = std::to_array<uint32_t>({0, 70000, 1});
+    const MeshVertexAdjacency adjacency{indices, 70001};
+
+    ASSERT_EQ(to_vector(adjacency.corners_of(70000)), std::vector<uint32_t>({1}));
+}
+
+TEST(MeshVertexAdjacency, ignores_trailing_indices_that_do_not_form_a_triangle)
+{
+    const auto indices = std::to_array<uint16_t>({0, 1, 2,  0, 3});
+    const MeshVertexAdjacency adjacency{indices, 4};
+
+    ASSERT_EQ(adjacency.num_indices(), indices.size());
+    ASSERT_EQ(to_vector(adjacency.corners_of(0)), std::vector<uint32_t>({0}));
+    ASSERT_TRUE(adjacency.corners_of(3).empty());
+}
+
+TEST(MeshVertexAdjacency, throws_if_an_index_is_out_of_range)
+{
+    const auto indices = std::to_array<uint16_t>({0, 1, 3});
+    ASSERT_THROW({ [[maybe_unused]] const MeshVertexAdjacency adjacency(indices, 3); }, std::out_of_range);
+}
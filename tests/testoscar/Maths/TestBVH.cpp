@@ -1,8 +1,67 @@
 #include <oscar/Maths/BVH.h>
 
+#include <testoscar/TestingHelpers.h>
+
 #include <gtest/gtest.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/CollisionTests.h>
+#include <oscar/Maths/FrustumPlanes.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Line.h>
+#include <oscar/Maths/PlaneFunctions.h>
+#include <oscar/Maths/Triangle.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar/Utils/ThreadPool.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <vector>
 
 using namespace osc;
+using namespace osc::testing;
+
+namespace
+{
+    std::vector<uint32_t> iota_uint32_indices(size_t n)
+    {
+        std::vector<uint32_t> rv(n);
+        std::iota(rv.begin(), rv.end(), 0);
+        return rv;
+    }
+
+    // returns a ray that starts outside of the unit cube and points at a random location within it
+    Line generate_ray_into_unit_cube()
+    {
+        const Vec3 origin = 4.0f*generate<Vec3>() - 2.0f;
+        const Vec3 target = generate<Vec3>();
+        return Line{.origin = origin, .direction = normalize(target - origin)};
+    }
+
+    // returns the closest collision by brute-force testing every triangle
+    std::optional<BVHCollision> brute_force_closest_collision(
+        const std::vector<Vec3>& vertices,
+        const std::vector<uint32_t>& indices,
+        const Line& ray)
+    {
+        std::optional<BVHCollision> rv;
+        for (size_t i = 0; i+2 < indices.size(); i += 3) {
+            const Triangle triangle{vertices[indices[i]], vertices[indices[i+1]], vertices[indices[i+2]]};
+            if (const auto collision = find_collision(ray, triangle)) {
+                if (not rv or collision->distance < rv->distance) {
+                    rv = BVHCollision{collision->distance, collision->position, static_cast<ptrdiff_t>(i)};
+                }
+            }
+        }
+        return rv;
+    }
+}
 
 TEST(BVH, GetMaxDepthReturns0OnDefaultConstruction)
 {
@@ -10,3 +69,396 @@ TEST(BVH, GetMaxDepthReturns0OnDefaultConstruction)
 
     ASSERT_EQ(bvh.max_depth(), 0);
 }
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionReturnsNulloptOnDefaultConstruction)
+{
+    const std::vector<Vec3> vertices = generate_vertices(3);
+    const std::vector<uint32_t> indices = iota_uint32_indices(3);
+
+    BVH bvh;
+
+    ASSERT_FALSE(bvh.closest_ray_indexed_triangle_collision(vertices, indices, Line{}));
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionReturnsNulloptIfRayMissesEverything)
+{
+    const std::vector<Vec3> vertices = generate_vertices(300);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    BVH bvh;
+    bvh.build_from_indexed_triangles(vertices, indices);
+
+    const Line ray_pointing_away{.origin = {2.0f, 2.0f, 2.0f}, .direction = {1.0f, 0.0f, 0.0f}};
+    ASSERT_FALSE(bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray_pointing_away));
+}
+
+TEST(BVH, ClosestRayIndexedTriangleCollisionReturnsSameResultAsBruteForce)
+{
+    const std::vector<Vec3> vertices = generate_vertices(3*500);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    BVH bvh;
+    bvh.build_from_indexed_triangles(vertices, indices);
+
+    size_t num_hits = 0;
+    for (size_t i = 0; i < 200; ++i) {
+        const Line ray = generate_ray_into_unit_cube();
+        const std::optional<BVHCollision> expected = brute_force_closest_collision(vertices, indices, ray);
+        const std::optional<BVHCollision> got = bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+
+        ASSERT_EQ(expected.has_value(), got.has_value());
+        if (expected) {
+            ASSERT_EQ(got->distance, expected->distance);
+            ASSERT_EQ(got->position, expected->position);
+            ASSERT_EQ(got->id, expected->id);
+            ++num_hits;
+        }
+    }
+    ASSERT_GT(num_hits, 0) << "the test should exercise at least some hits";
+}
+
+TEST(BVH, ClosestRayCollisionReturnsSameResultAsBruteForceWhenTestingTrianglesInAnAABBBVH)
+{
+    const std::vector<Vec3> vertices = generate_vertices(3*300);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    // e.g. like a scene BVH, where each `AABB` bounds something that needs further testing
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i+2 < vertices.size(); i += 3) {
+        aabbs.push_back(bounding_aabb_of(Triangle{vertices[i], vertices[i+1], vertices[i+2]}));
+    }
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+
+    size_t num_hits = 0;
+    for (size_t i = 0; i < 200; ++i) {
+        const Line ray = generate_ray_into_unit_cube();
+        const std::optional<BVHCollision> expected = brute_force_closest_collision(vertices, indices, ray);
+        const std::optional<BVHCollision> got = bvh.closest_ray_collision(ray, [&vertices, &ray](const BVHCollision& aabb_collision)
+        {
+            const auto first_vertex = static_cast<size_t>(3*aabb_collision.id);
+            return find_collision(ray, Triangle{vertices[first_vertex], vertices[first_vertex+1], vertices[first_vertex+2]});
+        });
+
+        ASSERT_EQ(expected.has_value(), got.has_value());
+        if (expected) {
+            ASSERT_EQ(got->distance, expected->distance);
+            ASSERT_EQ(3*got->id, expected->id);
+            ++num_hits;
+        }
+    }
+    ASSERT_GT(num_hits, 0) << "the test should exercise at least some hits";
+}
+
+TEST(BVH, ClosestRayCollisionReturnsNulloptIfTestPrimNeverReportsACollision)
+{
+    const std::vector<AABB> aabbs(10, AABB{.min = Vec3{-1.0f}, .max = Vec3{1.0f}});
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+
+    size_t num_calls = 0;
+    const auto rv = bvh.closest_ray_collision(Line{.origin = {0.0f, -5.0f, 0.0f}, .direction = {0.0f, 1.0f, 0.0f}}, [&num_calls](const BVHCollision&)
+    {
+        ++num_calls;
+        return std::optional<RayCollision>{};
+    });
+
+    ASSERT_FALSE(rv);
+    ASSERT_EQ(num_calls, aabbs.size()) << "every hit AABB should be tested if nothing is ever reported";
+}
+
+TEST(BVH, BuildStrategyIsDefaultOnDefaultConstruction)
+{
+    ASSERT_EQ(BVH{}.build_strategy(), BVHBuildStrategy::Default);
+}
+
+TEST(BVH, BuildStrategyCanBeSetViaConstructor)
+{
+    ASSERT_EQ(BVH{BVHBuildStrategy::BinnedSAH}.build_strategy(), BVHBuildStrategy::BinnedSAH);
+}
+
+TEST(BVH, MidpointAndBinnedSAHBuildsContainTheSameNumberOfNodes)
+{
+    const std::vector<Vec3> vertices = generate_vertices(3*500);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    std::array<size_t, 2> num_nodes{};
+    for (BVHBuildStrategy strategy : {BVHBuildStrategy::Midpoint, BVHBuildStrategy::BinnedSAH}) {
+        BVH bvh{strategy};
+        bvh.build_from_indexed_triangles(vertices, indices);
+        bvh.for_each_leaf_or_inner_node([&num_nodes, strategy](const BVHNode&) { ++num_nodes[strategy == BVHBuildStrategy::BinnedSAH]; });
+    }
+
+    ASSERT_EQ(num_nodes[0], 2*500 - 1) << "each leaf should contain one triangle";
+    ASSERT_EQ(num_nodes[0], num_nodes[1]);
+}
+
+TEST(BVH, BinnedSAHClosestRayIndexedTriangleCollisionReturnsSameDistanceAsBruteForce)
+{
+    // large enough to exercise the parallel build
+    const std::vector<Vec3> vertices = generate_vertices(3*20000);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    BVH bvh{BVHBuildStrategy::BinnedSAH};
+    bvh.build_from_indexed_triangles(vertices, indices);
+
+    for (size_t i = 0; i < 50; ++i) {
+        const Line ray = generate_ray_into_unit_cube();
+        const std::optional<BVHCollision> expected = brute_force_closest_collision(vertices, indices, ray);
+        const std::optional<BVHCollision> got = bvh.closest_ray_indexed_triangle_collision(vertices, indices, ray);
+
+        ASSERT_EQ(expected.has_value(), got.has_value());
+        if (expected) {
+            ASSERT_EQ(got->distance, expected->distance);
+        }
+    }
+}
+
+TEST(BVH, BuildFromIndexedTrianglesWithNonContiguousVerticesProducesTheSameResultAsContiguousVertices)
+{
+    struct Vertex final {
+        Vec3 position;
+        Vec3 normal;
+    };
+
+    const std::vector<Vec3> vertices = generate_vertices(3*500);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    // interleave the vertices with other data (like a mesh's vertex buffer)
+    std::vector<Vertex> interleaved;
+    for (const Vec3& vertex : vertices) {
+        interleaved.push_back({.position = vertex, .normal = generate<Vec3>()});
+    }
+    const auto positions = interleaved | std::views::transform([](const Vertex& v) { return v.position; });
+
+    BVH expected{BVHBuildStrategy::BinnedSAH};
+    expected.build_from_indexed_triangles(vertices, indices);
+    BVH got{BVHBuildStrategy::BinnedSAH};
+    got.build_from_indexed_triangles(positions, std::span<const uint32_t>{indices});
+
+    ASSERT_EQ(got.nodes().size(), expected.nodes().size());
+    for (size_t i = 0; i < got.nodes().size(); ++i) {
+        ASSERT_EQ(got.nodes()[i].bounds(), expected.nodes()[i].bounds());
+    }
+    ASSERT_EQ(got.prims().size(), expected.prims().size());
+    for (size_t i = 0; i < got.prims().size(); ++i) {
+        ASSERT_EQ(got.prims()[i].id(), expected.prims()[i].id());
+    }
+}
+
+TEST(BVH, BinnedSAHBuildHandlesPrimsWithIdenticalCentroids)
+{
+    // edge-case: the SAH builder can't find a split plane when all centroids are equal
+    const std::vector<AABB> aabbs(100, AABB{.min = Vec3{-1.0f}, .max = Vec3{1.0f}});
+
+    BVH bvh{BVHBuildStrategy::BinnedSAH};
+    bvh.build_from_aabbs(aabbs);
+
+    size_t num_collisions = 0;
+    bvh.for_each_ray_aabb_collision(Line{.origin = {0.0f, -5.0f, 0.0f}, .direction = {0.0f, 1.0f, 0.0f}}, [&num_collisions](BVHCollision)
+    {
+        ++num_collisions;
+    });
+    ASSERT_EQ(num_collisions, aabbs.size());
+}
+
+TEST(BVH, ForEachRayAABBCollisionEmitsSameAABBsAsBruteForce)
+{
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 500; ++i) {
+        const Vec3 p = generate<Vec3>();
+        aabbs.push_back(AABB{.min = p, .max = p + 0.1f*generate<Vec3>()});
+    }
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+
+    for (size_t i = 0; i < 100; ++i) {
+        const Line ray = generate_ray_into_unit_cube();
+
+        std::set<ptrdiff_t> expected;
+        for (size_t j = 0; j < aabbs.size(); ++j) {
+            if (find_collision(ray, aabbs[j])) {
+                expected.insert(static_cast<ptrdiff_t>(j));
+            }
+        }
+
+        std::set<ptrdiff_t> got;
+        bvh.for_each_ray_aabb_collision(ray, [&got](BVHCollision collision)
+        {
+            ASSERT_TRUE(got.insert(collision.id).second) << "each AABB should only be emitted once";
+        });
+
+        ASSERT_EQ(got, expected);
+    }
+}
+
+TEST(BVH, ForEachRayAABBCollisionWorksWhenBVHContainsOneAABB)
+{
+    const AABB aabb{.min = Vec3{-1.0f}, .max = Vec3{1.0f}};
+
+    BVH bvh;
+    bvh.build_from_aabbs({{aabb}});
+
+    size_t num_collisions = 0;
+    bvh.for_each_ray_aabb_collision(Line{.origin = {0.0f, -5.0f, 0.0f}, .direction = {0.0f, 1.0f, 0.0f}}, [&num_collisions](BVHCollision collision)
+    {
+        ASSERT_EQ(collision.id, 0);
+        ASSERT_EQ(collision.distance, 4.0f);
+        ++num_collisions;
+    });
+    ASSERT_EQ(num_collisions, 1);
+}
+
+TEST(BVH, ForEachFrustumAABBCollisionEmitsSameAABBsAsBruteForce)
+{
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 500; ++i) {
+        const Vec3 p = generate<Vec3>();
+        aabbs.push_back(AABB{.min = p, .max = p + 0.1f*generate<Vec3>()});
+    }
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+
+    // a box-shaped "frustum" that contains some, but not all, of the AABBs
+    const FrustumPlanes frustum = {
+        to_analytic_plane(Vec3{0.0f, 0.0f, 0.3f}, Vec3{ 0.0f,  0.0f, -1.0f}),
+        to_analytic_plane(Vec3{0.0f, 0.0f, 0.7f}, Vec3{ 0.0f,  0.0f,  1.0f}),
+        to_analytic_plane(Vec3{0.6f, 0.0f, 0.0f}, Vec3{ 1.0f,  0.0f,  0.0f}),
+        to_analytic_plane(Vec3{0.2f, 0.0f, 0.0f}, Vec3{-1.0f,  0.0f,  0.0f}),
+        to_analytic_plane(Vec3{0.0f, 0.8f, 0.0f}, Vec3{ 0.0f,  1.0f,  0.0f}),
+        to_analytic_plane(Vec3{0.0f, 0.1f, 0.0f}, Vec3{ 0.0f, -1.0f,  0.0f}),
+    };
+
+    std::set<ptrdiff_t> expected;
+    for (size_t i = 0; i < aabbs.size(); ++i) {
+        if (is_intersecting(frustum, aabbs[i])) {
+            expected.insert(static_cast<ptrdiff_t>(i));
+        }
+    }
+
+    std::set<ptrdiff_t> got;
+    bvh.for_each_frustum_aabb_collision(frustum, [&got](const BVHPrim& prim)
+    {
+        ASSERT_TRUE(got.insert(prim.id()).second) << "each AABB should only be emitted once";
+    });
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_LT(expected.size(), aabbs.size());
+    ASSERT_EQ(got, expected);
+}
+
+TEST(BVH, ForEachFrustumAABBCollisionEmitsNothingForEmptyBVH)
+{
+    const BVH bvh;
+    size_t num_collisions = 0;
+    bvh.for_each_frustum_aabb_collision(FrustumPlanes{}, [&num_collisions](const BVHPrim&) { ++num_collisions; });
+    ASSERT_EQ(num_collisions, 0);
+}
+
+TEST(BVH, RefitFromAABBsEmitsSameAABBsAsBruteForceAfterTheAABBsMove)
+{
+    std::vector<AABB> aabbs;
+    for (size_t i = 0; i < 500; ++i) {
+        const Vec3 p = generate<Vec3>();
+        aabbs.push_back(AABB{.min = p, .max = p + 0.1f*generate<Vec3>()});
+    }
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+    const size_t num_nodes = bvh.nodes().size();
+
+    for (AABB& aabb : aabbs) {
+        const Vec3 offset = 0.2f*generate<Vec3>() - 0.1f;
+        aabb.min += offset;
+        aabb.max += offset;
+    }
+    ASSERT_TRUE(bvh.refit_from_aabbs(aabbs));
+    ASSERT_EQ(bvh.nodes().size(), num_nodes) << "refitting shouldn't change the structure of the hierarchy";
+    ASSERT_EQ(bvh.bounds(), bounding_aabb_of(aabbs, std::identity{}));
+
+    for (size_t i = 0; i < 100; ++i) {
+        const Line ray = generate_ray_into_unit_cube();
+
+        std::set<ptrdiff_t> expected;
+        for (size_t j = 0; j < aabbs.size(); ++j) {
+            if (find_collision(ray, aabbs[j])) {
+                expected.insert(static_cast<ptrdiff_t>(j));
+            }
+        }
+
+        std::set<ptrdiff_t> got;
+        bvh.for_each_ray_aabb_collision(ray, [&got](BVHCollision collision)
+        {
+            ASSERT_TRUE(got.insert(collision.id).second) << "each AABB should only be emitted once";
+        });
+
+        ASSERT_EQ(got, expected);
+    }
+}
+
+TEST(BVH, RefitFromAABBsReturnsFalseAndDoesNothingIfTheNumberOfAABBsChanged)
+{
+    std::vector<AABB> aabbs = {
+        AABB{.min = Vec3{0.0f}, .max = Vec3{1.0f}},
+        AABB{.min = Vec3{2.0f}, .max = Vec3{3.0f}},
+    };
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+
+    aabbs.pop_back();
+    ASSERT_FALSE(bvh.refit_from_aabbs(aabbs));
+    ASSERT_EQ(bvh.bounds(), (AABB{.min = Vec3{0.0f}, .max = Vec3{3.0f}}));
+    ASSERT_EQ(bvh.prims().size(), 2);
+}
+
+TEST(BVH, RefitFromAABBsReturnsFalseIfAPreviouslySkippedPointAABBIsNoLongerAPoint)
+{
+    std::vector<AABB> aabbs = {
+        AABB{.min = Vec3{0.0f}, .max = Vec3{1.0f}},
+        AABB{.min = Vec3{2.0f}, .max = Vec3{2.0f}},  // point: skipped by the build
+    };
+
+    BVH bvh;
+    bvh.build_from_aabbs(aabbs);
+    ASSERT_EQ(bvh.prims().size(), 1);
+
+    aabbs[1].max = Vec3{3.0f};
+    ASSERT_FALSE(bvh.refit_from_aabbs(aabbs));
+}
+
+TEST(BVH, BuildingLargeSAHHierarchiesFromWithinTheGlobalThreadPoolProducesTheSameResultAsBuildingThemOnTheCallingThread)
+{
+    // large enough that the builder builds subtrees as separate tasks on the global pool
+    const std::vector<Vec3> vertices = generate_vertices(3*50000);
+    const std::vector<uint32_t> indices = iota_uint32_indices(vertices.size());
+
+    BVH expected{BVHBuildStrategy::BinnedSAH};
+    expected.build_from_indexed_triangles(vertices, indices);
+
+    // saturate the pool with builds, so that nested builds can't rely on free pool threads
+    std::vector<std::future<BVH>> builds;
+    for (size_t i = 0; i < 2*ThreadPool::global().num_threads(); ++i) {
+        builds.push_back(ThreadPool::global().submit([&vertices, &indices]()
+        {
+            BVH bvh{BVHBuildStrategy::BinnedSAH};
+            bvh.build_from_indexed_triangles(vertices, indices);
+            return bvh;
+        }));
+    }
+
+    for (std::future<BVH>& build : builds) {
+        const BVH bvh = build.get();
+        ASSERT_EQ(bvh.max_depth(), expected.max_depth());
+        ASSERT_EQ(bvh.nodes().size(), expected.nodes().size());
+        for (size_t i = 0; i < bvh.nodes().size(); ++i) {
+            ASSERT_EQ(bvh.nodes()[i].bounds(), expected.nodes()[i].bounds());
+        }
+        ASSERT_EQ(bvh.prims().size(), expected.prims().size());
+        for (size_t i = 0; i < bvh.prims().size(); ++i) {
+            ASSERT_EQ(bvh.prims()[i].id(), expected.prims()[i].id());
+        }
+    }
+}
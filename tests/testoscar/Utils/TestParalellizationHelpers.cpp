@@ -0,0 +1,77 @@
+#include <oscar/Utils/ParalellizationHelpers.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Utils/ThreadPool.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+TEST(for_each_chunk_parallel, does_nothing_when_given_an_empty_range)
+{
+    ThreadPool pool{2};
+    size_t num_calls = 0;
+    for_each_chunk_parallel(pool, 1, 0, [&num_calls](size_t, size_t) { ++num_calls; });
+    ASSERT_EQ(num_calls, 0);
+}
+
+TEST(for_each_chunk_parallel, visits_each_index_exactly_once)
+{
+    ThreadPool pool{4};
+    std::vector<std::atomic<int>> visits(10007);
+    for_each_chunk_parallel(pool, 16, visits.size(), [&visits](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+
+    for (const auto& num_visits : visits) {
+        ASSERT_EQ(num_visits, 1);
+    }
+}
+
+TEST(for_each_chunk_parallel, respects_min_chunk_size)
+{
+    ThreadPool pool{4};
+    std::atomic<size_t> smallest_non_final_chunk = 1000;
+    for_each_chunk_parallel(pool, 100, 1000, [&](size_t begin, size_t end)
+    {
+        if (end != 1000) {
+            size_t current = smallest_non_final_chunk;
+            while (end - begin < current and not smallest_non_final_chunk.compare_exchange_weak(current, end - begin)) {}
+        }
+    });
+    ASSERT_GE(smallest_non_final_chunk, 100);
+}
+
+TEST(for_each_chunk_parallel, rethrows_exceptions_thrown_by_the_callback)
+{
+    ThreadPool pool{2};
+    const auto throwing_callback = [](size_t begin, size_t)
+    {
+        if (begin == 0) {
+            throw std::runtime_error{"some error"};
+        }
+    };
+    ASSERT_THROW({ for_each_chunk_parallel(pool, 1, 100, throwing_callback); }, std::runtime_error);
+}
+
+TEST(for_each_chunk_parallel, can_be_nested_within_tasks_on_the_same_pool)
+{
+    ThreadPool pool{2};
+    std::atomic<size_t> num_visits = 0;
+    for_each_chunk_parallel(pool, 1, 8, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i) {
+            for_each_chunk_parallel(pool, 1, 8, [&num_visits](size_t inner_begin, size_t inner_end)
+            {
+                num_visits += inner_end - inner_begin;
+            });
+        }
+    });
+    ASSERT_EQ(num_visits, 64);
+}
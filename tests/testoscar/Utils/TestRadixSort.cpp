@@ -0,0 +1,94 @@
+#include <oscar/Utils/RadixSort.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    // a key + the element's original position, so that stability can be tested
+    struct KeyedElement final {
+        uint64_t key = 0;
+        size_t original_index = 0;
+
+        friend bool operator==(const KeyedElement&, const KeyedElement&) = default;
+    };
+
+    std::vector<KeyedElement> generate_keyed_elements(size_t n, uint64_t key_mask)
+    {
+        std::mt19937_64 engine{};  // default-seeded, so the test is deterministic
+        std::uniform_int_distribution<uint64_t> dist;
+
+        std::vector<KeyedElement> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.push_back({dist(engine) & key_mask, i});
+        }
+        return rv;
+    }
+
+    std::vector<KeyedElement> stable_sorted(std::vector<KeyedElement> els)
+    {
+        std::ranges::stable_sort(els, std::ranges::less{}, &KeyedElement::key);
+        return els;
+    }
+}
+
+TEST(radix_sort, DoesNothingToAnEmptyRange)
+{
+    std::vector<KeyedElement> els;
+    radix_sort(els, [](const KeyedElement& el) { return el.key; });
+    ASSERT_TRUE(els.empty());
+}
+
+TEST(radix_sort, ProducesSameResultAsStableSort)
+{
+    std::vector<KeyedElement> els = generate_keyed_elements(10000, ~uint64_t{0});
+    const std::vector<KeyedElement> expected = stable_sorted(els);
+
+    radix_sort(els, [](const KeyedElement& el) { return el.key; });
+
+    ASSERT_EQ(els, expected);
+}
+
+TEST(radix_sort, IsStableWhenManyKeysAreEqual)
+{
+    // only a few distinct keys, so that most elements compare equal
+    std::vector<KeyedElement> els = generate_keyed_elements(10000, 0x3);
+    const std::vector<KeyedElement> expected = stable_sorted(els);
+
+    radix_sort(els, [](const KeyedElement& el) { return el.key; });
+
+    ASSERT_EQ(els, expected);
+}
+
+TEST(radix_sort, HandlesKeysThatOnlyDifferInTheirMostSignificantBits)
+{
+    std::vector<KeyedElement> els = generate_keyed_elements(1000, uint64_t{0xff} << 56);
+    const std::vector<KeyedElement> expected = stable_sorted(els);
+
+    radix_sort(els, [](const KeyedElement& el) { return el.key; });
+
+    ASSERT_EQ(els, expected);
+}
+
+TEST(radix_sort, CanReuseScratchBuffer)
+{
+    std::vector<KeyedElement> scratch;
+    for (const size_t n : std::to_array<size_t>({100, 5000, 10})) {
+        std::vector<KeyedElement> els = generate_keyed_elements(n, 0xffff00ff);
+        const std::vector<KeyedElement> expected = stable_sorted(els);
+
+        radix_sort(els, [](const KeyedElement& el) { return el.key; }, scratch);
+
+        ASSERT_EQ(els, expected);
+    }
+}
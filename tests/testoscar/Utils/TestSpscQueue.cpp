@@ -0,0 +1,104 @@
+#include <oscar/Utils/SpscQueue.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace osc;
+
+TEST(SpscQueue, TryPopOnEmptyQueueReturnsNullopt)
+{
+    SpscQueue<int> queue;
+    ASSERT_EQ(queue.try_pop(), std::nullopt);
+}
+
+TEST(SpscQueue, TryPopReturnsElementsInTheOrderTheyWerePushed)
+{
+    SpscQueue<int, 4> queue;  // (small chunks, so that the test crosses chunk boundaries)
+    for (int i = 0; i < 10; ++i) {
+        queue.push(i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(queue.try_pop(), i);
+    }
+    ASSERT_EQ(queue.try_pop(), std::nullopt);
+}
+
+TEST(SpscQueue, CanBeUsedAfterBeingDrainedAtAChunkBoundary)
+{
+    SpscQueue<int, 2> queue;
+    queue.push(1);
+    queue.push(2);
+    ASSERT_EQ(queue.try_pop(), 1);
+    ASSERT_EQ(queue.try_pop(), 2);
+    ASSERT_EQ(queue.try_pop(), std::nullopt);
+    queue.push(3);
+    ASSERT_EQ(queue.try_pop(), 3);
+}
+
+TEST(SpscQueue, PopAllPopsAllElementsInOrderAndReturnsHowManyWerePopped)
+{
+    SpscQueue<int, 3> queue;
+    for (int i = 0; i < 7; ++i) {
+        queue.push(i);
+    }
+
+    std::vector<int> popped;
+    ASSERT_EQ(queue.pop_all([&popped](int v) { popped.push_back(v); }), 7);
+    ASSERT_EQ(popped, std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+    ASSERT_EQ(queue.pop_all([](int) {}), 0);
+}
+
+TEST(SpscQueue, WorksWithMoveOnlyTypes)
+{
+    SpscQueue<std::unique_ptr<int>> queue;
+    queue.push(std::make_unique<int>(1337));
+    const std::optional<std::unique_ptr<int>> popped = queue.try_pop();
+    ASSERT_TRUE(popped);
+    ASSERT_EQ(**popped, 1337);
+}
+
+TEST(SpscQueue, DestructorDestroysElementsThatWerentPopped)
+{
+    const auto element = std::make_shared<int>(0);
+    {
+        SpscQueue<std::shared_ptr<int>, 2> queue;
+        for (int i = 0; i < 5; ++i) {
+            queue.push(element);
+        }
+        ASSERT_EQ(element.use_count(), 6);
+    }
+    ASSERT_EQ(element.use_count(), 1);
+}
+
+TEST(SpscQueue, ConsumerReceivesEverythingFromAConcurrentProducerInOrder)
+{
+    constexpr size_t num_elements = 100000;
+    SpscQueue<size_t, 16> queue;
+
+    std::thread producer{[&queue]()
+    {
+        for (size_t i = 0; i < num_elements; ++i) {
+            queue.push(i);
+        }
+    }};
+
+    size_t num_received = 0;
+    bool in_order = true;
+    while (num_received < num_elements) {
+        queue.pop_all([&](size_t v)
+        {
+            in_order = in_order and v == num_received;
+            ++num_received;
+        });
+    }
+    producer.join();
+
+    ASSERT_TRUE(in_order);
+    ASSERT_EQ(num_received, num_elements);
+    ASSERT_EQ(queue.try_pop(), std::nullopt);
+}
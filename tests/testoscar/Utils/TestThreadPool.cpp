@@ -0,0 +1,63 @@
+#include <oscar/Utils/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace osc;
+
+TEST(ThreadPool, DefaultConstructorCreatesAtLeastOneThread)
+{
+    ASSERT_GE(ThreadPool{}.num_threads(), 1);
+}
+
+TEST(ThreadPool, ConstructingWithZeroThreadsCreatesOneThread)
+{
+    ASSERT_EQ(ThreadPool{0}.num_threads(), 1);
+}
+
+TEST(ThreadPool, SubmitReturnsFutureToResultOfTask)
+{
+    ThreadPool pool{2};
+    ASSERT_EQ(pool.submit([]() { return 1337; }).get(), 1337);
+}
+
+TEST(ThreadPool, SubmitPropagatesExceptionsViaFuture)
+{
+    ThreadPool pool{1};
+    std::future<void> future = pool.submit([]() { throw std::runtime_error{"boom"}; });
+    ASSERT_THROW({ future.get(); }, std::runtime_error);
+}
+
+TEST(ThreadPool, RunsAllSubmittedTasks)
+{
+    ThreadPool pool{4};
+    std::atomic<size_t> num_calls = 0;
+
+    std::vector<std::future<void>> futures;
+    for (size_t i = 0; i < 1000; ++i) {
+        futures.push_back(pool.submit([&num_calls]() { ++num_calls; }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    ASSERT_EQ(num_calls, 1000);
+}
+
+TEST(ThreadPool, PostedTasksThatThrowDoNotKillTheWorker)
+{
+    ThreadPool pool{1};
+    pool.post([]() { throw std::runtime_error{"boom"}; });
+    ASSERT_EQ(pool.submit([]() { return 5; }).get(), 5);
+}
+
+TEST(ThreadPool, GlobalReturnsTheSamePoolEachTime)
+{
+    ASSERT_EQ(&ThreadPool::global(), &ThreadPool::global());
+    ASSERT_GE(ThreadPool::global().num_threads(), 1);
+}
@@ -0,0 +1,399 @@
+#include <oscar_simbody/TPS3D.h>
+
+#include <gtest/gtest.h>
+#include <oscar/Graphics/Mesh.h>
+#include <oscar/Maths/AABBFunctions.h>
+#include <oscar/Maths/CommonFunctions.h>
+#include <oscar/Maths/GeometricFunctions.h>
+#include <oscar/Maths/Vec3.h>
+#include <oscar_simbody/LandmarkPair3D.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace osc;
+
+namespace
+{
+    std::vector<Vec3> GenerateRandomPoints(std::default_random_engine& rng, size_t n)
+    {
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::vector<Vec3> rv;
+        rv.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            rv.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return rv;
+    }
+
+    // returns coefficients with random terms (the evaluator doesn't care whether they're solved)
+    TPSCoefficients3D GenerateRandomCoefficients(std::default_random_engine& rng, size_t numTerms)
+    {
+        TPSCoefficients3D rv;
+        rv.a1 = {0.1f, 0.2f, 0.3f};
+        rv.a2 = {1.1f, 0.1f, 0.0f};
+        rv.a3 = {0.0f, 0.9f, 0.1f};
+        rv.a4 = {0.2f, 0.0f, 1.0f};
+        const std::vector<Vec3> weights = GenerateRandomPoints(rng, numTerms);
+        const std::vector<Vec3> controlPoints = GenerateRandomPoints(rng, numTerms);
+        for (size_t i = 0; i < numTerms; ++i) {
+            rv.nonAffineTerms.emplace_back(weights[i], controlPoints[i]);
+        }
+        return rv;
+    }
+
+    // the accuracy that `TPSEvaluator3D` documents (relative to `EvaluateTPSEquation`)
+    bool IsCloseTo(const Vec3& got, const Vec3& expected)
+    {
+        return length(got - expected) <= 1e-4f * (1.0f + length(expected));
+    }
+
+    std::vector<LandmarkPair3D> GenerateRandomLandmarks(std::default_random_engine& rng, size_t n)
+    {
+        std::uniform_real_distribution<float> offsetDist{-0.1f, 0.1f};
+        std::vector<LandmarkPair3D> rv;
+        rv.reserve(n);
+        for (const Vec3& source : GenerateRandomPoints(rng, n)) {
+            rv.push_back({source, source + Vec3{offsetDist(rng), offsetDist(rng), offsetDist(rng)}});
+        }
+        return rv;
+    }
+
+    // returns `true` if both sets of coefficients produce (approximately) the same warp
+    bool ProduceSameWarp(const TPSCoefficients3D& a, const TPSCoefficients3D& b)
+    {
+        std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+        for (const Vec3& p : GenerateRandomPoints(rng, 50)) {
+            if (not IsCloseTo(EvaluateTPSEquation(a, p), EvaluateTPSEquation(b, p))) {
+                return false;
+            }
+        }
+        return a.nonAffineTerms.size() == b.nonAffineTerms.size();
+    }
+
+    constexpr auto c_Kernels = std::to_array({
+        TPSEvaluatorKernel3D::Fastest,
+        TPSEvaluatorKernel3D::Scalar,
+        TPSEvaluatorKernel3D::AVX2,
+    });
+}
+
+TEST(TPSEvaluator3D, GetKernelReturnsAResolvedKernel)
+{
+    for (const TPSEvaluatorKernel3D kernel : c_Kernels) {
+        const TPSEvaluator3D evaluator{TPSCoefficients3D{}, kernel};
+        ASSERT_NE(evaluator.getKernel(), TPSEvaluatorKernel3D::Fastest);
+    }
+    ASSERT_EQ(TPSEvaluator3D(TPSCoefficients3D{}, TPSEvaluatorKernel3D::Scalar).getKernel(), TPSEvaluatorKernel3D::Scalar);
+}
+
+TEST(TPSEvaluator3D, EvaluateWithIdentityCoefficientsReturnsInput)
+{
+    for (const TPSEvaluatorKernel3D kernel : c_Kernels) {
+        const TPSEvaluator3D evaluator{TPSCoefficients3D{}, kernel};
+        ASSERT_EQ(evaluator.evaluate({1.0f, 2.0f, 3.0f}), Vec3(1.0f, 2.0f, 3.0f));
+    }
+}
+
+TEST(TPSEvaluator3D, EvaluateReturnsSameResultAsEvaluateTPSEquation)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 150);
+
+    for (const TPSEvaluatorKernel3D kernel : c_Kernels) {
+        const TPSEvaluator3D evaluator{coefs, kernel};
+        for (const Vec3& p : GenerateRandomPoints(rng, 100)) {
+            ASSERT_TRUE(IsCloseTo(evaluator.evaluate(p), EvaluateTPSEquation(coefs, p)));
+        }
+    }
+}
+
+TEST(TPSEvaluator3D, EvaluateInPlaceReturnsSameResultsAsEvaluateTPSEquationWithBlending)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 77);  // not a multiple of the block size
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 50003);    // not a multiple of the batch size
+    const float blendingFactor = 0.75f;
+
+    for (const TPSEvaluatorKernel3D kernel : c_Kernels) {
+        std::vector<Vec3> warped = points;
+        TPSEvaluator3D{coefs, kernel}.evaluateInPlace(warped, blendingFactor);
+
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Vec3 expected = lerp(points[i], EvaluateTPSEquation(coefs, points[i]), blendingFactor);
+            ASSERT_TRUE(IsCloseTo(warped[i], expected)) << "point " << i;
+        }
+    }
+}
+
+TEST(ApplyThinPlateWarpToPoints, ReturnsExactlyTheSameResultsAsEvaluateTPSEquation)
+{
+    // points (e.g. model stations) aren't warped with `TPSEvaluator3D`'s single-precision
+    // accumulation, so they should be exactly what `EvaluateTPSEquation` produces
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 500);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 10000);
+    const float blendingFactor = 0.75f;
+
+    const std::vector<Vec3> warped = ApplyThinPlateWarpToPoints(coefs, points, blendingFactor);
+
+    ASSERT_EQ(warped.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(warped[i], lerp(points[i], EvaluateTPSEquation(coefs, points[i]), blendingFactor));
+    }
+}
+
+TEST(ApplyThinPlateWarpToMeshVertices, ReturnsExactlyTheSameVerticesAsEvaluatingThemInPlace)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 300);
+    const std::vector<Vec3> vertices = GenerateRandomPoints(rng, 3*5001);
+    const std::vector<Vec3> normals = GenerateRandomPoints(rng, vertices.size());
+    const float blendingFactor = 0.75f;
+
+    // the mesh has normals, so its vertices are interleaved (strided) in its vertex buffer
+    std::vector<uint32_t> indices(vertices.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    Mesh mesh;
+    mesh.set_vertices(vertices);
+    mesh.set_normals(normals);
+    mesh.set_indices(indices);
+
+    for (const float maxApproximationError : {0.0f, 0.01f}) {
+        std::vector<Vec3> expected = vertices;
+        if (maxApproximationError > 0.0f) {
+            TPSApproximateEvaluator3D{coefs, maxApproximationError}.evaluateInPlace(expected, blendingFactor);
+        }
+        else {
+            TPSEvaluator3D{coefs}.evaluateInPlace(expected, blendingFactor);
+        }
+
+        const Mesh warped = ApplyThinPlateWarpToMeshVertices(coefs, mesh, blendingFactor, maxApproximationError);
+
+        ASSERT_EQ(warped.vertices(), expected);
+        ASSERT_EQ(warped.normals(), normals) << "other vertex attributes shouldn't be modified";
+        ASSERT_EQ(warped.bounds(), bounding_aabb_of(expected)) << "the bounds should be recalculated";
+        ASSERT_EQ(mesh.vertices(), vertices) << "the input mesh shouldn't be modified";
+    }
+}
+
+TEST(TPSCoefficientSolver3D, DefaultConstructedHasIdentityCoefficients)
+{
+    ASSERT_EQ(TPSCoefficientSolver3D{}.getCoefficients(), TPSCoefficients3D{});
+}
+
+TEST(TPSCoefficientSolver3D, ConstructingWithInputsProducesSameWarpAsCalcCoefficients)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficientSolverInputs3D inputs{GenerateRandomLandmarks(rng, 40)};
+
+    const TPSCoefficientSolver3D solver{inputs};
+
+    ASSERT_EQ(solver.getInputs(), inputs);
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(inputs)));
+    ASSERT_EQ(solver.getNumFullSolves(), 1);
+}
+
+TEST(TPSCoefficientSolver3D, SolvedCoefficientsWarpSourcesOntoDestinations)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{GenerateRandomLandmarks(rng, 30)}};
+    solver.setLandmark(7, {{0.5f, 0.5f, 0.5f}, {0.6f, 0.4f, 0.5f}});
+
+    for (const LandmarkPair3D& landmark : solver.getInputs().landmarks) {
+        ASSERT_TRUE(IsCloseTo(EvaluateTPSEquation(solver.getCoefficients(), landmark.source), landmark.destination));
+    }
+}
+
+TEST(TPSCoefficientSolver3D, SetLandmarkUpdatesCoefficientsIncrementally)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{GenerateRandomLandmarks(rng, 50)}};
+
+    solver.setLandmark(10, {{0.1f, 0.2f, 0.3f}, {0.2f, 0.2f, 0.3f}});  // moves source + destination
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    solver.setLandmark(10, {{0.1f, 0.2f, 0.3f}, {0.0f, 0.2f, 0.3f}});  // only moves destination
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    ASSERT_EQ(solver.getNumFullSolves(), 1);
+    ASSERT_EQ(solver.getNumIncrementalUpdates(), 2);
+}
+
+TEST(TPSCoefficientSolver3D, InsertAndEraseLandmarkUpdateCoefficientsIncrementally)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{GenerateRandomLandmarks(rng, 50)}};
+
+    solver.insertLandmark(20, {{0.1f, 0.2f, 0.3f}, {0.2f, 0.2f, 0.3f}});
+    ASSERT_EQ(solver.getInputs().landmarks.size(), 51);
+    ASSERT_EQ(solver.getInputs().landmarks.at(20).source, Vec3(0.1f, 0.2f, 0.3f));
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    solver.insertLandmark(51, {{-0.1f, 0.2f, -0.3f}, {-0.2f, 0.2f, -0.3f}});  // append
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    solver.eraseLandmark(3);
+    ASSERT_EQ(solver.getInputs().landmarks.size(), 51);
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    ASSERT_EQ(solver.getNumFullSolves(), 1);
+    ASSERT_EQ(solver.getNumIncrementalUpdates(), 3);
+}
+
+TEST(TPSCoefficientSolver3D, SetInputsUpdatesIncrementallyForSmallChanges)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<LandmarkPair3D> landmarks = GenerateRandomLandmarks(rng, 40);
+    TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{landmarks}};
+
+    landmarks.at(5).source += Vec3{0.05f};  // move
+    solver.setInputs(TPSCoefficientSolverInputs3D{landmarks});
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    landmarks.insert(landmarks.begin() + 12, LandmarkPair3D{{0.3f, -0.3f, 0.3f}, {0.3f, -0.2f, 0.3f}});  // insert
+    solver.setInputs(TPSCoefficientSolverInputs3D{landmarks});
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    landmarks.erase(landmarks.begin() + 30);  // erase
+    solver.setInputs(TPSCoefficientSolverInputs3D{landmarks});
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+
+    ASSERT_EQ(solver.getInputs().landmarks, landmarks);
+    ASSERT_EQ(solver.getNumFullSolves(), 1);
+    ASSERT_EQ(solver.getNumIncrementalUpdates(), 3);
+
+    solver.setInputs(TPSCoefficientSolverInputs3D{GenerateRandomLandmarks(rng, 40)});  // large change
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+    ASSERT_EQ(solver.getNumFullSolves(), 2);
+}
+
+TEST(TPSCoefficientSolver3D, ManyRandomEditsProduceSameWarpAsCalcCoefficients)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    TPSCoefficientSolver3D solver{TPSCoefficientSolverInputs3D{GenerateRandomLandmarks(rng, 30)}};
+
+    for (size_t edit = 0; edit < 200; ++edit) {
+        const size_t numLandmarks = solver.getInputs().landmarks.size();
+        const LandmarkPair3D landmark = GenerateRandomLandmarks(rng, 1).front();
+        std::uniform_int_distribution<size_t> indexDist{0, numLandmarks - 1};
+        switch (edit % 4) {
+        case 0:
+        case 1: solver.setLandmark(indexDist(rng), landmark); break;
+        case 2: solver.insertLandmark(indexDist(rng), landmark); break;
+        default: solver.eraseLandmark(indexDist(rng)); break;
+        }
+    }
+
+    ASSERT_TRUE(ProduceSameWarp(solver.getCoefficients(), CalcCoefficients(solver.getInputs())));
+    ASSERT_GT(solver.getNumIncrementalUpdates(), 0);
+}
+
+TEST(TPSCoefficientSolver3D, FallsBackToCalcCoefficientsWhenTooFewLandmarksToInvert)
+{
+    // with fewer than 4 (non-coplanar) landmarks, L is singular, so the solver should
+    // produce the same (least-squares) coefficients as `CalcCoefficients`
+    TPSCoefficientSolver3D solver;
+    solver.insertLandmark(0, {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}});
+    ASSERT_EQ(solver.getCoefficients(), CalcCoefficients(solver.getInputs()));
+    solver.insertLandmark(1, {{1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}});
+    ASSERT_EQ(solver.getCoefficients(), CalcCoefficients(solver.getInputs()));
+    solver.eraseLandmark(0);
+    ASSERT_EQ(solver.getCoefficients(), CalcCoefficients(solver.getInputs()));
+
+    ASSERT_EQ(solver.getNumIncrementalUpdates(), 0);
+}
+
+TEST(TPSCoefficientSolver3D, FullSolvesProduceTheSameCoefficientsAsCalcCoefficientsForIllConditionedInputs)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_real_distribution<float> jitter{-1e-6f, 1e-6f};
+
+    // nearly-coplanar landmarks, plus a pair of nearly-duplicate ones, make L badly conditioned
+    std::vector<LandmarkPair3D> landmarks = GenerateRandomLandmarks(rng, 30);
+    for (LandmarkPair3D& landmark : landmarks) {
+        landmark.source.z = jitter(rng);
+    }
+    landmarks.push_back({landmarks.front().source + Vec3{jitter(rng)}, landmarks.front().destination});
+
+    const TPSCoefficientSolverInputs3D inputs{landmarks};
+    TPSCoefficientSolver3D solver{inputs};
+    ASSERT_EQ(solver.getCoefficients(), CalcCoefficients(inputs));
+
+    // changing many landmarks at once also fully re-solves
+    for (LandmarkPair3D& landmark : landmarks) {
+        landmark.destination += Vec3{0.01f};
+    }
+    solver.setInputs(TPSCoefficientSolverInputs3D{landmarks});
+    ASSERT_EQ(solver.getCoefficients(), CalcCoefficients(solver.getInputs()));
+    ASSERT_EQ(solver.getNumFullSolves(), 2);
+}
+
+TEST(TPSApproximateEvaluator3D, EvaluateWithIdentityCoefficientsReturnsInput)
+{
+    const TPSApproximateEvaluator3D evaluator{TPSCoefficients3D{}, 0.01f};
+    ASSERT_EQ(evaluator.evaluate({1.0f, 2.0f, 3.0f}), Vec3(1.0f, 2.0f, 3.0f));
+}
+
+TEST(TPSApproximateEvaluator3D, ZeroMaxAbsoluteErrorReturnsSameResultAsEvaluateTPSEquation)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 500);
+
+    const TPSApproximateEvaluator3D evaluator{coefs, 0.0f};
+    for (const Vec3& p : GenerateRandomPoints(rng, 100)) {
+        ASSERT_TRUE(IsCloseTo(evaluator.evaluate(p), EvaluateTPSEquation(coefs, p)));
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, EvaluateIsWithinMaxAbsoluteErrorOfEvaluateTPSEquation)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 2000);
+    std::vector<Vec3> points = GenerateRandomPoints(rng, 200);
+    for (Vec3& p : GenerateRandomPoints(rng, 200)) {
+        points.push_back(4.0f * p);  // also test points that are outside of the control points' bounds
+    }
+
+    for (const float maxAbsoluteError : {1.0f, 0.1f, 0.001f}) {
+        const TPSApproximateEvaluator3D evaluator{coefs, maxAbsoluteError};
+        for (const Vec3& p : points) {
+            const Vec3 expected = EvaluateTPSEquation(coefs, p);
+            ASSERT_LE(length(evaluator.evaluate(p) - expected), maxAbsoluteError + 1e-4f*(1.0f + length(expected)));
+        }
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, EvaluateHandlesCoincidentControlPoints)
+{
+    TPSCoefficients3D coefs;
+    for (size_t i = 0; i < 100; ++i) {
+        coefs.nonAffineTerms.emplace_back(Vec3{0.01f}, Vec3{0.5f});
+    }
+
+    const TPSApproximateEvaluator3D evaluator{coefs, 0.001f};
+    for (const Vec3& p : {Vec3{0.5f}, Vec3{0.0f}, Vec3{10.0f, 0.0f, 0.0f}}) {
+        ASSERT_TRUE(IsCloseTo(evaluator.evaluate(p), EvaluateTPSEquation(coefs, p)));
+    }
+}
+
+TEST(TPSApproximateEvaluator3D, ApplyThinPlateWarpToPointsUsesItWhenGivenAMaxApproximationError)
+{
+    std::default_random_engine rng{};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const TPSCoefficients3D coefs = GenerateRandomCoefficients(rng, 1000);
+    const std::vector<Vec3> points = GenerateRandomPoints(rng, 5000);
+    const float blendingFactor = 0.5f;
+    const float maxApproximationError = 0.01f;
+
+    const std::vector<Vec3> warped = ApplyThinPlateWarpToPoints(coefs, points, blendingFactor, maxApproximationError);
+
+    ASSERT_EQ(warped.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        const Vec3 expected = lerp(points[i], EvaluateTPSEquation(coefs, points[i]), blendingFactor);
+        ASSERT_LE(length(warped[i] - expected), blendingFactor*maxApproximationError + 1e-4f*(1.0f + length(expected)));
+    }
+}